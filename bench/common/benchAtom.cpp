@@ -0,0 +1,160 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "common/atom.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const U32 gKeys = 64;
+
+    // profiler style names, long enough that hashing them is not free
+    std::string GetName(U32 i)
+    {
+        return "Engine::Systems::Render::Pass" + std::to_string(i);
+    }
+
+    void StringMapLookup(benchmark::State &state)
+    {
+        std::unordered_map< std::string, U64 > map;
+        std::vector< std::string > keys;
+
+        for (U32 i = 0; i < gKeys; ++i)
+        {
+            keys.push_back(GetName(i));
+            map[keys.back()] = i;
+        }
+
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            for (const std::string &key : keys)
+            {
+                sum += map.find(key)->second;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * gKeys);
+    }
+
+    void AtomMapLookup(benchmark::State &state)
+    {
+        std::unordered_map< Atom, U64 > map;
+        std::vector< Atom > keys;
+
+        for (U32 i = 0; i < gKeys; ++i)
+        {
+            keys.push_back(Atom(GetName(i)));
+            map[keys.back()] = i;
+        }
+
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            for (const Atom &key : keys)
+            {
+                sum += map.find(key)->second;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * gKeys);
+    }
+
+    // an array indexed by atom ID, for tables that cover most atoms
+    void AtomArrayLookup(benchmark::State &state)
+    {
+        std::vector< Atom > keys;
+
+        for (U32 i = 0; i < gKeys; ++i)
+        {
+            keys.push_back(Atom(GetName(i)));
+        }
+
+        std::vector< U64 > table(AtomTable::GetSize() + 1);
+
+        for (U32 i = 0; i < gKeys; ++i)
+        {
+            table[keys[i].GetID()] = i;
+        }
+
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            for (const Atom &key : keys)
+            {
+                sum += table[key.GetID()];
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * gKeys);
+    }
+
+    void InternString(benchmark::State &state)
+    {
+        const std::string name = GetName(0);
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(AtomTable::Intern(name));
+        }
+    }
+
+    void InternLiteral(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(AtomTable::Intern("Engine::Systems::Render::Pass0"));
+        }
+    }
+
+    void InternLiteralThreads(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(AtomTable::Intern("Engine::Systems::Render::Pass0"));
+        }
+    }
+}
+
+BENCHMARK(StringMapLookup);
+BENCHMARK(AtomMapLookup);
+BENCHMARK(AtomArrayLookup);
+BENCHMARK(InternString);
+BENCHMARK(InternLiteral);
+BENCHMARK(InternLiteralThreads)->ThreadRange(1, 8)->UseRealTime();
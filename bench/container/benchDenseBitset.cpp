@@ -0,0 +1,262 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/denseBitset.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <random>
+
+namespace
+{
+    const size_t gBits = 10000000;
+
+    DenseBitset Generate(U32 seed, U32 percentage)
+    {
+        std::mt19937 generator(seed);
+        DenseBitset bits(gBits);
+
+        for (size_t i = 0; i < gBits; ++i)
+        {
+            bits[i] = generator() % 100 < percentage;
+        }
+
+        return bits;
+    }
+
+    // the visibility mask of an entity is combined with a filter mask, bit by bit and in bulk
+    void BitsetAndPerBit(benchmark::State &state)
+    {
+        DenseBitset a = Generate(1, 50);
+        const DenseBitset b = Generate(2, 50);
+
+        while (state.KeepRunning())
+        {
+            for (size_t i = 0; i < gBits; ++i)
+            {
+                a[i] = a[i] && b[i];
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetAndBulk(benchmark::State &state)
+    {
+        DenseBitset a = Generate(1, 50);
+        const DenseBitset b = Generate(2, 50);
+
+        while (state.KeepRunning())
+        {
+            a &= b;
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetAndNotBulk(benchmark::State &state)
+    {
+        DenseBitset a = Generate(1, 50);
+        const DenseBitset b = Generate(2, 50);
+
+        while (state.KeepRunning())
+        {
+            a.AndNot(b);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetCountPerBit(benchmark::State &state)
+    {
+        const DenseBitset bits = Generate(1, 50);
+
+        while (state.KeepRunning())
+        {
+            size_t count = 0;
+
+            for (size_t i = 0; i < gBits; ++i)
+            {
+                count += bits[i] ? 1 : 0;
+            }
+
+            benchmark::DoNotOptimize(count);
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetCount(benchmark::State &state)
+    {
+        const DenseBitset bits = Generate(1, 50);
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(bits.Count());
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    // the argument is the percentage of set bits
+    void BitsetIteratePerBit(benchmark::State &state)
+    {
+        const DenseBitset bits = Generate(1, static_cast< U32 >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            size_t sum = 0;
+
+            for (size_t i = 0; i < gBits; ++i)
+            {
+                if (bits[i])
+                {
+                    sum += i;
+                }
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetIterateFindNext(benchmark::State &state)
+    {
+        const DenseBitset bits = Generate(1, static_cast< U32 >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            size_t sum = 0;
+
+            for (size_t bit = bits.FindFirst(); bit != bits.GetSize(); bit = bits.FindNext(bit))
+            {
+                sum += bit;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetIterateForEachSet(benchmark::State &state)
+    {
+        const DenseBitset bits = Generate(1, static_cast< U32 >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            size_t sum = 0;
+
+            bits.ForEachSet([&sum](size_t bit)
+            {
+                sum += bit;
+            });
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+
+    void BitsetSetRange(benchmark::State &state)
+    {
+        DenseBitset bits(gBits);
+
+        while (state.KeepRunning())
+        {
+            bits.SetRange(3, gBits - 3);
+            bits.ClearRange(3, gBits - 3);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits * 2);
+    }
+
+    void BitsetRank(benchmark::State &state)
+    {
+        DenseBitset bits = Generate(1, 50);
+        bits.BuildRankIndex();
+
+        std::mt19937 generator(3);
+        std::uniform_int_distribution< size_t > dist(0, gBits);
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(bits.Rank(dist(generator)));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BitsetSelect(benchmark::State &state)
+    {
+        DenseBitset bits = Generate(1, 50);
+        bits.BuildRankIndex();
+
+        std::mt19937 generator(3);
+        std::uniform_int_distribution< size_t > dist(0, bits.Count() - 1);
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(bits.Select(dist(generator)));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BitsetBuildRankIndex(benchmark::State &state)
+    {
+        DenseBitset bits = Generate(1, 50);
+
+        while (state.KeepRunning())
+        {
+            bits.BuildRankIndex();
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBits);
+    }
+}
+
+BENCHMARK(BitsetAndPerBit);
+BENCHMARK(BitsetAndBulk);
+BENCHMARK(BitsetAndNotBulk);
+BENCHMARK(BitsetCountPerBit);
+BENCHMARK(BitsetCount);
+BENCHMARK(BitsetIteratePerBit)->Arg(1)->Arg(50);
+BENCHMARK(BitsetIterateFindNext)->Arg(1)->Arg(50);
+BENCHMARK(BitsetIterateForEachSet)->Arg(1)->Arg(50);
+BENCHMARK(BitsetSetRange);
+BENCHMARK(BitsetRank);
+BENCHMARK(BitsetSelect);
+BENCHMARK(BitsetBuildRankIndex);
@@ -0,0 +1,171 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/fastPtrHashMap.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Object
+    {
+        U64 value;
+    };
+
+    // keeps the first `live` objects of the permutation stored, so the load stays at 65%
+    struct Churn
+    {
+        Churn(size_t capacity)
+            : objects(capacity * 2),
+              live(capacity * 65 / 100),
+              generator(1)
+        {
+            for (Object &object : objects)
+            {
+                order.push_back(&object);
+            }
+
+            std::shuffle(order.begin(), order.end(), generator);
+        }
+
+        std::vector< Object > objects;
+        std::vector< Object * > order;
+        size_t live;
+        std::mt19937_64 generator;
+    };
+
+    void Insert(FastPtrHashMap< Object, U64 > &map, Object *object)
+    {
+        map.Insert(object, object->value);
+    }
+
+    void Insert(std::unordered_map< Object *, U64 > &map, Object *object)
+    {
+        map.emplace(object, object->value);
+    }
+
+    void Erase(FastPtrHashMap< Object, U64 > &map, Object *object)
+    {
+        map.Erase(object);
+    }
+
+    void Erase(std::unordered_map< Object *, U64 > &map, Object *object)
+    {
+        map.erase(object);
+    }
+
+    bool Has(FastPtrHashMap< Object, U64 > &map, Object *object)
+    {
+        return map.Has(object);
+    }
+
+    bool Has(std::unordered_map< Object *, U64 > &map, Object *object)
+    {
+        return map.count(object) != 0;
+    }
+
+    template< typename tMap >
+    void BM_MixedHighLoad(benchmark::State &state)
+    {
+        const size_t capacity = static_cast< size_t >(state.range(0));
+        Churn churn(capacity);
+        tMap map(capacity);
+
+        for (size_t i = 0; i < churn.live; ++i)
+        {
+            Insert(map, churn.order[i]);
+        }
+
+        std::uniform_int_distribution< size_t > liveDist(0, churn.live - 1);
+        std::uniform_int_distribution< size_t > deadDist(churn.live, churn.order.size() - 1);
+
+        while (state.KeepRunning())
+        {
+            // one erase, one insert and two lookups
+            const size_t erased = liveDist(churn.generator);
+            const size_t inserted = deadDist(churn.generator);
+
+            Erase(map, churn.order[erased]);
+            Insert(map, churn.order[inserted]);
+            std::swap(churn.order[erased], churn.order[inserted]);
+
+            benchmark::DoNotOptimize(Has(map, churn.order[liveDist(churn.generator)]));
+            benchmark::DoNotOptimize(Has(map, churn.order[deadDist(churn.generator)]));
+        }
+
+        state.SetItemsProcessed(state.iterations() * 4);
+    }
+
+    BENCHMARK_TEMPLATE(BM_MixedHighLoad, std::unordered_map< Object *, U64 >)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_MixedHighLoad, FastPtrHashMap< Object, U64 >)->Range(1 << 10, 1 << 20);
+
+    template< bool tBatched >
+    void BM_FindMany(benchmark::State &state)
+    {
+        const size_t capacity = static_cast< size_t >(state.range(0));
+        Churn churn(capacity);
+        FastPtrHashMap< Object, U64 > map(capacity);
+
+        for (size_t i = 0; i < churn.live; ++i)
+        {
+            Insert(map, churn.order[i]);
+        }
+
+        std::vector< Object * > keys(churn.order.begin(), churn.order.begin() + churn.live);
+        std::shuffle(keys.begin(), keys.end(), churn.generator);
+
+        std::vector< U64 * > values(keys.size());
+
+        while (state.KeepRunning())
+        {
+            if (tBatched)
+            {
+                benchmark::DoNotOptimize(map.FindMany(keys.data(), keys.size(), values.data()));
+            }
+            else
+            {
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    map.Find(keys[i], values[i]);
+                }
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    BENCHMARK_TEMPLATE(BM_FindMany, false)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_FindMany, true)->Range(1 << 10, 1 << 20);
+}
@@ -0,0 +1,291 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/fastPtrHashMap.h"
+#include "container/flatHashMap.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    std::vector< U64 > GenerateKeys(size_t count, U32 seed)
+    {
+        std::mt19937_64 generator(seed);
+        std::vector< U64 > keys(count);
+
+        for (U64 &key : keys)
+        {
+            key = generator();
+        }
+
+        return keys;
+    }
+
+    template< typename tMap >
+    void BM_Insert(benchmark::State &state)
+    {
+        const std::vector< U64 > keys = GenerateKeys(static_cast< size_t >(state.range(0)), 1);
+
+        while (state.KeepRunning())
+        {
+            tMap map;
+
+            for (U64 key : keys)
+            {
+                map.emplace(key, key);
+            }
+
+            benchmark::DoNotOptimize(map.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    BENCHMARK_TEMPLATE(BM_Insert, std::unordered_map< U64, U64 >)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_Insert, FlatHashMap< U64, U64 >)->Range(1 << 10, 1 << 20);
+
+    template< typename tMap >
+    void BM_FindHit(benchmark::State &state)
+    {
+        std::vector< U64 > keys = GenerateKeys(static_cast< size_t >(state.range(0)), 1);
+
+        tMap map;
+
+        for (U64 key : keys)
+        {
+            map.emplace(key, key);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(2));
+
+        while (state.KeepRunning())
+        {
+            U64 sum = 0;
+
+            for (U64 key : keys)
+            {
+                sum += map.find(key)->second;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    BENCHMARK_TEMPLATE(BM_FindHit, std::unordered_map< U64, U64 >)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_FindHit, FlatHashMap< U64, U64 >)->Range(1 << 10, 1 << 20);
+
+    template< typename tMap >
+    void BM_FindMiss(benchmark::State &state)
+    {
+        const std::vector< U64 > keys = GenerateKeys(static_cast< size_t >(state.range(0)), 1);
+        const std::vector< U64 > misses = GenerateKeys(keys.size(), 3);
+
+        tMap map;
+
+        for (U64 key : keys)
+        {
+            map.emplace(key, key);
+        }
+
+        while (state.KeepRunning())
+        {
+            size_t found = 0;
+
+            for (U64 key : misses)
+            {
+                found += map.count(key);
+            }
+
+            benchmark::DoNotOptimize(found);
+        }
+
+        state.SetItemsProcessed(state.iterations() * misses.size());
+    }
+
+    BENCHMARK_TEMPLATE(BM_FindMiss, std::unordered_map< U64, U64 >)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_FindMiss, FlatHashMap< U64, U64 >)->Range(1 << 10, 1 << 20);
+
+    // erases and reinserts a quarter of the keys, so the map keeps a steady size
+    template< typename tMap >
+    void BM_EraseInsert(benchmark::State &state)
+    {
+        const std::vector< U64 > keys = GenerateKeys(static_cast< size_t >(state.range(0)), 1);
+        const size_t churn = keys.size() / 4;
+
+        tMap map;
+
+        for (U64 key : keys)
+        {
+            map.emplace(key, key);
+        }
+
+        size_t offset = 0;
+
+        while (state.KeepRunning())
+        {
+            for (size_t i = 0; i < churn; ++i)
+            {
+                map.erase(keys[(offset + i) % keys.size()]);
+            }
+
+            for (size_t i = 0; i < churn; ++i)
+            {
+                const U64 key = keys[(offset + i) % keys.size()];
+                map.emplace(key, key);
+            }
+
+            offset += churn;
+        }
+
+        state.SetItemsProcessed(state.iterations() * churn * 2);
+    }
+
+    BENCHMARK_TEMPLATE(BM_EraseInsert, std::unordered_map< U64, U64 >)->Range(1 << 10, 1 << 20);
+    BENCHMARK_TEMPLATE(BM_EraseInsert, FlatHashMap< U64, U64 >)->Range(1 << 10, 1 << 20);
+
+    // FastPtrHashMap only takes pointer keys, so we compare on those
+    struct Object
+    {
+        U64 value;
+    };
+
+    void BM_PtrFindHitFastPtrHashMap(benchmark::State &state)
+    {
+        std::vector< Object > objects(static_cast< size_t >(state.range(0)));
+        std::vector< Object * > keys;
+
+        FastPtrHashMap< Object, U64 > map;
+
+        for (Object &object : objects)
+        {
+            map.Insert(&object, 1);
+            keys.push_back(&object);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(2));
+
+        while (state.KeepRunning())
+        {
+            U64 sum = 0;
+            U64 *value;
+
+            for (Object *key : keys)
+            {
+                map.Find(key, value);
+                sum += *value;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    BENCHMARK(BM_PtrFindHitFastPtrHashMap)->Range(1 << 10, 1 << 20);
+
+    void BM_PtrFindHitFlatHashMap(benchmark::State &state)
+    {
+        std::vector< Object > objects(static_cast< size_t >(state.range(0)));
+        std::vector< Object * > keys;
+
+        FlatHashMap< Object *, U64 > map;
+
+        for (Object &object : objects)
+        {
+            map.emplace(&object, 1);
+            keys.push_back(&object);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(2));
+
+        while (state.KeepRunning())
+        {
+            U64 sum = 0;
+
+            for (Object *key : keys)
+            {
+                sum += map.find(key)->second;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    BENCHMARK(BM_PtrFindHitFlatHashMap)->Range(1 << 10, 1 << 20);
+
+    void BM_PtrInsertFastPtrHashMap(benchmark::State &state)
+    {
+        std::vector< Object > objects(static_cast< size_t >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            FastPtrHashMap< Object, U64 > map;
+
+            for (Object &object : objects)
+            {
+                map.Insert(&object, 1);
+            }
+
+            benchmark::DoNotOptimize(&map);
+        }
+
+        state.SetItemsProcessed(state.iterations() * objects.size());
+    }
+
+    BENCHMARK(BM_PtrInsertFastPtrHashMap)->Range(1 << 10, 1 << 20);
+
+    void BM_PtrInsertFlatHashMap(benchmark::State &state)
+    {
+        std::vector< Object > objects(static_cast< size_t >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            FlatHashMap< Object *, U64 > map;
+
+            for (Object &object : objects)
+            {
+                map.emplace(&object, 1);
+            }
+
+            benchmark::DoNotOptimize(&map);
+        }
+
+        state.SetItemsProcessed(state.iterations() * objects.size());
+    }
+
+    BENCHMARK(BM_PtrInsertFlatHashMap)->Range(1 << 10, 1 << 20);
+}
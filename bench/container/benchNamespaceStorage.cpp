@@ -0,0 +1,114 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/namespaceNamedStorage.h"
+#include "container/namespaceStorage.h"
+
+#include "common/typeID.h"
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <typeindex>
+
+namespace
+{
+    const U32 gLookups = 1000;
+
+    template< U32 tN >
+    struct Stored
+    {
+    };
+
+    // selects between the type_index keys and the dense type identifiers
+    template< typename tName, typename tT >
+    struct Select;
+
+    template< typename tT >
+    struct Select< std::type_index, tT >
+    {
+        static std::type_index Get()
+        {
+            return typeid(tT);
+        }
+    };
+
+    template< typename tT >
+    struct Select< TypeID, tT >
+    {
+        static TypeID Get()
+        {
+            return TypeID::Get< tT >();
+        }
+    };
+
+    template< typename tName >
+    void NamespaceStorageGet(benchmark::State &state)
+    {
+        NamespaceStorage< tName, U32 > storage;
+        storage.Add(new U32(1), Select< tName, Stored< 1 >>::Get());
+        storage.Add(new U32(2), Select< tName, Stored< 2 >>::Get());
+        storage.Add(new U32(3), Select< tName, Stored< 3 >>::Get());
+        storage.Add(new U32(4), Select< tName, Stored< 4 >>::Get(), 1u);
+        storage.Add(new U32(5), Select< tName, Stored< 5 >>::Get(), Namespace(1, 1));
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gLookups; ++i)
+            {
+                benchmark::DoNotOptimize(storage.Get(Select< tName, Stored< 3 >>::Get()));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gLookups);
+    }
+
+    template< typename tName >
+    void NamespaceNamedStorageGet(benchmark::State &state)
+    {
+        NamespaceNamedStorage< tName, U32 > storage;
+        storage.Add(new U32(1), Select< tName, Stored< 1 >>::Get());
+        storage.Add(new U32(2), Select< tName, Stored< 2 >>::Get());
+        storage.Add(new U32(3), Select< tName, Stored< 3 >>::Get());
+        storage.Add(new U32(4), Select< tName, Stored< 4 >>::Get(), 1u);
+        storage.Add(new U32(5), Select< tName, Stored< 5 >>::Get(), Namespace(1, 1));
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gLookups; ++i)
+            {
+                benchmark::DoNotOptimize(storage.Get(Select< tName, Stored< 3 >>::Get()));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gLookups);
+    }
+}
+
+BENCHMARK_TEMPLATE(NamespaceStorageGet, std::type_index);
+BENCHMARK_TEMPLATE(NamespaceStorageGet, TypeID);
+BENCHMARK_TEMPLATE(NamespaceNamedStorageGet, std::type_index);
+BENCHMARK_TEMPLATE(NamespaceNamedStorageGet, TypeID);
@@ -0,0 +1,196 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/unorderedContiguousMap.h"
+#include "container/slotMap.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Component
+    {
+        F32 position[3];
+        F32 velocity[3];
+    };
+
+    // inserts count values and erases every third one, so the dense array has holes filled by swaps
+    template< typename tHandle >
+    void FillSlotMap(SlotMap< Component, tHandle > &map, std::vector< SlotHandle< tHandle > > &handles, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            handles.push_back(map.Insert(Component{ { 1, 2, 3 }, { 1, 1, 1 } }));
+        }
+
+        std::vector< SlotHandle< tHandle > > live;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                map.Erase(handles[i]);
+            }
+            else
+            {
+                live.push_back(handles[i]);
+            }
+        }
+
+        handles.swap(live);
+        std::shuffle(handles.begin(), handles.end(), std::mt19937(42));
+    }
+
+    // Delete does not fix up the key of the value swapped into the hole, so only insert the same live set
+    void FillContiguousMap(UnorderedContiguousMap< U32, Component > &map, std::vector< U32 > &keys, size_t count)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            if (i % 3 != 0)
+            {
+                map.Insert(i, Component{ { 1, 2, 3 }, { 1, 1, 1 } });
+                keys.push_back(i);
+            }
+        }
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    }
+
+    template< typename tHandle >
+    void SlotMapLookup(benchmark::State &state)
+    {
+        SlotMap< Component, tHandle > map;
+        std::vector< SlotHandle< tHandle > > handles;
+        FillSlotMap(map, handles, static_cast< size_t >(state.range(0)));
+
+        F32 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            for (auto handle : handles)
+            {
+                sum += map.Find(handle)->position[0];
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * handles.size());
+    }
+
+    void UnorderedContiguousMapLookup(benchmark::State &state)
+    {
+        UnorderedContiguousMap< U32, Component > map;
+        std::vector< U32 > keys;
+        FillContiguousMap(map, keys, static_cast< size_t >(state.range(0)));
+
+        F32 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            for (U32 key : keys)
+            {
+                sum += map.Find(key)->position[0];
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * keys.size());
+    }
+
+    void SlotMapIterate(benchmark::State &state)
+    {
+        SlotMap< Component > map;
+        std::vector< SlotHandle< U32 > > handles;
+        FillSlotMap(map, handles, static_cast< size_t >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            for (Component &component : map)
+            {
+                for (U32 i = 0; i < 3; ++i)
+                {
+                    component.position[i] += component.velocity[i];
+                }
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * map.Size());
+    }
+
+    void UnorderedContiguousMapIterate(benchmark::State &state)
+    {
+        UnorderedContiguousMap< U32, Component > map;
+        std::vector< U32 > keys;
+        FillContiguousMap(map, keys, static_cast< size_t >(state.range(0)));
+
+        while (state.KeepRunning())
+        {
+            for (Component &component : map.GetValues())
+            {
+                for (U32 i = 0; i < 3; ++i)
+                {
+                    component.position[i] += component.velocity[i];
+                }
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * map.Size());
+    }
+
+    // steady state churn: erase a live value and insert a new one
+    void SlotMapChurn(benchmark::State &state)
+    {
+        SlotMap< Component > map;
+        std::vector< SlotHandle< U32 > > handles;
+        FillSlotMap(map, handles, static_cast< size_t >(state.range(0)));
+
+        size_t i = 0;
+
+        while (state.KeepRunning())
+        {
+            map.Erase(handles[i]);
+            handles[i] = map.Insert(Component{ { 1, 2, 3 }, { 1, 1, 1 } });
+            i = (i + 1) % handles.size();
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(SlotMapLookup, U32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(SlotMapLookup, U64)->Range(1 << 10, 1 << 20);
+BENCHMARK(UnorderedContiguousMapLookup)->Range(1 << 10, 1 << 20);
+BENCHMARK(SlotMapIterate)->Range(1 << 10, 1 << 20);
+BENCHMARK(UnorderedContiguousMapIterate)->Range(1 << 10, 1 << 20);
+BENCHMARK(SlotMapChurn)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,281 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/namespaceNamedStorage.h"
+#include "container/smallVector.h"
+
+#include "manager/eventManager.h"
+
+#include "events/observer.h"
+
+#include "common/string.h"
+
+#include "config.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// count the allocations of the whole binary, the benchmarks report the difference per iteration
+#if !PROGRAM_OVERRIDE_NEW
+
+namespace
+{
+    std::atomic< U64 > gAllocations(0);
+}
+
+void *operator new(size_t bytes)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    void *const ptr = std::malloc(bytes ? bytes : 1);
+
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void *operator new[](size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    operator delete[](ptr);
+}
+
+#endif
+
+namespace
+{
+    U64 GetAllocationCount()
+    {
+#if !PROGRAM_OVERRIDE_NEW
+        return gAllocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+    void SetAllocationCounter(benchmark::State &state, U64 start)
+    {
+        state.counters["allocs"] = benchmark::Counter(static_cast< F64 >(GetAllocationCount() - start) / state.iterations());
+    }
+
+    class TestEvent
+        : public IEvent
+    {
+    };
+
+    class Receiver
+    {
+    public:
+
+        void OnEvent(const TestEvent &)
+        {
+            benchmark::DoNotOptimize(++mCount);
+        }
+
+        U32 mCount = 0;
+    };
+
+    typedef Observer< Receiver, TestEvent > TestObserver;
+
+    // the copy EventManager::Post makes of the observers, with the previous and the current list type
+    template< typename tList >
+    void BM_PostObserverCopy(benchmark::State &state)
+    {
+        Receiver receiver;
+        std::vector< TestObserver > storage(static_cast< size_t >(state.range(0)), TestObserver(&receiver, &Receiver::OnEvent));
+        std::vector< AbstractObserver * > registered;
+
+        for (auto &observer : storage)
+        {
+            registered.push_back(&observer);
+        }
+
+        SpinLock lock;
+        const TestEvent event;
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            lock.lock();
+            const tList observers(registered.begin(), registered.end());
+            lock.unlock();
+
+            for (AbstractObserver *observer : observers)
+            {
+                observer->Notify(event);
+            }
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK_TEMPLATE(BM_PostObserverCopy, std::vector< AbstractObserver * >)->Arg(1)->Arg(4)->Arg(8)->Arg(32);
+    BENCHMARK_TEMPLATE(BM_PostObserverCopy, EventManager::ObserverList)->Arg(1)->Arg(4)->Arg(8)->Arg(32);
+
+    void BM_EventManagerPost(benchmark::State &state)
+    {
+        Receiver receiver;
+        std::vector< TestObserver > storage(static_cast< size_t >(state.range(0)), TestObserver(&receiver, &Receiver::OnEvent));
+
+        EventManager manager;
+
+        for (auto &observer : storage)
+        {
+            manager.Add< TestEvent >(&observer);
+        }
+
+        const TestEvent event;
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            manager.Post(event);
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+
+        for (auto &observer : storage)
+        {
+            manager.Remove< TestEvent >(&observer, false);
+        }
+    }
+
+    BENCHMARK(BM_EventManagerPost)->Arg(1)->Arg(4)->Arg(8)->Arg(32);
+
+    // a typical short configuration value, the parts fit in the small string buffer
+    const std::string gSplitInput = "x, y, width, height";
+
+    void BM_SplitReturnVector(benchmark::State &state)
+    {
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(String::Split(gSplitInput, ',', true));
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_SplitReturnVector);
+
+    template< typename tContainer >
+    void BM_SplitContainer(benchmark::State &state)
+    {
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            tContainer parts;
+            String::Split(gSplitInput, ',', parts, true);
+            benchmark::DoNotOptimize(parts.data());
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK_TEMPLATE(BM_SplitContainer, std::vector< std::string >);
+    BENCHMARK_TEMPLATE(BM_SplitContainer, SmallVector< std::string, 8 >);
+
+    void FillStorage(NamespaceNamedStorage< U32, U32 > &storage, U32 count)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            storage.Add(new U32(i), i, Namespace(1, static_cast< U16 >(i % 3)));
+        }
+    }
+
+    void BM_GetNamesReturnVector(benchmark::State &state)
+    {
+        NamespaceNamedStorage< U32, U32 > storage;
+        FillStorage(storage, static_cast< U32 >(state.range(0)));
+
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(storage.GetNames(Namespace(1, 0)));
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_GetNamesReturnVector)->Arg(4)->Arg(16)->Arg(64);
+
+    template< typename tContainer >
+    void BM_GetNamesContainer(benchmark::State &state)
+    {
+        NamespaceNamedStorage< U32, U32 > storage;
+        FillStorage(storage, static_cast< U32 >(state.range(0)));
+
+        const U64 allocations = GetAllocationCount();
+
+        while (state.KeepRunning())
+        {
+            tContainer names;
+            storage.GetNames(Namespace(1, 0), names);
+            benchmark::DoNotOptimize(names.data());
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK_TEMPLATE(BM_GetNamesContainer, std::vector< U32 >)->Arg(4)->Arg(16)->Arg(64);
+    BENCHMARK_TEMPLATE(BM_GetNamesContainer, SmallVector< U32, 16 >)->Arg(4)->Arg(16)->Arg(64);
+}
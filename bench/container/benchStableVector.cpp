@@ -0,0 +1,167 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/stableVector.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Object
+    {
+        F32 position[3];
+        F32 velocity[3];
+        U32 id;
+        U32 flags;
+    };
+
+    template< typename tContainer >
+    void Fill(tContainer &container, size_t count)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            container.push_back(Object{ { 1, 2, 3 }, { 1, 1, 1 }, i, 0 });
+        }
+    }
+
+    template< typename tContainer >
+    void BM_PushBack(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+
+        while (state.KeepRunning())
+        {
+            tContainer container;
+            Fill(container, count);
+            benchmark::DoNotOptimize(&container.back());
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK_TEMPLATE(BM_PushBack, std::vector< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_PushBack, std::deque< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_PushBack, StableVector< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_PushBack, StableVector< Object, 1024 >)->Range(1 << 8, 1 << 18);
+
+    template< typename tContainer >
+    void BM_Iterate(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+
+        tContainer container;
+        Fill(container, count);
+
+        while (state.KeepRunning())
+        {
+            F32 sum = 0;
+
+            for (const Object &object : container)
+            {
+                sum += object.position[0] * object.velocity[0];
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK_TEMPLATE(BM_Iterate, std::vector< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_Iterate, std::deque< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_Iterate, StableVector< Object >)->Range(1 << 8, 1 << 18);
+
+    template< typename tContainer >
+    void BM_IterateChunks(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+
+        tContainer container;
+        Fill(container, count);
+
+        while (state.KeepRunning())
+        {
+            F32 sum = 0;
+
+            container.ForEachChunk([&sum](const Object * objects, size_t chunkCount)
+            {
+                for (size_t i = 0; i < chunkCount; ++i)
+                {
+                    sum += objects[i].position[0] * objects[i].velocity[0];
+                }
+            });
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK_TEMPLATE(BM_IterateChunks, StableVector< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_IterateChunks, StableVector< Object, 1024 >)->Range(1 << 8, 1 << 18);
+
+    template< typename tContainer >
+    void BM_RandomAccess(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+
+        tContainer container;
+        Fill(container, count);
+
+        std::vector< U32 > indices(4096);
+        std::mt19937 generator(42);
+        std::uniform_int_distribution< U32 > distribution(0, static_cast< U32 >(count - 1));
+
+        for (U32 &index : indices)
+        {
+            index = distribution(generator);
+        }
+
+        while (state.KeepRunning())
+        {
+            U32 sum = 0;
+
+            for (U32 index : indices)
+            {
+                sum += container[index].id;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * indices.size());
+    }
+
+    BENCHMARK_TEMPLATE(BM_RandomAccess, std::vector< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_RandomAccess, std::deque< Object >)->Range(1 << 8, 1 << 18);
+    BENCHMARK_TEMPLATE(BM_RandomAccess, StableVector< Object >)->Range(1 << 8, 1 << 18);
+}
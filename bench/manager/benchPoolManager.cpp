@@ -0,0 +1,180 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "manager/poolManager.h"
+
+#include "manager/scheduleManager.h"
+
+#include "common/types.h"
+
+#include "config.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+namespace
+{
+    const U32 gLookups = 1000;
+
+    std::atomic< U32 > gNextThreadID(0);
+
+    // benchmark threads are no engine threads, so we hand out consecutive IDs
+    void AssignThreadID()
+    {
+        ScheduleManager::SetCurrentThreadID(static_cast< ThreadID >(gNextThreadID.fetch_add(1) %
+                                                                    (PROGRAM_MAX_THREADS + 1)));
+    }
+
+    template< U32 tN >
+    struct Pooled
+    {
+        void OnInit()
+        {
+        }
+
+        void OnRelease()
+        {
+        }
+
+        U32 value[tN];
+    };
+
+    bool AddPools(PoolManager &pools)
+    {
+        pools.Add< Pooled< 1 >>();
+        pools.Add< Pooled< 2 >>();
+        pools.Add< Pooled< 3 >>();
+        pools.Add< Pooled< 4 >>();
+        pools.Add< Pooled< 5 >>(1);
+        pools.Add< Pooled< 6 >>(Namespace(1, 1));
+
+        return true;
+    }
+
+    // all benchmark threads share the manager, the statics are initialised only once
+    PoolManager &GetPools()
+    {
+        static PoolManager pools;
+        static const bool added = AddPools(pools);
+        (void)added;
+
+        return pools;
+    }
+
+    // the previous read path: a lock and two nested map lookups
+    class LockedRegistry
+    {
+    public:
+
+        LockedRegistry()
+        {
+            mObjects[ 0u ][ typeid(Pooled< 1 >) ] = &mObjects;
+            mObjects[ 0u ][ typeid(Pooled< 2 >) ] = &mObjects;
+            mObjects[ 0u ][ typeid(Pooled< 3 >) ] = &mObjects;
+            mObjects[ 0u ][ typeid(Pooled< 4 >) ] = &mObjects;
+            mObjects[ 1u ][ typeid(Pooled< 5 >) ] = &mObjects;
+        }
+
+        void *Get(const std::type_index &type, Namespace ns) const
+        {
+            std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+            const auto nameIt = mObjects.find(ns);
+
+            if (nameIt != mObjects.end())
+            {
+                const auto objectIt = nameIt->second.find(type);
+
+                if (objectIt != nameIt->second.end())
+                {
+                    return objectIt->second;
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+
+        std::unordered_map< Namespace, std::unordered_map< std::type_index, void * >> mObjects;
+        mutable std::recursive_mutex mMutex;
+    };
+
+    LockedRegistry gLocked;
+
+    void LockedGet(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gLookups; ++i)
+            {
+                benchmark::DoNotOptimize(gLocked.Get(typeid(Pooled< 3 >), 0u));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gLookups);
+    }
+
+    void PoolGet(benchmark::State &state)
+    {
+        AssignThreadID();
+        PoolManager &pools = GetPools();
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gLookups; ++i)
+            {
+                benchmark::DoNotOptimize(pools.Get< Pooled< 3 >>());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gLookups);
+    }
+
+    void PoolGetUnassigned(benchmark::State &state)
+    {
+        ScheduleManager::SetCurrentThreadID(Thread::InvalidID);
+        PoolManager &pools = GetPools();
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gLookups; ++i)
+            {
+                benchmark::DoNotOptimize(pools.Get< Pooled< 3 >>());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gLookups);
+    }
+}
+
+BENCHMARK(LockedGet)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(PoolGet)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(PoolGetUnassigned)->ThreadRange(1, 8)->UseRealTime();
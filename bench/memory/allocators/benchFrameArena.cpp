@@ -0,0 +1,106 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/blockAllocator.h"
+#include "memory/allocators/frameArena.h"
+
+#include "common/util.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    // a typical per frame command
+    struct Command
+    {
+        U64 key;
+        F32 transform[12];
+        U32 flags;
+    };
+
+    const U32 gCommands = 10000;
+
+    void BlockAllocatorFrame(benchmark::State &state)
+    {
+        BlockAllocator allocator(SIZE_OF_MB(1));
+        std::vector< BlockAllocator::BlockLocation > locations(gCommands);
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gCommands; ++i)
+            {
+                Command command = {};
+                command.key = i;
+                locations[i] = allocator.Move(command);
+            }
+
+            U64 sum = 0;
+
+            for (BlockAllocator::BlockLocation location : locations)
+            {
+                sum += allocator.Extract< Command >(location)->key;
+            }
+
+            benchmark::DoNotOptimize(sum);
+            allocator.Clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gCommands);
+    }
+
+    void FrameArenaFrame(benchmark::State &state)
+    {
+        FrameArena arena(SIZE_OF_MB(1));
+        std::vector< Command * > commands(gCommands);
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gCommands; ++i)
+            {
+                Command *const command = arena.New< Command >();
+                command->key = i;
+                commands[i] = command;
+            }
+
+            U64 sum = 0;
+
+            for (Command *command : commands)
+            {
+                sum += command->key;
+            }
+
+            benchmark::DoNotOptimize(sum);
+            arena.Reset();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gCommands);
+    }
+}
+
+BENCHMARK(BlockAllocatorFrame);
+BENCHMARK(FrameArenaFrame);
@@ -0,0 +1,139 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/hugePageArena.h"
+#include "memory/allocators/malloc.h"
+
+#include "preproc/os.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstring>
+
+#if !OS_IS_WINDOWS
+#   include <sys/resource.h>
+#endif
+
+namespace
+{
+    const size_t gWorkingSet = 256 * 1024 * 1024;
+    const size_t gPageSize = 4096;
+
+    // random reads over the working set, each on a different page
+    const U32 gReads = 1 << 20;
+
+    U64 GetPageFaults()
+    {
+#if OS_IS_WINDOWS
+        return 0;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast< U64 >(usage.ru_minflt + usage.ru_majflt);
+#endif
+    }
+
+    U64 TouchAndRead(U8 *memory)
+    {
+        for (size_t offset = 0; offset < gWorkingSet; offset += gPageSize)
+        {
+            memory[offset] = static_cast< U8 >(offset >> 12);
+        }
+
+        U64 sum = 0;
+        U32 seed = 42;
+
+        for (U32 i = 0; i < gReads; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            sum += memory[(seed % (gWorkingSet / gPageSize)) * gPageSize];
+        }
+
+        return sum;
+    }
+
+    void ReportFaults(benchmark::State &state, U64 faults)
+    {
+        state.counters["faults"] = benchmark::Counter(static_cast< double >(faults) / state.iterations());
+    }
+
+    void ArenaFaults(benchmark::State &state, HugePageArena::PageMode mode)
+    {
+        U64 faults = 0;
+
+        while (state.KeepRunning())
+        {
+            HugePageArena arena(gWorkingSet, mode);
+            U8 *const memory = static_cast< U8 * >(arena.Allocate(gWorkingSet, gPageSize));
+
+            const U64 before = GetPageFaults();
+            benchmark::DoNotOptimize(TouchAndRead(memory));
+            faults += GetPageFaults() - before;
+        }
+
+        ReportFaults(state, faults);
+    }
+
+    void NormalPages(benchmark::State &state)
+    {
+        ArenaFaults(state, HugePageArena::PageMode::Normal);
+    }
+
+    void TransparentHugePages(benchmark::State &state)
+    {
+        ArenaFaults(state, HugePageArena::PageMode::Transparent);
+    }
+
+    void ExplicitHugePages(benchmark::State &state)
+    {
+        ArenaFaults(state, HugePageArena::PageMode::Explicit);
+    }
+
+    void AlignedMalloc(benchmark::State &state)
+    {
+        U64 faults = 0;
+
+        while (state.KeepRunning())
+        {
+            U8 *const memory = static_cast< U8 * >(ZefAlignedMalloc(gWorkingSet, gPageSize));
+
+            const U64 before = GetPageFaults();
+            benchmark::DoNotOptimize(TouchAndRead(memory));
+            faults += GetPageFaults() - before;
+
+            ZefAlignedFree(memory);
+        }
+
+        ReportFaults(state, faults);
+    }
+}
+
+BENCHMARK(AlignedMalloc)->Unit(benchmark::kMillisecond);
+BENCHMARK(NormalPages)->Unit(benchmark::kMillisecond);
+BENCHMARK(TransparentHugePages)->Unit(benchmark::kMillisecond);
+BENCHMARK(ExplicitHugePages)->Unit(benchmark::kMillisecond);
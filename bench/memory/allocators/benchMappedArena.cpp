@@ -0,0 +1,211 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/mappedArena.h"
+
+#include "container/persistentHashMap.h"
+
+#include "common/file.h"
+
+#include "benchmark/benchmark.h"
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+    const U32 gLayoutVersion = 1;
+
+    typedef PersistentHashMap< U32, U64 > Table;
+
+    // the source data a process parses on startup when it has nothing better
+    std::string WriteSource(size_t count)
+    {
+        const std::string path = File::TempGet();
+        std::ofstream stream(path);
+
+        for (U32 i = 0; i < count; ++i)
+        {
+            stream << i * 13 << ' ' << static_cast< U64 >(i) * i << '\n';
+        }
+
+        return path;
+    }
+
+    size_t GetArenaSize(size_t count)
+    {
+        return count * 64 + 1024 * 1024;
+    }
+
+    template< typename tInsert >
+    void ParseSource(const std::string &path, const tInsert &insert)
+    {
+        std::ifstream stream(path);
+
+        U32 key;
+        U64 value;
+
+        while (stream >> key >> value)
+        {
+            insert(key, value);
+        }
+    }
+
+    void BuildTable(MappedArena &arena, const std::string &source, size_t count)
+    {
+        Table *table = arena.New< Table >();
+        table->Reserve(arena, count);
+
+        ParseSource(source, [&](U32 key, U64 value)
+        {
+            table->Insert(arena, key, value);
+        });
+
+        arena.SetRoot(table);
+        arena.Commit();
+    }
+
+    // what we do today: parse into a heap table on every start
+    void BM_StartupParse(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+        const std::string source = WriteSource(count);
+
+        while (state.KeepRunning())
+        {
+            std::unordered_map< U32, U64 > table;
+            table.reserve(count);
+
+            ParseSource(source, [&table](U32 key, U64 value)
+            {
+                table.emplace(key, value);
+            });
+
+            benchmark::DoNotOptimize(table.find(13));
+        }
+
+        File::Delete(source);
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK(BM_StartupParse)->Arg(1 << 14)->Arg(1 << 17)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+    // the first start, or a start after a layout change, which parses and writes the file
+    void BM_StartupRebuild(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+        const std::string source = WriteSource(count);
+        const std::string path = File::TempGet();
+
+        while (state.KeepRunning())
+        {
+            MappedArena arena;
+            arena.Open(path, GetArenaSize(count), gLayoutVersion);
+            BuildTable(arena, source, count);
+
+            benchmark::DoNotOptimize(arena.GetRoot< Table >()->Find(13));
+
+            // the next iteration starts without a file again
+            state.PauseTiming();
+            arena.Close();
+            File::Delete(path);
+            state.ResumeTiming();
+        }
+
+        File::Delete(source);
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK(BM_StartupRebuild)->Arg(1 << 14)->Arg(1 << 17)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+    // a warm start, which maps the committed file and does a lookup
+    void BM_StartupMapped(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+        const std::string source = WriteSource(count);
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, GetArenaSize(count), gLayoutVersion);
+            BuildTable(arena, source, count);
+        }
+
+        while (state.KeepRunning())
+        {
+            MappedArena arena;
+
+            if (arena.Open(path, GetArenaSize(count), gLayoutVersion) != MappedArena::OpenResult::Opened)
+            {
+                state.SkipWithError("The committed file was not accepted");
+                break;
+            }
+
+            benchmark::DoNotOptimize(arena.GetRoot< Table >()->Find(13));
+        }
+
+        File::Delete(source);
+        File::Delete(path);
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK(BM_StartupMapped)->Arg(1 << 14)->Arg(1 << 17)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+    // a warm start that touches the whole table, so every page is faulted in
+    void BM_StartupMappedScan(benchmark::State &state)
+    {
+        const size_t count = static_cast< size_t >(state.range(0));
+        const std::string source = WriteSource(count);
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, GetArenaSize(count), gLayoutVersion);
+            BuildTable(arena, source, count);
+        }
+
+        while (state.KeepRunning())
+        {
+            MappedArena arena;
+            arena.Open(path, GetArenaSize(count), gLayoutVersion);
+
+            U64 sum = 0;
+            arena.GetRoot< Table >()->ForEach([&sum](U32, U64 value)
+            {
+                sum += value;
+            });
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        File::Delete(source);
+        File::Delete(path);
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    BENCHMARK(BM_StartupMappedScan)->Arg(1 << 14)->Arg(1 << 17)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+}
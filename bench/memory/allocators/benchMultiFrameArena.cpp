@@ -0,0 +1,119 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/multiFrameArena.h"
+
+#include "common/util.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    // a result produced in one frame and consumed by the next
+    struct Result
+    {
+        U64 id;
+        F32 values[14];
+    };
+
+    const U32 gResults = 10000;
+
+    U64 Consume(const std::vector< Result * > &results)
+    {
+        U64 sum = 0;
+
+        for (const Result *result : results)
+        {
+            sum += result->id;
+        }
+
+        return sum;
+    }
+
+    void HeapFrames(benchmark::State &state)
+    {
+        std::vector< Result * > previous;
+        std::vector< Result * > current;
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gResults; ++i)
+            {
+                Result *const result = new Result;
+                result->id = i;
+                current.push_back(result);
+            }
+
+            benchmark::DoNotOptimize(Consume(previous));
+
+            for (Result *result : previous)
+            {
+                delete result;
+            }
+
+            previous.clear();
+            previous.swap(current);
+        }
+
+        for (Result *result : previous)
+        {
+            delete result;
+        }
+
+        state.SetItemsProcessed(state.iterations() * gResults);
+    }
+
+    void MultiFrameArenaFrames(benchmark::State &state)
+    {
+        MultiFrameArena arena(2, SIZE_OF_MB(1));
+        std::vector< Result * > previous;
+        std::vector< Result * > current;
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gResults; ++i)
+            {
+                Result *const result = arena.New< Result >();
+                result->id = i;
+                current.push_back(result);
+            }
+
+            benchmark::DoNotOptimize(Consume(previous));
+
+            previous.clear();
+            previous.swap(current);
+
+            arena.NextFrame();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gResults);
+    }
+}
+
+BENCHMARK(HeapFrames);
+BENCHMARK(MultiFrameArenaFrames);
@@ -0,0 +1,164 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/malloc.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <stdlib.h>
+#include <atomic>
+
+namespace
+{
+    const size_t gBatchSize = 64;
+
+    struct Glibc
+    {
+        static void *Allocate(size_t bytes)
+        {
+            return malloc(bytes);
+        }
+
+        static void Free(void *ptr)
+        {
+            free(ptr);
+        }
+    };
+
+    struct Slab
+    {
+        static void *Allocate(size_t bytes)
+        {
+            return ZefAlignedMalloc(bytes, 16);
+        }
+
+        static void Free(void *ptr)
+        {
+            ZefAlignedFree(ptr);
+        }
+    };
+
+    // mostly small sizes with the occasional larger one, as in typical engine code
+    size_t GetSize(U32 &seed)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const U32 roll = seed >> 24;
+
+        if (roll < 192)
+        {
+            return 16 + (seed >> 8) % 240;
+        }
+
+        if (roll < 248)
+        {
+            return 256 + (seed >> 8) % 3840;
+        }
+
+        return 4096 + (seed >> 8) % 28672;
+    }
+
+    struct Batch
+    {
+        void *ptrs[gBatchSize];
+    };
+
+    std::atomic< Batch * > gMailbox(nullptr);
+
+    template< typename tAllocator >
+    void MixedSizes(benchmark::State &state)
+    {
+        U32 seed = 42;
+        void *ptrs[gBatchSize];
+
+        while (state.KeepRunning())
+        {
+            for (void *&ptr : ptrs)
+            {
+                ptr = tAllocator::Allocate(GetSize(seed));
+            }
+
+            for (void *ptr : ptrs)
+            {
+                tAllocator::Free(ptr);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBatchSize);
+    }
+
+    // every thread frees the batch another thread allocated
+    template< typename tAllocator >
+    void CrossThreadFree(benchmark::State &state)
+    {
+        U32 seed = 42;
+        Batch *batch = new Batch;
+
+        while (state.KeepRunning())
+        {
+            for (void *&ptr : batch->ptrs)
+            {
+                ptr = tAllocator::Allocate(GetSize(seed));
+            }
+
+            Batch *other = gMailbox.exchange(batch);
+
+            if (other)
+            {
+                for (void *ptr : other->ptrs)
+                {
+                    tAllocator::Free(ptr);
+                }
+
+                batch = other;
+            }
+            else
+            {
+                batch = new Batch;
+            }
+        }
+
+        delete batch;
+
+        if (Batch *left = gMailbox.exchange(nullptr))
+        {
+            for (void *ptr : left->ptrs)
+            {
+                tAllocator::Free(ptr);
+            }
+
+            delete left;
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBatchSize);
+    }
+}
+
+BENCHMARK_TEMPLATE(MixedSizes, Glibc)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(MixedSizes, Slab)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(CrossThreadFree, Glibc)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(CrossThreadFree, Slab)->ThreadRange(2, 8)->UseRealTime();
@@ -0,0 +1,118 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/instantiator/memoryPoolInstantiator.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const size_t gBlockSize = 16;
+
+    struct Object
+    {
+        U64 data[4];
+    };
+
+    struct Heavy
+    {
+        Heavy()
+        {
+            std::memset(data, 0, sizeof(data));
+        }
+
+        U8 data[4096];
+    };
+
+    // destroys and recreates objects spread over all blocks
+    void DestroyCreate(benchmark::State &state)
+    {
+        const size_t blocks = static_cast< size_t >(state.range(0));
+        MemoryPoolInstantiator< Object > inst(gBlockSize, blocks);
+
+        std::vector< Object * > objects(gBlockSize * blocks);
+
+        for (Object *&object : objects)
+        {
+            object = inst.Create();
+        }
+
+        std::shuffle(objects.begin(), objects.end(), std::mt19937(42));
+
+        size_t i = 0;
+
+        while (state.KeepRunning())
+        {
+            Object *&object = objects[i];
+            inst.Destroy(object);
+            object = inst.Create();
+
+            i = i + 1 == objects.size() ? 0 : i + 1;
+        }
+
+        for (Object *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+
+    // the cost of adding a block that holds 1000 4KB objects, and using one of them
+    void BlockGrowth(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            MemoryPoolInstantiator< Heavy > inst(1000, 1);
+
+            Heavy *heavy = inst.Create();
+            benchmark::DoNotOptimize(heavy->data);
+
+            inst.Destroy(heavy);
+        }
+    }
+
+    // what growing a block cost while every object in the block was constructed up front
+    void BlockGrowthEager(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            Heavy *block = new Heavy[1000];
+            benchmark::DoNotOptimize(block->data);
+
+            delete[] block;
+        }
+    }
+}
+
+BENCHMARK(BlockGrowth);
+BENCHMARK(BlockGrowthEager);
+BENCHMARK(DestroyCreate)->RangeMultiplier(10)->Range(1, 1000);
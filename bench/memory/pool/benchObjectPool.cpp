@@ -0,0 +1,105 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/pool/objectPool.h"
+
+#include "manager/scheduleManager.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+
+namespace
+{
+    // the amount of objects a thread holds at once
+    const U32 gBatchSize = 16;
+
+    class Object
+    {
+    public:
+
+        void OnInit()
+        {
+            value = 1;
+        }
+
+        void OnRelease()
+        {
+            value = 0;
+        }
+
+        U64 value = 0;
+    };
+
+    std::atomic< U32 > gNextThreadID(0);
+
+    // benchmark threads are no engine threads, so we hand out consecutive IDs
+    void AssignThreadID()
+    {
+        ScheduleManager::SetCurrentThreadID(static_cast< ThreadID >(gNextThreadID.fetch_add(1) %
+                                                                    (PROGRAM_MAX_THREADS + 1)));
+    }
+
+    ObjectPool< Object > gSharedPool(1024);
+    ObjectPool< Object > gMagazinePool(1024, gBatchSize);
+
+    void GetDispose(benchmark::State &state, ObjectPool< Object > &pool)
+    {
+        AssignThreadID();
+
+        Object *objects[gBatchSize];
+
+        while (state.KeepRunning())
+        {
+            for (Object *&object : objects)
+            {
+                object = pool.Get();
+            }
+
+            for (Object *object : objects)
+            {
+                pool.Dispose(object);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gBatchSize);
+    }
+
+    void ObjectPoolShared(benchmark::State &state)
+    {
+        GetDispose(state, gSharedPool);
+    }
+
+    void ObjectPoolMagazine(benchmark::State &state)
+    {
+        GetDispose(state, gMagazinePool);
+    }
+}
+
+BENCHMARK(ObjectPoolShared)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(ObjectPoolMagazine)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,101 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/pool/unsynchronisedObjectPool.h"
+#include "memory/pool/objectPool.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    class Object
+    {
+    public:
+
+        void OnInit()
+        {
+            value = 1;
+        }
+
+        void OnRelease()
+        {
+            value = 0;
+        }
+
+        U64 value = 0;
+    };
+
+    template< typename tPool >
+    void PoolLoop(benchmark::State &state)
+    {
+        tPool pool(4096);
+        const size_t count = static_cast< size_t >(state.range(0));
+        std::vector< Object * > objects(count);
+
+        while (state.KeepRunning())
+        {
+            for (Object *&object : objects)
+            {
+                object = pool.Get();
+            }
+
+            for (Object *object : objects)
+            {
+                pool.Dispose(object);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    template< typename tPool >
+    void PoolBatch(benchmark::State &state)
+    {
+        tPool pool(4096);
+        const size_t count = static_cast< size_t >(state.range(0));
+        std::vector< Object * > objects(count);
+
+        while (state.KeepRunning())
+        {
+            pool.GetBatch(count, objects.data());
+            pool.DisposeBatch(objects.data(), count);
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    typedef ObjectPool< Object > SharedPool;
+    typedef UnsynchronisedObjectPool< Object > LocalPool;
+}
+
+BENCHMARK_TEMPLATE(PoolLoop, SharedPool)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PoolBatch, SharedPool)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PoolLoop, LocalPool)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PoolBatch, LocalPool)->Arg(64)->Arg(1024);
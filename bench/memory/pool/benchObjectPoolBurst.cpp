@@ -0,0 +1,127 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/pool/objectPool.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    const U32 gFrames = 120;
+    const U32 gBurst = 5000;
+    const U32 gSteady = 50;
+
+    U64 gCreated = 0;
+
+    class Object
+    {
+    public:
+
+        Object()
+        {
+            ++gCreated;
+        }
+
+        void OnInit()
+        {
+        }
+
+        void OnRelease()
+        {
+        }
+
+        U64 data[8];
+    };
+
+    // a burst every couple of seconds on top of a steady load
+    void Burst(benchmark::State &state, ObjectPool< Object > &pool)
+    {
+        std::vector< Object * > objects;
+        const U64 created = gCreated;
+
+        while (state.KeepRunning())
+        {
+            for (U32 frame = 0; frame < gFrames; ++frame)
+            {
+                const U32 count = frame == 0 ? gBurst : gSteady;
+
+                for (U32 i = 0; i < count; ++i)
+                {
+                    objects.push_back(pool.Get());
+                }
+
+                for (Object *object : objects)
+                {
+                    pool.Dispose(object);
+                }
+
+                objects.clear();
+                pool.Adapt();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * (gBurst + (gFrames - 1) * gSteady));
+        state.counters["created"] = benchmark::Counter(static_cast< F64 >(gCreated - created) / state.iterations());
+        state.counters["idleKB"] = benchmark::Counter(static_cast< F64 >(pool.GetIdleCount() * sizeof(Object)) / 1024);
+    }
+
+    void PoolBurstFixedSmall(benchmark::State &state)
+    {
+        ObjectPool< Object > pool(500);
+        Burst(state, pool);
+    }
+
+    void PoolBurstFixedLarge(benchmark::State &state)
+    {
+        ObjectPool< Object > pool(gBurst);
+        Burst(state, pool);
+    }
+
+    void PoolBurstAdaptive(benchmark::State &state)
+    {
+        ObjectPool< Object > pool(500);
+        pool.SetAdaptiveCapacity(gSteady, gBurst, 10);
+        Burst(state, pool);
+    }
+
+    void PoolBurstTrim(benchmark::State &state)
+    {
+        ObjectPool< Object > pool(gBurst);
+        Burst(state, pool);
+
+        // what a memory pressure trim gives back after the burst
+        state.counters["trimmed"] = benchmark::Counter(static_cast< F64 >(pool.Trim()));
+    }
+}
+
+BENCHMARK(PoolBurstFixedSmall);
+BENCHMARK(PoolBurstFixedLarge);
+BENCHMARK(PoolBurstAdaptive);
+BENCHMARK(PoolBurstTrim);
@@ -0,0 +1,110 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/pool/objectPool.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    const U32 gObjects = 10000;
+
+    class Object
+    {
+    public:
+
+        void OnInit()
+        {
+            data[0] = 1;
+        }
+
+        void OnRelease()
+        {
+        }
+
+        // large enough that the objects span many pages
+        U64 data[64];
+    };
+
+    // the time the first frame spends getting its objects from a fresh pool
+    void FirstFrame(benchmark::State &state, size_t reserve, bool faultIn)
+    {
+        std::vector< Object * > objects;
+        objects.reserve(gObjects);
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+
+            ObjectPool< Object > *pool = new ObjectPool< Object >(gObjects);
+            pool->Reserve(reserve, faultIn);
+
+            state.ResumeTiming();
+
+            for (U32 i = 0; i < gObjects; ++i)
+            {
+                objects.push_back(pool->Get());
+            }
+
+            state.PauseTiming();
+
+            for (Object *object : objects)
+            {
+                pool->Dispose(object);
+            }
+
+            objects.clear();
+            delete pool;
+
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * gObjects);
+    }
+
+    void PoolFirstFrameCold(benchmark::State &state)
+    {
+        FirstFrame(state, 0, false);
+    }
+
+    void PoolFirstFrameReserved(benchmark::State &state)
+    {
+        FirstFrame(state, gObjects, false);
+    }
+
+    void PoolFirstFrameFaultedIn(benchmark::State &state)
+    {
+        FirstFrame(state, gObjects, true);
+    }
+}
+
+BENCHMARK(PoolFirstFrameCold);
+BENCHMARK(PoolFirstFrameReserved);
+BENCHMARK(PoolFirstFrameFaultedIn);
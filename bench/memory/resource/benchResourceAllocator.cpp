@@ -0,0 +1,153 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/resourceAllocator.h"
+#include "memory/resource/frameArenaResource.h"
+#include "memory/resource/unsynchronisedPoolResource.h"
+
+#include "memory/allocators/frameArena.h"
+
+#include "common/types.h"
+#include "common/util.h"
+
+#include "benchmark/benchmark.h"
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+    const U32 gEntries = 10000;
+
+    typedef std::pair< const U32, U32 > Entry;
+
+    typedef std::map< U32, U32 > HeapMap;
+    typedef std::map< U32, U32, std::less< U32 >, ResourceAllocator< Entry >> ResourceMap;
+
+    typedef std::unordered_map< U32, U32 > HeapHashMap;
+    typedef std::unordered_map< U32, U32, std::hash< U32 >, std::equal_to< U32 >, ResourceAllocator< Entry >>
+            ResourceHashMap;
+
+    // fills a map, looks every key up and erases half of them, as a frame of bookkeeping would
+    template< typename tMap >
+    void Workload(tMap &map, benchmark::State &state)
+    {
+        for (U32 i = 0; i < gEntries; ++i)
+        {
+            map[i * 7919u] = i;
+        }
+
+        U64 sum = 0;
+
+        for (U32 i = 0; i < gEntries; ++i)
+        {
+            sum += map.find(i * 7919u)->second;
+        }
+
+        for (U32 i = 0; i < gEntries; i += 2)
+        {
+            map.erase(i * 7919u);
+        }
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations() * gEntries);
+    }
+
+    template< typename tMap >
+    void MapHeap(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            tMap map;
+            Workload(map, state);
+        }
+    }
+
+    template< typename tMap >
+    tMap MakeMap(MemoryResource *resource);
+
+    template<>
+    ResourceMap MakeMap< ResourceMap >(MemoryResource *resource)
+    {
+        return ResourceMap(resource);
+    }
+
+    template<>
+    ResourceHashMap MakeMap< ResourceHashMap >(MemoryResource *resource)
+    {
+        return ResourceHashMap(0, std::hash< U32 >(), std::equal_to< U32 >(), resource);
+    }
+
+    template< typename tMap >
+    void MapDefaultResource(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            tMap map = MakeMap< tMap >(GetDefaultMemoryResource());
+            Workload(map, state);
+        }
+    }
+
+    template< typename tMap >
+    void MapPoolResource(benchmark::State &state)
+    {
+        UnsynchronisedPoolResource resource;
+
+        while (state.KeepRunning())
+        {
+            tMap map = MakeMap< tMap >(&resource);
+            Workload(map, state);
+        }
+    }
+
+    template< typename tMap >
+    void MapFrameArena(benchmark::State &state)
+    {
+        FrameArena arena(SIZE_OF_MB(1));
+        FrameArenaResource resource(arena);
+
+        while (state.KeepRunning())
+        {
+            {
+                tMap map = MakeMap< tMap >(&resource);
+                Workload(map, state);
+            }
+
+            arena.Reset();
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(MapHeap, HeapMap);
+BENCHMARK_TEMPLATE(MapDefaultResource, ResourceMap);
+BENCHMARK_TEMPLATE(MapPoolResource, ResourceMap);
+BENCHMARK_TEMPLATE(MapFrameArena, ResourceMap);
+
+BENCHMARK_TEMPLATE(MapHeap, HeapHashMap);
+BENCHMARK_TEMPLATE(MapDefaultResource, ResourceHashMap);
+BENCHMARK_TEMPLATE(MapPoolResource, ResourceHashMap);
+BENCHMARK_TEMPLATE(MapFrameArena, ResourceHashMap);
@@ -0,0 +1,96 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/heapProfiler.h"
+#include "memory/allocators/slabAllocator.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    const U32 gAllocations = 1000;
+
+    // allocates and frees a batch of mixed sizes, optionally through the profiler hooks
+    template< bool tProfile >
+    void AllocateBatch(benchmark::State &state)
+    {
+        std::vector< void * > pointers(gAllocations);
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gAllocations; ++i)
+            {
+                const size_t bytes = 16 << (i % 8);
+                pointers[i] = SlabAllocator::Allocate(bytes, 16);
+
+                if (tProfile)
+                {
+                    HeapProfiler::OnAllocate(pointers[i], bytes, HeapSampleSource::Heap);
+                }
+            }
+
+            for (U32 i = 0; i < gAllocations; ++i)
+            {
+                if (tProfile)
+                {
+                    HeapProfiler::OnFree(pointers[i], HeapSampleSource::Heap);
+                }
+
+                SlabAllocator::Free(pointers[i]);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gAllocations);
+    }
+
+    void HeapProfilerNone(benchmark::State &state)
+    {
+        AllocateBatch< false >(state);
+    }
+
+    void HeapProfilerDisabled(benchmark::State &state)
+    {
+        HeapProfiler::SetSampleInterval(0);
+        AllocateBatch< true >(state);
+        HeapProfiler::SetSampleInterval(HeapProfiler::DefaultSampleInterval);
+    }
+
+    void HeapProfilerSampling(benchmark::State &state)
+    {
+        HeapProfiler::SetSampleInterval(static_cast< size_t >(state.range(0)));
+        AllocateBatch< true >(state);
+
+        HeapProfiler::SetSampleInterval(HeapProfiler::DefaultSampleInterval);
+    }
+}
+
+BENCHMARK(HeapProfilerNone)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(HeapProfilerDisabled)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(HeapProfilerSampling)->Arg(64 * 1024)->Arg(512 * 1024)->ThreadRange(1, 8)->UseRealTime();
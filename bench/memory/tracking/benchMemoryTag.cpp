@@ -0,0 +1,82 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/memoryTag.h"
+
+#include "manager/scheduleManager.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+
+namespace
+{
+    const U32 gAllocations = 1000;
+
+    std::atomic< U32 > gNextThreadID(0);
+
+    // benchmark threads are no engine threads, so we hand out consecutive IDs
+    void AssignThreadID()
+    {
+        ScheduleManager::SetCurrentThreadID(static_cast< ThreadID >(gNextThreadID.fetch_add(1) %
+                                                                    (PROGRAM_MAX_THREADS + 1)));
+    }
+
+    MemoryTag gTag("Bench", MemoryKind::Allocator, 0U);
+
+    void Track(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gAllocations; ++i)
+            {
+                gTag.OnAllocate(64);
+                gTag.OnFree(64);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gAllocations);
+    }
+
+    // every thread writes its own counters
+    void MemoryTagOwned(benchmark::State &state)
+    {
+        AssignThreadID();
+        Track(state);
+    }
+
+    // all threads share the counters of threads without a valid ID
+    void MemoryTagShared(benchmark::State &state)
+    {
+        ScheduleManager::SetCurrentThreadID(Thread::InvalidID);
+        Track(state);
+    }
+}
+
+BENCHMARK(MemoryTagOwned)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(MemoryTagShared)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,172 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/rwSpinLock.h"
+#include "threading/spinlock.h"
+#include "threading/seqLock.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <shared_mutex>
+#include <mutex>
+
+namespace
+{
+    // one write in every twenty operations, a 95/5 read/write mix
+    const U32 gWriteInterval = 20;
+
+    struct Snapshot
+    {
+        U64 frame;
+        F64 time;
+        F64 delta;
+        U64 checksum;
+    };
+
+    Snapshot gSnapshot = {};
+
+    SpinLock gSpinLock;
+    std::mutex gMutex;
+    std::shared_timed_mutex gSharedMutex;
+    RWSpinLock gRWSpinLock;
+    SeqLock< Snapshot > gSeqLock;
+
+    template< typename tLock >
+    void ReadWriteExclusive(benchmark::State &state, tLock &lock)
+    {
+        U32 i = 0;
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            std::lock_guard< tLock > guard(lock);
+
+            if (++i % gWriteInterval == 0)
+            {
+                ++gSnapshot.frame;
+                gSnapshot.checksum = gSnapshot.frame;
+            }
+            else
+            {
+                sum += gSnapshot.checksum;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    template< typename tLock >
+    void ReadWriteShared(benchmark::State &state, tLock &lock)
+    {
+        U32 i = 0;
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            if (++i % gWriteInterval == 0)
+            {
+                std::lock_guard< tLock > guard(lock);
+                ++gSnapshot.frame;
+                gSnapshot.checksum = gSnapshot.frame;
+            }
+            else
+            {
+                std::shared_lock< tLock > guard(lock);
+                sum += gSnapshot.checksum;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    void SpinLockMix(benchmark::State &state)
+    {
+        ReadWriteExclusive(state, gSpinLock);
+    }
+
+    void MutexMix(benchmark::State &state)
+    {
+        ReadWriteExclusive(state, gMutex);
+    }
+
+    void SharedMutexMix(benchmark::State &state)
+    {
+        ReadWriteShared(state, gSharedMutex);
+    }
+
+    void RWSpinLockMix(benchmark::State &state)
+    {
+        const U64 readContention = gRWSpinLock.GetReadContentionCount();
+        const U64 writeContention = gRWSpinLock.GetWriteContentionCount();
+
+        ReadWriteShared(state, gRWSpinLock);
+
+        // every thread observes (nearly) the whole run, so the average is the contention of the run
+        state.counters["readContention"] = benchmark::Counter(static_cast< F64 >(gRWSpinLock.GetReadContentionCount() -
+                                                                                 readContention), benchmark::Counter::kAvgThreads);
+        state.counters["writeContention"] = benchmark::Counter(static_cast< F64 >(gRWSpinLock.GetWriteContentionCount() -
+                                                                                  writeContention), benchmark::Counter::kAvgThreads);
+    }
+
+    void SeqLockMix(benchmark::State &state)
+    {
+        const U64 readRetries = gSeqLock.GetReadRetryCount();
+        const U64 writeContention = gSeqLock.GetWriteContentionCount();
+
+        U32 i = 0;
+        U64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            if (++i % gWriteInterval == 0)
+            {
+                Snapshot snapshot = gSeqLock.Read();
+                ++snapshot.frame;
+                snapshot.checksum = snapshot.frame;
+                gSeqLock.Write(snapshot);
+            }
+            else
+            {
+                sum += gSeqLock.Read().checksum;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+
+        state.counters["readRetries"] = benchmark::Counter(static_cast< F64 >(gSeqLock.GetReadRetryCount() - readRetries),
+                                                           benchmark::Counter::kAvgThreads);
+        state.counters["writeContention"] = benchmark::Counter(static_cast< F64 >(gSeqLock.GetWriteContentionCount() -
+                                                                                  writeContention), benchmark::Counter::kAvgThreads);
+    }
+}
+
+BENCHMARK(SpinLockMix)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(MutexMix)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(SharedMutexMix)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(RWSpinLockMix)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(SeqLockMix)->ThreadRange(1, 8)->UseRealTime();
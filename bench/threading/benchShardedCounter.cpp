@@ -0,0 +1,135 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/shardedCounter.h"
+#include "threading/perThread.h"
+
+#include "manager/scheduleManager.h"
+
+#include "common/types.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+
+namespace
+{
+    const U32 gIncrements = 1000;
+
+    std::atomic< U32 > gNextThreadID(0);
+
+    // benchmark threads are no engine threads, so we hand out consecutive IDs
+    void AssignThreadID()
+    {
+        ScheduleManager::SetCurrentThreadID(static_cast< ThreadID >(gNextThreadID.fetch_add(1) %
+                                                                    (PROGRAM_MAX_THREADS + 1)));
+    }
+
+    std::atomic< S64 > gShared(0);
+
+    // unpadded per thread counters, neighbouring threads write the same cache line
+    std::atomic< S64 > gAdjacent[PerThread< S64 >::SlotCount];
+
+    ShardedCounter gSharded;
+
+    void SharedAtomic(benchmark::State &state)
+    {
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gIncrements; ++i)
+            {
+                gShared.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gIncrements);
+    }
+
+    void AdjacentCounters(benchmark::State &state)
+    {
+        AssignThreadID();
+        std::atomic< S64 > &counter = gAdjacent[PerThread< S64 >::GetSlot(ScheduleManager::GetCurrentThreadID())];
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gIncrements; ++i)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gIncrements);
+    }
+
+    void Sharded(benchmark::State &state)
+    {
+        AssignThreadID();
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gIncrements; ++i)
+            {
+                gSharded.Increment();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gIncrements);
+    }
+
+    // threads without an engine ID fall back to the shared atomic shard
+    void ShardedUnassigned(benchmark::State &state)
+    {
+        ScheduleManager::SetCurrentThreadID(Thread::InvalidID);
+
+        while (state.KeepRunning())
+        {
+            for (U32 i = 0; i < gIncrements; ++i)
+            {
+                gSharded.Increment();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * gIncrements);
+    }
+
+    void ShardedRead(benchmark::State &state)
+    {
+        S64 sum = 0;
+
+        while (state.KeepRunning())
+        {
+            sum += gSharded.Get();
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(SharedAtomic)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(AdjacentCounters)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(Sharded)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(ShardedUnassigned)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(ShardedRead);
@@ -79,6 +79,17 @@ namespace Hash
 
     U32 Fnv1a(const char *str) noexcept;
 
+    /**
+     * Fnv1a hash of a range of characters, which may contain null characters.
+     *
+     * @param   data    The characters.
+     * @param   length  The amount of characters.
+     *
+     * @return  The hash.
+     */
+
+    U32 Fnv1a(const char *data, size_t length) noexcept;
+
     /**
      * Combine two hashes to a new hash.
      *
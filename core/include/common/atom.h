@@ -0,0 +1,243 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_ATOM_H__
+#define __ENGINE_ATOM_H__
+
+#include "algorithm/stringHash.h"
+
+#include "common/types.h"
+
+#include <string.h>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+class AtomStorage;
+
+/// @addtogroup docCommon
+/// @{
+
+/**
+ * An interned string, a small integer that is unique per distinct string for the lifetime of the
+ * process. Comparing and hashing atoms is as cheap as comparing integers, and the string can be
+ * retrieved again. The default constructed atom is invalid and maps to the empty string.
+ *
+ * Atoms of string literals are interned through their StringHash, which the compiler computes.
+ * Character arrays are interned up to their terminator, so a partially filled buffer gives the
+ * same atom as its string.
+ *
+ * @sa  AtomTable
+ */
+
+class Atom
+{
+    friend class AtomTable;
+
+public:
+
+    Atom() noexcept
+        : mID(0)
+    {
+    }
+
+    template< U32 N >
+    Atom(const char(&str)[ N ]);
+
+    /**
+     * Interns a string pointer. This is a template so that string literals still take the
+     * constructor above, and a single implicit conversion suffices for a `const char *`.
+     *
+     * @param   str The string.
+     */
+
+    template< typename tT, typename = typename std::enable_if<
+                  std::is_convertible< tT, const char * >::value &&
+                  !std::is_array< typename std::remove_reference< tT >::type >::value >::type >
+    Atom(tT &&str)
+        : mID(Intern(str))
+    {
+    }
+
+    Atom(const std::string &str);
+
+    U32 GetID() const noexcept
+    {
+        return mID;
+    }
+
+    bool IsValid() const noexcept
+    {
+        return mID != 0;
+    }
+
+    const std::string &GetString() const;
+
+    bool operator==(const Atom &other) const noexcept
+    {
+        return mID == other.mID;
+    }
+
+    bool operator!=(const Atom &other) const noexcept
+    {
+        return mID != other.mID;
+    }
+
+    bool operator<(const Atom &other) const noexcept
+    {
+        return mID < other.mID;
+    }
+
+private:
+
+    U32 mID;
+
+    explicit Atom(U32 id) noexcept
+        : mID(id)
+    {
+    }
+
+    static U32 Intern(const char *str);
+};
+
+/**
+ * The process wide table of atoms. Atoms are looked up by the FNV-1a hash of their string, and
+ * strings that share a hash are chained, so collisions only cost a string comparison. Lookups
+ * by hash alone cannot tell colliding strings apart; debug builds assert when they are asked to.
+ *
+ * Every module that links the core library has its own storage, but only the one of the host
+ * is used once a SystemManager exists, the same way as the TypeRegistry.
+ *
+ * @threadsafe
+ */
+
+class AtomTable
+{
+    friend class Atom;
+
+public:
+
+    static Atom Intern(const std::string &str);
+
+    /**
+     * Interns a character array up to its terminator. For a string literal the hash is computed
+     * at compile time.
+     *
+     * @param   str The character array.
+     *
+     * @return  The atom.
+     */
+
+    template< U32 N >
+    static Atom Intern(const char(&str)[ N ])
+    {
+        const size_t length = strlen(str);
+
+        if (length + 1 == N)
+        {
+            return Intern(str, length, StringHash(str).GetHash());
+        }
+
+        return Intern(str, length, Hash::Fnv1a(str));
+    }
+
+    /**
+     * Finds an interned string without interning it.
+     *
+     * @param   str The string.
+     *
+     * @return  The atom, or an invalid atom when the string was never interned.
+     */
+
+    static Atom Find(const std::string &str);
+
+    /**
+     * Finds the atom of an interned string by its hash only.
+     *
+     * @param   hash    The StringHash of the string.
+     *
+     * @return  The first atom interned with the hash, or an invalid atom.
+     */
+
+    static Atom Find(const StringHash &hash);
+
+    static const std::string &GetString(Atom atom);
+
+    static size_t GetSize();
+
+    /**
+     * Gets the amount of interned strings that share their hash with an earlier string.
+     *
+     * @return  The collision count.
+     */
+
+    static size_t GetCollisionCount();
+
+    /**
+     * Gets the storage of the host, through SystemManager::Get(). Before a system manager is set
+     * this is the storage of the calling module.
+     *
+     * @return  The storage.
+     */
+
+    static AtomStorage *GetStorage();
+
+    /**
+     * Gets the storage of the calling module. It is never destroyed, since static objects may
+     * still use their atoms during shutdown.
+     *
+     * @return  The storage.
+     */
+
+    static AtomStorage *GetModuleStorage();
+
+private:
+
+    static Atom Intern(const char *str, size_t length, U32 hash);
+};
+
+template< U32 N >
+Atom::Atom(const char(&str)[ N ])
+    : mID(AtomTable::Intern(str).mID)
+{
+}
+
+namespace std
+{
+    template <>
+    struct hash< Atom >
+    {
+        std::size_t operator()(const Atom &atom) const noexcept
+        {
+            return static_cast< size_t >(atom.GetID());
+        }
+    };
+}
+
+/// @}
+
+#endif
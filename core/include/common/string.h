@@ -32,6 +32,7 @@
 #include "external/stringAlgorithm.h"
 
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace String
@@ -265,6 +266,51 @@ namespace String
 
     std::vector< std::string > Split(const std::string &str, char sep, bool trim = false) noexcept;
 
+    /**
+     * Split a string into parts seperated by the given seperator, and append the parts to the
+     * given container. Lets callers that split short strings collect the parts in a container
+     * with inline storage, such as a SmallVector.
+     *
+     * @tparam  tContainer Type of the container, needs to provide emplace_back(std::string &&).
+     * @param           str    The string.
+     * @param           sep    The separator.
+     * @param [in,out]  output The container the parts are appended to.
+     * @param           trim   True to trim whitespace between the parts.
+     *
+     * @see Split
+     */
+
+    template< typename tContainer >
+    void Split(const std::string &str, char sep, tContainer &output, bool trim = false)
+    {
+        std::string::size_type pos, prevPos = 0;
+
+        //loop over all delimiter positions
+        while ((pos = str.find(sep, prevPos + 1)) != std::string::npos)
+        {
+            std::string token = str.substr(prevPos, pos - prevPos);
+
+            if (trim)
+            {
+                token = Trim(token);
+            }
+
+            output.emplace_back(std::move(token));
+
+            prevPos = pos + 1;
+        }
+
+        //wont catch the last bit
+        std::string token = str.substr(prevPos, str.size());
+
+        if (trim)
+        {
+            token = Trim(token);
+        }
+
+        output.emplace_back(std::move(token));
+    }
+
     /**
      * Replaces all occurrences of a certain string, in a larger string by an other given string.
      *
@@ -0,0 +1,214 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_TYPEID_H__
+#define __ENGINE_TYPEID_H__
+
+#include "common/types.h"
+#include "common/utilClasses.h"
+
+#include <functional>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/// @addtogroup docCommon
+/// @{
+
+/**
+ * A dense, process wide identifier of a type. The identifiers count up from one in the order the
+ * types are first asked for, so registries keyed by type can be plain arrays. The default
+ * constructed identifier is invalid.
+ *
+ * Every module caches the identifier of a type in a static, but the identifiers are handed out
+ * by the registry of the host, which plugins reach through the SystemManager. A type therefore
+ * has the same identifier in all plugins, as long as the plugin asks for it after its
+ * SystemManager is set.
+ *
+ * Example:
+ * @code
+ *      const TypeID id = TypeID::Get< Foo >();
+ *      id == TypeRegistry::Get()->Register(typeid(Foo)); // true
+ * @endcode
+ *
+ * @sa  TypeRegistry
+ */
+
+class TypeID
+{
+    friend class TypeRegistry;
+
+public:
+
+    TypeID() noexcept
+        : mID(0)
+    {
+    }
+
+    /**
+     * Gets the identifier of a type. Only the first call per module registers the type, later
+     * calls load the cached identifier.
+     *
+     * @tparam  tT  The type.
+     *
+     * @return  The identifier.
+     */
+
+    template< typename tT >
+    static TypeID Get();
+
+    U32 GetID() const noexcept
+    {
+        return mID;
+    }
+
+    bool IsValid() const noexcept
+    {
+        return mID != 0;
+    }
+
+    bool operator==(const TypeID &other) const noexcept
+    {
+        return mID == other.mID;
+    }
+
+    bool operator!=(const TypeID &other) const noexcept
+    {
+        return mID != other.mID;
+    }
+
+    bool operator<(const TypeID &other) const noexcept
+    {
+        return mID < other.mID;
+    }
+
+private:
+
+    U32 mID;
+
+    explicit TypeID(U32 id) noexcept
+        : mID(id)
+    {
+    }
+};
+
+/**
+ * A table of type identifiers. Types are matched by their std::type_index, which compares equal
+ * for the same type in different modules.
+ *
+ * Every module that links the core library has its own registry, but only the one of the host
+ * is used once a SystemManager exists. The SystemManager adopts the registry of the module that
+ * creates it, so identifiers the host cached before that stay valid.
+ *
+ * @threadsafe
+ */
+
+class TypeRegistry
+    : public NonCopyable< TypeRegistry >
+{
+public:
+
+    TypeRegistry();
+
+    /**
+     * Gets the identifier of a type, and assigns the next one when the type is new.
+     *
+     * @param   type    The type.
+     *
+     * @return  The identifier.
+     */
+
+    TypeID Register(const std::type_index &type);
+
+    /**
+     * Gets the name of the type, as given by std::type_info::name.
+     *
+     * @param   id  The identifier.
+     *
+     * @return  The name, or an empty string for an invalid identifier.
+     */
+
+    const char *GetName(TypeID id);
+
+    /**
+     * Gets the amount of registered types, which is also the highest identifier.
+     *
+     * @return  The amount of types.
+     */
+
+    size_t GetSize();
+
+    /**
+     * Gets the registry of the host, through SystemManager::Get(). Before a system manager is
+     * set this is the registry of the calling module.
+     *
+     * @return  The registry.
+     */
+
+    static TypeRegistry *Get();
+
+    /**
+     * Gets the registry of the calling module. It is never destroyed, since static objects may
+     * still ask for identifiers during shutdown.
+     *
+     * @return  The registry.
+     */
+
+    static TypeRegistry *GetModuleRegistry();
+
+private:
+
+    std::unordered_map< std::type_index, U32 > mIDs;
+
+    // the types by identifier minus one, identifier zero is the invalid one
+    std::vector< std::type_index > mTypes;
+    std::mutex mMutex;
+};
+
+template< typename tT >
+TypeID TypeID::Get()
+{
+    static const TypeID id = TypeRegistry::Get()->Register(typeid(tT));
+    return id;
+}
+
+namespace std
+{
+    template <>
+    struct hash< TypeID >
+    {
+        std::size_t operator()(const TypeID &id) const noexcept
+        {
+            return static_cast< size_t >(id.GetID());
+        }
+    };
+}
+
+/// @}
+
+#endif
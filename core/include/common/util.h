@@ -386,6 +386,16 @@ namespace Util
         return  static_cast< tT >(Mathf::Pow(2, static_cast< F64 >(BitExponent(in))));
     }
 
+    /**
+     * Writes every page of the given memory with its own contents, so the operating system
+     * backs the memory now instead of on first use.
+     *
+     * @param [in,out]  memory  The memory.
+     * @param   size            The size in bytes.
+     */
+
+    void FaultIn(void *memory, size_t size) noexcept;
+
 
     /// @name Traits
     /// @{
@@ -60,6 +60,31 @@
 #   define PROGRAM_MAX_THREADS 8
 #endif
 
+// the assumed cache line size, data written by different threads is kept this far apart
+#ifndef PROGRAM_CACHE_LINE_SIZE
+#   define PROGRAM_CACHE_LINE_SIZE 64
+#endif
+
+// the amount of frames multi frame allocations stay valid
+#ifndef PROGRAM_FRAME_BUFFERS
+#   define PROGRAM_FRAME_BUFFERS 2
+#endif
+
+// routes the global operator new and delete through the slab allocator
+#ifndef PROGRAM_OVERRIDE_NEW
+#   define PROGRAM_OVERRIDE_NEW 0
+#endif
+
+// records per pool, allocator and namespace memory statistics, published by the profiler
+#ifndef PROGRAM_MEMORY_TRACKING
+#   define PROGRAM_MEMORY_TRACKING 0
+#endif
+
+// samples heap and pool allocations with their stack traces, see HeapProfiler
+#ifndef PROGRAM_HEAP_PROFILING
+#   define PROGRAM_HEAP_PROFILING 0
+#endif
+
 #ifndef PROGRAM_PLUGIN_DIRECTORY
 #   define PROGRAM_PLUGIN_DIRECTORY "plugins"
 #endif
@@ -28,11 +28,26 @@
 #ifndef __ENGINE_DENSEBITSET_H__
 #define __ENGINE_DENSEBITSET_H__
 
+#include "preproc/compiler.h"
+
 #include "common/types.h"
 
 #include <cstddef>
 #include <vector>
 
+#ifdef COMP_IS_MSVC
+#   include <intrin.h>
+#endif
+
+/**
+ * A bitset with a size chosen at runtime. Besides single bits, whole sets can be combined and
+ * counted a word at a time, set bits can be iterated without testing every bit, and with a rank
+ * index the amount of set bits before a position and the position of the n-th set bit are found
+ * in constant and logarithmic time.
+ *
+ * The bits past the size are always zero, so the word wise operations never see them.
+ */
+
 class DenseBitset
 {
 public:
@@ -63,13 +78,181 @@ public:
 
     void Resize(size_t size) noexcept;
 
+    size_t GetSize() const noexcept
+    {
+        return mSize;
+    }
+
     bool operator[](size_t bit) const noexcept;
 
     BitReference operator[](size_t bit) noexcept;
 
+    /// @name Bulk operations
+    /// @{
+
+    /**
+     * Combines the bits with those of another set of the same size.
+     *
+     * @param   other   The other set.
+     *
+     * @return  This set.
+     */
+
+    DenseBitset &operator&=(const DenseBitset &other) noexcept;
+
+    DenseBitset &operator|=(const DenseBitset &other) noexcept;
+
+    DenseBitset &operator^=(const DenseBitset &other) noexcept;
+
+    /**
+     * Clears the bits that are set in the other set.
+     *
+     * @param   other   The other set, of the same size.
+     *
+     * @return  This set.
+     */
+
+    DenseBitset &AndNot(const DenseBitset &other) noexcept;
+
+    /**
+     * Sets the bits in the range [begin, end).
+     *
+     * @param   begin   The first bit.
+     * @param   end     One past the last bit.
+     */
+
+    void SetRange(size_t begin, size_t end) noexcept;
+
+    /**
+     * Clears the bits in the range [begin, end).
+     *
+     * @param   begin   The first bit.
+     * @param   end     One past the last bit.
+     */
+
+    void ClearRange(size_t begin, size_t end) noexcept;
+
+    /// @}
+
+    /// @name Queries
+    /// @{
+
+    /**
+     * Counts the set bits.
+     *
+     * @return  The amount of set bits.
+     */
+
+    size_t Count() const noexcept;
+
+    bool Any() const noexcept;
+
+    /**
+     * Finds the first set bit.
+     *
+     * @return  The bit, or GetSize() when no bit is set.
+     */
+
+    size_t FindFirst() const noexcept;
+
+    /**
+     * Finds the first set bit after the given one.
+     *
+     * @param   bit The bit to start after.
+     *
+     * @return  The bit, or GetSize() when no later bit is set.
+     */
+
+    size_t FindNext(size_t bit) const noexcept;
+
+    /**
+     * Calls the function with the position of every set bit, in increasing order.
+     *
+     * @param   function    The function, called with a size_t.
+     */
+
+    template< typename tFunction >
+    void ForEachSet(const tFunction &function) const
+    {
+        for (size_t i = 0, end = mBits.size(); i < end; ++i)
+        {
+            for (U64 word = mBits[i]; word != 0; word &= word - 1)
+            {
+                function((i << 6) + CountTrailingZeros(word));
+            }
+        }
+    }
+
+    /// @}
+
+    /// @name Rank and select
+    /// @{
+
+    /**
+     * Builds the index Rank and Select use, it should be rebuilt after the bits changed. The index
+     * holds one count per 512 bits.
+     */
+
+    void BuildRankIndex();
+
+    /**
+     * Counts the set bits before the given one, the rank index should be up to date.
+     *
+     * @param   bit The bit, may be GetSize().
+     *
+     * @return  The amount of set bits in [0, bit).
+     */
+
+    size_t Rank(size_t bit) const noexcept;
+
+    /**
+     * Finds the n-th set bit, counting from zero. The rank index should be up to date.
+     *
+     * @param   n   The rank of the bit.
+     *
+     * @return  The bit, or GetSize() when less bits are set.
+     */
+
+    size_t Select(size_t n) const noexcept;
+
+    /// @}
+
+    static size_t CountTrailingZeros(U64 word) noexcept
+    {
+#ifdef COMP_IS_MSVC
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast< size_t >(index);
+#else
+        return static_cast< size_t >(__builtin_ctzll(word));
+#endif
+    }
+
+    static size_t Popcount(U64 word) noexcept
+    {
+#ifdef COMP_IS_MSVC
+        return static_cast< size_t >(__popcnt64(word));
+#elif defined(__POPCNT__)
+        return static_cast< size_t >(__builtin_popcountll(word));
+#else
+        // without the instruction the builtin calls a table based routine, this is faster
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast< size_t >((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
 private:
 
     std::vector< U64 > mBits;
+
+    /// The set bits before every block of 512 bits, and the total in the last entry.
+    std::vector< U64 > mRanks;
+
+    size_t mSize;
+
+    void ClearTail() noexcept;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -28,10 +28,22 @@
 #ifndef __ENGINE_PTRHASHMAP_H__
 #define __ENGINE_PTRHASHMAP_H__
 
-#include "container/denseBitset.h"
+#include "preproc/compiler.h"
+#include "preproc/arch.h"
+
+#include "common/types.h"
 
 #include "math/scalar/mathf.h"
 
+#include <algorithm>
+#include <assert.h>
+#include <stdint.h>
+#include <vector>
+
+#if ARCH_IS_X86
+#   include <xmmintrin.h>
+#endif
+
 template< typename tPtr, typename tValue >
 class FastPtrHashMap
 {
@@ -74,7 +86,7 @@ public:
 
     void Clear() noexcept
     {
-        mFilled.Reset();
+        std::fill(mTable.begin(), mTable.end(), Slot{ nullptr, 0 });
         mNodes.clear();
         mItemCount = 0;
     }
@@ -85,50 +97,53 @@ public:
 
         if (nextPow2 > mSize)
         {
-            std::vector< Node > temp = std::move(mNodes);
-
-            mNodes = std::vector< Node >();
+            Rehash(nextPow2);
             mNodes.reserve(nextPow2);
+        }
 
-            std::fill(mTable.begin(), mTable.end(), 0x00);
-            mTable.resize(nextPow2);
+        return mSize;
+    }
 
-            mFilled.Reset();
-            mFilled.Resize(nextPow2);
-            mSize = nextPow2;
+    /**
+     * Rebuilds the table with the least size that keeps the load below the growth threshold, and
+     * gives the unused node memory back.
+     */
 
-            // temporarily so we can insert the items
-            mItemCount = 0;
+    void ShrinkToFit() noexcept
+    {
+        size_t size = 1;
 
-            for (Node &node : temp)
-            {
-                Insert(node.ptr, node.element);
-            }
+        while (mItemCount > size * 0.7)
+        {
+            size <<= 1;
         }
 
-        return mSize;
+        if (size < mSize)
+        {
+            Rehash(size);
+        }
+
+        mNodes.shrink_to_fit();
     }
 
     void Insert(tPtr *ptr, tValue element) noexcept
     {
-        size_t hash = FirstHash(ptr);
-        const size_t step = StepHash(ptr);
+        // a null key marks an empty slot
+        assert(ptr != nullptr);
 
-        while (mFilled[hash])
-        {
-            const Node &node = mNodes[mTable[ hash ]];
+        size_t slot = FirstHash(ptr);
 
-            if (node.ptr == ptr)
+        while (mTable[slot].ptr)
+        {
+            if (mTable[slot].ptr == ptr)
             {
                 return;
             }
 
-            hash += step;
-            hash &= (mSize - 1);
+            slot = (slot + 1) & (mSize - 1);
         }
 
-        mFilled[hash] = true;
-        mTable[hash] = mItemCount;
+        mTable[slot] = Slot{ ptr, mItemCount };
 
         Node node = {element, ptr };
         mNodes.emplace_back(node);
@@ -139,82 +154,204 @@ public:
         }
     }
 
-    bool Find(tPtr *ptr, tValue *&value) noexcept
+    /**
+     * Removes the pointer. The last node is moved into the place of the removed one, so the
+     * order of Data() changes.
+     *
+     * @param   ptr The pointer.
+     *
+     * @return  true if the pointer was stored.
+     */
+
+    bool Erase(tPtr *ptr) noexcept
     {
-        size_t hash = FirstHash(ptr);
-        const size_t step = StepHash(ptr);
+        const size_t slot = FindSlot(ptr);
 
-        while (mFilled[hash])
+        if (slot == mSize)
         {
-            Node &node = mNodes[mTable[ hash ]];
+            return false;
+        }
 
-            if (node.ptr == ptr)
-            {
-                value = &node.element;
-                return true;
-            }
+        const size_t index = mTable[slot].index;
+        const size_t last = mItemCount - 1;
 
-            hash += step;
-            hash &= (mSize - 1);
+        if (index != last)
+        {
+            mNodes[index] = mNodes[last];
+            mTable[FindSlot(mNodes[index].ptr)].index = index;
         }
 
-        value = nullptr;
-        return false;
+        mNodes.pop_back();
+        --mItemCount;
+
+        RemoveSlot(slot);
+
+        return true;
     }
 
-    bool Has(tPtr *ptr) const noexcept
+    bool Find(tPtr *ptr, tValue *&value) noexcept
+    {
+        const size_t slot = FindSlot(ptr);
+
+        if (slot == mSize)
+        {
+            value = nullptr;
+            return false;
+        }
+
+        value = &mNodes[mTable[slot].index].element;
+        return true;
+    }
+
+    /**
+     * Looks up many pointers at once, prefetching the slots of the pointers a few lookups ahead
+     * so their cache misses overlap.
+     *
+     * @param           ptrs    The pointers.
+     * @param           count   The amount of pointers.
+     * @param [out]     values  Receives the value of each pointer, or nullptr when not stored.
+     *
+     * @return  The amount of pointers found.
+     */
+
+    size_t FindMany(tPtr *const *ptrs, size_t count, tValue **values) noexcept
     {
-        size_t hash = FirstHash(ptr);
-        const size_t step = StepHash(ptr);
+        const size_t distance = 8;
 
-        while (mFilled[hash])
+        for (size_t i = 0; i < count && i < distance; ++i)
         {
-            const Node &node = mNodes[mTable[ hash ]];
+            Prefetch(&mTable[FirstHash(ptrs[i])]);
+        }
+
+        size_t found = 0;
 
-            if (node.ptr == ptr)
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i + distance < count)
             {
-                return true;
+                Prefetch(&mTable[FirstHash(ptrs[i + distance])]);
             }
 
-            hash += step;
-            hash &= (mSize - 1);
+            const size_t slot = FindSlot(ptrs[i]);
+
+            if (slot == mSize)
+            {
+                values[i] = nullptr;
+            }
+            else
+            {
+                values[i] = &mNodes[mTable[slot].index].element;
+                ++found;
+            }
         }
 
-        return false;
+        return found;
+    }
+
+    bool Has(tPtr *ptr) const noexcept
+    {
+        return FindSlot(ptr) != mSize;
+    }
+
+    size_t Size() const noexcept
+    {
+        return mItemCount;
     }
 
+    size_t GetCapacity() const noexcept
+    {
+        return mSize;
+    }
 
 private:
 
-    std::vector< size_t > mTable;
+    // the key sits next to the index of its node, so a probe only touches this array
+    struct Slot
+    {
+        tPtr *ptr;
+        size_t index;
+    };
+
+    std::vector< Slot > mTable;
     std::vector< Node > mNodes;
-    DenseBitset mFilled;
     size_t mItemCount;
     size_t mSize;
 
     size_t FirstHash(tPtr *ptr) const noexcept
     {
-        return (reinterpret_cast< size_t >(ptr) * 2654435761) & (mSize - 1);
+        // pointers have their low bits in common, so mix all bits into the ones we use
+        U64 x = static_cast< U64 >(reinterpret_cast< uintptr_t >(ptr));
+        x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdull;
+        x = x ^ (x >> 33);
+        return static_cast< size_t >(x) & (mSize - 1);
+    }
+
+    size_t FindSlot(tPtr *ptr) const noexcept
+    {
+        size_t slot = FirstHash(ptr);
+
+        while (mTable[slot].ptr)
+        {
+            if (mTable[slot].ptr == ptr)
+            {
+                return slot;
+            }
+
+            slot = (slot + 1) & (mSize - 1);
+        }
+
+        return mSize;
     }
 
-    size_t SecondHash(tPtr *ptr) const noexcept
+    // shifts the following slots of the probe sequence back, so no tombstones are needed
+    void RemoveSlot(size_t slot) noexcept
     {
-        return (reinterpret_cast< size_t >(ptr) * 33) & (mSize - 1);
+        const size_t mask = mSize - 1;
+
+        for (size_t next = (slot + 1) & mask; mTable[next].ptr; next = (next + 1) & mask)
+        {
+            const size_t home = FirstHash(mTable[next].ptr);
+
+            // the entry may fill the hole when its home does not lie after the hole
+            if (((next - home) & mask) >= ((next - slot) & mask))
+            {
+                mTable[slot] = mTable[next];
+                slot = next;
+            }
+        }
+
+        mTable[slot] = Slot{ nullptr, 0 };
     }
 
-    size_t ThirdHash(tPtr *ptr) const noexcept
+    // only the slots are rebuilt, the nodes keep their place
+    void Rehash(size_t size) noexcept
     {
-        ptrdiff_t x = reinterpret_cast<ptrdiff_t>(ptr);
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x);
-        return x & (mSize - 1);
+        mTable.assign(size, Slot{ nullptr, 0 });
+        mSize = size;
+
+        for (size_t i = 0; i < mItemCount; ++i)
+        {
+            size_t slot = FirstHash(mNodes[i].ptr);
+
+            while (mTable[slot].ptr)
+            {
+                slot = (slot + 1) & (mSize - 1);
+            }
+
+            mTable[slot] = Slot{ mNodes[i].ptr, i };
+        }
     }
 
-    size_t StepHash(tPtr *ptr)const noexcept
+    static void Prefetch(const void *address) noexcept
     {
-        return (SecondHash(ptr) * ThirdHash(ptr)) | 0x01;
+#if ARCH_IS_X86
+        _mm_prefetch(static_cast< const char * >(address), _MM_HINT_T0);
+#elif !defined(COMP_IS_MSVC)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,840 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_FLATHASHMAP_H__
+#define __ENGINE_FLATHASHMAP_H__
+
+#include "memory/allocators/malloc.h"
+
+#include "preproc/compiler.h"
+#include "preproc/hw.h"
+
+#include "common/types.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if HW_HAS_SIMD_X86_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef COMP_IS_MSVC
+#   include <intrin.h>
+#endif
+
+/**
+ * An open addressing hash map that keeps its values in one flat array, next to an array of one
+ * byte control words. A control word holds 7 bits of the hash of a full slot, or marks it as
+ * empty or deleted, so a lookup compares 16 control words at once and only touches the values
+ * whose hash bits match.
+ *
+ * The interface follows std::unordered_map, but iterators, pointers and references are
+ * invalidated by every insertion that grows the map. Lookups with another type than the key,
+ * for example a const char * in a map with std::string keys, are allowed when both the hash and
+ * the key equality define is_transparent.
+ *
+ * @tparam  tKey    The key type.
+ * @tparam  tValue  The mapped type.
+ * @tparam  tHash   The hash function.
+ * @tparam  tEqual  The key equality.
+ */
+
+template< typename tKey, typename tValue, typename tHash = std::hash< tKey >, typename tEqual = std::equal_to< tKey > >
+class FlatHashMap
+{
+    typedef S8 Control;
+
+    static const Control Empty = -128;
+    static const Control Deleted = -2;
+    static const size_t GroupWidth = 16;
+
+public:
+
+    typedef tKey key_type;
+    typedef tValue mapped_type;
+    typedef std::pair< const tKey, tValue > value_type;
+    typedef size_t size_type;
+    typedef tHash hasher;
+    typedef tEqual key_equal;
+
+    template< typename tMap, typename tPair >
+    class Iterator
+    {
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef tPair value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef tPair *pointer;
+        typedef tPair &reference;
+
+        Iterator() noexcept
+            : mMap(nullptr),
+              mIndex(0)
+        {
+        }
+
+        Iterator(tMap *map, size_t index) noexcept
+            : mMap(map),
+              mIndex(index)
+        {
+        }
+
+        // allows converting an iterator to a const iterator
+        template< typename tOtherMap, typename tOtherPair >
+        Iterator(const Iterator< tOtherMap, tOtherPair > &other) noexcept
+            : mMap(other.mMap),
+              mIndex(other.mIndex)
+        {
+        }
+
+        tPair &operator*() const noexcept
+        {
+            return mMap->mSlots[mIndex];
+        }
+
+        tPair *operator->() const noexcept
+        {
+            return &mMap->mSlots[mIndex];
+        }
+
+        Iterator &operator++() noexcept
+        {
+            mIndex = mMap->SkipEmpty(mIndex + 1);
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const Iterator &other) const noexcept
+        {
+            return mIndex == other.mIndex;
+        }
+
+        bool operator!=(const Iterator &other) const noexcept
+        {
+            return mIndex != other.mIndex;
+        }
+
+    private:
+
+        template< typename, typename >
+        friend class Iterator;
+
+        friend class FlatHashMap;
+
+        tMap *mMap;
+        size_t mIndex;
+    };
+
+    typedef Iterator< FlatHashMap, value_type > iterator;
+    typedef Iterator< const FlatHashMap, const value_type > const_iterator;
+
+    FlatHashMap() noexcept
+        : mControl(nullptr),
+          mSlots(nullptr),
+          mSize(0),
+          mCapacity(0),
+          mGrowthLeft(0)
+    {
+    }
+
+    explicit FlatHashMap(size_t count)
+        : FlatHashMap()
+    {
+        reserve(count);
+    }
+
+    FlatHashMap(std::initializer_list< value_type > values)
+        : FlatHashMap()
+    {
+        reserve(values.size());
+
+        for (const value_type &value : values)
+        {
+            insert(value);
+        }
+    }
+
+    FlatHashMap(const FlatHashMap &other)
+        : FlatHashMap()
+    {
+        reserve(other.mSize);
+
+        for (const value_type &value : other)
+        {
+            insert(value);
+        }
+    }
+
+    FlatHashMap(FlatHashMap &&other) noexcept
+        : FlatHashMap()
+    {
+        swap(other);
+    }
+
+    ~FlatHashMap()
+    {
+        DestroySlots();
+        ZefAlignedFree(mControl);
+    }
+
+    FlatHashMap &operator=(const FlatHashMap &other)
+    {
+        if (this != &other)
+        {
+            FlatHashMap copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashMap &operator=(FlatHashMap &&other) noexcept
+    {
+        if (this != &other)
+        {
+            FlatHashMap moved(std::move(other));
+            swap(moved);
+        }
+
+        return *this;
+    }
+
+    /// @name Iterators
+    /// @{
+
+    iterator begin() noexcept
+    {
+        return iterator(this, SkipEmpty(0));
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, mCapacity);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, SkipEmpty(0));
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, mCapacity);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /// @}
+
+    /// @name Capacity
+    /// @{
+
+    bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    /**
+     * Gets the amount of slots, the map grows when 7/8 of them are in use.
+     */
+
+    size_t capacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    F32 load_factor() const noexcept
+    {
+        return mCapacity ? static_cast< F32 >(mSize) / static_cast< F32 >(mCapacity) : 0.0f;
+    }
+
+    void reserve(size_t count)
+    {
+        size_t capacity = GroupWidth;
+
+        while (GetMaxLoad(capacity) < count)
+        {
+            capacity *= 2;
+        }
+
+        if (capacity > mCapacity)
+        {
+            Resize(capacity);
+        }
+    }
+
+    /**
+     * Rebuilds the map with the least capacity that holds the current elements, which also
+     * drops the markers left by erased elements.
+     */
+
+    void shrink_to_fit()
+    {
+        if (mSize == 0)
+        {
+            FlatHashMap().swap(*this);
+            return;
+        }
+
+        size_t capacity = GroupWidth;
+
+        while (GetMaxLoad(capacity) < mSize)
+        {
+            capacity *= 2;
+        }
+
+        Resize(capacity);
+    }
+
+    /// @}
+
+    /// @name Modifiers
+    /// @{
+
+    void clear() noexcept
+    {
+        DestroySlots();
+
+        if (mCapacity)
+        {
+            std::memset(mControl, Empty, mCapacity);
+        }
+
+        mSize = 0;
+        mGrowthLeft = GetMaxLoad(mCapacity);
+    }
+
+    std::pair< iterator, bool > insert(const value_type &value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair< iterator, bool > insert(value_type &&value)
+    {
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    template< typename tK, typename... tArgs >
+    std::pair< iterator, bool > emplace(tK &&key, tArgs &&... args)
+    {
+        return try_emplace(tKey(std::forward< tK >(key)), std::forward< tArgs >(args)...);
+    }
+
+    /**
+     * Constructs the value from the arguments, unless the key is present already.
+     *
+     * @return  The element with the key, and whether it was inserted.
+     */
+
+    template< typename... tArgs >
+    std::pair< iterator, bool > try_emplace(const tKey &key, tArgs &&... args)
+    {
+        return TryEmplace(key, std::forward< tArgs >(args)...);
+    }
+
+    template< typename... tArgs >
+    std::pair< iterator, bool > try_emplace(tKey &&key, tArgs &&... args)
+    {
+        return TryEmplace(std::move(key), std::forward< tArgs >(args)...);
+    }
+
+    template< typename tV >
+    std::pair< iterator, bool > insert_or_assign(const tKey &key, tV &&value)
+    {
+        auto result = try_emplace(key, std::forward< tV >(value));
+
+        if (!result.second)
+        {
+            result.first->second = std::forward< tV >(value);
+        }
+
+        return result;
+    }
+
+    iterator erase(const_iterator position)
+    {
+        EraseIndex(position.mIndex);
+        return iterator(this, SkipEmpty(position.mIndex + 1));
+    }
+
+    iterator erase(iterator position)
+    {
+        return erase(const_iterator(position));
+    }
+
+    size_t erase(const tKey &key)
+    {
+        return EraseKey(key);
+    }
+
+    template< typename tLookup, typename tH = tHash, typename = typename tH::is_transparent >
+    size_t erase(const tLookup &key)
+    {
+        return EraseKey(key);
+    }
+
+    void swap(FlatHashMap &other) noexcept
+    {
+        std::swap(mControl, other.mControl);
+        std::swap(mSlots, other.mSlots);
+        std::swap(mSize, other.mSize);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mGrowthLeft, other.mGrowthLeft);
+        std::swap(mHash, other.mHash);
+        std::swap(mEqual, other.mEqual);
+    }
+
+    /// @}
+
+    /// @name Lookup
+    /// @{
+
+    tValue &operator[](const tKey &key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    tValue &operator[](tKey &&key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    tValue &at(const tKey &key)
+    {
+        const iterator it = find(key);
+
+        if (it == end())
+        {
+            throw std::out_of_range("FlatHashMap::at(): key not found");
+        }
+
+        return it->second;
+    }
+
+    const tValue &at(const tKey &key) const
+    {
+        const const_iterator it = find(key);
+
+        if (it == end())
+        {
+            throw std::out_of_range("FlatHashMap::at(): key not found");
+        }
+
+        return it->second;
+    }
+
+    iterator find(const tKey &key)
+    {
+        return iterator(this, FindIndex(key, Hash(key)));
+    }
+
+    const_iterator find(const tKey &key) const
+    {
+        return const_iterator(this, FindIndex(key, Hash(key)));
+    }
+
+    template< typename tLookup, typename tH = tHash, typename = typename tH::is_transparent >
+    iterator find(const tLookup &key)
+    {
+        return iterator(this, FindIndex(key, Hash(key)));
+    }
+
+    template< typename tLookup, typename tH = tHash, typename = typename tH::is_transparent >
+    const_iterator find(const tLookup &key) const
+    {
+        return const_iterator(this, FindIndex(key, Hash(key)));
+    }
+
+    size_t count(const tKey &key) const
+    {
+        return FindIndex(key, Hash(key)) != mCapacity ? 1 : 0;
+    }
+
+    template< typename tLookup, typename tH = tHash, typename = typename tH::is_transparent >
+    size_t count(const tLookup &key) const
+    {
+        return FindIndex(key, Hash(key)) != mCapacity ? 1 : 0;
+    }
+
+    /// @}
+
+private:
+
+    template< typename, typename >
+    friend class Iterator;
+
+    // a group of control words, a bit is set in the returned masks for every matching word
+    class Group
+    {
+    public:
+
+#if HW_HAS_SIMD_X86_SSE2
+
+        explicit Group(const Control *control) noexcept
+            : mControl(_mm_load_si128(reinterpret_cast< const __m128i * >(control)))
+        {
+        }
+
+        U32 Match(Control control) const noexcept
+        {
+            return static_cast< U32 >(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(control), mControl)));
+        }
+
+        U32 MatchEmptyOrDeleted() const noexcept
+        {
+            // only the empty and deleted words have their sign bit set
+            return static_cast< U32 >(_mm_movemask_epi8(mControl));
+        }
+
+    private:
+
+        __m128i mControl;
+
+#else
+
+        explicit Group(const Control *control) noexcept
+            : mControl(control)
+        {
+        }
+
+        U32 Match(Control control) const noexcept
+        {
+            U32 mask = 0;
+
+            for (size_t i = 0; i < GroupWidth; ++i)
+            {
+                mask |= static_cast< U32 >(mControl[i] == control) << i;
+            }
+
+            return mask;
+        }
+
+        U32 MatchEmptyOrDeleted() const noexcept
+        {
+            U32 mask = 0;
+
+            for (size_t i = 0; i < GroupWidth; ++i)
+            {
+                mask |= static_cast< U32 >(mControl[i] < 0) << i;
+            }
+
+            return mask;
+        }
+
+    private:
+
+        const Control *mControl;
+
+#endif
+
+    public:
+
+        U32 MatchEmpty() const noexcept
+        {
+            return Match(Empty);
+        }
+    };
+
+    Control *mControl;
+    value_type *mSlots;
+
+    size_t mSize;
+    size_t mCapacity;
+
+    /// The amount of empty slots we may still fill before we have to grow
+    size_t mGrowthLeft;
+
+    tHash mHash;
+    tEqual mEqual;
+
+    static size_t GetMaxLoad(size_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    static U32 CountTrailingZeros(U32 mask) noexcept
+    {
+#ifdef COMP_IS_MSVC
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast< U32 >(index);
+#else
+        return static_cast< U32 >(__builtin_ctz(mask));
+#endif
+    }
+
+    template< typename tLookup >
+    size_t Hash(const tLookup &key) const
+    {
+        // the low bits go to the control word, so spread identity hashes over all bits
+        const U64 hash = static_cast< U64 >(mHash(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast< size_t >(hash ^ (hash >> 32));
+    }
+
+    static Control GetControl(size_t hash) noexcept
+    {
+        return static_cast< Control >(hash & 0x7F);
+    }
+
+    size_t GetGroupMask() const noexcept
+    {
+        return mCapacity / GroupWidth - 1;
+    }
+
+    // the groups are probed triangularly, which visits every group once for a power of two count
+    template< typename tLookup >
+    size_t FindIndex(const tLookup &key, size_t hash) const
+    {
+        if (mCapacity == 0)
+        {
+            return mCapacity;
+        }
+
+        const Control control = GetControl(hash);
+        const size_t groupMask = GetGroupMask();
+
+        size_t group = (hash >> 7) & groupMask;
+
+        for (size_t step = 1; ; group = (group + step++) & groupMask)
+        {
+            const size_t offset = group * GroupWidth;
+            const Group current(mControl + offset);
+
+            for (U32 mask = current.Match(control); mask != 0; mask &= mask - 1)
+            {
+                const size_t index = offset + CountTrailingZeros(mask);
+
+                if (mEqual(mSlots[index].first, key))
+                {
+                    return index;
+                }
+            }
+
+            if (current.MatchEmpty())
+            {
+                return mCapacity;
+            }
+        }
+    }
+
+    template< typename tK, typename... tArgs >
+    std::pair< iterator, bool > TryEmplace(tK &&key, tArgs &&... args)
+    {
+        const size_t hash = Hash(key);
+        const size_t found = FindIndex(key, hash);
+
+        if (found != mCapacity)
+        {
+            return std::make_pair(iterator(this, found), false);
+        }
+
+        if (mGrowthLeft == 0)
+        {
+            Grow();
+        }
+
+        const size_t index = FindInsertIndex(hash);
+
+        new(mSlots + index) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward< tK >(key)),
+                                       std::forward_as_tuple(std::forward< tArgs >(args)...));
+
+        // reusing a deleted slot does not bring us closer to a full probe sequence
+        if (mControl[index] == Empty)
+        {
+            --mGrowthLeft;
+        }
+
+        mControl[index] = GetControl(hash);
+        ++mSize;
+
+        return std::make_pair(iterator(this, index), true);
+    }
+
+    size_t FindInsertIndex(size_t hash) const noexcept
+    {
+        const size_t groupMask = GetGroupMask();
+
+        size_t group = (hash >> 7) & groupMask;
+
+        for (size_t step = 1; ; group = (group + step++) & groupMask)
+        {
+            const U32 mask = Group(mControl + group * GroupWidth).MatchEmptyOrDeleted();
+
+            if (mask)
+            {
+                return group * GroupWidth + CountTrailingZeros(mask);
+            }
+        }
+    }
+
+    size_t SkipEmpty(size_t index) const noexcept
+    {
+        while (index < mCapacity && mControl[index] < 0)
+        {
+            ++index;
+        }
+
+        return index;
+    }
+
+    template< typename tLookup >
+    size_t EraseKey(const tLookup &key)
+    {
+        const size_t index = FindIndex(key, Hash(key));
+
+        if (index == mCapacity)
+        {
+            return 0;
+        }
+
+        EraseIndex(index);
+
+        return 1;
+    }
+
+    void EraseIndex(size_t index)
+    {
+        mSlots[index].~value_type();
+        --mSize;
+
+        // when the group has an empty slot no probe sequence ever went past it, so the slot can
+        // be empty again, otherwise lookups have to keep probing past it
+        if (Group(mControl + (index & ~(GroupWidth - 1))).MatchEmpty())
+        {
+            mControl[index] = Empty;
+            ++mGrowthLeft;
+        }
+        else
+        {
+            mControl[index] = Deleted;
+        }
+    }
+
+    void Grow()
+    {
+        // when mostly deleted slots fill the map, rebuilding at the same size frees them
+        if (mCapacity && mSize <= GetMaxLoad(mCapacity) / 2)
+        {
+            Resize(mCapacity);
+        }
+        else
+        {
+            Resize(mCapacity ? mCapacity * 2 : GroupWidth);
+        }
+    }
+
+    void Resize(size_t capacity)
+    {
+        const size_t alignment = std::max< size_t >(alignof(value_type), GroupWidth);
+        const size_t slotOffset = (capacity + alignment - 1) & ~(alignment - 1);
+
+        Control *const control = static_cast< Control * >(ZefAlignedMalloc(slotOffset + capacity * sizeof(value_type),
+                                                                           alignment));
+
+        if (!control)
+        {
+            throw std::bad_alloc();
+        }
+
+        std::memset(control, Empty, capacity);
+
+        Control *const oldControl = mControl;
+        value_type *const oldSlots = mSlots;
+        const size_t oldCapacity = mCapacity;
+
+        mControl = control;
+        mSlots = reinterpret_cast< value_type * >(reinterpret_cast< char * >(control) + slotOffset);
+        mCapacity = capacity;
+        mGrowthLeft = GetMaxLoad(capacity) - mSize;
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldControl[i] >= 0)
+            {
+                const size_t hash = Hash(oldSlots[i].first);
+                const size_t index = FindInsertIndex(hash);
+
+                new(mSlots + index) value_type(std::move(oldSlots[i]));
+                mControl[index] = GetControl(hash);
+
+                oldSlots[i].~value_type();
+            }
+        }
+
+        ZefAlignedFree(oldControl);
+    }
+
+    void DestroySlots() noexcept
+    {
+        for (size_t i = 0; i < mCapacity; ++i)
+        {
+            if (mControl[i] >= 0)
+            {
+                mSlots[i].~value_type();
+            }
+        }
+    }
+};
+
+template< typename tKey, typename tValue, typename tHash, typename tEqual >
+const typename FlatHashMap< tKey, tValue, tHash, tEqual >::Control FlatHashMap< tKey, tValue, tHash, tEqual >::Empty;
+
+template< typename tKey, typename tValue, typename tHash, typename tEqual >
+const typename FlatHashMap< tKey, tValue, tHash, tEqual >::Control FlatHashMap< tKey, tValue, tHash, tEqual >::Deleted;
+
+template< typename tKey, typename tValue, typename tHash, typename tEqual >
+const size_t FlatHashMap< tKey, tValue, tHash, tEqual >::GroupWidth;
+
+#endif
@@ -0,0 +1,575 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_INLINESTRING_H__
+#define __ENGINE_INLINESTRING_H__
+
+#include "algorithm/hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * A string that stores up to N characters inside the object itself, and only allocates when it
+ * grows beyond that. Offers the common part of the std::string interface, and is always null
+ * terminated.
+ *
+ * @tparam  N   The inline capacity, excluding the null terminator.
+ */
+
+template< size_t N >
+class InlineString
+{
+public:
+
+    typedef char value_type;
+    typedef size_t size_type;
+    typedef char *iterator;
+    typedef const char *const_iterator;
+
+    static const size_t npos = static_cast< size_t >(-1);
+
+    InlineString() noexcept
+        : mData(mInline),
+          mSize(0),
+          mCapacity(N)
+    {
+        mInline[0] = '\0';
+    }
+
+    InlineString(const char *str)
+        : InlineString()
+    {
+        assign(str, std::strlen(str));
+    }
+
+    InlineString(const char *str, size_t length)
+        : InlineString()
+    {
+        assign(str, length);
+    }
+
+    InlineString(const std::string &str)
+        : InlineString()
+    {
+        assign(str.data(), str.size());
+    }
+
+    InlineString(size_t count, char c)
+        : InlineString()
+    {
+        resize(count, c);
+    }
+
+    InlineString(const InlineString &other)
+        : InlineString()
+    {
+        assign(other.mData, other.mSize);
+    }
+
+    InlineString(InlineString &&other) noexcept
+        : InlineString()
+    {
+        MoveFrom(other);
+    }
+
+    ~InlineString()
+    {
+        Deallocate();
+    }
+
+    InlineString &operator=(const InlineString &other)
+    {
+        if (this != &other)
+        {
+            assign(other.mData, other.mSize);
+        }
+
+        return *this;
+    }
+
+    InlineString &operator=(InlineString &&other) noexcept
+    {
+        if (this != &other)
+        {
+            MoveFrom(other);
+        }
+
+        return *this;
+    }
+
+    InlineString &operator=(const char *str)
+    {
+        return assign(str, std::strlen(str));
+    }
+
+    InlineString &operator=(const std::string &str)
+    {
+        return assign(str.data(), str.size());
+    }
+
+    InlineString &assign(const char *str, size_t length)
+    {
+        // the source may point into our own buffer, which stays valid when it is large enough
+        reserve(length);
+        std::memmove(mData, str, length);
+        SetSize(length);
+
+        return *this;
+    }
+
+    /// @name Element access
+    /// @{
+
+    char &operator[](size_t index) noexcept
+    {
+        return mData[index];
+    }
+
+    const char &operator[](size_t index) const noexcept
+    {
+        return mData[index];
+    }
+
+    char &at(size_t index)
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("InlineString::at(): index out of range");
+        }
+
+        return mData[index];
+    }
+
+    const char &at(size_t index) const
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("InlineString::at(): index out of range");
+        }
+
+        return mData[index];
+    }
+
+    char &front() noexcept
+    {
+        return mData[0];
+    }
+
+    const char &front() const noexcept
+    {
+        return mData[0];
+    }
+
+    char &back() noexcept
+    {
+        return mData[mSize - 1];
+    }
+
+    const char &back() const noexcept
+    {
+        return mData[mSize - 1];
+    }
+
+    const char *data() const noexcept
+    {
+        return mData;
+    }
+
+    const char *c_str() const noexcept
+    {
+        return mData;
+    }
+
+    std::string str() const
+    {
+        return std::string(mData, mSize);
+    }
+
+    /// @}
+
+    /// @name Iterators
+    /// @{
+
+    iterator begin() noexcept
+    {
+        return mData;
+    }
+
+    iterator end() noexcept
+    {
+        return mData + mSize;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return mData;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return mData + mSize;
+    }
+
+    /// @}
+
+    /// @name Capacity
+    /// @{
+
+    bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    size_t length() const noexcept
+    {
+        return mSize;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    /**
+     * Query if the characters are stored inside the object.
+     *
+     * @return  True if no memory is allocated.
+     */
+
+    bool IsInline() const noexcept
+    {
+        return mData == mInline;
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > mCapacity)
+        {
+            Grow(capacity);
+        }
+    }
+
+    /// @}
+
+    /// @name Modifiers
+    /// @{
+
+    void clear() noexcept
+    {
+        SetSize(0);
+    }
+
+    void push_back(char c)
+    {
+        if (mSize == mCapacity)
+        {
+            // without inline characters the capacity starts at zero
+            Grow(mCapacity != 0 ? mCapacity * 2 : 1);
+        }
+
+        mData[mSize] = c;
+        SetSize(mSize + 1);
+    }
+
+    void pop_back() noexcept
+    {
+        SetSize(mSize - 1);
+    }
+
+    InlineString &append(const char *str, size_t length)
+    {
+        if (mSize + length > mCapacity)
+        {
+            // keep the source alive while growing, it may point into our own buffer
+            InlineString copy(str, length);
+            Grow(std::max(mSize + length, mCapacity * 2));
+            std::memcpy(mData + mSize, copy.mData, length);
+        }
+        else
+        {
+            std::memmove(mData + mSize, str, length);
+        }
+
+        SetSize(mSize + length);
+
+        return *this;
+    }
+
+    InlineString &append(const char *str)
+    {
+        return append(str, std::strlen(str));
+    }
+
+    InlineString &append(const std::string &str)
+    {
+        return append(str.data(), str.size());
+    }
+
+    InlineString &append(const InlineString &str)
+    {
+        return append(str.mData, str.mSize);
+    }
+
+    InlineString &operator+=(char c)
+    {
+        push_back(c);
+        return *this;
+    }
+
+    InlineString &operator+=(const char *str)
+    {
+        return append(str);
+    }
+
+    InlineString &operator+=(const std::string &str)
+    {
+        return append(str);
+    }
+
+    InlineString &operator+=(const InlineString &str)
+    {
+        return append(str);
+    }
+
+    void resize(size_t count, char c = '\0')
+    {
+        if (count > mSize)
+        {
+            reserve(count);
+            std::memset(mData + mSize, c, count - mSize);
+        }
+
+        SetSize(count);
+    }
+
+    /// @}
+
+    /// @name Operations
+    /// @{
+
+    size_t find(char c, size_t position = 0) const noexcept
+    {
+        if (position >= mSize)
+        {
+            return npos;
+        }
+
+        const void *found = std::memchr(mData + position, c, mSize - position);
+
+        return found ? static_cast< size_t >(static_cast< const char * >(found) - mData) : npos;
+    }
+
+    size_t find(const char *str, size_t position = 0) const noexcept
+    {
+        const size_t length = std::strlen(str);
+
+        if (position > mSize || length > mSize - position)
+        {
+            return npos;
+        }
+
+        const char *const last = mData + mSize;
+        const char *const found = std::search(static_cast< const char * >(mData + position), last, str, str + length);
+
+        return found != last || length == 0 ? static_cast< size_t >(found - mData) : npos;
+    }
+
+    InlineString substr(size_t position = 0, size_t count = npos) const
+    {
+        if (position > mSize)
+        {
+            throw std::out_of_range("InlineString::substr(): position out of range");
+        }
+
+        return InlineString(mData + position, std::min(count, mSize - position));
+    }
+
+    int compare(const char *str, size_t length) const noexcept
+    {
+        const int result = std::memcmp(mData, str, std::min(mSize, length));
+
+        if (result != 0)
+        {
+            return result;
+        }
+
+        return mSize < length ? -1 : (mSize > length ? 1 : 0);
+    }
+
+    int compare(const InlineString &other) const noexcept
+    {
+        return compare(other.mData, other.mSize);
+    }
+
+    /// @}
+
+    friend bool operator==(const InlineString &lhs, const InlineString &rhs) noexcept
+    {
+        return lhs.mSize == rhs.mSize && std::memcmp(lhs.mData, rhs.mData, lhs.mSize) == 0;
+    }
+
+    friend bool operator!=(const InlineString &lhs, const InlineString &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const InlineString &lhs, const InlineString &rhs) noexcept
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    friend bool operator==(const InlineString &lhs, const char *rhs) noexcept
+    {
+        return lhs.compare(rhs, std::strlen(rhs)) == 0;
+    }
+
+    friend bool operator==(const char *lhs, const InlineString &rhs) noexcept
+    {
+        return rhs == lhs;
+    }
+
+    friend bool operator!=(const InlineString &lhs, const char *rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(const char *lhs, const InlineString &rhs) noexcept
+    {
+        return !(rhs == lhs);
+    }
+
+    friend bool operator==(const InlineString &lhs, const std::string &rhs) noexcept
+    {
+        return lhs.compare(rhs.data(), rhs.size()) == 0;
+    }
+
+    friend bool operator==(const std::string &lhs, const InlineString &rhs) noexcept
+    {
+        return rhs == lhs;
+    }
+
+    friend bool operator!=(const InlineString &lhs, const std::string &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(const std::string &lhs, const InlineString &rhs) noexcept
+    {
+        return !(rhs == lhs);
+    }
+
+private:
+
+    char *mData;
+    size_t mSize;
+    size_t mCapacity;
+
+    char mInline[N + 1];
+
+    void SetSize(size_t size) noexcept
+    {
+        mSize = size;
+        mData[size] = '\0';
+    }
+
+    void Deallocate() noexcept
+    {
+        if (!IsInline())
+        {
+            delete[] mData;
+        }
+    }
+
+    void Grow(size_t capacity)
+    {
+        char *const memory = new char[capacity + 1];
+
+        std::memcpy(memory, mData, mSize + 1);
+        Deallocate();
+
+        mData = memory;
+        mCapacity = capacity;
+    }
+
+    // steals the allocation of a heap string, or copies the characters of an inline one
+    void MoveFrom(InlineString &other) noexcept
+    {
+        if (other.IsInline())
+        {
+            // fits, since our capacity is never below N
+            std::memcpy(mData, other.mData, other.mSize + 1);
+            mSize = other.mSize;
+        }
+        else
+        {
+            Deallocate();
+
+            mData = other.mData;
+            mSize = other.mSize;
+            mCapacity = other.mCapacity;
+
+            other.mData = other.mInline;
+            other.mCapacity = N;
+        }
+
+        other.SetSize(0);
+    }
+};
+
+template< size_t N >
+const size_t InlineString< N >::npos;
+
+template< size_t N >
+std::ostream &operator<<(std::ostream &stream, const InlineString< N > &str)
+{
+    return stream.write(str.data(), static_cast< std::streamsize >(str.size()));
+}
+
+namespace std
+{
+    template< size_t N >
+    struct hash< InlineString< N > >
+    {
+        size_t operator()(const InlineString< N > &value) const noexcept
+        {
+            // hash every character, like operator== compares them
+            return static_cast< size_t >(Hash::Fnv1a(value.data(), value.size()));
+        }
+    };
+}
+
+#endif
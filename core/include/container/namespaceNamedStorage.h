@@ -28,10 +28,16 @@
 #ifndef __ENGINE_NAMESPACENAMEDSTORAGE_H__
 #define __ENGINE_NAMESPACENAMEDSTORAGE_H__
 
+#include "container/namespaceSnapshot.h"
+
+#include "threading/snapshotPtr.h"
+
+#include "common/utilClasses.h"
 #include "common/namespace.h"
 
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
 #include <vector>
 #include <mutex>
 
@@ -51,6 +57,9 @@
  * @warning The addin namespace ID '0' will not be recognised as an addin, but as the whole
  *          plugin namespace. This is because of how the Namespace class is designed to work.
  *
+ * @note    Get and Has never lock, they look up in an immutable snapshot of the objects that is
+ *          rebuilt on every change, or once at the end of a Batch.
+ *
  * @see NamespaceStorage
  *
  * @threadsafe.
@@ -64,6 +73,39 @@ class NamespaceNamedStorage
 {
 public:
 
+    /**
+     * Defers rebuilding the snapshot while it exists, so a batch of changes rebuilds it once.
+     * Batches may nest, the outermost one publishes.
+     */
+
+    class Batch
+        : NonCopyable< Batch >
+    {
+    public:
+
+        explicit Batch(NamespaceNamedStorage &storage)
+            : mStorage(storage)
+        {
+            mStorage.BeginBatch();
+        }
+
+        ~Batch()
+        {
+            mStorage.EndBatch();
+        }
+
+    private:
+
+        NamespaceNamedStorage &mStorage;
+    };
+
+    NamespaceNamedStorage()
+        : mSnapshot(new Snapshot),
+          mBatchDepth(0),
+          mIsStale(false)
+    {
+    }
+
     /**
      * Destructor, releases all our used memory.
      */
@@ -123,6 +165,8 @@ public:
                 mObjectName[ name ] = ns;
             }
 
+            OnChanged();
+
             return true;
         }
 
@@ -139,9 +183,11 @@ public:
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
+        std::vector< tStoredType * > removed;
+
         for (const auto &it : mObjects)
         {
-            delete it.second;
+            removed.push_back(it.second);
         }
 
         mObjects.clear();
@@ -149,6 +195,9 @@ public:
         mPluginObjects.clear();
         mPluginAddinsNamespaces.clear();
         mObjectName.clear();
+
+        OnChanged();
+        DeleteObjects(removed);
     }
 
     /**
@@ -161,14 +210,21 @@ public:
 
     void Clear(const Namespace ns)
     {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        std::vector< tStoredType * > removed;
+
         if (ns.IsAddin())
         {
-            RemoveObjectsByAddinNamespace(ns);
+            RemoveObjectsByAddinNamespace(ns, removed);
         }
         else
         {
-            RemoveObjectsByPluginNamespace(ns.GetPlugin());
+            RemoveObjectsByPluginNamespace(ns.GetPlugin(), removed);
         }
+
+        OnChanged();
+        DeleteObjects(removed);
     }
 
     /**
@@ -222,7 +278,48 @@ public:
             }
         }
 
-        RemoveObjectName(name);
+        std::vector< tStoredType * > removed;
+        RemoveObjectName(name, removed);
+
+        if (!removed.empty())
+        {
+            OnChanged();
+            DeleteObjects(removed);
+        }
+    }
+
+    /**
+     * Starts deferring the snapshot rebuilds, prefer a Batch scope.
+     *
+     * @threadsafe
+     */
+
+    void BeginBatch()
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        ++mBatchDepth;
+    }
+
+    /**
+     * Ends a batch, and publishes the changes made in it when it was the outermost one. Also
+     * frees the snapshots that readers held on to during earlier changes.
+     *
+     * @threadsafe
+     */
+
+    void EndBatch()
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        if (--mBatchDepth == 0 && mIsStale.load(std::memory_order_relaxed))
+        {
+            PublishSnapshot();
+        }
+        else
+        {
+            mSnapshot.Reclaim();
+        }
     }
 
     /// @}
@@ -242,16 +339,21 @@ public:
 
     tStoredType *Get(const tName &name) const
     {
-        std::lock_guard< std::recursive_mutex > lock(mMutex);
-
-        auto objectIt = mObjects.find(name);
-
-        if (objectIt != mObjects.end())
         {
-            return objectIt->second;
+            const typename SnapshotPtr< Snapshot >::Reader snapshot(mSnapshot);
+
+            if (!mIsStale.load(std::memory_order_seq_cst))
+            {
+                return snapshot->Get(name);
+            }
         }
 
-        return nullptr;
+        // a batch changed the objects, which only the maps know about yet
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        const auto objectIt = mObjects.find(name);
+
+        return objectIt != mObjects.end() ? objectIt->second : nullptr;
     }
 
     /// @}
@@ -272,17 +374,32 @@ public:
     std::vector< tName > GetNames(const Namespace ns) const
     {
         std::vector< tName > objects;
+        GetNames(ns, objects);
+        return objects;
+    }
+
+    /**
+     * Appends the names used by the given namespace to the given container. Callers that only
+     * need the names briefly can pass a container with inline storage, such as a SmallVector.
+     *
+     * @threadsafe
+     *
+     * @tparam  tContainer  Type of the container, needs to provide push_back(const tName &).
+     * @param           ns      The namespace.
+     * @param [in,out]  names   The container the names are appended to.
+     */
 
+    template< typename tContainer >
+    void GetNames(const Namespace ns, tContainer &names) const
+    {
         if (ns.IsAddin())
         {
-            objects = GetNamesByAddinNamespace(ns);
+            GetNamesByAddinNamespace(ns, names);
         }
         else
         {
-            objects = GetNamesByPluginNamespace(ns.GetPlugin());
+            GetNamesByPluginNamespace(ns.GetPlugin(), names);
         }
-
-        return objects;
     }
 
     /// @}
@@ -302,9 +419,7 @@ public:
 
     bool Has(const tName &name) const
     {
-        std::lock_guard< std::recursive_mutex > lock(mMutex);
-
-        return mObjects.find(name) != mObjects.end();
+        return Get(name) != nullptr;
     }
 
     /// @}
@@ -328,19 +443,73 @@ private:
 
     mutable std::recursive_mutex mMutex;
 
+    typedef NamedSnapshot< tName, tStoredType > Snapshot;
+
+    /// Holds the objects for the readers, replaced on every change
+    SnapshotPtr< Snapshot > mSnapshot;
+
+    /// The amount of open batches, guarded by the mutex
+    U32 mBatchDepth;
+
+    /// Whether a batch changed the objects since the snapshot was published
+    std::atomic< bool > mIsStale;
+
     /**
-     * Removes the object described by the name.
+     * Publishes a change, or marks the snapshot stale when a batch is open.
+     */
+
+    void OnChanged()
+    {
+        if (mBatchDepth > 0)
+        {
+            mIsStale.store(true, std::memory_order_seq_cst);
+        }
+        else
+        {
+            PublishSnapshot();
+        }
+    }
+
+    /**
+     * Rebuilds the snapshot from the objects and publishes it to the readers.
+     */
+
+    void PublishSnapshot()
+    {
+        Snapshot *const snapshot = new Snapshot;
+
+        for (const auto &it : mObjects)
+        {
+            snapshot->Add(it.first, it.second);
+        }
+
+        mSnapshot.Publish(snapshot);
+        mIsStale.store(false, std::memory_order_seq_cst);
+    }
+
+    static void DeleteObjects(const std::vector< tStoredType * > &objects)
+    {
+        for (tStoredType *object : objects)
+        {
+            delete object;
+        }
+    }
+
+    /**
+     * Removes the object described by the name. It is deleted by the caller after the snapshot
+     * without it is published.
      *
-     * @param   name    The name.
+     * @param           name    The name.
+     * @param [in,out]  removed The removed objects.
      */
 
-    void RemoveObjectName(const tName &name)
+    void RemoveObjectName(const tName &name, std::vector< tStoredType * > &removed)
     {
         auto objectIt = mObjects.find(name);
 
         if (objectIt != mObjects.end())
         {
-            delete objectIt->second;
+            removed.push_back(objectIt->second);
 
             mObjects.erase(objectIt);
         }
@@ -358,10 +527,11 @@ private:
      *
      * @threadsafe
      *
-     * @param   ns  The addin namespace.
+     * @param           addinNs The addin namespace.
+     * @param [in,out]  removed The removed objects.
      */
 
-    void RemoveObjectsByAddinNamespace(Namespace addinNs)
+    void RemoveObjectsByAddinNamespace(Namespace addinNs, std::vector< tStoredType * > &removed)
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
@@ -373,7 +543,7 @@ private:
 
             for (const auto id : identifiers)
             {
-                RemoveObjectName(id);
+                RemoveObjectName(id, removed);
             }
 
             mAddinObjects.erase(nameIt);
@@ -399,10 +569,11 @@ private:
      *
      * @threadsafe
      *
-     * @param   pluginNs    The plugin namespace.
+     * @param           pluginNs    The plugin namespace.
+     * @param [in,out]  removed     The removed objects.
      */
 
-    void RemoveObjectsByPluginNamespace(Namespace pluginNs)
+    void RemoveObjectsByPluginNamespace(Namespace pluginNs, std::vector< tStoredType * > &removed)
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
@@ -414,7 +585,7 @@ private:
 
             for (const auto id : identifiers)
             {
-                RemoveObjectName(id);
+                RemoveObjectName(id, removed);
             }
 
             mPluginObjects.erase(nameIt);
@@ -428,7 +599,7 @@ private:
 
             for (auto addinNs : addinIDs)
             {
-                RemoveObjectsByAddinNamespace(Namespace(pluginNs, addinNs));
+                RemoveObjectsByAddinNamespace(Namespace(pluginNs, addinNs), removed);
             }
 
             mPluginAddinsNamespaces.erase(addinIt);
@@ -436,19 +607,17 @@ private:
     }
 
     /**
-     * Gets the names used by the given addin namespace.
+     * Appends the names used by the given addin namespace.
      *
      * @threadsafe
      *
-     * @param   addinNs The addin nsnamespace
-     *
-     * @return  The names used by the addin namespace.
+     * @param           addinNs The addin namespace.
+     * @param [in,out]  names   The container the names are appended to.
      */
 
-    std::vector< tName > GetNamesByAddinNamespace(Namespace addinNs) const
+    template< typename tContainer >
+    void GetNamesByAddinNamespace(Namespace addinNs, tContainer &names) const
     {
-        std::vector< tName > objects;
-
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
         auto pluginIt = mAddinObjects.find(addinNs);
@@ -457,29 +626,25 @@ private:
         {
             const std::unordered_set< tName > &identifiers = pluginIt->second;
 
-            for (const auto id : identifiers)
+            for (const auto &id : identifiers)
             {
-                objects.push_back(id);
+                names.push_back(id);
             }
         }
-
-        return objects;
     }
 
     /**
-     * Gets the names used by the plugin namespace.
+     * Appends the names used by the plugin namespace, including those of its addins.
      *
      * @threadsafe.
      *
-     * @param   pluginNs    The plugin namespace.
-     *
-     * @return  The names used by the plugin namespace.
+     * @param           pluginNs    The plugin namespace.
+     * @param [in,out]  names       The container the names are appended to.
      */
 
-    std::vector< tName > GetNamesByPluginNamespace(Namespace pluginNs) const
+    template< typename tContainer >
+    void GetNamesByPluginNamespace(Namespace pluginNs, tContainer &names) const
     {
-        std::vector< tName > objects;
-
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
         auto nameIt = mPluginObjects.find(pluginNs);
@@ -488,9 +653,9 @@ private:
         {
             const std::unordered_set< tName > &identifiers = nameIt->second;
 
-            for (const auto id : identifiers)
+            for (const auto &id : identifiers)
             {
-                objects.push_back(id);
+                names.push_back(id);
             }
         }
 
@@ -502,15 +667,12 @@ private:
 
             for (const auto id : addinIDs)
             {
-                const std::vector< tName > newObjects = GetNamesByAddinNamespace(Namespace(pluginNs, id));
-                objects.insert(objects.end(), newObjects.begin(), newObjects.end());
+                GetNamesByAddinNamespace(Namespace(pluginNs, id), names);
             }
         }
-
-        return objects;
     }
 };
 
 /// @}
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_NAMESPACESNAPSHOT_H__
+#define __ENGINE_NAMESPACESNAPSHOT_H__
+
+#include "container/flatHashMap.h"
+#include "container/smallVector.h"
+
+#include "common/namespace.h"
+#include "common/typeID.h"
+
+#include <vector>
+
+/// @addtogroup Datastructures
+/// @{
+
+/**
+ * The immutable lookup table the readers of a NamespaceStorage use. Objects are found by their
+ * name together with their namespace in one hash lookup.
+ *
+ * @tparam  tName       Type of the dictionary key.
+ * @tparam  tStoredType Type of the stored type.
+ */
+
+template< typename tName, typename tStoredType >
+class NamespaceSnapshot
+{
+public:
+
+    void Add(const tName &name, const Namespace ns, tStoredType *object)
+    {
+        mObjects.emplace(Key{ name, ns }, object);
+    }
+
+    tStoredType *Get(const tName &name, const Namespace ns) const
+    {
+        const auto objectIt = mObjects.find(Key{ name, ns });
+
+        return objectIt != mObjects.end() ? objectIt->second : nullptr;
+    }
+
+private:
+
+    struct Key
+    {
+        tName name;
+        Namespace ns;
+
+        bool operator==(const Key &other) const
+        {
+            return ns == other.ns && name == other.name;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash< tName >()(key.name) ^ (static_cast< size_t >(key.ns.GetNamespace()) * 0x9E3779B9u);
+        }
+    };
+
+    FlatHashMap< Key, tStoredType *, KeyHash > mObjects;
+};
+
+/**
+ * Objects named by their type are indexed by the dense type identifier instead, so a lookup is
+ * an array load and a scan of the few namespaces the type is stored under.
+ */
+
+template< typename tStoredType >
+class NamespaceSnapshot< TypeID, tStoredType >
+{
+public:
+
+    void Add(const TypeID type, const Namespace ns, tStoredType *object)
+    {
+        if (type.GetID() >= mObjects.size())
+        {
+            mObjects.resize(type.GetID() + 1);
+        }
+
+        mObjects[ type.GetID() ].push_back(Entry{ ns, object });
+    }
+
+    tStoredType *Get(const TypeID type, const Namespace ns) const
+    {
+        if (type.GetID() < mObjects.size())
+        {
+            for (const Entry &entry : mObjects[ type.GetID() ])
+            {
+                if (entry.ns == ns)
+                {
+                    return entry.object;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+
+    struct Entry
+    {
+        Namespace ns;
+        tStoredType *object;
+    };
+
+    // most types are stored in one namespace only
+    std::vector< SmallVector< Entry, 1 >> mObjects;
+};
+
+/**
+ * The immutable lookup table the readers of a NamespaceNamedStorage use.
+ *
+ * @tparam  tName       Type of the dictionary key.
+ * @tparam  tStoredType Type of the stored type.
+ */
+
+template< typename tName, typename tStoredType >
+class NamedSnapshot
+{
+public:
+
+    void Add(const tName &name, tStoredType *object)
+    {
+        mObjects.emplace(name, object);
+    }
+
+    tStoredType *Get(const tName &name) const
+    {
+        const auto objectIt = mObjects.find(name);
+
+        return objectIt != mObjects.end() ? objectIt->second : nullptr;
+    }
+
+private:
+
+    FlatHashMap< tName, tStoredType * > mObjects;
+};
+
+/**
+ * Names are unique over all namespaces, so objects named by their type are a plain array indexed
+ * by the type identifier.
+ */
+
+template< typename tStoredType >
+class NamedSnapshot< TypeID, tStoredType >
+{
+public:
+
+    void Add(const TypeID type, tStoredType *object)
+    {
+        if (type.GetID() >= mObjects.size())
+        {
+            mObjects.resize(type.GetID() + 1, nullptr);
+        }
+
+        mObjects[ type.GetID() ] = object;
+    }
+
+    tStoredType *Get(const TypeID type) const
+    {
+        return type.GetID() < mObjects.size() ? mObjects[ type.GetID() ] : nullptr;
+    }
+
+private:
+
+    std::vector< tStoredType * > mObjects;
+};
+
+/// @}
+
+#endif
@@ -28,10 +28,17 @@
 #ifndef __NAMESPACESTORAGE_H__
 #define __NAMESPACESTORAGE_H__
 
+#include "container/namespaceSnapshot.h"
+
+#include "threading/snapshotPtr.h"
+
+#include "common/utilClasses.h"
 #include "common/namespace.h"
 
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
+#include <vector>
 #include <mutex>
 
 /// @addtogroup Datastructures
@@ -78,6 +85,12 @@
  * @note    The class only stores objects created with new, and after storing it, it will take
  *          ownership of the objects.
  *
+ * @note    Get and Has never lock, they look up in an immutable snapshot of all objects that is
+ *          rebuilt on every change. Changes are thus expensive, which suits storages that are
+ *          filled once and read from many threads, such as the pool and factory registries.
+ *          Many changes in a row should be wrapped in a Batch, which rebuilds the snapshot once
+ *          at its end; readers take the lock until then.
+ *
  * @warning The addin namespace ID '0' will not be recognised as an addin, but as the whole
  *          plugin namespace. This is because of how the Namespace class is designed to work.
  *
@@ -92,6 +105,39 @@ class NamespaceStorage
 {
 public:
 
+    /**
+     * Defers rebuilding the snapshot while it exists, so a batch of changes rebuilds it once.
+     * Batches may nest, the outermost one publishes.
+     */
+
+    class Batch
+        : NonCopyable< Batch >
+    {
+    public:
+
+        explicit Batch(NamespaceStorage &storage)
+            : mStorage(storage)
+        {
+            mStorage.BeginBatch();
+        }
+
+        ~Batch()
+        {
+            mStorage.EndBatch();
+        }
+
+    private:
+
+        NamespaceStorage &mStorage;
+    };
+
+    NamespaceStorage()
+        : mSnapshot(new Snapshot),
+          mBatchDepth(0),
+          mIsStale(false)
+    {
+    }
+
     /**
      * Deconstructor, releases all our used memory.
      */
@@ -139,6 +185,8 @@ public:
                 nameMap[ name ] = object;
                 mPluginAddins[ ns.GetPlugin() ].insert(ns.GetAddin());
 
+                OnChanged();
+
                 return true;
             }
         }
@@ -154,6 +202,8 @@ public:
             {
                 nameMap[ name ] = object;
 
+                OnChanged();
+
                 return true;
             }
         }
@@ -171,13 +221,15 @@ public:
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
+        std::vector< tStoredType * > removed;
+
         for (const auto &nameit : mPluginObjects)
         {
             const std::unordered_map< tName, tStoredType * > &nameMap = nameit.second;
 
             for (const auto &it : nameMap)
             {
-                delete it.second;
+                removed.push_back(it.second);
             }
         }
 
@@ -187,13 +239,16 @@ public:
 
             for (const auto &it : nameMap)
             {
-                delete it.second;
+                removed.push_back(it.second);
             }
         }
 
         mPluginObjects.clear();
         mAddinObjects.clear();
         mPluginAddins.clear();
+
+        OnChanged();
+        DeleteObjects(removed);
     }
 
     /**
@@ -206,14 +261,21 @@ public:
 
     void Clear(const Namespace ns)
     {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        std::vector< tStoredType * > removed;
+
         if (ns.IsAddin())
         {
-            RemoveObjectsByAddinNamespace(ns);
+            RemoveObjectsByAddinNamespace(ns, removed);
         }
         else
         {
-            RemoveObjectsByPluginNamespace(ns.GetPlugin());
+            RemoveObjectsByPluginNamespace(ns.GetPlugin(), removed);
         }
+
+        OnChanged();
+        DeleteObjects(removed);
     }
 
     /**
@@ -257,13 +319,51 @@ public:
 
             if (objectIt != nameMap->end())
             {
-                delete objectIt->second;
+                tStoredType *const object = objectIt->second;
 
                 nameMap->erase(objectIt);
+
+                // readers may not find the object anymore before we delete it
+                OnChanged();
+                delete object;
             }
         }
     }
 
+    /**
+     * Starts deferring the snapshot rebuilds, prefer a Batch scope.
+     *
+     * @threadsafe
+     */
+
+    void BeginBatch()
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        ++mBatchDepth;
+    }
+
+    /**
+     * Ends a batch, and publishes the changes made in it when it was the outermost one. Also
+     * frees the snapshots that readers held on to during earlier changes.
+     *
+     * @threadsafe
+     */
+
+    void EndBatch()
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        if (--mBatchDepth == 0 && mIsStale.load(std::memory_order_relaxed))
+        {
+            PublishSnapshot();
+        }
+        else
+        {
+            mSnapshot.Reclaim();
+        }
+    }
+
     /// @}
 
     /// @name Element access
@@ -282,40 +382,16 @@ public:
 
     tStoredType *Get(const tName &name, const Namespace ns = 0u) const
     {
-        const std::unordered_map< tName, tStoredType * > *nameMap = nullptr;
-
-        std::lock_guard< std::recursive_mutex > lock(mMutex);
-
-        if (ns.IsAddin())
-        {
-            const auto nameIt = mAddinObjects.find(ns);
-
-            if (nameIt != mAddinObjects.end())
-            {
-                nameMap = &nameIt->second;
-            }
-        }
-        else
-        {
-            const auto nameIt = mPluginObjects.find(ns.GetPlugin());
-
-            if (nameIt != mPluginObjects.end())
-            {
-                nameMap = &nameIt->second;
-            }
-        }
-
-        if (nameMap)
         {
-            const auto objectIt = nameMap->find(name);
+            const typename SnapshotPtr< Snapshot >::Reader snapshot(mSnapshot);
 
-            if (objectIt != nameMap->end())
+            if (!mIsStale.load(std::memory_order_seq_cst))
             {
-                return objectIt->second;
+                return snapshot->Get(name, ns.IsAddin() ? ns : ns.GetPlugin());
             }
         }
 
-        return nullptr;
+        return Find(name, ns);
     }
 
     /// @}
@@ -336,35 +412,7 @@ public:
 
     bool Has(const tName &name, const Namespace ns = 0u) const
     {
-        const std::unordered_map< tName, tStoredType * > *nameMap = nullptr;
-
-        std::lock_guard< std::recursive_mutex > lock(mMutex);
-
-        if (ns.IsAddin())
-        {
-            const auto nameIt = mAddinObjects.find(ns);
-
-            if (nameIt != mAddinObjects.end())
-            {
-                nameMap = &nameIt->second;
-            }
-        }
-        else
-        {
-            const auto nameIt = mPluginObjects.find(ns.GetPlugin());
-
-            if (nameIt != mPluginObjects.end())
-            {
-                nameMap = &nameIt->second;
-            }
-        }
-
-        if (nameMap)
-        {
-            return nameMap->find(name) != nameMap->end();
-        }
-
-        return false;
+        return Get(name, ns) != nullptr;
     }
 
     /**
@@ -395,8 +443,47 @@ public:
 
     /// @}
 
+    /// @name Iteration
+    /// @{
+
+    /**
+     * Calls the function for every stored object, in all namespaces. The storage stays
+     * locked meanwhile, so the function should not add or remove objects from another thread.
+     *
+     * @threadsafe
+     *
+     * @param   function    The function, called with a pointer to the object.
+     */
+
+    template< typename tFunction >
+    void ForEach(tFunction function) const
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        for (const auto &nameit : mPluginObjects)
+        {
+            for (const auto &it : nameit.second)
+            {
+                function(it.second);
+            }
+        }
+
+        for (const auto &nameit : mAddinObjects)
+        {
+            for (const auto &it : nameit.second)
+            {
+                function(it.second);
+            }
+        }
+    }
+
+    /// @}
+
 private:
 
+    // Plugin objects are stored in the snapshot under their plugin namespace.
+    typedef NamespaceSnapshot< tName, tStoredType > Snapshot;
+
     // Holds the objects stored under the full addin namespace.
     std::unordered_map< Namespace, std::unordered_map< tName, tStoredType * >> mAddinObjects;
 
@@ -409,18 +496,108 @@ private:
     // Mutex for our threadsafety.
     mutable std::recursive_mutex mMutex;
 
+    // Holds all objects for the readers, replaced on every change.
+    SnapshotPtr< Snapshot > mSnapshot;
+
+    // The amount of open batches, guarded by the mutex.
+    U32 mBatchDepth;
+
+    // Whether a batch changed the maps since the snapshot was published.
+    std::atomic< bool > mIsStale;
+
+    /**
+     * Publishes a change, or marks the snapshot stale when a batch is open.
+     */
+
+    void OnChanged()
+    {
+        if (mBatchDepth > 0)
+        {
+            mIsStale.store(true, std::memory_order_seq_cst);
+        }
+        else
+        {
+            PublishSnapshot();
+        }
+    }
+
+    /**
+     * Looks the object up in the namespace maps, for readers of a stale snapshot.
+     *
+     * @param   name    The name.
+     * @param   ns      The namespace.
+     *
+     * @return  The object, or nullptr when it is not stored.
+     */
+
+    tStoredType *Find(const tName &name, const Namespace ns) const
+    {
+        std::lock_guard< std::recursive_mutex > lock(mMutex);
+
+        const auto &objects = ns.IsAddin() ? mAddinObjects : mPluginObjects;
+        const auto nameMap = objects.find(ns.IsAddin() ? ns : ns.GetPlugin());
+
+        if (nameMap != objects.end())
+        {
+            const auto objectIt = nameMap->second.find(name);
+
+            if (objectIt != nameMap->second.end())
+            {
+                return objectIt->second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Rebuilds the snapshot from the namespace maps and publishes it to the readers.
+     */
+
+    void PublishSnapshot()
+    {
+        Snapshot *const snapshot = new Snapshot;
+
+        for (const auto &nameit : mPluginObjects)
+        {
+            for (const auto &it : nameit.second)
+            {
+                snapshot->Add(it.first, nameit.first, it.second);
+            }
+        }
+
+        for (const auto &nameit : mAddinObjects)
+        {
+            for (const auto &it : nameit.second)
+            {
+                snapshot->Add(it.first, nameit.first, it.second);
+            }
+        }
+
+        mSnapshot.Publish(snapshot);
+        mIsStale.store(false, std::memory_order_seq_cst);
+    }
+
+    static void DeleteObjects(const std::vector< tStoredType * > &objects)
+    {
+        for (tStoredType *object : objects)
+        {
+            delete object;
+        }
+    }
+
     /// @addtogroup Memory Management
     /// @{
 
     /**
-     * Removes and frees the memory of the stored under the given addin namespace.
-     *
-     * @threadsafe.
+     * Removes the objects stored under the given addin namespace. They are deleted by the caller
+     * after the snapshot without them is published.
      *
-     * @param   addinNs The addin namespace.
+     * @param           addinNs The addin namespace.
+     * @param [in,out]  removed The removed objects.
      */
 
-    void RemoveObjectsByAddinNamespace(const Namespace addinNs)
+    void RemoveObjectsByAddinNamespace(const Namespace addinNs, std::vector< tStoredType * > &removed)
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
@@ -432,7 +609,7 @@ private:
 
             for (const auto &it : objects)
             {
-                delete it.second;
+                removed.push_back(it.second);
             }
 
             mAddinObjects.erase(pluginIt);
@@ -454,14 +631,13 @@ private:
     }
 
     /**
-     * Removes and frees the memory of the objects stored under the given plugin namespace.
-     *
-     * @threadsafe
+     * Removes the objects stored under the given plugin namespace, including those of its addins.
      *
-     * @param   pluginNs    The plugin namespace.
+     * @param           pluginNs    The plugin namespace.
+     * @param [in,out]  removed     The removed objects.
      */
 
-    void RemoveObjectsByPluginNamespace(const Namespace pluginNs)
+    void RemoveObjectsByPluginNamespace(const Namespace pluginNs, std::vector< tStoredType * > &removed)
     {
         std::lock_guard< std::recursive_mutex > lock(mMutex);
 
@@ -473,7 +649,7 @@ private:
 
             for (const auto &it : objects)
             {
-                delete it.second;
+                removed.push_back(it.second);
             }
 
             mPluginObjects.erase(pluginIt);
@@ -487,7 +663,7 @@ private:
 
             for (auto addinNs : addinIDs)
             {
-                RemoveObjectsByAddinNamespace(Namespace(pluginNs, addinNs));
+                RemoveObjectsByAddinNamespace(Namespace(pluginNs, addinNs), removed);
             }
 
             mPluginAddins.erase(addinIt);
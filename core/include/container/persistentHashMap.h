@@ -0,0 +1,256 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_PERSISTENTHASHMAP_H__
+#define __ENGINE_PERSISTENTHASHMAP_H__
+
+#include "memory/allocators/offsetPtr.h"
+#include "memory/allocators/mappedArena.h"
+
+#include "common/types.h"
+
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+/**
+ * An open addressing hash map that lives in a MappedArena, and stays valid when the arena is
+ * mapped at another address. Meant for lookup tables that are built once and read on every
+ * following run, so there is no erase.
+ *
+ * The hash is stored implicitly in the bucket positions, so it has to give the same result in
+ * every run of the program. Keys and values may only refer to arena memory through an OffsetPtr.
+ *
+ * @tparam  tKey    The key type.
+ * @tparam  tValue  The value type.
+ * @tparam  tHash   The hash function, should not depend on addresses or seeds.
+ */
+
+template< typename tKey, typename tValue, typename tHash = std::hash< tKey > >
+class PersistentHashMap
+{
+    static_assert(std::is_trivially_destructible< tKey >::value && std::is_trivially_destructible< tValue >::value,
+                  "Persistent elements are never destroyed");
+
+public:
+
+    PersistentHashMap() noexcept
+        : mSize(0),
+          mBucketCount(0)
+    {
+    }
+
+    PersistentHashMap(const PersistentHashMap &) = delete;
+    PersistentHashMap &operator=(const PersistentHashMap &) = delete;
+
+    /**
+     * Makes room for the given amount of elements without growing.
+     *
+     * @return  false when the arena is exhausted.
+     */
+
+    bool Reserve(MappedArena &arena, size_t count)
+    {
+        size_t bucketCount = 16;
+
+        // keep the load factor below 3/4
+        while (bucketCount * 3 < count * 4)
+        {
+            bucketCount *= 2;
+        }
+
+        return bucketCount <= mBucketCount || Rehash(arena, bucketCount);
+    }
+
+    /**
+     * Inserts the value, or replaces the value of an existing key.
+     *
+     * @return  false when the arena is exhausted.
+     */
+
+    bool Insert(MappedArena &arena, const tKey &key, const tValue &value)
+    {
+        tValue *const existing = Find(key);
+
+        if (existing)
+        {
+            *existing = value;
+            return true;
+        }
+
+        if (!Reserve(arena, static_cast< size_t >(mSize) + 1))
+        {
+            return false;
+        }
+
+        Place(key, value);
+
+        return true;
+    }
+
+    tValue *Find(const tKey &key) noexcept
+    {
+        return const_cast< tValue * >(static_cast< const PersistentHashMap * >(this)->Find(key));
+    }
+
+    const tValue *Find(const tKey &key) const noexcept
+    {
+        if (mBucketCount == 0)
+        {
+            return nullptr;
+        }
+
+        const Entry *const entries = mEntries.Get();
+        const U8 *const used = mUsed.Get();
+        const U64 mask = mBucketCount - 1;
+
+        for (U64 i = GetBucket(key);; i = (i + 1) & mask)
+        {
+            if (!used[i])
+            {
+                return nullptr;
+            }
+
+            if (entries[i].key == key)
+            {
+                return &entries[i].value;
+            }
+        }
+    }
+
+    bool Has(const tKey &key) const noexcept
+    {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * Calls the function for every key and value, in bucket order.
+     */
+
+    template< typename tFunction >
+    void ForEach(const tFunction &function) const
+    {
+        const Entry *const entries = mEntries.Get();
+        const U8 *const used = mUsed.Get();
+
+        for (U64 i = 0; i < mBucketCount; ++i)
+        {
+            if (used[i])
+            {
+                function(entries[i].key, entries[i].value);
+            }
+        }
+    }
+
+    size_t Size() const noexcept
+    {
+        return static_cast< size_t >(mSize);
+    }
+
+    size_t GetBucketCount() const noexcept
+    {
+        return static_cast< size_t >(mBucketCount);
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+private:
+
+    struct Entry
+    {
+        tKey key;
+        tValue value;
+    };
+
+    OffsetPtr< Entry > mEntries;
+    OffsetPtr< U8 > mUsed;
+    U64 mSize;
+    U64 mBucketCount;
+
+    U64 GetBucket(const tKey &key) const noexcept
+    {
+        // spreads identity hashes, such as those of integers, over the buckets
+        const U64 hash = static_cast< U64 >(tHash()(key)) * 0x9E3779B97F4A7C15ull;
+        return (hash ^ (hash >> 32)) & (mBucketCount - 1);
+    }
+
+    void Place(const tKey &key, const tValue &value)
+    {
+        Entry *const entries = mEntries.Get();
+        U8 *const used = mUsed.Get();
+        const U64 mask = mBucketCount - 1;
+
+        U64 i = GetBucket(key);
+
+        while (used[i])
+        {
+            i = (i + 1) & mask;
+        }
+
+        new(&entries[i]) Entry{ key, value };
+        used[i] = 1;
+        ++mSize;
+    }
+
+    bool Rehash(MappedArena &arena, size_t bucketCount)
+    {
+        Entry *const entries = static_cast< Entry * >(arena.Allocate(bucketCount * sizeof(Entry), alignof(Entry)));
+        U8 *const used = static_cast< U8 * >(arena.Allocate(bucketCount, 1));
+
+        if (!entries || !used)
+        {
+            return false;
+        }
+
+        std::memset(used, 0, bucketCount);
+
+        const Entry *const oldEntries = mEntries.Get();
+        const U8 *const oldUsed = mUsed.Get();
+        const U64 oldBucketCount = mBucketCount;
+
+        mEntries = entries;
+        mUsed = used;
+        mBucketCount = bucketCount;
+        mSize = 0;
+
+        for (U64 i = 0; i < oldBucketCount; ++i)
+        {
+            if (oldUsed[i])
+            {
+                Place(oldEntries[i].key, oldEntries[i].value);
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_PERSISTENTVECTOR_H__
+#define __ENGINE_PERSISTENTVECTOR_H__
+
+#include "memory/allocators/offsetPtr.h"
+#include "memory/allocators/mappedArena.h"
+
+#include "common/types.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+/**
+ * A vector that lives in a MappedArena, and stays valid when the arena is mapped at another
+ * address. Elements may only refer to arena memory through an OffsetPtr.
+ *
+ * Growing takes the arena, reading does not. The storage of a grown vector is not reused, and
+ * elements are never destroyed.
+ *
+ * @tparam  tT  The element type.
+ */
+
+template< typename tT >
+class PersistentVector
+{
+    static_assert(std::is_trivially_destructible< tT >::value, "Persistent elements are never destroyed");
+
+public:
+
+    PersistentVector() noexcept
+        : mSize(0),
+          mCapacity(0)
+    {
+    }
+
+    PersistentVector(const PersistentVector &) = delete;
+    PersistentVector &operator=(const PersistentVector &) = delete;
+
+    bool Reserve(MappedArena &arena, size_t capacity)
+    {
+        if (capacity <= mCapacity)
+        {
+            return true;
+        }
+
+        tT *const data = static_cast< tT * >(arena.Allocate(capacity * sizeof(tT), alignof(tT)));
+
+        if (!data)
+        {
+            return false;
+        }
+
+        for (U64 i = 0; i < mSize; ++i)
+        {
+            new(data + i) tT(mData[i]);
+        }
+
+        mData = data;
+        mCapacity = capacity;
+
+        return true;
+    }
+
+    /**
+     * Adds a value at the end.
+     *
+     * @return  false when the arena is exhausted.
+     */
+
+    bool PushBack(MappedArena &arena, const tT &value)
+    {
+        if (mSize == mCapacity && !Reserve(arena, std::max< size_t >(static_cast< size_t >(mCapacity) * 2, 8)))
+        {
+            return false;
+        }
+
+        new(mData.Get() + mSize) tT(value);
+        ++mSize;
+
+        return true;
+    }
+
+    void PopBack() noexcept
+    {
+        --mSize;
+    }
+
+    void Clear() noexcept
+    {
+        mSize = 0;
+    }
+
+    tT &operator[](size_t index) noexcept
+    {
+        return mData[index];
+    }
+
+    const tT &operator[](size_t index) const noexcept
+    {
+        return mData[index];
+    }
+
+    tT *GetData() noexcept
+    {
+        return mData.Get();
+    }
+
+    const tT *GetData() const noexcept
+    {
+        return mData.Get();
+    }
+
+    tT *begin() noexcept
+    {
+        return mData.Get();
+    }
+
+    tT *end() noexcept
+    {
+        return mData.Get() + mSize;
+    }
+
+    const tT *begin() const noexcept
+    {
+        return mData.Get();
+    }
+
+    const tT *end() const noexcept
+    {
+        return mData.Get() + mSize;
+    }
+
+    size_t Size() const noexcept
+    {
+        return static_cast< size_t >(mSize);
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return static_cast< size_t >(mCapacity);
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+private:
+
+    OffsetPtr< tT > mData;
+    U64 mSize;
+    U64 mCapacity;
+};
+
+#endif
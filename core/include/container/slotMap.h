@@ -0,0 +1,394 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SLOTMAP_H__
+#define __ENGINE_SLOTMAP_H__
+
+#include "common/types.h"
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Bit layout of a slot map handle. A 32 bit handle addresses 2^20 slots with 12 generation bits, a 64 bit handle
+ * splits evenly. Generation zero is never handed out, so a zero handle is always invalid.
+ */
+
+template< typename tHandle >
+struct SlotHandleTraits;
+
+template<>
+struct SlotHandleTraits< U32 >
+{
+    static constexpr U32 IndexBits = 20;
+    static constexpr U32 GenerationBits = 12;
+};
+
+template<>
+struct SlotHandleTraits< U64 >
+{
+    static constexpr U32 IndexBits = 32;
+    static constexpr U32 GenerationBits = 32;
+};
+
+template< typename tHandle >
+class SlotHandle
+{
+public:
+
+    static constexpr U32 IndexBits = SlotHandleTraits< tHandle >::IndexBits;
+    static constexpr U32 GenerationBits = SlotHandleTraits< tHandle >::GenerationBits;
+
+    static constexpr tHandle IndexMask = (static_cast< tHandle >(1) << IndexBits) - 1;
+    static constexpr tHandle MaxGeneration = (static_cast< tHandle >(1) << (GenerationBits - 1) << 1) - 1;
+
+    constexpr SlotHandle() noexcept
+        : mValue(0)
+    {
+    }
+
+    constexpr SlotHandle(tHandle index, tHandle generation) noexcept
+        : mValue((generation << IndexBits) | index)
+    {
+    }
+
+    static constexpr SlotHandle FromValue(tHandle value) noexcept
+    {
+        return SlotHandle(value & IndexMask, value >> IndexBits);
+    }
+
+    constexpr tHandle GetIndex() const noexcept
+    {
+        return mValue & IndexMask;
+    }
+
+    constexpr tHandle GetGeneration() const noexcept
+    {
+        return mValue >> IndexBits;
+    }
+
+    constexpr tHandle GetValue() const noexcept
+    {
+        return mValue;
+    }
+
+    constexpr bool IsValid() const noexcept
+    {
+        return GetGeneration() != 0;
+    }
+
+    constexpr bool operator==(const SlotHandle &other) const noexcept
+    {
+        return mValue == other.mValue;
+    }
+
+    constexpr bool operator!=(const SlotHandle &other) const noexcept
+    {
+        return mValue != other.mValue;
+    }
+
+private:
+
+    tHandle mValue;
+};
+
+/**
+ * Densely stored values addressed through generational handles. Values live contiguously in insertion order until
+ * an erase moves the last value into the hole, so iteration only touches live values. Every slot remembers the
+ * generation it was last issued with; erasing bumps it, which makes every handle to the old value stale. A slot
+ * whose generation would wrap is retired instead of reused, so a stale handle can never alias a newer value.
+ *
+ * @tparam  tT      The value type.
+ * @tparam  tHandle The handle storage type, U32 or U64.
+ */
+
+template< typename tT, typename tHandle = U32 >
+class SlotMap
+{
+public:
+
+    typedef SlotHandle< tHandle > Handle;
+
+    typedef typename std::vector< tT >::iterator iterator;
+    typedef typename std::vector< tT >::const_iterator const_iterator;
+
+    SlotMap() noexcept
+        : mFreeHead(NoSlot),
+          mFreeTail(NoSlot)
+    {
+    }
+
+    Handle Insert(const tT &value)
+    {
+        return Emplace(value);
+    }
+
+    Handle Insert(tT &&value)
+    {
+        return Emplace(std::move(value));
+    }
+
+    /**
+     * Constructs a value in place. When the constructor or an allocation throws, the map is left
+     * as it was.
+     *
+     * @exception   std::length_error   Thrown when the handle has no index bits left for a slot.
+     */
+
+    template< typename... tArgs >
+    Handle Emplace(tArgs &&... args)
+    {
+        mValues.emplace_back(std::forward< tArgs >(args)...);
+
+        tHandle slot;
+
+        try
+        {
+            mValueSlots.push_back(NoSlot);
+            slot = AcquireSlot();
+        }
+        catch (...)
+        {
+            mValueSlots.resize(mValues.size() - 1);
+            mValues.pop_back();
+            throw;
+        }
+
+        mValueSlots.back() = slot;
+
+        Slot &entry = mSlots[slot];
+        entry.index = static_cast< tHandle >(mValues.size() - 1);
+
+        return Handle(slot, entry.generation);
+    }
+
+    bool Erase(Handle handle)
+    {
+        if (!Has(handle))
+        {
+            return false;
+        }
+
+        const tHandle slot = handle.GetIndex();
+        const tHandle index = mSlots[slot].index;
+        const tHandle last = static_cast< tHandle >(mValues.size() - 1);
+
+        if (index != last)
+        {
+            mValues[index] = std::move(mValues[last]);
+            mValueSlots[index] = mValueSlots[last];
+            mSlots[mValueSlots[index]].index = index;
+        }
+
+        mValues.pop_back();
+        mValueSlots.pop_back();
+
+        ReleaseSlot(slot);
+
+        return true;
+    }
+
+    bool Has(Handle handle) const noexcept
+    {
+        const tHandle slot = handle.GetIndex();
+
+        return slot < mSlots.size() && mSlots[slot].generation == handle.GetGeneration() && handle.IsValid();
+    }
+
+    tT *Find(Handle handle) noexcept
+    {
+        return Has(handle) ? &mValues[mSlots[handle.GetIndex()].index] : nullptr;
+    }
+
+    const tT *CFind(Handle handle) const noexcept
+    {
+        return Has(handle) ? &mValues[mSlots[handle.GetIndex()].index] : nullptr;
+    }
+
+    /// Returns the handle of the value at the given dense position, for iterating values together with their handles.
+    Handle GetHandle(size_t index) const noexcept
+    {
+        const tHandle slot = mValueSlots[index];
+
+        return Handle(slot, mSlots[slot].generation);
+    }
+
+    void Reserve(size_t capacity)
+    {
+        mValues.reserve(capacity);
+        mValueSlots.reserve(capacity);
+        mSlots.reserve(capacity);
+    }
+
+    void Clear()
+    {
+        for (tHandle slot : mValueSlots)
+        {
+            ReleaseSlot(slot);
+        }
+
+        mValues.clear();
+        mValueSlots.clear();
+    }
+
+    size_t Size() const noexcept
+    {
+        return mValues.size();
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return mValues.empty();
+    }
+
+    /// The number of slots ever created, including free and retired ones.
+    size_t GetSlotCount() const noexcept
+    {
+        return mSlots.size();
+    }
+
+    const std::vector< tT > &GetValues() const noexcept
+    {
+        return mValues;
+    }
+
+    std::vector< tT > &GetValues() noexcept
+    {
+        return mValues;
+    }
+
+    iterator begin() noexcept
+    {
+        return mValues.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return mValues.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return mValues.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return mValues.end();
+    }
+
+private:
+
+    static constexpr tHandle NoSlot = std::numeric_limits< tHandle >::max();
+
+    struct Slot
+    {
+        // the dense index while the slot is live, the next free slot otherwise
+        tHandle index;
+        tHandle generation;
+    };
+
+    std::vector< tT > mValues;
+    std::vector< tHandle > mValueSlots;
+    std::vector< Slot > mSlots;
+
+    // freed slots are reused oldest first, which spreads generation bumps over all slots
+    tHandle mFreeHead;
+    tHandle mFreeTail;
+
+    tHandle AcquireSlot()
+    {
+        if (mFreeHead != NoSlot)
+        {
+            const tHandle slot = mFreeHead;
+            mFreeHead = mSlots[slot].index;
+
+            if (mFreeHead == NoSlot)
+            {
+                mFreeTail = NoSlot;
+            }
+
+            return slot;
+        }
+
+        if (mSlots.size() > Handle::IndexMask)
+        {
+            // a larger index would spill into the generation bits
+            throw std::length_error("SlotMap ran out of handle index bits");
+        }
+
+        mSlots.push_back({ NoSlot, 1 });
+
+        return static_cast< tHandle >(mSlots.size() - 1);
+    }
+
+    void ReleaseSlot(tHandle slot) noexcept
+    {
+        Slot &entry = mSlots[slot];
+
+        if (entry.generation == Handle::MaxGeneration)
+        {
+            // retire the slot, generation zero marks it as dead for any handle
+            entry.generation = 0;
+            entry.index = NoSlot;
+            return;
+        }
+
+        ++entry.generation;
+        entry.index = NoSlot;
+
+        if (mFreeTail == NoSlot)
+        {
+            mFreeHead = slot;
+        }
+        else
+        {
+            mSlots[mFreeTail].index = slot;
+        }
+
+        mFreeTail = slot;
+    }
+};
+
+template< typename tT, typename tHandle >
+constexpr tHandle SlotMap< tT, tHandle >::NoSlot;
+
+template< typename tHandle >
+constexpr U32 SlotHandle< tHandle >::IndexBits;
+
+template< typename tHandle >
+constexpr U32 SlotHandle< tHandle >::GenerationBits;
+
+template< typename tHandle >
+constexpr tHandle SlotHandle< tHandle >::IndexMask;
+
+template< typename tHandle >
+constexpr tHandle SlotHandle< tHandle >::MaxGeneration;
+
+#endif
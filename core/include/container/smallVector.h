@@ -0,0 +1,581 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SMALLVECTOR_H__
+#define __ENGINE_SMALLVECTOR_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * A vector that stores up to N elements inside the object itself, and only allocates when it
+ * grows beyond that. Meant for short lived lists that usually hold a handful of elements, it
+ * offers the common part of the std::vector interface. Iterators are plain pointers and are
+ * invalidated by any change of capacity, including moving an inline vector.
+ *
+ * @tparam  tT  The element type, moving it should not throw.
+ * @tparam  N   The inline capacity.
+ */
+
+template< typename tT, size_t N >
+class SmallVector
+{
+public:
+
+    typedef tT value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef tT &reference;
+    typedef const tT &const_reference;
+    typedef tT *pointer;
+    typedef const tT *const_pointer;
+    typedef tT *iterator;
+    typedef const tT *const_iterator;
+    typedef std::reverse_iterator< iterator > reverse_iterator;
+    typedef std::reverse_iterator< const_iterator > const_reverse_iterator;
+
+    SmallVector() noexcept
+        : mBegin(GetInline()),
+          mSize(0),
+          mCapacity(N)
+    {
+    }
+
+    explicit SmallVector(size_t count)
+        : SmallVector()
+    {
+        resize(count);
+    }
+
+    SmallVector(size_t count, const tT &value)
+        : SmallVector()
+    {
+        resize(count, value);
+    }
+
+    template< typename tIterator, typename = typename std::iterator_traits< tIterator >::iterator_category >
+    SmallVector(tIterator first, tIterator last)
+        : SmallVector()
+    {
+        assign(first, last);
+    }
+
+    SmallVector(std::initializer_list< tT > values)
+        : SmallVector()
+    {
+        assign(values.begin(), values.end());
+    }
+
+    SmallVector(const SmallVector &other)
+        : SmallVector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector &&other) noexcept
+        : SmallVector()
+    {
+        MoveFrom(other);
+    }
+
+    ~SmallVector()
+    {
+        Destroy(mBegin, mBegin + mSize);
+        Deallocate();
+    }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            MoveFrom(other);
+        }
+
+        return *this;
+    }
+
+    SmallVector &operator=(std::initializer_list< tT > values)
+    {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    template< typename tIterator >
+    void assign(tIterator first, tIterator last)
+    {
+        clear();
+        reserve(static_cast< size_t >(std::distance(first, last)));
+
+        for (; first != last; ++first)
+        {
+            new(mBegin + mSize) tT(*first);
+            ++mSize;
+        }
+    }
+
+    /// @name Element access
+    /// @{
+
+    tT &operator[](size_t index) noexcept
+    {
+        return mBegin[index];
+    }
+
+    const tT &operator[](size_t index) const noexcept
+    {
+        return mBegin[index];
+    }
+
+    tT &at(size_t index)
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("SmallVector::at(): index out of range");
+        }
+
+        return mBegin[index];
+    }
+
+    const tT &at(size_t index) const
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("SmallVector::at(): index out of range");
+        }
+
+        return mBegin[index];
+    }
+
+    tT &front() noexcept
+    {
+        return mBegin[0];
+    }
+
+    const tT &front() const noexcept
+    {
+        return mBegin[0];
+    }
+
+    tT &back() noexcept
+    {
+        return mBegin[mSize - 1];
+    }
+
+    const tT &back() const noexcept
+    {
+        return mBegin[mSize - 1];
+    }
+
+    tT *data() noexcept
+    {
+        return mBegin;
+    }
+
+    const tT *data() const noexcept
+    {
+        return mBegin;
+    }
+
+    /// @}
+
+    /// @name Iterators
+    /// @{
+
+    iterator begin() noexcept
+    {
+        return mBegin;
+    }
+
+    iterator end() noexcept
+    {
+        return mBegin + mSize;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return mBegin;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return mBegin + mSize;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return mBegin;
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return mBegin + mSize;
+    }
+
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /// @}
+
+    /// @name Capacity
+    /// @{
+
+    bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    /**
+     * Query if the elements are stored inside the object.
+     *
+     * @return  True if no memory is allocated.
+     */
+
+    bool IsInline() const noexcept
+    {
+        return mBegin == GetInline();
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > mCapacity)
+        {
+            Grow(capacity);
+        }
+    }
+
+    /**
+     * Moves the elements back inside the object when they fit, or into a smaller allocation.
+     */
+
+    void shrink_to_fit()
+    {
+        if (IsInline() || mSize == mCapacity)
+        {
+            return;
+        }
+
+        tT *const old = mBegin;
+
+        mBegin = mSize <= N ? GetInline() : Allocate(mSize);
+        mCapacity = mSize <= N ? N : mSize;
+
+        Relocate(old, old + mSize, mBegin);
+        ::operator delete(old);
+    }
+
+    /// @}
+
+    /// @name Modifiers
+    /// @{
+
+    void clear() noexcept
+    {
+        Destroy(mBegin, mBegin + mSize);
+        mSize = 0;
+    }
+
+    void push_back(const tT &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(tT &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template< typename... tArgs >
+    tT &emplace_back(tArgs &&... args)
+    {
+        if (mSize == mCapacity)
+        {
+            // construct first, the arguments may refer to an element
+            tT value(std::forward< tArgs >(args)...);
+            Grow(mCapacity * 2);
+            new(mBegin + mSize) tT(std::move(value));
+        }
+        else
+        {
+            new(mBegin + mSize) tT(std::forward< tArgs >(args)...);
+        }
+
+        return mBegin[mSize++];
+    }
+
+    void pop_back() noexcept
+    {
+        mBegin[--mSize].~tT();
+    }
+
+    iterator insert(const_iterator position, const tT &value)
+    {
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, tT &&value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    template< typename tIterator, typename = typename std::iterator_traits< tIterator >::iterator_category >
+    iterator insert(const_iterator position, tIterator first, tIterator last)
+    {
+        const size_t index = static_cast< size_t >(position - mBegin);
+        const size_t oldSize = mSize;
+
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+
+        std::rotate(mBegin + index, mBegin + oldSize, mBegin + mSize);
+
+        return mBegin + index;
+    }
+
+    template< typename... tArgs >
+    iterator emplace(const_iterator position, tArgs &&... args)
+    {
+        const size_t index = static_cast< size_t >(position - mBegin);
+
+        emplace_back(std::forward< tArgs >(args)...);
+        std::rotate(mBegin + index, mBegin + mSize - 1, mBegin + mSize);
+
+        return mBegin + index;
+    }
+
+    iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        tT *const from = mBegin + (first - mBegin);
+        tT *const to = mBegin + (last - mBegin);
+
+        // moving the tail onto itself would self move assign every element
+        if (from == to)
+        {
+            return from;
+        }
+
+        tT *const newEnd = std::move(to, mBegin + mSize, from);
+
+        Destroy(newEnd, mBegin + mSize);
+        mSize = static_cast< size_t >(newEnd - mBegin);
+
+        return from;
+    }
+
+    void resize(size_t count)
+    {
+        ResizeWith(count, [](tT * slot)
+        {
+            new(slot) tT();
+        });
+    }
+
+    void resize(size_t count, const tT &value)
+    {
+        ResizeWith(count, [&value](tT * slot)
+        {
+            new(slot) tT(value);
+        });
+    }
+
+    void swap(SmallVector &other)
+    {
+        SmallVector temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    /// @}
+
+    bool operator==(const SmallVector &other) const
+    {
+        return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const SmallVector &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+
+    typename std::aligned_storage< sizeof(tT) * (N > 0 ? N : 1), alignof(tT) >::type mInline;
+
+    tT *mBegin;
+    size_t mSize;
+    size_t mCapacity;
+
+    tT *GetInline() noexcept
+    {
+        return reinterpret_cast< tT * >(&mInline);
+    }
+
+    const tT *GetInline() const noexcept
+    {
+        return reinterpret_cast< const tT * >(&mInline);
+    }
+
+    static tT *Allocate(size_t count)
+    {
+        return static_cast< tT * >(::operator new(count * sizeof(tT)));
+    }
+
+    void Deallocate() noexcept
+    {
+        if (!IsInline())
+        {
+            ::operator delete(mBegin);
+        }
+    }
+
+    static void Destroy(tT *first, tT *last) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            first->~tT();
+        }
+    }
+
+    // moves the elements to uninitialised memory and destroys the originals
+    static void Relocate(tT *first, tT *last, tT *destination) noexcept
+    {
+        for (; first != last; ++first, ++destination)
+        {
+            new(destination) tT(std::move(*first));
+            first->~tT();
+        }
+    }
+
+    void Grow(size_t capacity)
+    {
+        capacity = std::max< size_t >(capacity, 4);
+
+        tT *const memory = Allocate(capacity);
+
+        Relocate(mBegin, mBegin + mSize, memory);
+        Deallocate();
+
+        mBegin = memory;
+        mCapacity = capacity;
+    }
+
+    template< typename tConstruct >
+    void ResizeWith(size_t count, const tConstruct &construct)
+    {
+        if (count < mSize)
+        {
+            Destroy(mBegin + count, mBegin + mSize);
+        }
+        else
+        {
+            reserve(count);
+
+            for (size_t i = mSize; i < count; ++i)
+            {
+                construct(mBegin + i);
+            }
+        }
+
+        mSize = count;
+    }
+
+    // steals the allocation of a heap vector, or moves the elements of an inline one
+    void MoveFrom(SmallVector &other) noexcept
+    {
+        if (other.IsInline())
+        {
+            Relocate(other.mBegin, other.mBegin + other.mSize, mBegin);
+            mSize = other.mSize;
+        }
+        else
+        {
+            Deallocate();
+
+            mBegin = other.mBegin;
+            mSize = other.mSize;
+            mCapacity = other.mCapacity;
+
+            other.mBegin = other.GetInline();
+            other.mCapacity = N;
+        }
+
+        other.mSize = 0;
+    }
+};
+
+#endif
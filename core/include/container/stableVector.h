@@ -0,0 +1,540 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_STABLEVECTOR_H__
+#define __ENGINE_STABLEVECTOR_H__
+
+#include "memory/allocators/malloc.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A vector that stores its elements in fixed size chunks, so growing never moves an element and
+ * pointers and references stay valid until the element is removed. Indexing is a shift and a
+ * mask, and each chunk is contiguous, so ForEachChunk iterates as fast as a plain array.
+ *
+ * Chunks are kept when the vector shrinks, until shrink_to_fit is called.
+ *
+ * Iterators refer to the vector and an index, so like pointers they stay valid while the vector
+ * grows, and only the iterators past the new end are invalidated when it shrinks. Moving or
+ * swapping the vector does not carry the iterators along; they keep referring to the old vector.
+ *
+ * @tparam  tT          The element type.
+ * @tparam  tChunkSize  The amount of elements per chunk, should be a power of two.
+ */
+
+template< typename tT, size_t tChunkSize = 64 >
+class StableVector
+{
+    static_assert(tChunkSize > 0 && (tChunkSize & (tChunkSize - 1)) == 0, "The chunk size should be a power of two");
+
+public:
+
+    template< typename tValue >
+    class Iterator
+    {
+        typedef typename std::conditional< std::is_const< tValue >::value, const StableVector, StableVector >::type Vector;
+
+    public:
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef tValue value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef tValue *pointer;
+        typedef tValue &reference;
+
+        Iterator() noexcept
+            : mVector(nullptr),
+              mIndex(0)
+        {
+        }
+
+        Iterator(Vector *vector, size_t index) noexcept
+            : mVector(vector),
+              mIndex(index)
+        {
+        }
+
+        // allows converting an iterator to a const iterator
+        operator Iterator< const tValue >() const noexcept
+        {
+            return Iterator< const tValue >(mVector, mIndex);
+        }
+
+        tValue &operator*() const noexcept
+        {
+            // look the chunk up on every access, since the chunk table moves when the vector grows
+            return (*mVector)[mIndex];
+        }
+
+        tValue *operator->() const noexcept
+        {
+            return &**this;
+        }
+
+        tValue &operator[](difference_type offset) const noexcept
+        {
+            return *(*this + offset);
+        }
+
+        Iterator &operator++() noexcept
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator it(*this);
+            ++mIndex;
+            return it;
+        }
+
+        Iterator &operator--() noexcept
+        {
+            --mIndex;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept
+        {
+            Iterator it(*this);
+            --mIndex;
+            return it;
+        }
+
+        Iterator &operator+=(difference_type offset) noexcept
+        {
+            mIndex = static_cast< size_t >(static_cast< difference_type >(mIndex) + offset);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type offset) noexcept
+        {
+            return *this += -offset;
+        }
+
+        Iterator operator+(difference_type offset) const noexcept
+        {
+            Iterator it(*this);
+            return it += offset;
+        }
+
+        Iterator operator-(difference_type offset) const noexcept
+        {
+            Iterator it(*this);
+            return it -= offset;
+        }
+
+        difference_type operator-(const Iterator &other) const noexcept
+        {
+            return static_cast< difference_type >(mIndex) - static_cast< difference_type >(other.mIndex);
+        }
+
+        bool operator==(const Iterator &other) const noexcept
+        {
+            return mIndex == other.mIndex;
+        }
+
+        bool operator!=(const Iterator &other) const noexcept
+        {
+            return mIndex != other.mIndex;
+        }
+
+        bool operator<(const Iterator &other) const noexcept
+        {
+            return mIndex < other.mIndex;
+        }
+
+        bool operator>(const Iterator &other) const noexcept
+        {
+            return mIndex > other.mIndex;
+        }
+
+        bool operator<=(const Iterator &other) const noexcept
+        {
+            return mIndex <= other.mIndex;
+        }
+
+        bool operator>=(const Iterator &other) const noexcept
+        {
+            return mIndex >= other.mIndex;
+        }
+
+    private:
+
+        Vector *mVector;
+        size_t mIndex;
+    };
+
+    typedef tT value_type;
+    typedef size_t size_type;
+    typedef Iterator< tT > iterator;
+    typedef Iterator< const tT > const_iterator;
+
+    static const size_t ChunkSize = tChunkSize;
+
+    StableVector() noexcept
+        : mSize(0)
+    {
+    }
+
+    StableVector(std::initializer_list< tT > values)
+        : StableVector()
+    {
+        for (const tT &value : values)
+        {
+            push_back(value);
+        }
+    }
+
+    StableVector(const StableVector &other)
+        : StableVector()
+    {
+        reserve(other.mSize);
+
+        other.ForEachChunk([this](const tT * chunk, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                push_back(chunk[i]);
+            }
+        });
+    }
+
+    StableVector(StableVector &&other) noexcept
+        : mChunks(std::move(other.mChunks)),
+          mSize(other.mSize)
+    {
+        other.mChunks.clear();
+        other.mSize = 0;
+    }
+
+    ~StableVector()
+    {
+        clear();
+        FreeChunks(0);
+    }
+
+    StableVector &operator=(const StableVector &other)
+    {
+        if (this != &other)
+        {
+            StableVector copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    StableVector &operator=(StableVector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            FreeChunks(0);
+            swap(other);
+        }
+
+        return *this;
+    }
+
+    /// @name Element access
+    /// @{
+
+    tT &operator[](size_t index) noexcept
+    {
+        return mChunks[index / tChunkSize][index % tChunkSize];
+    }
+
+    const tT &operator[](size_t index) const noexcept
+    {
+        return mChunks[index / tChunkSize][index % tChunkSize];
+    }
+
+    tT &at(size_t index)
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("StableVector::at(): index out of range");
+        }
+
+        return (*this)[index];
+    }
+
+    const tT &at(size_t index) const
+    {
+        if (index >= mSize)
+        {
+            throw std::out_of_range("StableVector::at(): index out of range");
+        }
+
+        return (*this)[index];
+    }
+
+    tT &front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const tT &front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    tT &back() noexcept
+    {
+        return (*this)[mSize - 1];
+    }
+
+    const tT &back() const noexcept
+    {
+        return (*this)[mSize - 1];
+    }
+
+    /// @}
+
+    /// @name Iterators
+    /// @{
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, mSize);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, mSize);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /**
+     * Calls the function once per chunk with the contiguous elements it holds, which lets the
+     * compiler treat the loop over a chunk as a plain array loop.
+     *
+     * @param   function    The function, called as function(tT *elements, size_t count).
+     */
+
+    template< typename tFunction >
+    void ForEachChunk(const tFunction &function)
+    {
+        for (size_t i = 0, remaining = mSize; remaining > 0; ++i)
+        {
+            const size_t count = std::min(remaining, tChunkSize);
+            function(mChunks[i], count);
+            remaining -= count;
+        }
+    }
+
+    template< typename tFunction >
+    void ForEachChunk(const tFunction &function) const
+    {
+        for (size_t i = 0, remaining = mSize; remaining > 0; ++i)
+        {
+            const size_t count = std::min(remaining, tChunkSize);
+            function(static_cast< const tT * >(mChunks[i]), count);
+            remaining -= count;
+        }
+    }
+
+    /// @}
+
+    /// @name Capacity
+    /// @{
+
+    bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mChunks.size() * tChunkSize;
+    }
+
+    size_t GetChunkCount() const noexcept
+    {
+        return mChunks.size();
+    }
+
+    void reserve(size_t capacity)
+    {
+        const size_t chunkCount = (capacity + tChunkSize - 1) / tChunkSize;
+
+        if (chunkCount > mChunks.size())
+        {
+            mChunks.reserve(chunkCount);
+
+            while (mChunks.size() < chunkCount)
+            {
+                AddChunk();
+            }
+        }
+    }
+
+    /**
+     * Frees the chunks that hold no elements.
+     */
+
+    void shrink_to_fit()
+    {
+        FreeChunks((mSize + tChunkSize - 1) / tChunkSize);
+        mChunks.shrink_to_fit();
+    }
+
+    /// @}
+
+    /// @name Modifiers
+    /// @{
+
+    void clear() noexcept
+    {
+        while (mSize > 0)
+        {
+            pop_back();
+        }
+    }
+
+    void push_back(const tT &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(tT &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template< typename... tArgs >
+    tT &emplace_back(tArgs &&... args)
+    {
+        if (mSize == capacity())
+        {
+            AddChunk();
+        }
+
+        tT *const element = &(*this)[mSize];
+        new(element) tT(std::forward< tArgs >(args)...);
+        ++mSize;
+
+        return *element;
+    }
+
+    void pop_back() noexcept
+    {
+        (*this)[--mSize].~tT();
+    }
+
+    void resize(size_t count)
+    {
+        while (mSize > count)
+        {
+            pop_back();
+        }
+
+        reserve(count);
+
+        while (mSize < count)
+        {
+            emplace_back();
+        }
+    }
+
+    void swap(StableVector &other) noexcept
+    {
+        mChunks.swap(other.mChunks);
+        std::swap(mSize, other.mSize);
+    }
+
+    /// @}
+
+private:
+
+    std::vector< tT * > mChunks;
+    size_t mSize;
+
+    void AddChunk()
+    {
+        const size_t alignment = alignof(tT) > 16 ? alignof(tT) : 16;
+
+        // grow the chunk table first, so a failure there cannot leak the chunk
+        mChunks.push_back(nullptr);
+        mChunks.back() = static_cast< tT * >(ZefAlignedMalloc(sizeof(tT) * tChunkSize, alignment));
+
+        if (!mChunks.back())
+        {
+            mChunks.pop_back();
+            throw std::bad_alloc();
+        }
+    }
+
+    void FreeChunks(size_t keep) noexcept
+    {
+        while (mChunks.size() > keep)
+        {
+            ZefAlignedFree(mChunks.back());
+            mChunks.pop_back();
+        }
+    }
+};
+
+template< typename tT, size_t tChunkSize >
+const size_t StableVector< tT, tChunkSize >::ChunkSize;
+
+#endif
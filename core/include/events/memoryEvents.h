@@ -0,0 +1,69 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MEMORYEVENTS_H__
+#define __ENGINE_MEMORYEVENTS_H__
+
+#include "events/abstract/IEvent.h"
+
+#include "memory/tracking/memoryTag.h"
+
+#include <chrono>
+#include <vector>
+
+class MemoryStatsEvent
+    : public IEvent
+{
+public:
+
+    MemoryStatsEvent(std::chrono::time_point< std::chrono::high_resolution_clock > time,
+                     const std::vector< MemoryStats > &tags, const std::vector< MemoryStats > &namespaces);
+
+    std::chrono::time_point< std::chrono::high_resolution_clock > GetTime() const noexcept;
+
+    const std::vector< MemoryStats > &GetTags() const noexcept;
+
+    const std::vector< MemoryStats > &GetNamespaces() const noexcept;
+
+private:
+
+    std::vector< MemoryStats > mTags;
+    std::vector< MemoryStats > mNamespaces;
+    std::chrono::time_point< std::chrono::high_resolution_clock > mTime;
+};
+
+/**
+ * Asks the engine to give idle memory back, for example when the operating system reports that
+ * memory runs low. May be posted from any thread; the pools are trimmed at the next update.
+ */
+
+class MemoryPressureEvent
+    : public IEvent
+{
+};
+
+#endif
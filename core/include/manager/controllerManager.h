@@ -32,6 +32,8 @@
 
 #include "container/namespaceNamedStorage.h"
 
+#include "common/typeID.h"
+
 #include "api/console.h"
 
 #include <typeindex>
@@ -54,25 +56,26 @@ public:
     template< typename tT >
     tT *Add(Namespace ns = 0U)
     {
-        const std::type_index typeID = typeid(tT);
         tT *controller = new tT();
 
-        AddExt(typeID, controller, ns);
+        AddExt(TypeID::Get< tT >(), controller, ns);
 
         return controller;
     }
 
     void AddExt(std::type_index typeID, AbstractManager *mngr, Namespace ns = 0U);
 
+    void AddExt(TypeID typeID, AbstractManager *mngr, Namespace ns = 0U);
+
     template< typename tT>
     tT *Get()
     {
-        return static_cast< tT * >(mControllers.Get(typeid(tT)));
+        return static_cast< tT * >(mControllers.Get(TypeID::Get< tT >()));
     }
 
 private:
 
-    NamespaceNamedStorage< std::type_index, AbstractManager > mControllers;
+    NamespaceNamedStorage< TypeID, AbstractManager > mControllers;
     std::vector< AbstractManager * > mControllerCache;
 
 };
@@ -34,13 +34,14 @@
 
 #include "events/observer.h"
 
+#include "container/smallVector.h"
+
 #include "threading/spinlock.h"
 
-#include <unordered_map>
-#include <assert.h>
+#include "common/typeID.h"
+
 #include <vector>
 #include <mutex>
-#include <typeindex>
 
 /// @addtogroup Events
 /// @{
@@ -50,6 +51,9 @@ class EventManager
 {
 public:
 
+    /// The observers are copied for every post, few event types have more than a handful.
+    typedef SmallVector< AbstractObserver *, 8 > ObserverList;
+
     EventManager();
 
     void OnRelease() override;
@@ -58,7 +62,7 @@ public:
     const tT *Add(AbstractObserver *observer)
     {
         std::lock_guard< SpinLock > lock(mLock);
-        mOberservers[ GetClassID< tT >() ].push_back(observer);
+        GetObservers(GetClassID< tT >()).push_back(observer);
 
         return nullptr;
     }
@@ -68,7 +72,7 @@ public:
     {
         std::lock_guard< SpinLock > lock(mLock);
 
-        std::vector< AbstractObserver * > &observers = mOberservers[ GetClassID< tT >() ];
+        std::vector< AbstractObserver * > &observers = GetObservers(GetClassID< tT >());
 
         for (auto it = observers.begin(), end = observers.end(); it != end; ++it)
         {
@@ -90,9 +94,16 @@ public:
     template< typename tT >
     void Post(const tT &event)
     {
+        const U32 classID = GetClassID< tT >();
+
         mLock.lock();
 
-        std::vector< AbstractObserver * > observers = mOberservers[GetClassID< tT >()];
+        ObserverList observers;
+
+        if (classID < mOberservers.size())
+        {
+            observers.assign(mOberservers[ classID ].begin(), mOberservers[ classID ].end());
+        }
 
         mLock.unlock();
 
@@ -102,50 +113,34 @@ public:
         }
     }
 
+    /**
+     * Gets the class ID of an event type, which is its dense type identifier and never 0.
+     *
+     * @return  The class ID.
+     */
+
     template< typename tT >
     U32 GetClassID()
     {
-        return AssignClassID< tT >(*this);
+        return TypeID::Get< tT >().GetID();
     }
 
 private:
 
-    std::unordered_map< U32, std::vector< AbstractObserver * >> mOberservers;
-    std::unordered_map< std::type_index, U32 > mClassIDCache;
-
-    SpinLock mClassIDLock;
-    U32 mClassIDCounter;
+    /// The observers indexed by the class ID of their event type.
+    std::vector< std::vector< AbstractObserver * >> mOberservers;
 
     SpinLock mLock;
 
-    template< typename tT >
-    static U32 AssignClassID(EventManager &eventManager)
-    {
-        static U32 mClassId = CacheClassID< tT >(eventManager);
-
-        assert(mClassId > 0 && "A class ID of 0 is not allowed.");
-
-        return mClassId;
-    }
-
-    template< typename tT >
-    static U32 CacheClassID(EventManager &eventManager)
+    std::vector< AbstractObserver * > &GetObservers(U32 classID)
     {
-        const std::type_index typeIndex = std::type_index(typeid(tT));
-
-        std::lock_guard< SpinLock > lock(eventManager.mClassIDLock);
-
-        auto it = eventManager.mClassIDCache.find(typeIndex);
-
-        if (it == eventManager.mClassIDCache.end())
+        if (classID >= mOberservers.size())
         {
-            eventManager.mClassIDCache.insert(std::make_pair(typeIndex, ++eventManager.mClassIDCounter));
-            return eventManager.mClassIDCounter;
+            mOberservers.resize(classID + 1);
         }
 
-        return it->second;
+        return mOberservers[ classID ];
     }
-
 };
 
 template <class tC, class tN>
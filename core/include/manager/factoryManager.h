@@ -35,21 +35,30 @@
 
 #include "container/namespaceStorage.h"
 
-#include "api/console.h"
+#include "common/typeID.h"
 
-#include <typeindex>
+#include "api/console.h"
 
 class FactoryManager
     : public AbstractManager
 {
 public:
 
+    /**
+     * Batches the factory registrations until the post initialisation, so the registry is
+     * rebuilt once instead of once per factory.
+     */
+
+    virtual void OnPreInit() override;
+
+    virtual void OnPostInit() override;
+
     virtual void OnRelease() override;
 
     template< typename tT, typename tBase = tT >
     AbstractTInstantiator< tBase > *Add(Namespace ns = 0U)
     {
-        const std::type_index typeID = typeid(tT);
+        const TypeID typeID = TypeID::Get< tT >();
         AbstractInstantiator *instantiator = nullptr;
 
         if (!mFactories.Has(typeID, ns))
@@ -68,7 +77,7 @@ public:
     template< typename tT, typename tBase = tT>
     bool Add(AbstractTInstantiator< tBase > *instantiator, Namespace ns = 0u)
     {
-        const std::type_index typeID = typeid(tT);
+        const TypeID typeID = TypeID::Get< tT >();
 
         if (!mFactories.Has(typeID, ns))
         {
@@ -87,7 +96,7 @@ public:
     template< typename tT >
     void Clear(Namespace ns = 0u)
     {
-        mFactories.Remove(typeid(tT), ns);
+        mFactories.Remove(TypeID::Get< tT >(), ns);
     }
 
     void ClearAll(Namespace ns = 0u);
@@ -95,13 +104,13 @@ public:
     template< typename tT >
     bool Has(Namespace ns = 0u) const
     {
-        return mFactories.Has(typeid(tT), ns);
+        return mFactories.Has(TypeID::Get< tT >(), ns);
     }
 
     template< typename tT, typename tBase = tT >
     AbstractTInstantiator< tBase > *Get(Namespace ns = 0u) const
     {
-        return static_cast< AbstractTInstantiator< tBase > * >(mFactories.Get(typeid(tT), ns));
+        return static_cast< AbstractTInstantiator< tBase > * >(mFactories.Get(TypeID::Get< tT >(), ns));
     }
 
     template< typename tT, typename tBase = tT >
@@ -112,7 +121,7 @@ public:
 
 private:
 
-    NamespaceStorage< std::type_index, AbstractInstantiator > mFactories;
+    NamespaceStorage< TypeID, AbstractInstantiator > mFactories;
 };
 
 #endif
\ No newline at end of file
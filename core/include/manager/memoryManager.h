@@ -30,50 +30,135 @@
 
 #include "manager/abstract/abstractManager.h"
 
-#include "memory/allocators/blockAllocator.h"
+#include "memory/allocators/multiFrameArena.h"
+#include "memory/allocators/frameArena.h"
+#include "memory/tracking/memoryTracker.h"
 
 #include "threading/threadID.h"
 
 #include "config.h"
 
+#include <utility>
+
 class MemoryManager
     :  public AbstractManager
 {
 public:
 
+    /// Locations of temporary allocations, kept for the BlockAllocator based interface
+    typedef std::ptrdiff_t TempLocation;
+
     struct ThreadAllocators
     {
         ThreadAllocators();
 
         void Clear();
 
-        BlockAllocator blockAlloc;
+        FrameArena frameArena;
+
+        MultiFrameArena multiFrameArena;
     };
 
+    MemoryManager();
+
+    ~MemoryManager();
+
     virtual void OnUpdate() override;
 
+    /**
+     * Gets the arena of a thread, which is reset every frame.
+     *
+     * @param   tid The thread ID.
+     *
+     * @return  The frame arena.
+     */
+
+    FrameArena &GetFrameArena(ThreadID tid)
+    {
+        return mTempThreadAllocators[tid].frameArena;
+    }
+
+    /**
+     * Constructs an object that lives until the end of the frame.
+     *
+     * @param   tid     The thread ID.
+     * @param   args    The constructor arguments.
+     *
+     * @return  The object.
+     */
+
+    template< class T, typename... tArgs >
+    T *TempNew(ThreadID tid, tArgs &&... args)
+    {
+        return mTempThreadAllocators[tid].frameArena.New< T >(std::forward< tArgs >(args)...);
+    }
+
+    /**
+     * Gets the multi frame arena of a thread, its allocations stay valid for
+     * PROGRAM_FRAME_BUFFERS frames.
+     *
+     * @param   tid The thread ID.
+     *
+     * @return  The multi frame arena.
+     */
+
+    MultiFrameArena &GetMultiFrameArena(ThreadID tid)
+    {
+        return mTempThreadAllocators[tid].multiFrameArena;
+    }
+
+    /**
+     * Constructs an object that lives for PROGRAM_FRAME_BUFFERS frames, including the current
+     * one. Use this for data consumed by the next frame.
+     *
+     * @param   tid     The thread ID.
+     * @param   args    The constructor arguments.
+     *
+     * @return  The object.
+     */
+
+    template< class T, typename... tArgs >
+    T *MultiFrameNew(ThreadID tid, tArgs &&... args)
+    {
+        return mTempThreadAllocators[tid].multiFrameArena.New< T >(std::forward< tArgs >(args)...);
+    }
+
+    /// @name Location based interface
+    /// Temporary allocations used to be addressed by location. The locations are now plain
+    /// addresses in the frame arena, so new code should use TempNew instead.
+    /// @{
+
     template< class T >
-    BlockAllocator::BlockLocation TempAlloc(ThreadID tid)
+    TempLocation TempAlloc(ThreadID tid)
     {
-        return mTempThreadAllocators[tid].blockAlloc.Alloc< T >();
+        return reinterpret_cast< TempLocation >(mTempThreadAllocators[tid].frameArena.AllocateArray< T >(1));
     }
 
     template< class T >
-    BlockAllocator::BlockLocation TempMove(ThreadID tid, const T &item)
+    TempLocation TempMove(ThreadID tid, const T &item)
     {
-        return mTempThreadAllocators[tid].blockAlloc.Move< T >(item);
+        return reinterpret_cast< TempLocation >(TempNew< T >(tid, item));
     }
 
     template< class T >
-    T *ExtractTemp(ThreadID tid, BlockAllocator::BlockLocation loc)
+    T *ExtractTemp(ThreadID tid, TempLocation loc)
     {
-        return mTempThreadAllocators[tid].blockAlloc.Extract< T >(loc);
+        (void)tid;
+        return reinterpret_cast< T * >(loc);
     }
 
+    /// @}
 
 private:
 
-    ThreadAllocators mTempThreadAllocators[PROGRAM_MAX_THREADS];
+    // worker threads are numbered from 1 up to the thread count, the main thread is 0
+    ThreadAllocators mTempThreadAllocators[PROGRAM_MAX_THREADS + 1];
+
+#if PROGRAM_MEMORY_TRACKING
+    // the arenas are sampled once a frame, right before they are cleared
+    MemoryTag *mFrameArenaTag;
+    MemoryTag *mMultiFrameArenaTag;
+#endif
 };
 
-#endif
\ No newline at end of file
+#endif
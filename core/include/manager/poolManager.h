@@ -32,31 +32,77 @@
 
 #include "container/namespaceStorage.h"
 
+#include "common/typeID.h"
+
 #include "memory/pool/objectPool.h"
 
+#include "threading/abstract/IThreadExecutable.h"
+
+#include <atomic>
+
 class AbstractPool;
+class MemoryPressureEvent;
 
 class PoolManager
     : public AbstractManager
 {
 public:
 
+    PoolManager();
+
+    /**
+     * Batches the pool registrations until the post initialisation, so the registry is rebuilt
+     * once instead of once per pool.
+     */
+
+    virtual void OnPreInit() override;
+
+    virtual void OnInit() override;
+
+    virtual void OnPostInit() override;
+
     virtual void OnRelease() override;
 
     virtual void OnRelease(Namespace ns) override;
 
+    /**
+     * Adapts the capacity of every pool to its usage, and trims the pools when memory pressure
+     * was reported since the previous update.
+     */
+
+    virtual void OnUpdate() override;
+
+    /**
+     * Destroys the idle objects of every pool above their minimum capacity, to give memory
+     * back under memory pressure. The thread magazines are drained as well, so no thread may
+     * use the pools meanwhile; prefer posting a MemoryPressureEvent.
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    size_t Trim();
+
+    /**
+     * Requests a trim at the next update, when the worker threads do not use the pools.
+     *
+     * @threadsafe
+     */
+
+    void OnMemoryPressure(const MemoryPressureEvent &event);
+
     template< typename tT >
     void Remove(const Namespace ns = 0u)
     {
-        mPools.Remove(typeid(tT), ns);
+        mPools.Remove(TypeID::Get< tT >(), ns);
     }
 
     void ClearAll(const Namespace ns);
 
     template< typename tT, typename tBase = tT >
-    AbstractObjectPool< tBase > *AddFromFactory(const Namespace ns = 0U, size_t capacity = 500)
+    AbstractObjectPool< tBase > *AddFromFactory(const Namespace ns = 0U, size_t capacity = 500,
+                                               size_t magazineSize = 0)
     {
-        const std::type_index typeID = typeid(tT);
+        const TypeID typeID = TypeID::Get< tT >();
         ObjectPool< tT, tBase, AbstractPoolableInstantiator<tBase>> *pool = nullptr;
 
         if (!mPools.Has(typeID, ns))
@@ -64,8 +110,12 @@ public:
             AbstractPoolableInstantiator<tBase> *inst = static_cast< AbstractPoolableInstantiator<tBase> *>
                                                         (GetManagers()->factory->Get< tT >()->Copy());
 
-            pool = new ObjectPool< tT, tBase, AbstractPoolableInstantiator<tBase>>(inst, capacity);
+            pool = new ObjectPool< tT, tBase, AbstractPoolableInstantiator<tBase>>(inst, capacity, magazineSize);
             mPools.Add(pool, typeID, ns);
+
+#if PROGRAM_MEMORY_TRACKING
+            pool->GetMemoryTag()->SetNamespace(ns);
+#endif
         }
         else
         {
@@ -76,15 +126,19 @@ public:
     }
 
     template< typename tT, typename tBase = tT, typename tInstantiator = PoolableInstantiator< tT, tBase >>
-    AbstractObjectPool< tBase > *Add(const Namespace ns = 0U, size_t capacity = 500)
+    AbstractObjectPool< tBase > *Add(const Namespace ns = 0U, size_t capacity = 500, size_t magazineSize = 0)
     {
-        const std::type_index typeID = typeid(tT);
+        const TypeID typeID = TypeID::Get< tT >();
         ObjectPool< tT, tBase, tInstantiator > *pool = nullptr;
 
         if (!mPools.Has(typeID, ns))
         {
-            pool = new ObjectPool< tT, tBase, tInstantiator >(capacity);
+            pool = new ObjectPool< tT, tBase, tInstantiator >(capacity, magazineSize);
             mPools.Add(pool, typeID, ns);
+
+#if PROGRAM_MEMORY_TRACKING
+            pool->GetMemoryTag()->SetNamespace(ns);
+#endif
         }
         else
         {
@@ -97,7 +151,52 @@ public:
     template< typename tT, typename tBase = tT >
     AbstractObjectPool< tBase > *Get(const Namespace ns = 0u) const
     {
-        return static_cast< AbstractObjectPool< tBase > * >(mPools.Get(typeid(tT), ns));
+        return static_cast< AbstractObjectPool< tBase > * >(mPools.Get(TypeID::Get< tT >(), ns));
+    }
+
+    /**
+     * Pre-warms a pool, so the first frames do not have to create its objects.
+     *
+     * @param   count   The amount of idle objects.
+     * @param   ns      (optional) The namespace.
+     * @param   faultIn (optional) Writes every page of the created objects, so their memory
+     *                  is backed before it is used.
+     *
+     * @return  The amount of created objects.
+     */
+
+    template< typename tT, typename tBase = tT >
+    size_t Reserve(size_t count, const Namespace ns = 0U, bool faultIn = false) const
+    {
+        AbstractObjectPool< tBase > *pool = Get< tT, tBase >(ns);
+
+        return pool ? pool->Reserve(count, faultIn) : 0;
+    }
+
+    /**
+     * Pre-warms a pool on the loader thread, so initialisation does not wait for it. The pool
+     * should not be removed before the loader thread has run.
+     *
+     * @param   count   The amount of idle objects.
+     * @param   ns      (optional) The namespace.
+     * @param   faultIn (optional) Writes every page of the created objects, so their memory
+     *                  is backed before it is used.
+     */
+
+    template< typename tT, typename tBase = tT >
+    void ReserveOnLoader(size_t count, const Namespace ns = 0U, bool faultIn = false)
+    {
+        AbstractObjectPool< tBase > *pool = Get< tT, tBase >(ns);
+
+        if (pool)
+        {
+            GetManagers()->schedule->RegisterJob(new ReserveJob< tBase >(pool, count, faultIn),
+                                                 IThreadExecutable::Type::Loader);
+        }
+        else
+        {
+            Console::Errorf(LOG("Pool not registered."));
+        }
     }
 
     bool HasPools(const Namespace ns) const;
@@ -105,13 +204,49 @@ public:
     template< typename tT >
     bool Has(const Namespace ns = 0u) const
     {
-        return mPools.Has(typeid(tT), ns);
+        return mPools.Has(TypeID::Get< tT >(), ns);
     }
 
 
 private:
 
-    NamespaceStorage< std::type_index, AbstractPool > mPools;
+    /**
+     * Reserves objects in a pool once, and deletes itself when it is done.
+     */
+
+    template< typename tBase >
+    class ReserveJob
+        : public IThreadExecutable
+    {
+    public:
+
+        ReserveJob(AbstractObjectPool< tBase > *pool, size_t count, bool faultIn) noexcept
+            : mPool(pool),
+              mCount(count),
+              mFaultIn(faultIn)
+        {
+        }
+
+        void OnRunJob() override
+        {
+            mPool->Reserve(mCount, mFaultIn);
+        }
+
+        void OnJobFinished() override
+        {
+            delete this;
+        }
+
+    private:
+
+        AbstractObjectPool< tBase > *mPool;
+        size_t mCount;
+        bool mFaultIn;
+    };
+
+    NamespaceStorage< TypeID, AbstractPool > mPools;
+
+    std::atomic< bool > mTrimRequested;
 };
 
 #endif
\ No newline at end of file
@@ -30,6 +30,8 @@
 
 #include "manager/abstract/abstractManager.h"
 
+#include "common/atom.h"
+
 #include <unordered_map>
 #include <chrono>
 #include <string>
@@ -52,15 +54,15 @@ public:
 
     /// @}
 
-    void Start(const std::string &name);
+    void Start(Atom name);
 
-    void Waypoint(const std::string &name, const std::string &comment);
+    void Waypoint(Atom name, const std::string &comment);
 
-    void End(const std::string &name);
+    void End(Atom name);
 
 private:
 
-    std::unordered_map< std::string, std::chrono::time_point< std::chrono::high_resolution_clock >> mTimings;
+    std::unordered_map< Atom, std::chrono::time_point< std::chrono::high_resolution_clock >> mTimings;
     std::chrono::time_point< std::chrono::high_resolution_clock > mLastUpdate;
     std::mutex mMutex;
 
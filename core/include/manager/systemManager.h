@@ -32,6 +32,9 @@
 
 #include "common/util.h"
 
+class TypeRegistry;
+class AtomStorage;
+
 /// @addtogroup Managers
 /// @{
 
@@ -103,6 +106,23 @@ public:
 
     static SystemManager *Get(SystemManager *systemManager = nullptr);
 
+    /**
+     * Gets the type registry of the host. Plugins link their own copy of the core library, so
+     * they must use this registry instead of their own to agree on type identifiers.
+     *
+     * @return  The type registry.
+     */
+
+    TypeRegistry *GetTypeRegistry() const;
+
+    /**
+     * Gets the atom storage of the host, for the same reason as the type registry.
+     *
+     * @return  The atom storage.
+     */
+
+    AtomStorage *GetAtomStorage() const;
+
     /// @}
 
     const S32 &GetArgc() const;
@@ -191,6 +211,10 @@ protected:
 
     S32 mArgc;
     const char **mArgv;
+
+    // owned by the module that created this manager, and outlive it
+    TypeRegistry *mTypeRegistry;
+    AtomStorage *mAtomStorage;
 };
 
 /// @}
@@ -71,6 +71,21 @@ public:
         return Get();
     }
 
+    /**
+     * Gets a batch of objects from the object pool.
+     *
+     * @param   count           The amount of objects.
+     * @param [out] objects     The objects, should have room for count objects.
+     */
+
+    virtual void GetBatch(size_t count, tBase **objects)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects[i] = Get();
+        }
+    }
+
     /// @}
 
     /// @name Return Objects
@@ -85,6 +100,45 @@ public:
 
     virtual void Dispose(tBase *object) = 0;
 
+    /**
+     * Returns a batch of objects to the pool.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void DisposeBatch(tBase *const *objects, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Dispose(objects[i]);
+        }
+    }
+
+    /// @}
+
+    /// @name Capacity
+    /// @{
+
+    /**
+     * Makes sure the pool holds at least the given amount of idle objects, so the first
+     * requests after startup do not have to create them.
+     *
+     * @param   count   The amount of idle objects.
+     * @param   faultIn (optional) Writes every page of the created objects, so their memory
+     *                  is backed before it is used.
+     *
+     * @return  The amount of created objects.
+     */
+
+    virtual size_t Reserve(size_t count, bool faultIn = false)
+    {
+        (void)count;
+        (void)faultIn;
+
+        return 0;
+    }
+
     /// @}
 
     /// @name Verification
@@ -28,6 +28,8 @@
 #ifndef __ENGINE_ABSTRACTPOOL_H__
 #define __ENGINE_ABSTRACTPOOL_H__
 
+#include <stddef.h>
+
 /// @addtogroup Pools
 /// @{
 
@@ -40,6 +42,21 @@ class AbstractPool
 public:
 
     virtual ~AbstractPool();
+
+    /**
+     * Destroys the idle objects above the minimum capacity of the pool, to give memory back
+     * under memory pressure.
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    virtual size_t Trim();
+
+    /**
+     * Adapts the capacity of the pool to its recent usage. Called once a frame.
+     */
+
+    virtual void Adapt();
 };
 
 /// @}
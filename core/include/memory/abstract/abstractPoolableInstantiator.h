@@ -30,6 +30,8 @@
 
 #include "memory/abstract/abstractTInstantiator.h"
 
+#include <stddef.h>
+
 /// @addtogroup Instantiators
 /// @{
 
@@ -74,6 +76,21 @@ public:
 
     virtual void Initialise(tBase *const object) = 0;
 
+    /**
+     * Initialises a batch of objects.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void InitialiseBatch(tBase *const *objects, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Initialise(objects[i]);
+        }
+    }
+
     /// @}
 
     /// @name Releasing
@@ -87,6 +104,21 @@ public:
 
     virtual void Release(tBase *const object) = 0;
 
+    /**
+     * Releases a batch of objects.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void ReleaseBatch(tBase *const *objects, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Release(objects[i]);
+        }
+    }
+
     /// @}
 
 };
@@ -28,23 +28,43 @@
 #ifndef __ENGINE_ALIGNEDALLOCATOR_H__
 #define __ENGINE_ALIGNEDALLOCATOR_H__
 
+#include "memory/allocators/hugePageArena.h"
 #include "memory/allocators/malloc.h"
 
 #include "common/types.h"
 
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/**
+ * An allocator that aligns every allocation to N bytes. When an arena is given, memory is taken
+ * from the arena first and falls back to the heap once the arena is exhausted.
+ *
+ * The arena only gives its memory back when it is reset, so every regrowth of a container that
+ * uses it leaves the old buffer behind in the arena. Containers that grow should reserve their
+ * final size up front, or move to a heap allocator before they grow again.
+ */
+
 template< class T, U32 N >
 class AlignedAllocator
 {
 public:
 
     AlignedAllocator() throw()
+        : mArena(nullptr)
     {}
-    AlignedAllocator(const AlignedAllocator &) throw()
+    explicit AlignedAllocator(HugePageArena *arena) throw()
+        : mArena(arena)
+    {}
+    AlignedAllocator(const AlignedAllocator &other) throw()
+        : mArena(other.mArena)
     {}
     ~AlignedAllocator() throw()
     {}
     template <class U>
-    inline AlignedAllocator(const AlignedAllocator<U, N> &) throw()
+    inline AlignedAllocator(const AlignedAllocator<U, N> &other) throw()
+        : mArena(other.GetArena())
     {}
 
     typedef T value_type;
@@ -54,6 +74,9 @@ public:
     typedef const T *const_pointer;
     typedef size_t size_type;
 
+    // lets a container move a heap buffer in, instead of copying it into the arena
+    typedef std::true_type propagate_on_container_move_assignment;
+
     template < class Y >
     struct rebind
     {
@@ -74,7 +97,12 @@ public:
     {
         (void) t;
 
-        pointer address = static_cast< pointer >(ZefAlignedMalloc(sizeof(T) * n, N));
+        pointer address = mArena ? static_cast< pointer >(mArena->Allocate(sizeof(T) * n, N)) : nullptr;
+
+        if (address == nullptr)
+        {
+            address = static_cast< pointer >(ZefAlignedMalloc(sizeof(T) * n, N));
+        }
 
         if (address == nullptr)
         {
@@ -86,7 +114,11 @@ public:
 
     inline void deallocate(pointer ptr, size_type)
     {
-        ZefAlignedFree(ptr);
+        // arena memory is given back with the arena
+        if (!mArena || !mArena->Owns(ptr))
+        {
+            ZefAlignedFree(ptr);
+        }
     }
 
     inline void construct(pointer p, const_reference val)
@@ -103,16 +135,21 @@ public:
     {
         return ~size_type(0) / sizeof(T);
     }
+
+    inline HugePageArena *GetArena() const
+    {
+        return mArena;
+    }
+
+private:
+
+    HugePageArena *mArena;
 };
 
 template< class T1, U32 N1, class T2, U32 N2 >
 bool operator==(const AlignedAllocator<T1, N1> &lhs, const AlignedAllocator<T2, N2> &rhs)
 {
-    // prevent warning
-    (void) lhs;
-    (void) rhs;
-
-    return N1 == N2;
+    return N1 == N2 && lhs.GetArena() == rhs.GetArena();
 }
 
 template< class T1, U32 N1, class T2, U32 N2 >
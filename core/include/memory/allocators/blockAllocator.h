@@ -30,9 +30,12 @@
 
 #include "memory/allocators/stackAllocator.h"
 
+#include "container/stableVector.h"
+
 #include "common/utilClasses.h"
 
 //Allocate the stack in blocks to ensure that we never have to resize ( invalidate ptr's ) when allocating
+//@deprecated Use FrameArena, which hands out aligned typed pointers directly
 class BlockAllocator
     : public NonAssignable< BlockAllocator >
 {
@@ -40,7 +43,7 @@ public:
 
     typedef std::ptrdiff_t BlockLocation;
 
-    explicit BlockAllocator(size_t blockSize);
+    explicit BlockAllocator(size_t blockSize, HugePageArena *arena = nullptr);
 
     template< class tT >
     BlockLocation Move(const tT &item)
@@ -94,12 +97,15 @@ public:
 
 private:
 
-    std::vector< StackAllocator > mBlocks;
+    /// Growing never moves the existing blocks
+    StableVector< StackAllocator, 16 > mBlocks;
 
     const size_t mBlockSize;
 
     size_t mBlockPosition;
 
+    HugePageArena *mArena;
+
     void BlockAdvance(size_t bytes);
 
     BlockLocation GenerateBlockLocation(StackAllocator::StackLocation stackLoc) const;
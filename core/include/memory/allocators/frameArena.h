@@ -0,0 +1,243 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_FRAMEARENA_H__
+#define __ENGINE_FRAMEARENA_H__
+
+#include "memory/allocators/hugePageArena.h"
+
+#include "common/utilClasses.h"
+#include "common/types.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <new>
+
+/**
+ * A linear arena for short lived allocations, typically everything that lives for a frame.
+ *
+ * Allocations return properly aligned typed pointers directly. Memory comes in chunks that
+ * never move, so pointers stay valid until the arena is reset. Objects that are not trivially
+ * destructible get their destructor registered, and those run on reset in reverse order of
+ * construction. Resetting keeps the chunks, so it costs nothing beyond the registered
+ * destructors.
+ *
+ * Supersedes StackAllocator and BlockAllocator.
+ */
+
+class FrameArena
+    : public NonCopyable< FrameArena >
+{
+public:
+
+    /**
+     * Constructs the arena, the first chunk is allocated on first use.
+     *
+     * @param   chunkSize       (optional) The size of a chunk in bytes.
+     * @param [in,out]  arena   (optional) The arena the chunks are taken from.
+     */
+
+    explicit FrameArena(size_t chunkSize = 64 * 1024, HugePageArena *arena = nullptr);
+
+    ~FrameArena();
+
+    /**
+     * Takes uninitialised memory from the arena.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment, should be a power of two.
+     *
+     * @return  The memory.
+     *
+     * @exception   std::bad_alloc  Thrown when no chunk can be allocated.
+     */
+
+    void *Allocate(size_t bytes, size_t alignment)
+    {
+        // the cursor is null until the first chunk is allocated
+        U8 *const ptr = mCursor ? Fit(mCursor, mEnd, bytes, alignment) : nullptr;
+
+        if (!ptr)
+        {
+            return AllocateSlow(bytes, alignment);
+        }
+
+        mCursor = ptr + bytes;
+        return ptr;
+    }
+
+    /**
+     * Takes uninitialised memory for an array of objects from the arena.
+     *
+     * @tparam  tT  The object type.
+     * @param   count   The amount of objects.
+     *
+     * @return  The array.
+     */
+
+    template< typename tT >
+    tT *AllocateArray(size_t count)
+    {
+        return static_cast< tT * >(Allocate(sizeof(tT) * count, alignof(tT)));
+    }
+
+    /**
+     * Constructs an object in the arena. When the object is not trivially destructible, its
+     * destructor is called on reset.
+     *
+     * @tparam  tT      The object type.
+     * @tparam  tArgs   The constructor argument types.
+     * @param   args    The constructor arguments.
+     *
+     * @return  The object.
+     */
+
+    template< typename tT, typename... tArgs >
+    tT *New(tArgs &&... args)
+    {
+        return New< tT >(!std::is_trivially_destructible< tT >::value, std::forward< tArgs >(args)...);
+    }
+
+    /**
+     * Constructs an object in the arena, without registering its destructor.
+     *
+     * @tparam  tT      The object type.
+     * @tparam  tArgs   The constructor argument types.
+     * @param   args    The constructor arguments.
+     *
+     * @return  The object.
+     */
+
+    template< typename tT, typename... tArgs >
+    tT *NewUntracked(tArgs &&... args)
+    {
+        return New< tT >(false, std::forward< tArgs >(args)...);
+    }
+
+    /**
+     * Runs the registered destructors and makes all memory available again.
+     */
+
+    void Reset();
+
+    size_t GetUsed() const;
+
+    size_t GetCapacity() const;
+
+    size_t GetChunkSize() const;
+
+private:
+
+    struct Chunk
+    {
+        U8 *begin;
+        U8 *end;
+        bool owned;
+    };
+
+    struct Destructor
+    {
+        void (*destroy)(void *);
+        void *object;
+        Destructor *next;
+    };
+
+    std::vector< Chunk > mChunks;
+
+    Destructor *mDestructors;
+
+    U8 *mCursor;
+    U8 *mEnd;
+
+    size_t mChunkIndex;
+
+    // the bytes in the chunks before the current one
+    size_t mUsedBefore;
+
+    const size_t mChunkSize;
+
+    HugePageArena *mArena;
+
+    template< typename tT, typename... tArgs >
+    tT *New(bool track, tArgs &&... args)
+    {
+        Destructor *destructor = nullptr;
+
+        if (track)
+        {
+            destructor = static_cast< Destructor * >(Allocate(sizeof(Destructor), alignof(Destructor)));
+        }
+
+        tT *const object = new(Allocate(sizeof(tT), alignof(tT))) tT(std::forward< tArgs >(args)...);
+
+        if (destructor)
+        {
+            destructor->destroy = &Destroy< tT >;
+            destructor->object = object;
+            destructor->next = mDestructors;
+            mDestructors = destructor;
+        }
+
+        return object;
+    }
+
+    template< typename tT >
+    static void Destroy(void *object)
+    {
+        static_cast< tT * >(object)->~tT();
+    }
+
+    /**
+     * Finds the place of an allocation in a range. Only sizes are compared, so no pointer is
+     * formed beyond the end of the range.
+     *
+     * @param   begin       The start of the free range.
+     * @param   end         The end of the free range.
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment, should be a power of two.
+     *
+     * @return  The aligned allocation, or nullptr when it does not fit.
+     */
+
+    static U8 *Fit(U8 *begin, U8 *end, size_t bytes, size_t alignment)
+    {
+        const size_t padding = (0 - reinterpret_cast< size_t >(begin)) & (alignment - 1);
+        const size_t available = static_cast< size_t >(end - begin);
+
+        if (padding > available || bytes > available - padding)
+        {
+            return nullptr;
+        }
+
+        return begin + padding;
+    }
+
+    void *AllocateSlow(size_t bytes, size_t alignment);
+};
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_HUGEPAGEARENA_H__
+#define __ENGINE_HUGEPAGEARENA_H__
+
+#include "threading/spinlock.h"
+
+#include "common/utilClasses.h"
+
+#include <stddef.h>
+
+/**
+ * A linear arena on a single reservation of virtual memory that prefers to be backed by huge
+ * pages, so large working sets fault in far fewer pages and need far fewer TLB entries.
+ *
+ * Explicit huge pages are taken from the system huge page pool and are faulted in at once.
+ * When that pool is too small we fall back to transparent huge pages, which the kernel
+ * assembles on fault, and finally to normal pages.
+ *
+ * Memory is only given back when the arena is reset or destroyed.
+ *
+ * @threadsafe
+ */
+
+class HugePageArena
+    : public NonCopyable< HugePageArena >
+{
+public:
+
+    enum class PageMode
+    {
+        Normal,
+        Transparent,
+        Explicit
+    };
+
+    /**
+     * Reserves the address space of the arena.
+     *
+     * @param   capacity    The amount of bytes in the arena, rounded up to the huge page size.
+     * @param   mode        (optional) The preferred page mode.
+     */
+
+    explicit HugePageArena(size_t capacity, PageMode mode = PageMode::Transparent);
+
+    ~HugePageArena();
+
+    /**
+     * Takes memory from the arena.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment, should be a power of two.
+     *
+     * @return  The memory, or nullptr when the arena is exhausted.
+     */
+
+    void *Allocate(size_t bytes, size_t alignment);
+
+    /**
+     * Makes all memory in the arena available again.
+     *
+     * @warning No memory taken from the arena may be used afterwards.
+     */
+
+    void Reset();
+
+    /**
+     * Queries whether the memory lies in this arena.
+     *
+     * @param   ptr The memory.
+     *
+     * @return  true when the arena owns the memory.
+     */
+
+    bool Owns(const void *ptr) const;
+
+    /**
+     * Gets the page mode we actually got from the system.
+     *
+     * @return  The page mode.
+     */
+
+    PageMode GetPageMode() const;
+
+    size_t GetCapacity() const;
+
+    size_t GetUsed() const;
+
+    static size_t GetHugePageSize();
+
+private:
+
+    mutable SpinLock mLock;
+
+    void *mMapping;
+    size_t mMappingSize;
+
+    char *mBegin;
+    char *mCursor;
+    char *mEnd;
+
+    PageMode mPageMode;
+
+    void Map(size_t capacity, PageMode mode);
+};
+
+#endif
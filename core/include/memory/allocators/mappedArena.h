@@ -0,0 +1,207 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MAPPEDARENA_H__
+#define __ENGINE_MAPPEDARENA_H__
+
+#include "threading/spinlock.h"
+
+#include "preproc/os.h"
+
+#include "common/utilClasses.h"
+#include "common/types.h"
+
+#include <stddef.h>
+#include <string>
+#include <new>
+#include <utility>
+
+/**
+ * A linear arena backed by a memory mapped file, so data built in it survives a restart and can
+ * be used again without parsing. Since the file is mapped at a different address on every run,
+ * the data may only refer to itself with an OffsetPtr, and containers such as PersistentVector
+ * and PersistentHashMap.
+ *
+ * The file starts with a header holding the format, the layout version chosen by the caller,
+ * the pointer size and the byte order. When any of them differs from the running program, or
+ * the data was never committed, the file is emptied and the caller has to rebuild the data.
+ *
+ * A typical startup:
+ *
+ * @code
+ * MappedArena arena;
+ *
+ * if (arena.Open(path, capacity, layoutVersion) != MappedArena::OpenResult::Opened)
+ * {
+ *     arena.SetRoot(BuildTable(arena));
+ *     arena.Commit();
+ * }
+ *
+ * const Table *table = arena.GetRoot< Table >();
+ * @endcode
+ *
+ * Memory is only given back when the file is rebuilt.
+ *
+ * @threadsafe
+ */
+
+class MappedArena
+    : public NonCopyable< MappedArena >
+{
+public:
+
+    enum class OpenResult
+    {
+        /// The file could not be opened or mapped.
+        Failed,
+        /// There was no file, it has been created empty.
+        Created,
+        /// The file did not match this program or was never committed, it has been emptied.
+        Rebuilt,
+        /// The data of a previous run is available.
+        Opened
+    };
+
+    /// The version of the header, changes whenever the header layout changes.
+    static const U32 FormatVersion;
+
+    MappedArena();
+
+    ~MappedArena();
+
+    /**
+     * Opens and maps the file, verifying the data it holds.
+     *
+     * @param   path            The file path.
+     * @param   capacity        The amount of bytes available for allocations, used when the file
+     *                          has to be (re)created.
+     * @param   layoutVersion   The version of the stored data, changing it invalidates all files
+     *                          written by older versions of the program.
+     *
+     * @return  What we found in the file.
+     */
+
+    OpenResult Open(const std::string &path, size_t capacity, U32 layoutVersion);
+
+    /**
+     * Unmaps and closes the file, without committing.
+     */
+
+    void Close();
+
+    /**
+     * Takes memory from the arena, and marks the data as not committed.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment, should be a power of two.
+     *
+     * @return  The memory, or nullptr when the arena is exhausted.
+     */
+
+    void *Allocate(size_t bytes, size_t alignment);
+
+    /**
+     * Constructs an object in the arena. Its destructor is never called.
+     *
+     * @return  The object, or nullptr when the arena is exhausted.
+     */
+
+    template< typename tT, typename... tArgs >
+    tT *New(tArgs &&... args)
+    {
+        void *const memory = Allocate(sizeof(tT), alignof(tT));
+        return memory ? new(memory) tT(std::forward< tArgs >(args)...) : nullptr;
+    }
+
+    /**
+     * Sets the object from which all other data can be found after the next open, and marks the
+     * data as not committed.
+     *
+     * @param   root    The object, should lie in the arena.
+     */
+
+    void SetRoot(void *root);
+
+    template< typename tT >
+    tT *GetRoot() const
+    {
+        return static_cast< tT * >(GetRootPointer());
+    }
+
+    /**
+     * Writes the data to the file and marks it as valid, so the next open can use it. Data that
+     * is changed afterwards should be committed again.
+     *
+     * @return  true if it succeeds, false if it fails.
+     */
+
+    bool Commit();
+
+    bool IsOpen() const;
+
+    bool IsCommitted() const;
+
+    bool Owns(const void *ptr) const;
+
+    size_t GetCapacity() const;
+
+    size_t GetUsed() const;
+
+private:
+
+    struct Header;
+
+    mutable SpinLock mLock;
+
+    Header *mHeader;
+    char *mBegin;
+
+    size_t mMappingSize;
+
+#if OS_IS_WINDOWS
+    void *mFile;
+    void *mFileMapping;
+#else
+    int mFile;
+#endif
+
+    void *GetRootPointer() const;
+
+    bool Map(size_t size);
+
+    void Unmap();
+
+    void CloseFile();
+
+    bool Resize(size_t size);
+
+    void Initialise(size_t size, U32 layoutVersion);
+
+    bool Flush(void *address, size_t size);
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MULTIFRAMEARENA_H__
+#define __ENGINE_MULTIFRAMEARENA_H__
+
+#include "memory/allocators/frameArena.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * A ring of frame arenas, so allocations stay valid for a number of frames instead of one.
+ *
+ * Every call to NextFrame moves on to the next arena and resets it, recycling everything that
+ * was allocated in it as many frames ago as there are arenas. With two arenas the results of
+ * a frame can still be consumed during the next frame.
+ *
+ * @note    Not synchronised, use one instance per thread.
+ */
+
+class MultiFrameArena
+    : public NonCopyable< MultiFrameArena >
+{
+public:
+
+    /**
+     * Constructs the arenas.
+     *
+     * @param   frames          (optional) The amount of frames an allocation stays valid, at least one.
+     * @param   chunkSize       (optional) The size of a chunk in bytes.
+     * @param [in,out]  arena   (optional) The arena the chunks are taken from.
+     */
+
+    explicit MultiFrameArena(U32 frames = 2, size_t chunkSize = 64 * 1024, HugePageArena *arena = nullptr);
+
+    void *Allocate(size_t bytes, size_t alignment)
+    {
+        return mCurrent->Allocate(bytes, alignment);
+    }
+
+    template< typename tT >
+    tT *AllocateArray(size_t count)
+    {
+        return mCurrent->AllocateArray< tT >(count);
+    }
+
+    template< typename tT, typename... tArgs >
+    tT *New(tArgs &&... args)
+    {
+        return mCurrent->New< tT >(std::forward< tArgs >(args)...);
+    }
+
+    /**
+     * Moves on to the next frame, and recycles the memory of the oldest frame.
+     */
+
+    void NextFrame();
+
+    /**
+     * Recycles the memory of all frames.
+     */
+
+    void Reset();
+
+    FrameArena &GetCurrent();
+
+    U32 GetFrameCount() const;
+
+    size_t GetUsed() const;
+
+private:
+
+    std::vector< std::unique_ptr< FrameArena > > mArenas;
+
+    FrameArena *mCurrent;
+
+    U32 mIndex;
+};
+
+#endif
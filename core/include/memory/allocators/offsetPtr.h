@@ -0,0 +1,129 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_OFFSETPTR_H__
+#define __ENGINE_OFFSETPTR_H__
+
+#include "common/types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A pointer that stores the distance from itself to its target instead of an address. As long
+ * as the pointer and its target move together, for example because they both live in a file
+ * that is mapped at a different address on every run, the pointer stays valid.
+ *
+ * Copying recomputes the distance, so an OffsetPtr may not be copied with memcpy.
+ *
+ * @tparam  tT  The pointed to type.
+ */
+
+template< typename tT >
+class OffsetPtr
+{
+public:
+
+    OffsetPtr() noexcept
+        : mOffset(0)
+    {
+    }
+
+    OffsetPtr(tT *ptr) noexcept
+    {
+        Set(ptr);
+    }
+
+    OffsetPtr(const OffsetPtr &other) noexcept
+    {
+        Set(other.Get());
+    }
+
+    OffsetPtr &operator=(const OffsetPtr &other) noexcept
+    {
+        Set(other.Get());
+        return *this;
+    }
+
+    OffsetPtr &operator=(tT *ptr) noexcept
+    {
+        Set(ptr);
+        return *this;
+    }
+
+    tT *Get() const noexcept
+    {
+        // an offset of zero would point at ourselves, which we use as null
+        if (mOffset == 0)
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast< tT * >(reinterpret_cast< intptr_t >(this) + static_cast< intptr_t >(mOffset));
+    }
+
+    tT &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    tT *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    tT &operator[](size_t index) const noexcept
+    {
+        return Get()[index];
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return mOffset != 0;
+    }
+
+    bool operator==(const OffsetPtr &other) const noexcept
+    {
+        return Get() == other.Get();
+    }
+
+    bool operator!=(const OffsetPtr &other) const noexcept
+    {
+        return Get() != other.Get();
+    }
+
+private:
+
+    S64 mOffset;
+
+    void Set(tT *ptr) noexcept
+    {
+        mOffset = ptr ? static_cast< S64 >(reinterpret_cast< intptr_t >(ptr) - reinterpret_cast< intptr_t >(this)) : 0;
+    }
+};
+
+#endif
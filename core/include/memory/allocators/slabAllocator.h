@@ -0,0 +1,127 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SLABALLOCATOR_H__
+#define __ENGINE_SLABALLOCATOR_H__
+
+#include <stddef.h>
+
+/**
+ * A general purpose allocator that serves small allocations from size classes.
+ *
+ * Every size class carves its objects from slabs, which are taken from large chunks of
+ * virtual memory. Each thread keeps a cache of free objects per size class, so most
+ * allocations and frees do not synchronise at all. Objects freed on another thread simply
+ * end up in that thread's cache. Caches exchange objects with a central free list per size
+ * class in batches.
+ *
+ * Alignments up to the page size are honoured by picking a size class that is a multiple
+ * of the alignment. Larger allocations and alignments are mapped directly from the system.
+ *
+ * Chunks are never returned to the system, freed objects are only reused.
+ *
+ * @threadsafe
+ */
+
+class SlabAllocator
+{
+public:
+
+    /// The amount of size classes
+    static const size_t ClassCount = 40;
+
+    /// The largest size served from a size class
+    static const size_t MaxSmallSize = 32 * 1024;
+
+    /// The largest alignment served from a size class
+    static const size_t MaxSmallAlignment = 4096;
+
+    /// The size of a slab, slabs are aligned to their size
+    static const size_t SlabSize = 256 * 1024;
+
+    /// The size of the chunks slabs are taken from
+    static const size_t ChunkSize = 4 * 1024 * 1024;
+
+    /**
+     * Allocates memory.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment, should be a power of two.
+     *
+     * @return  The memory, or nullptr when the system is out of memory.
+     */
+
+    static void *Allocate(size_t bytes, size_t alignment);
+
+    /**
+     * Frees memory allocated by Allocate. Does nothing for nullptr.
+     *
+     * @param [in,out]  ptr The memory.
+     */
+
+    static void Free(void *ptr);
+
+    /**
+     * Gets the amount of bytes that can be used at the given allocation.
+     *
+     * @param   ptr The memory allocated by Allocate.
+     *
+     * @return  The usable size.
+     */
+
+    static size_t GetUsableSize(const void *ptr);
+
+    /**
+     * Gets the size class that serves an allocation.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment.
+     *
+     * @return  The size class, or ClassCount when the allocation is mapped directly.
+     */
+
+    static size_t GetSizeClass(size_t bytes, size_t alignment);
+
+    /**
+     * Gets the object size of a size class.
+     *
+     * @param   sizeClass   The size class.
+     *
+     * @return  The size in bytes.
+     */
+
+    static size_t GetClassSize(size_t sizeClass);
+
+    /**
+     * Returns the objects cached by the calling thread to the central free lists. This happens
+     * automatically when a thread exits.
+     */
+
+    static void FlushThreadCache();
+};
+
+#endif
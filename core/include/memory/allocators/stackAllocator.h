@@ -28,11 +28,14 @@
 #ifndef __ENGINE_STACKALLOCATOR_H__
 #define __ENGINE_STACKALLOCATOR_H__
 
+#include "memory/allocators/alignedAllocator.h"
+
 #include "common/types.h"
 
 #include <cstring>
 #include <vector>
 
+// @deprecated Use FrameArena, which respects alignment and never moves its memory
 class StackAllocator
 {
 public:
@@ -41,7 +44,7 @@ public:
 
     StackAllocator();
 
-    StackAllocator(size_t size);
+    StackAllocator(size_t size, HugePageArena *arena = nullptr);
 
     template< class tItem >
     StackLocation Move(const tItem &item)
@@ -83,7 +86,7 @@ private:
 
     StackLocation InternalAlloc(size_t allocSize);
 
-    std::vector< U8 > mStack;
+    std::vector< U8, AlignedAllocator< U8, 16 > > mStack;
 
     size_t mCursor;
 };
@@ -37,8 +37,9 @@ class MemoryPoolableInstantiator
 {
 public:
 
-    explicit MemoryPoolableInstantiator(size_t blocksize = 1000, size_t maxBlocks = 1000)
-        : mMemoryPool(blocksize, maxBlocks)
+    explicit MemoryPoolableInstantiator(size_t blocksize = 1000, size_t maxBlocks = 1000,
+                                        HugePageArena *arena = nullptr)
+        : mMemoryPool(blocksize, maxBlocks, arena)
     {
     }
 
@@ -54,7 +55,8 @@ public:
 
     virtual AbstractInstantiator *Copy() override
     {
-        return new MemoryPoolableInstantiator< tT, tBase >(mMemoryPool.GetBlockSize(), mMemoryPool.GetMaxBlocks());
+        return new MemoryPoolableInstantiator< tT, tBase >(mMemoryPool.GetBlockSize(), mMemoryPool.GetMaxBlocks(),
+                                                           mMemoryPool.GetArena());
     }
 
 private:
@@ -94,7 +94,11 @@ public:
 
     virtual tBase *Create() override
     {
-        return new tT(mParameter);
+        tBase *const object = new tT(mParameter);
+
+        HEAP_PROFILE_ALLOCATE(object, sizeof(tT), HeapSampleSource::Pool);
+
+        return object;
     }
 
     /// @}
@@ -110,6 +114,8 @@ public:
 
     virtual void Destroy(tBase *object) override
     {
+        HEAP_PROFILE_FREE(object, HeapSampleSource::Pool);
+
         delete object;
     }
 
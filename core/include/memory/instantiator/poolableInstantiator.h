@@ -29,6 +29,7 @@
 #define __ENGINE_POOLABLEINSTANTIATOR_H__
 
 #include "memory/abstract/abstractPoolableInstantiator.h"
+#include "memory/tracking/heapProfiler.h"
 
 #include "common/util.h"
 
@@ -73,7 +74,11 @@ public:
 
     virtual tBase *Create() override
     {
-        return new tT;
+        tBase *const object = new tT;
+
+        HEAP_PROFILE_ALLOCATE(object, sizeof(tT), HeapSampleSource::Pool);
+
+        return object;
     }
 
     /// @}
@@ -89,6 +94,8 @@ public:
 
     virtual void Destroy(tBase *object) override
     {
+        HEAP_PROFILE_FREE(object, HeapSampleSource::Pool);
+
         delete object;
     }
 
@@ -109,6 +116,23 @@ public:
         object->OnInit();
     }
 
+    /**
+     * Initialises a batch of objects, without a virtual call per object.
+     *
+     * @note    Derived instantiators that override Initialise() should override this as well.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void InitialiseBatch(tBase *const *objects, size_t count) override
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects[i]->OnInit();
+        }
+    }
+
     /// @}
 
     /// @name Releasing
@@ -126,6 +150,23 @@ public:
         object->OnRelease();
     }
 
+    /**
+     * Releases a batch of objects, without a virtual call per object.
+     *
+     * @note    Derived instantiators that override Release() should override this as well.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void ReleaseBatch(tBase *const *objects, size_t count) override
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects[i]->OnRelease();
+        }
+    }
+
     /// @}
 
     virtual AbstractInstantiator *Copy() override
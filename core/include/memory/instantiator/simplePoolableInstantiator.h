@@ -29,6 +29,7 @@
 #define __ENGINE_SIMPLEPOOLABLEINSTANTIATOR_H__
 
 #include "memory/abstract/abstractPoolableInstantiator.h"
+#include "memory/tracking/heapProfiler.h"
 
 #include "common/util.h"
 
@@ -70,7 +71,11 @@ public:
 
     virtual tBase *Create() override
     {
-        return new tT;
+        tBase *const object = new tT;
+
+        HEAP_PROFILE_ALLOCATE(object, sizeof(tT), HeapSampleSource::Pool);
+
+        return object;
     }
 
     /// @}
@@ -86,6 +91,8 @@ public:
 
     virtual void Destroy(tBase *object) override
     {
+        HEAP_PROFILE_FREE(object, HeapSampleSource::Pool);
+
         delete object;
     }
 
@@ -98,6 +105,10 @@ public:
     {
     }
 
+    virtual void InitialiseBatch(tBase *const *, size_t) override
+    {
+    }
+
     /// @}
 
     /// @name Releasing
@@ -107,6 +118,10 @@ public:
     {
     }
 
+    virtual void ReleaseBatch(tBase *const *, size_t) override
+    {
+    }
+
     /// @}
 
     virtual AbstractInstantiator *Copy() override
@@ -37,8 +37,9 @@ class UnsynchronisedMemoryPoolableInstantiator
 {
 public:
 
-    UnsynchronisedMemoryPoolableInstantiator(size_t blocksize = 1000, size_t maxBlocks = 1000) noexcept
-        : mMemoryPool(blocksize, maxBlocks)
+    UnsynchronisedMemoryPoolableInstantiator(size_t blocksize = 1000, size_t maxBlocks = 1000,
+                                             HugePageArena *arena = nullptr) noexcept
+        : mMemoryPool(blocksize, maxBlocks, arena)
     {
     }
 
@@ -54,7 +55,8 @@ public:
 
     virtual AbstractInstantiator *Copy() override
     {
-        return new UnsynchronisedMemoryPoolableInstantiator< tT, tBase >(mMemoryPool.mBlockSize, mMemoryPool.mMaxBlocks);
+        return new UnsynchronisedMemoryPoolableInstantiator< tT, tBase >(mMemoryPool.GetBlockSize(),
+                mMemoryPool.GetMaxBlocks(), mMemoryPool.GetArena());
     }
 
 private:
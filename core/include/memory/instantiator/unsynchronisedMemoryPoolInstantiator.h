@@ -29,10 +29,18 @@
 #define __ENGINE_UNSYNCHRONISEDMEMORYPOOLINSTANTIATOR_H__
 
 #include "memory/abstract/abstractMemoryPoolInstantiator.h"
+#include "memory/allocators/hugePageArena.h"
+#include "memory/allocators/malloc.h"
+
+#include "container/flatHashMap.h"
 
 #include "common/util.h"
 
+#include <type_traits>
 #include <assert.h>
+#include <utility>
+#include <vector>
+#include <new>
 
 /// @addtogroup Instantiators
 /// @{
@@ -41,6 +49,13 @@
  * An instantiator that stores the objects in contiguous memory for better caching and also
  * functions as a memory pool.
  *
+ * The memory blocks start on power of two aligned slabs of at most 64 KB, and every slab a
+ * block covers has one entry in a flat lookup table, so the block owning an object is found
+ * by masking its address to its slab. Fresh slots are handed out in address order, so a new
+ * block is only touched as far as it is used. Returned slots are
+ * linked through the slots themselves. Objects are constructed on creation and destructed
+ * on destruction.
+ *
  * This is the unsynchronised version of @see MemoryPoolInstantiator.
  *
  * @tparam  tT    The instantiated object type.
@@ -58,38 +73,77 @@ class UnsychronisedMemoryPoolInstantiator
 public:
 
     /**
-     * Constructs the instantiator and fills the first block.
+     * Constructs an object in the given memory. The memory is either a slot of the pool, or
+     * aligned heap storage when the pool is exhausted.
+     */
+
+    typedef tT *(*Factory)(void *memory);
+
+    /**
+     * Constructs the instantiator and allocates the first block. Create() default constructs
+     * the objects.
+     *
+     * @param   blocksize       (optional) the amount of objects per block.
+     * @param   maxBlocks       (optional) the maximum amount of blocks.
+     * @param [in,out]  arena   (optional) the arena the blocks are taken from, blocks that do not
+     *                          fit in the arena are allocated normally.
+     *
+     * @pre The instantiated type is default constructible, otherwise pass a factory.
+     */
+
+    explicit UnsychronisedMemoryPoolInstantiator(size_t blocksize = 1000, size_t maxBlocks = 1000,
+                                                 HugePageArena *arena = nullptr)
+        : UnsychronisedMemoryPoolInstantiator(blocksize, maxBlocks, arena, &ConstructDefault)
+    {
+    }
+
+    /**
+     * Constructs the instantiator and allocates the first block. Create() constructs the objects
+     * with the factory.
      *
-     * @param   blocksize   (optional) the amount of objects per block.
-     * @param   maxBlocks   (optional) the maximum amount of blocks.
+     * @param   blocksize       the amount of objects per block.
+     * @param   maxBlocks       the maximum amount of blocks.
+     * @param [in,out]  arena   the arena the blocks are taken from, or nullptr.
+     * @param   factory         the factory.
      */
 
-    explicit UnsychronisedMemoryPoolInstantiator(const size_t blocksize = 1000, const size_t maxBlocks = 1000) noexcept
-        : mBlockSize(blocksize),
-          mMaxBlocks(maxBlocks)
+    UnsychronisedMemoryPoolInstantiator(size_t blocksize, size_t maxBlocks, HugePageArena *arena, Factory factory)
+        : mArena(arena),
+          mFreeList(nullptr),
+          mFreshSlot(nullptr),
+          mFreshEnd(nullptr),
+          mLiveCount(0),
+          mBlockBytes(blocksize * sizeof(Slot)),
+          mSlabSize(GetSlabSize(mBlockBytes)),
+          mBlockSize(blocksize),
+          mMaxBlocks(maxBlocks),
+          mFactory(factory)
     {
         static_assert(Util::IsChildParent< tT, tBase >::value,
                       "UnsychronisedMemoryPoolInstantiator::UnsychronisedMemoryPoolInstantiator():\n\tThe child type should derive from the base type.");
 
-        AddMemoryBlockArray();
+        assert(factory);
+
+        AddMemoryBlock();
     }
 
     /**
      * Frees all the memory used by the memory pool.
      *
-     *  @warning All objects should be returned to the pool
-     *           to avoid memory leaks.
+     * @warning All objects should be returned to the pool
+     *          to avoid memory leaks.
      */
 
     virtual ~UnsychronisedMemoryPoolInstantiator()
     {
-        assert(mBlockSize == 0 || mAvailablePtrs.size() / (mBlockSize * mMemoryBlocks.size()) == 1);
-
-        mAvailablePtrs.clear();
+        assert(mLiveCount == 0);
 
         for (auto it = mMemoryBlocks.begin(), end = mMemoryBlocks.end(); it != end; ++it)
         {
-            delete[] *it;
+            if (!mArena || !mArena->Owns(*it))
+            {
+                ZefAlignedFree(*it);
+            }
         }
     }
 
@@ -97,29 +151,34 @@ public:
     /// @{
 
     /**
-     * Creates the instance. When there are still objects available, retrieve them
-     * from the pool. Otherwise we either add a new memory block of pointers or
-     * we just create an object.
+     * Creates an instance with the factory, which default constructs it unless another factory
+     * was given.
      *
      * @return  The new instance.
      */
 
     virtual tBase *Create() override
     {
-        if (!mAvailablePtrs.empty())
-        {
-            return GetObject();
+        return Construct(mFactory);
+    }
 
-        }
-        else if (mMemoryBlocks.size() <= mMaxBlocks)
-        {
-            AddMemoryBlockArray();
-            return GetObject();
-        }
-        else
+    /**
+     * Creates the instance. When there are still slots available, construct the object
+     * in a free slot. Otherwise we either add a new memory block or we just create an object.
+     *
+     * @tparam  tArgs   The constructor argument types.
+     * @param   args    The constructor arguments.
+     *
+     * @return  The new instance.
+     */
+
+    template< typename... tArgs >
+    tT *Create(tArgs &&... args)
+    {
+        return Construct([&args...](void *memory)
         {
-            return new tT;
-        }
+            return new(memory) tT(std::forward< tArgs >(args)...);
+        });
     }
 
     /// @}
@@ -135,48 +194,155 @@ public:
 
     virtual void Destroy(tBase *object) override
     {
-        for (auto it = mMemoryBlocks.begin(), end = mMemoryBlocks.end(); it != end; ++it)
-        {
-            // Check whether the pointer falls in this memory block
-            if (object >= *it && *it + mBlockSize > object)
-            {
-                mAvailablePtrs.push_back(static_cast< tT * >(object));
+        tT *const instance = static_cast< tT * >(object);
+        Slot *const slot = reinterpret_cast< Slot * >(instance);
 
-                return;
-            }
+        if (!Owns(slot))
+        {
+            // the pool was exhausted, so the object lives in its own aligned allocation
+            instance->~tT();
+            ZefAlignedFree(instance);
+            return;
         }
 
-        delete object;
+        instance->~tT();
+        ReleaseSlot(slot);
     }
 
     /// @}
 
-
     virtual AbstractInstantiator *Copy() override
     {
-        return new UnsychronisedMemoryPoolInstantiator< tT, tBase >(mBlockSize, mMaxBlocks);
+        return new UnsychronisedMemoryPoolInstantiator< tT, tBase >(mBlockSize, mMaxBlocks, mArena, mFactory);
+    }
+
+    size_t GetBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    size_t GetMaxBlocks() const
+    {
+        return mMaxBlocks;
+    }
+
+    HugePageArena *GetArena() const
+    {
+        return mArena;
     }
 
 private:
 
+    /**
+     * The storage of a single object. While the slot is free it links to the next free slot.
+     */
+
+    union Slot
+    {
+        Slot *next;
+        typename std::aligned_storage< sizeof(tT), alignof(tT) >::type object;
+    };
+
+    /// The largest granularity of the block lookup
+    static const size_t SlabSize = 64 * 1024;
+
+    UnsychronisedMemoryPoolInstantiator(const UnsychronisedMemoryPoolInstantiator &);
+
     /// @name Pool state
     /// @{
 
     /**
-     * Adds a full block of memory to the available object pointers.
+     * Allocates a block of memory and hands out its slots from the start. When no memory is
+     * available the block stays empty, and the objects come from the heap instead.
+     */
+
+    void AddMemoryBlock()
+    {
+        if (mBlockSize == 0)
+        {
+            return;
+        }
+
+        Slot *block = mArena ? static_cast< Slot * >(mArena->Allocate(mBlockBytes, mSlabSize)) : nullptr;
+        const bool fromArena = block != nullptr;
+
+        if (!block)
+        {
+            block = static_cast< Slot * >(ZefAlignedMalloc(mBlockBytes, mSlabSize));
+
+            if (!block)
+            {
+                return;
+            }
+        }
+
+        const size_t address = reinterpret_cast< size_t >(block);
+
+        try
+        {
+            for (size_t offset = 0; offset < mBlockBytes; offset += mSlabSize)
+            {
+                mSlabLookup.emplace(address + offset, block);
+            }
+
+            mMemoryBlocks.push_back(block);
+        }
+        catch (const std::bad_alloc &)
+        {
+            for (size_t offset = 0; offset < mBlockBytes; offset += mSlabSize)
+            {
+                mSlabLookup.erase(address + offset);
+            }
+
+            if (!fromArena)
+            {
+                ZefAlignedFree(block);
+            }
+
+            return;
+        }
+
+        mFreshSlot = block;
+        mFreshEnd = block + mBlockSize;
+    }
+
+    /**
+     * Queries whether the slot lies in one of our memory blocks.
+     *
+     * @param   slot    The slot.
+     *
+     * @return  true if the slot is owned by this instantiator.
      */
 
-    void AddMemoryBlockArray()
+    bool Owns(const Slot *slot) const
     {
-        tT *memBlock = new tT[ mBlockSize ];
-        mMemoryBlocks.push_back(memBlock);
+        const size_t address = reinterpret_cast< size_t >(slot);
+        const auto it = mSlabLookup.find(address & ~(mSlabSize - 1));
+
+        // the last slab of a block may extend beyond the block
+        return it != mSlabLookup.end() && address - reinterpret_cast< size_t >(it->second) < mBlockBytes;
+    }
+
+    /**
+     * Gets the slab size, which is also the alignment of a memory block. Small blocks fit in a
+     * single slab, larger ones span 64 KB slabs. Blocks start on a slab, so no slab is shared by
+     * two blocks.
+     *
+     * @param   blockBytes  The size of a memory block in bytes.
+     *
+     * @return  The slab size, a power of two.
+     */
 
-        mAvailablePtrs.reserve(mAvailablePtrs.size() + mBlockSize);
+    static size_t GetSlabSize(size_t blockBytes)
+    {
+        size_t slabSize = alignof(Slot);
 
-        for (size_t i = 0; i < mBlockSize; ++i)
+        while (slabSize < blockBytes && slabSize < SlabSize)
         {
-            mAvailablePtrs.push_back(memBlock++);
+            slabSize <<= 1;
         }
+
+        return slabSize;
     }
 
     /// @}
@@ -184,32 +350,150 @@ private:
     /// @name Object retrieval
     /// @{
 
+    static tT *ConstructDefault(void *memory)
+    {
+        static_assert(std::is_default_constructible< tT >::value,
+                      "UnsychronisedMemoryPoolInstantiator::UnsychronisedMemoryPoolInstantiator():\n\tThe type is not default constructible, pass a factory instead.");
+
+        return new(memory) tT();
+    }
+
+    /**
+     * Constructs an object in a slot. When the pool is exhausted, the object is constructed in
+     * heap memory with the alignment of the type instead. When the constructor throws, the slot
+     * is returned.
+     *
+     * @tparam  tConstructor    The type of the constructor.
+     * @param   construct       Constructs the object in the given memory.
+     *
+     * @return  The new instance.
+     */
+
+    template< typename tConstructor >
+    tT *Construct(const tConstructor &construct)
+    {
+        Slot *const slot = AcquireSlot();
+
+        if (!slot)
+        {
+            void *const memory = ZefAlignedMalloc(sizeof(tT), alignof(tT));
+
+            if (!memory)
+            {
+                throw std::bad_alloc();
+            }
+
+            try
+            {
+                return construct(memory);
+            }
+            catch (...)
+            {
+                ZefAlignedFree(memory);
+                throw;
+            }
+        }
+
+        try
+        {
+            return construct(slot);
+        }
+        catch (...)
+        {
+            ReleaseSlot(slot);
+            throw;
+        }
+    }
+
     /**
-     * Gets an object from the pointer vector.
+     * Takes a returned slot, or a fresh slot when none were returned. Adds a memory block
+     * when the current block is used up and we are allowed to grow.
      *
-     * @return  The object.
+     * @return  The slot, or nullptr when the pool is exhausted.
      */
 
-    tBase *GetObject()
+    Slot *AcquireSlot()
     {
-        tT *object = mAvailablePtrs.back();
-        mAvailablePtrs.pop_back();
-        return object;
+        Slot *slot = mFreeList;
+
+        if (slot)
+        {
+            mFreeList = slot->next;
+        }
+        else
+        {
+            if (mFreshSlot == mFreshEnd)
+            {
+                if (mMemoryBlocks.size() > mMaxBlocks)
+                {
+                    return nullptr;
+                }
+
+                AddMemoryBlock();
+
+                if (mFreshSlot == mFreshEnd)
+                {
+                    return nullptr;
+                }
+            }
+
+            slot = mFreshSlot++;
+        }
+
+        ++mLiveCount;
+        return slot;
     }
 
-    /// @}
+    /**
+     * Puts a slot in front of the free list.
+     *
+     * @param [in,out]  slot    The slot.
+     */
 
-    /// Holds all the available pointers to object
-    std::vector< tT * > mAvailablePtrs;
+    void ReleaseSlot(Slot *slot)
+    {
+        slot->next = mFreeList;
+        mFreeList = slot;
+        --mLiveCount;
+    }
+
+    /// @}
 
     /// Holds the used memory blocks
-    std::vector< tT * > mMemoryBlocks;
+    std::vector< Slot * > mMemoryBlocks;
+
+    /// The arena we take the memory blocks from, when set
+    HugePageArena *mArena;
+
+    /// Maps the address of every slab in our memory blocks to its block
+    FlatHashMap< size_t, Slot * > mSlabLookup;
+
+    /// The first returned slot
+    Slot *mFreeList;
+
+    /// The next never used slot in the newest block
+    Slot *mFreshSlot;
+
+    /// The end of the newest block
+    Slot *mFreshEnd;
+
+    /// The amount of objects living in our blocks
+    size_t mLiveCount;
+
+    /// The size of a memory block in bytes
+    const size_t mBlockBytes;
+
+    /// The granularity of the block lookup and the alignment of a memory block in bytes
+    const size_t mSlabSize;
 
     /// The amount of objects per block
     const size_t mBlockSize;
 
     /// The maximum of blocks used by this instantiator
     const size_t mMaxBlocks;
+
+    /// Constructs the objects of Create()
+    const Factory mFactory;
 };
 
 //// @}
@@ -30,12 +30,25 @@
 
 #include "memory/instantiator/poolableInstantiator.h"
 #include "memory/abstract/abstractObjectPool.h"
+#include "memory/allocators/alignedAllocator.h"
+#include "memory/tracking/memoryTracker.h"
 
+#include "manager/scheduleManager.h"
+
+#include "threading/threadOwnerCheck.h"
+#include "threading/cacheAligned.h"
 #include "threading/spinlock.h"
 
 #include "api/console.h"
 
+#include "common/util.h"
+
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <typeinfo>
 
 /// @addtogroup Pools
 /// @{
@@ -52,6 +65,23 @@
  * will be deleted. When we have objects stored, we use those objects instead
  * of creating new objects.
  *
+ * Optionally the pool keeps a magazine of free objects per thread. Threads then get and
+ * dispose objects from their own magazine without locking, and only exchange objects with
+ * the shared pool in batches of the magazine size. Threads without a valid thread ID, such
+ * as the loader thread, keep using the shared pool directly. The capacity only limits the
+ * shared pool; every magazine holds at most twice the magazine size on top of that.
+ *
+ * The magazines are only race free while no two live threads share a thread ID, since
+ * nothing stops ScheduleManager::SetCurrentThreadID or a ThreadPool from handing out an ID
+ * that is in use. Debug builds assert when two threads use the same magazine at once.
+ *
+ * The capacity can adapt to the usage of the pool. Every window of frames the pool checks the
+ * fewest idle objects it had; objects that stayed idle the whole window are destroyed, half of
+ * them at a time, and the capacity shrinks with them. When the pool both created objects because
+ * it ran empty and destroyed objects because it was full, the capacity grows by the amount
+ * destroyed. Trim() gives back all idle objects above the minimum capacity at once, including
+ * those in the magazines; the PoolManager does so on a MemoryPressureEvent.
+ *
  * @partthreadsafe{ the instantiators should be threadsafe }
  *
  * @tparam tT               The instantiated type.
@@ -72,34 +102,65 @@ public:
      *
      * @param [in,out]  instantiator    If non-null, the instantiator.
      * @param   capacity                (optional) The maximum of kept alive objects.
+     * @param   magazineSize            (optional) The amount of objects exchanged between a thread
+     *                                  magazine and the shared pool, 0 disables the magazines.
      *
      * @note    Takes ownership of the instantiator.
      */
 
-    explicit ObjectPool(AbstractPoolableInstantiator< tBase > *instantiator, size_t capacity = 500) noexcept
-        : mCapacity(capacity),
+    explicit ObjectPool(AbstractPoolableInstantiator< tBase > *instantiator, size_t capacity = 500,
+                        size_t magazineSize = 0) noexcept
+        : mMagazines(magazineSize > 0 ? PROGRAM_MAX_THREADS + 1 : 0),
+          mCapacity(capacity),
+          mMinCapacity(0),
+          mMaxCapacity(capacity),
+          mMagazineSize(magazineSize),
+          mWindowLowWater(0),
+          mWindowMisses(0),
+          mWindowOverflows(0),
           mBorrowedObjectsCount(0),
           mReturnedObjectsCount(0),
-          mInstantiator(instantiator)
+          mInstantiator(instantiator),
+          mWindow(0),
+          mWindowFrames(0)
     {
         static_assert(Util::IsChildParent< tT, tBase >::value,
                       "ObjectPool::ObjectPool():\n\tThe child type should derive from the base type.");
+
+#if PROGRAM_MEMORY_TRACKING
+        mMemoryTag = MemoryTracker::Register(typeid(tT).name(), MemoryKind::Pool);
+#endif
     }
 
     /**
      * Creates its own instantiator.
      *
-     * @param   capacity    (optional) The maximum of kept alive objects.
+     * @param   capacity        (optional) The maximum of kept alive objects.
+     * @param   magazineSize    (optional) The amount of objects exchanged between a thread
+     *                          magazine and the shared pool, 0 disables the magazines.
      */
 
-    explicit ObjectPool(size_t capacity = 500)
-        : mCapacity(capacity),
+    explicit ObjectPool(size_t capacity = 500, size_t magazineSize = 0)
+        : mMagazines(magazineSize > 0 ? PROGRAM_MAX_THREADS + 1 : 0),
+          mCapacity(capacity),
+          mMinCapacity(0),
+          mMaxCapacity(capacity),
+          mMagazineSize(magazineSize),
+          mWindowLowWater(0),
+          mWindowMisses(0),
+          mWindowOverflows(0),
           mBorrowedObjectsCount(0),
           mReturnedObjectsCount(0),
-          mInstantiator(new tInstantiator)
+          mInstantiator(new tInstantiator),
+          mWindow(0),
+          mWindowFrames(0)
     {
         static_assert(Util::IsChildParent< tT, tBase >::value,
                       "ObjectPool::ObjectPool():\n\tThe child type should derive from the base type.");
+
+#if PROGRAM_MEMORY_TRACKING
+        mMemoryTag = MemoryTracker::Register(typeid(tT).name(), MemoryKind::Pool);
+#endif
     }
 
     /**
@@ -110,7 +171,15 @@ public:
     {
         for (auto it = mPool.begin(); it != mPool.end(); ++it)
         {
-            mInstantiator->Destroy(*it);
+            DestroyObject(*it);
+        }
+
+        for (AlignedMagazine &magazine : mMagazines)
+        {
+            for (tBase *object : magazine->objects)
+            {
+                DestroyObject(object);
+            }
         }
 
         if (ObjectPool<tT, tBase, tInstantiator>::GetBorrowedCount() !=
@@ -120,6 +189,10 @@ public:
         }
 
         SAFE_DELETE(mInstantiator);
+
+#if PROGRAM_MEMORY_TRACKING
+        MemoryTracker::Unregister(mMemoryTag);
+#endif
     }
 
     /// @name Retrieve Objects
@@ -152,6 +225,28 @@ public:
 
     tBase *FastGet() override
     {
+        MEMORY_TRACK_ACQUIRE(mMemoryTag);
+
+        Magazine *const magazine = GetMagazine();
+
+        if (magazine)
+        {
+            ThreadOwnerCheck::Guard guard(magazine->owner);
+
+            // only this thread writes its magazine counters
+            magazine->borrowed.store(magazine->borrowed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            if (magazine->objects.empty())
+            {
+                Refill(*magazine);
+            }
+
+            tBase *const object = magazine->objects.back();
+            magazine->objects.pop_back();
+
+            return object;
+        }
+
         std::lock_guard< SpinLock > lock(mSpinLock);
 
         ++mBorrowedObjectsCount;
@@ -159,6 +254,79 @@ public:
         return CreateInstance();
     }
 
+    /**
+     * Gets a batch of objects from the object pool, and initialises them at once.
+     *
+     * @threadsafe
+     *
+     * @param   count           The amount of objects.
+     * @param [out] objects     The objects, should have room for count objects.
+     */
+
+    void GetBatch(size_t count, tBase **objects) override
+    {
+        FastGetBatch(count, objects);
+
+        mInstantiator->InitialiseBatch(objects, count);
+    }
+
+    /**
+     * Gets a batch of objects from the object pool without initialising. The objects come from
+     * the thread magazine first, then from the shared pool under a single lock, and the objects
+     * still missing are created outside the lock.
+     *
+     * @threadsafe
+     *
+     * @param   count           The amount of objects.
+     * @param [out] objects     The objects, should have room for count objects.
+     */
+
+    void FastGetBatch(size_t count, tBase **objects)
+    {
+        MEMORY_TRACK_ACQUIRE_BATCH(mMemoryTag, count);
+
+        size_t taken = 0;
+        Magazine *const magazine = GetMagazine();
+
+        if (magazine)
+        {
+            ThreadOwnerCheck::Guard guard(magazine->owner);
+
+            magazine->borrowed.store(magazine->borrowed.load(std::memory_order_relaxed) + count,
+                                     std::memory_order_relaxed);
+
+            taken = std::min(count, magazine->objects.size());
+            std::copy(magazine->objects.end() - taken, magazine->objects.end(), objects);
+            magazine->objects.resize(magazine->objects.size() - taken);
+        }
+
+        if (taken < count)
+        {
+            mSpinLock.lock();
+
+            // without a magazine nothing was taken yet, so every object is counted here
+            if (!magazine)
+            {
+                mBorrowedObjectsCount += count;
+            }
+
+            const size_t shared = std::min(count - taken, mPool.size());
+            std::copy(mPool.end() - shared, mPool.end(), objects + taken);
+            mPool.resize(mPool.size() - shared);
+            taken += shared;
+
+            mWindowLowWater = std::min(mWindowLowWater, mPool.size());
+            mWindowMisses += count - taken;
+
+            mSpinLock.unlock();
+
+            for (; taken < count; ++taken)
+            {
+                objects[taken] = CreateObject();
+            }
+        }
+    }
+
     /// @}
 
     /// @name Return Objects
@@ -191,6 +359,25 @@ public:
 
     void FastDispose(tBase *object)
     {
+        MEMORY_TRACK_RELEASE(mMemoryTag);
+
+        Magazine *const magazine = GetMagazine();
+
+        if (magazine)
+        {
+            ThreadOwnerCheck::Guard guard(magazine->owner);
+
+            magazine->returned.store(magazine->returned.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            magazine->objects.push_back(object);
+
+            if (magazine->objects.size() >= 2 * mMagazineSize)
+            {
+                Flush(*magazine, mMagazineSize);
+            }
+
+            return;
+        }
+
         mSpinLock.lock();
 
         ++mReturnedObjectsCount;
@@ -202,8 +389,73 @@ public:
         }
         else
         {
+            ++mWindowOverflows;
             mSpinLock.unlock();
-            mInstantiator->Destroy(object);
+            DestroyObject(object);
+        }
+    }
+
+    /**
+     * Returns a batch of objects to the pool, and releases them at once.
+     *
+     * @threadsafe
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    void DisposeBatch(tBase *const *objects, size_t count) override
+    {
+        mInstantiator->ReleaseBatch(objects, count);
+
+        FastDisposeBatch(objects, count);
+    }
+
+    /**
+     * Returns a batch of objects to the pool without releasing them, taking the lock at
+     * most once.
+     *
+     * @threadsafe
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    void FastDisposeBatch(tBase *const *objects, size_t count)
+    {
+        MEMORY_TRACK_RELEASE_BATCH(mMemoryTag, count);
+
+        Magazine *const magazine = GetMagazine();
+
+        if (magazine)
+        {
+            ThreadOwnerCheck::Guard guard(magazine->owner);
+
+            magazine->returned.store(magazine->returned.load(std::memory_order_relaxed) + count,
+                                     std::memory_order_relaxed);
+            magazine->objects.insert(magazine->objects.end(), objects, objects + count);
+
+            if (magazine->objects.size() >= 2 * mMagazineSize)
+            {
+                Flush(*magazine, magazine->objects.size() - mMagazineSize);
+            }
+
+            return;
+        }
+
+        mSpinLock.lock();
+
+        mReturnedObjectsCount += count;
+
+        const size_t fits = std::min(count, mCapacity - std::min(mCapacity, mPool.size()));
+        mPool.insert(mPool.end(), objects, objects + fits);
+        mWindowOverflows += count - fits;
+
+        mSpinLock.unlock();
+
+        for (size_t i = fits; i < count; ++i)
+        {
+            DestroyObject(objects[i]);
         }
     }
 
@@ -222,9 +474,19 @@ public:
 
     size_t GetBorrowedCount() const noexcept override
     {
-        std::lock_guard< SpinLock > lock(mSpinLock);
+        size_t count;
+
+        {
+            std::lock_guard< SpinLock > lock(mSpinLock);
+            count = mBorrowedObjectsCount;
+        }
 
-        return mBorrowedObjectsCount;
+        for (const AlignedMagazine &magazine : mMagazines)
+        {
+            count += magazine->borrowed.load(std::memory_order_relaxed);
+        }
+
+        return count;
     }
 
     /**
@@ -237,32 +499,326 @@ public:
 
     size_t GetReturnedCount() const noexcept override
     {
+        size_t count;
+
+        {
+            std::lock_guard< SpinLock > lock(mSpinLock);
+            count = mReturnedObjectsCount;
+        }
+
+        for (const AlignedMagazine &magazine : mMagazines)
+        {
+            count += magazine->returned.load(std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    /// @}
+
+    /**
+     * Gets the amount of objects exchanged between a thread magazine and the shared pool.
+     *
+     * @return  The magazine size, 0 when magazines are disabled.
+     */
+
+    size_t GetMagazineSize() const noexcept
+    {
+        return mMagazineSize;
+    }
+
+    /// @name Capacity
+    /// @{
+
+    /**
+     * Lets the capacity adapt to the usage of the pool, within the given bounds.
+     *
+     * @threadsafe
+     *
+     * @param   minCapacity The least amount of kept alive objects.
+     * @param   maxCapacity The maximum of kept alive objects.
+     * @param   window      (optional) The amount of frames usage is measured over, 0 disables
+     *                      adaptation.
+     */
+
+    void SetAdaptiveCapacity(size_t minCapacity, size_t maxCapacity, U32 window = 60)
+    {
+        std::lock_guard< SpinLock > lock(mSpinLock);
+
+        mMinCapacity = std::min(minCapacity, maxCapacity);
+        mMaxCapacity = maxCapacity;
+        mCapacity = std::max(mMinCapacity, std::min(mCapacity, mMaxCapacity));
+        mWindow = window;
+
+        ResetWindow();
+    }
+
+    /**
+     * Creates idle objects in the shared pool until it holds the given amount, and raises the
+     * capacity to keep them. Objects are created outside the lock, so this can run on a loader
+     * thread while the pool is in use. An adaptive pool gives reserved objects back when they
+     * stay unused, unless its minimum capacity covers them.
+     *
+     * @threadsafe
+     *
+     * @param   count   The amount of idle objects.
+     * @param   faultIn (optional) Writes every page of the created objects, so their memory
+     *                  is backed before it is used.
+     *
+     * @return  The amount of created objects.
+     */
+
+    size_t Reserve(size_t count, bool faultIn = false) override
+    {
+        mSpinLock.lock();
+
+        mCapacity = std::max(mCapacity, count);
+        mMaxCapacity = std::max(mMaxCapacity, mCapacity);
+        const size_t missing = count - std::min(count, mPool.size());
+
+        mSpinLock.unlock();
+
+        std::vector< tBase * > created;
+        created.reserve(missing);
+
+        for (size_t i = 0; i < missing; ++i)
+        {
+            tBase *const object = CreateObject();
+
+            if (faultIn)
+            {
+                Util::FaultIn(static_cast< tT * >(object), sizeof(tT));
+            }
+
+            created.push_back(object);
+        }
+
         std::lock_guard< SpinLock > lock(mSpinLock);
 
-        return mReturnedObjectsCount;
+        mPool.reserve(mCapacity);
+        mPool.insert(mPool.end(), created.begin(), created.end());
+
+        return missing;
+    }
+
+    /**
+     * Measures the usage of the pool, and adapts the capacity at the end of every window.
+     *
+     * @threadsafe
+     */
+
+    void Adapt() override
+    {
+        std::vector< tBase * > trimmed;
+        {
+            std::lock_guard< SpinLock > lock(mSpinLock);
+
+            if (mWindow == 0 || ++mWindowFrames < mWindow)
+            {
+                return;
+            }
+
+            if (mWindowMisses > 0 && mWindowOverflows > 0)
+            {
+                mCapacity = std::min(mMaxCapacity, mCapacity + mWindowOverflows);
+            }
+            else if (mWindowLowWater > 0)
+            {
+                // only give back half of the unused objects, so we do not thrash on a
+                // usage pattern that is slower than the window
+                const size_t unused = std::min(mPool.size() - std::min(mPool.size(), mMinCapacity),
+                                               (mWindowLowWater + 1) / 2);
+
+                mCapacity = std::max(mMinCapacity, mCapacity - std::min(mCapacity, unused));
+                Take(trimmed, std::max(unused, mPool.size() - std::min(mPool.size(), mCapacity)));
+            }
+
+            ResetWindow();
+        }
+
+        for (tBase *object : trimmed)
+        {
+            DestroyObject(object);
+        }
+    }
+
+    /**
+     * Destroys the idle objects above the minimum capacity, including those held by the thread
+     * magazines.
+     *
+     * @partthreadsafe{ no thread may use its magazine meanwhile }
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    size_t Trim() override
+    {
+        mSpinLock.lock();
+        const size_t minCapacity = mMinCapacity;
+        mSpinLock.unlock();
+
+        return TrimTo(minCapacity);
+    }
+
+    /**
+     * Empties the thread magazines into the shared pool, and destroys the idle objects above
+     * the given amount.
+     *
+     * @partthreadsafe{ no thread may use its magazine meanwhile }
+     *
+     * @param   idle    The amount of idle objects to keep.
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    size_t TrimTo(size_t idle)
+    {
+        std::vector< tBase * > trimmed;
+        {
+            std::lock_guard< SpinLock > lock(mSpinLock);
+
+            for (AlignedMagazine &magazine : mMagazines)
+            {
+                ThreadOwnerCheck::Guard guard(magazine->owner);
+
+                mPool.insert(mPool.end(), magazine->objects.begin(), magazine->objects.end());
+                magazine->objects.clear();
+            }
+
+            Take(trimmed, mPool.size() - std::min(mPool.size(), std::min(idle, mCapacity)));
+            mWindowLowWater = std::min(mWindowLowWater, mPool.size());
+        }
+
+        for (tBase *object : trimmed)
+        {
+            DestroyObject(object);
+        }
+
+        return trimmed.size();
+    }
+
+    /**
+     * Gets the maximum of kept alive objects.
+     *
+     * @threadsafe
+     *
+     * @return  The capacity.
+     */
+
+    size_t GetCapacity() const
+    {
+        std::lock_guard< SpinLock > lock(mSpinLock);
+
+        return mCapacity;
+    }
+
+    /**
+     * Gets the amount of idle objects in the shared pool.
+     *
+     * @threadsafe
+     *
+     * @return  The idle count.
+     */
+
+    size_t GetIdleCount() const
+    {
+        std::lock_guard< SpinLock > lock(mSpinLock);
+
+        return mPool.size();
     }
 
     /// @}
 
+#if PROGRAM_MEMORY_TRACKING
+
+    /**
+     * Gets the tag the memory statistics of this pool are recorded in.
+     *
+     * @return  The memory tag.
+     */
+
+    MemoryTag *GetMemoryTag() const noexcept
+    {
+        return mMemoryTag;
+    }
+
+#endif
+
 private:
 
+    /**
+     * The thread local cache of free objects. Only the owning thread touches the objects, the
+     * counters are atomic so other threads can read them. The owner check asserts on two
+     * threads using the magazine at once in debug builds.
+     */
+
+    struct Magazine
+    {
+        Magazine() noexcept
+            : borrowed(0),
+              returned(0)
+        {
+        }
+
+        std::vector< tBase * > objects;
+
+        std::atomic< size_t > borrowed;
+        std::atomic< size_t > returned;
+
+        ThreadOwnerCheck owner;
+    };
+
+    typedef CacheAligned< Magazine > AlignedMagazine;
+
     /// The unused stored objects
     std::vector< tBase * > mPool;
 
+    /// The magazines, indexed by thread ID, each on its own cache line
+    std::vector< AlignedMagazine, AlignedAllocator< AlignedMagazine, PROGRAM_CACHE_LINE_SIZE >> mMagazines;
+
     /// The maximum amount of objects in our pool
     size_t mCapacity;
 
-    /// The amount of objects borrowed from the pool
+    /// The least capacity adaptation shrinks to
+    size_t mMinCapacity;
+
+    /// The most capacity adaptation grows to
+    size_t mMaxCapacity;
+
+    /// The amount of objects a magazine exchanges with the pool at once
+    size_t mMagazineSize;
+
+    /// The fewest idle objects in the shared pool during the current window
+    size_t mWindowLowWater;
+
+    /// The objects created because the shared pool was empty during the current window
+    size_t mWindowMisses;
+
+    /// The objects destroyed because the shared pool was full during the current window
+    size_t mWindowOverflows;
+
+    /// The amount of objects borrowed from the shared pool, guarded by the spin lock
     size_t mBorrowedObjectsCount;
 
-    /// The amount of returned objects
+    /// The amount of objects returned to the shared pool, guarded by the spin lock
     size_t mReturnedObjectsCount;
 
     /// The instantiator we use to create and delete objects.
     AbstractPoolableInstantiator< tBase > *mInstantiator;
 
+    /// The amount of frames usage is measured over, 0 disables adaptation
+    U32 mWindow;
+
+    /// The frames passed in the current window
+    U32 mWindowFrames;
+
     mutable SpinLock mSpinLock;
 
+#if PROGRAM_MEMORY_TRACKING
+    /// The memory statistics of this pool
+    MemoryTag *mMemoryTag;
+#endif
+
     /**
      * Checks whether we can retrieve an object from our pool,
      * or whether we need to create a new one.
@@ -278,14 +834,137 @@ private:
         {
             object = mPool.back();
             mPool.pop_back();
+
+            mWindowLowWater = std::min(mWindowLowWater, mPool.size());
         }
         else
         {
-            object = mInstantiator->Create();
+            ++mWindowMisses;
+            object = CreateObject();
         }
 
         return object;
     }
+
+    /**
+     * Creates a new object with the instantiator.
+     *
+     * @return  The object.
+     */
+
+    tBase *CreateObject()
+    {
+        MEMORY_TRACK_ALLOCATE(mMemoryTag, sizeof(tT));
+
+        return mInstantiator->Create();
+    }
+
+    /**
+     * Destroys an object with the instantiator.
+     *
+     * @param [in,out]  object  The object.
+     */
+
+    void DestroyObject(tBase *object)
+    {
+        MEMORY_TRACK_FREE(mMemoryTag, sizeof(tT));
+
+        mInstantiator->Destroy(object);
+    }
+
+    /**
+     * Starts a new usage window, the spin lock should be held.
+     */
+
+    void ResetWindow() noexcept
+    {
+        mWindowFrames = 0;
+        mWindowLowWater = mPool.size();
+        mWindowMisses = 0;
+        mWindowOverflows = 0;
+    }
+
+    /**
+     * Moves idle objects out of the shared pool, the spin lock should be held.
+     *
+     * @param [out] objects The taken objects.
+     * @param   count       The amount of objects to take.
+     */
+
+    void Take(std::vector< tBase * > &objects, size_t count)
+    {
+        objects.insert(objects.end(), mPool.end() - count, mPool.end());
+        mPool.resize(mPool.size() - count);
+    }
+
+    /**
+     * Gets the magazine of the calling thread.
+     *
+     * @return  The magazine, or nullptr when magazines are disabled or the thread has no magazine.
+     */
+
+    Magazine *GetMagazine() noexcept
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+
+        return threadID < mMagazines.size() ? &mMagazines[threadID].value : nullptr;
+    }
+
+    /**
+     * Moves a batch of objects from the shared pool into the magazine, or creates a new object
+     * when the shared pool is empty.
+     *
+     * @param [in,out]  magazine    The magazine.
+     */
+
+    void Refill(Magazine &magazine)
+    {
+        std::lock_guard< SpinLock > lock(mSpinLock);
+
+        const size_t count = std::min(mPool.size(), mMagazineSize);
+
+        if (count > 0)
+        {
+            magazine.objects.insert(magazine.objects.end(), mPool.end() - count, mPool.end());
+            mPool.resize(mPool.size() - count);
+
+            mWindowLowWater = std::min(mWindowLowWater, mPool.size());
+        }
+        else
+        {
+            ++mWindowMisses;
+            magazine.objects.push_back(CreateObject());
+        }
+    }
+
+    /**
+     * Moves a batch of objects from the magazine back into the shared pool. Objects that do not fit
+     * in the shared pool are destroyed.
+     *
+     * @param [in,out]  magazine    The magazine.
+     * @param   count               The amount of objects to move.
+     */
+
+    void Flush(Magazine &magazine, size_t count)
+    {
+        std::vector< tBase * > &objects = magazine.objects;
+        const auto begin = objects.end() - count;
+
+        mSpinLock.lock();
+
+        const size_t fits = std::min(count, mCapacity - std::min(mCapacity, mPool.size()));
+        mPool.insert(mPool.end(), begin, begin + fits);
+        mWindowOverflows += count - fits;
+
+        mSpinLock.unlock();
+
+        for (auto it = begin + fits, end = objects.end(); it != end; ++it)
+        {
+            DestroyObject(*it);
+        }
+
+        objects.erase(begin, objects.end());
+    }
 };
 
 /// @}
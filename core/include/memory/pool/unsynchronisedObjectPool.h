@@ -31,8 +31,13 @@
 
 #include "memory/instantiator/poolableInstantiator.h"
 #include "memory/abstract/abstractObjectPool.h"
+#include "memory/tracking/memoryTracker.h"
 
+#include "common/util.h"
+
+#include <algorithm>
 #include <assert.h>
+#include <typeinfo>
 
 /// @addtogroup Pools
 /// @{
@@ -81,6 +86,10 @@ public:
     {
         static_assert(Util::IsChildParent< tT, tBase >::value,
                       "UnsynchronisedObjectPool::UnsynchronisedObjectPool():\n\tThe child type should derive from the base type.");
+
+#if PROGRAM_MEMORY_TRACKING
+        mMemoryTag = MemoryTracker::Register(typeid(tT).name(), MemoryKind::Pool);
+#endif
     }
 
     /**
@@ -97,6 +106,10 @@ public:
     {
         static_assert(Util::IsChildParent< tT, tBase >::value,
                       "ObjectPool::ObjectPool():\n\tThe child type should derive from the base type.");
+
+#if PROGRAM_MEMORY_TRACKING
+        mMemoryTag = MemoryTracker::Register(typeid(tT).name(), MemoryKind::Pool);
+#endif
     }
 
     /**
@@ -107,12 +120,16 @@ public:
     {
         for (auto it = mPool.begin(); it != mPool.end(); ++it)
         {
-            mInstantiator->Destroy(*it);
+            DestroyObject(*it);
         }
 
         assert(GetBorrowedCount() == GetReturnedCount());
 
         SAFE_DELETE(mInstantiator);
+
+#if PROGRAM_MEMORY_TRACKING
+        MemoryTracker::Unregister(mMemoryTag);
+#endif
     }
 
     /// @name Retrieve Objects
@@ -141,11 +158,50 @@ public:
 
     virtual tBase *FastGet() override
     {
+        MEMORY_TRACK_ACQUIRE(mMemoryTag);
+
         ++mBorrowedObjectsCount;
 
         return Create();
     }
 
+    /**
+     * Gets a batch of objects from the object pool, and initialises them at once.
+     *
+     * @param   count           The amount of objects.
+     * @param [out] objects     The objects, should have room for count objects.
+     */
+
+    virtual void GetBatch(size_t count, tBase **objects) override
+    {
+        FastGetBatch(count, objects);
+
+        mInstantiator->InitialiseBatch(objects, count);
+    }
+
+    /**
+     * Gets a batch of objects from the object pool without initialising.
+     *
+     * @param   count           The amount of objects.
+     * @param [out] objects     The objects, should have room for count objects.
+     */
+
+    void FastGetBatch(size_t count, tBase **objects)
+    {
+        MEMORY_TRACK_ACQUIRE_BATCH(mMemoryTag, count);
+
+        mBorrowedObjectsCount += count;
+
+        const size_t taken = std::min(count, mPool.size());
+        std::copy(mPool.end() - taken, mPool.end(), objects);
+        mPool.resize(mPool.size() - taken);
+
+        for (size_t i = taken; i < count; ++i)
+        {
+            objects[i] = CreateObject();
+        }
+    }
+
     /// @}
 
     /// @name Return Objects
@@ -162,6 +218,8 @@ public:
     {
         mInstantiator->Release(object);
 
+        MEMORY_TRACK_RELEASE(mMemoryTag);
+
         ++mReturnedObjectsCount;
 
         if (mPool.size() < mCapacity)
@@ -170,7 +228,7 @@ public:
         }
         else
         {
-            mInstantiator->Destroy(object);
+            DestroyObject(object);
         }
     }
 
@@ -183,6 +241,8 @@ public:
 
     void FastDispose(tBase *object)
     {
+        MEMORY_TRACK_RELEASE(mMemoryTag);
+
         ++mReturnedObjectsCount;
 
         if (mPool.size() < mCapacity)
@@ -191,7 +251,43 @@ public:
         }
         else
         {
-            mInstantiator->Destroy(object);
+            DestroyObject(object);
+        }
+    }
+
+    /**
+     * Returns a batch of objects to the pool, and releases them at once.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    virtual void DisposeBatch(tBase *const *objects, size_t count) override
+    {
+        mInstantiator->ReleaseBatch(objects, count);
+
+        FastDisposeBatch(objects, count);
+    }
+
+    /**
+     * Returns a batch of objects to the pool without releasing them.
+     *
+     * @param   objects The objects.
+     * @param   count   The amount of objects.
+     */
+
+    void FastDisposeBatch(tBase *const *objects, size_t count)
+    {
+        MEMORY_TRACK_RELEASE_BATCH(mMemoryTag, count);
+
+        mReturnedObjectsCount += count;
+
+        const size_t fits = std::min(count, mCapacity - std::min(mCapacity, mPool.size()));
+        mPool.insert(mPool.end(), objects, objects + fits);
+
+        for (size_t i = fits; i < count; ++i)
+        {
+            DestroyObject(objects[i]);
         }
     }
 
@@ -224,6 +320,101 @@ public:
 
     /// @}
 
+    /// @name Capacity
+    /// @{
+
+    /**
+     * Creates idle objects until the pool holds the given amount, and raises the capacity to
+     * keep them.
+     *
+     * @param   count   The amount of idle objects.
+     * @param   faultIn (optional) Writes every page of the created objects, so their memory
+     *                  is backed before it is used.
+     *
+     * @return  The amount of created objects.
+     */
+
+    virtual size_t Reserve(size_t count, bool faultIn = false) override
+    {
+        mCapacity = std::max(mCapacity, count);
+        mPool.reserve(mCapacity);
+
+        const size_t missing = count - std::min(count, mPool.size());
+
+        for (size_t i = 0; i < missing; ++i)
+        {
+            tBase *const object = CreateObject();
+
+            if (faultIn)
+            {
+                Util::FaultIn(static_cast< tT * >(object), sizeof(tT));
+            }
+
+            mPool.push_back(object);
+        }
+
+        return missing;
+    }
+
+    /**
+     * Destroys all idle objects.
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    virtual size_t Trim() override
+    {
+        return TrimTo(0);
+    }
+
+    /**
+     * Destroys the idle objects above the given amount.
+     *
+     * @param   idle    The amount of idle objects to keep.
+     *
+     * @return  The amount of destroyed objects.
+     */
+
+    size_t TrimTo(size_t idle)
+    {
+        const size_t count = mPool.size() - std::min(mPool.size(), idle);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            DestroyObject(mPool.back());
+            mPool.pop_back();
+        }
+
+        return count;
+    }
+
+    size_t GetCapacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    size_t GetIdleCount() const noexcept
+    {
+        return mPool.size();
+    }
+
+    /// @}
+
+#if PROGRAM_MEMORY_TRACKING
+
+    /**
+     * Gets the tag the memory statistics of this pool are recorded in.
+     *
+     * @return  The memory tag.
+     */
+
+    MemoryTag *GetMemoryTag() const noexcept
+    {
+        return mMemoryTag;
+    }
+
+#endif
+
 private:
 
     /// The unused stored objects
@@ -241,6 +432,11 @@ private:
     /// The instantiator we use to create and delete objects.
     AbstractPoolableInstantiator< tBase > *mInstantiator;
 
+#if PROGRAM_MEMORY_TRACKING
+    /// The memory statistics of this pool
+    MemoryTag *mMemoryTag;
+#endif
+
     /**
      * Checks whether we can retrieve an object from our pool,
      * or whether we need to create a new one.
@@ -259,11 +455,37 @@ private:
         }
         else
         {
-            object = mInstantiator->Create();
+            object = CreateObject();
         }
 
         return object;
     }
+
+    /**
+     * Creates a new object with the instantiator.
+     *
+     * @return  The object.
+     */
+
+    tBase *CreateObject()
+    {
+        MEMORY_TRACK_ALLOCATE(mMemoryTag, sizeof(tT));
+
+        return mInstantiator->Create();
+    }
+
+    /**
+     * Destroys an object with the instantiator.
+     *
+     * @param [in,out]  object  The object.
+     */
+
+    void DestroyObject(tBase *object)
+    {
+        MEMORY_TRACK_FREE(mMemoryTag, sizeof(tT));
+
+        mInstantiator->Destroy(object);
+    }
 };
 
 /// @}
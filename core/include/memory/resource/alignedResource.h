@@ -0,0 +1,71 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_ALIGNEDRESOURCE_H__
+#define __ENGINE_ALIGNEDRESOURCE_H__
+
+#include "memory/resource/memoryResource.h"
+
+class HugePageArena;
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * A memory resource with the behaviour of the AlignedAllocator. Memory is taken from the
+ * huge page arena while it has room, and from ZefAlignedMalloc otherwise.
+ *
+ * @threadsafe
+ */
+
+class AlignedResource
+    : public MemoryResource
+{
+public:
+
+    /**
+     * @param [in,out]  arena   (optional) The arena to allocate from first.
+     */
+
+    explicit AlignedResource(HugePageArena *arena = nullptr) noexcept;
+
+    HugePageArena *GetArena() const noexcept;
+
+private:
+
+    HugePageArena *mArena;
+
+    void *DoAllocate(size_t bytes, size_t alignment) override;
+
+    void DoDeallocate(void *ptr, size_t bytes, size_t alignment) override;
+
+    bool DoIsEqual(const MemoryResource &other) const noexcept override;
+};
+
+/// @}
+
+#endif
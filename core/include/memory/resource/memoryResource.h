@@ -0,0 +1,127 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MEMORYRESOURCE_H__
+#define __ENGINE_MEMORYRESOURCE_H__
+
+#include <cstddef>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * An interface to a source of memory, so standard containers can be backed by the arenas and
+ * pools of CoreLib through a ResourceAllocator. Mirrors std::pmr::memory_resource.
+ */
+
+class MemoryResource
+{
+public:
+
+    virtual ~MemoryResource();
+
+    /**
+     * Allocates memory.
+     *
+     * @exception   std::bad_alloc  Thrown when the resource is exhausted.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   (optional) The alignment, should be a power of two.
+     *
+     * @return  The memory.
+     */
+
+    void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        return DoAllocate(bytes, alignment);
+    }
+
+    /**
+     * Gives back memory, with the same size and alignment it was allocated with.
+     *
+     * @param [in,out]  ptr The memory.
+     * @param   bytes       The size in bytes.
+     * @param   alignment   (optional) The alignment.
+     */
+
+    void Deallocate(void *ptr, size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        DoDeallocate(ptr, bytes, alignment);
+    }
+
+    /**
+     * Checks whether memory from this resource can be given back to the other one.
+     *
+     * @param   other   The other resource.
+     *
+     * @return  True if the resources are interchangeable.
+     */
+
+    bool IsEqual(const MemoryResource &other) const noexcept
+    {
+        return this == &other || DoIsEqual(other);
+    }
+
+private:
+
+    virtual void *DoAllocate(size_t bytes, size_t alignment) = 0;
+
+    virtual void DoDeallocate(void *ptr, size_t bytes, size_t alignment) = 0;
+
+    virtual bool DoIsEqual(const MemoryResource &other) const noexcept = 0;
+};
+
+bool operator==(const MemoryResource &lhs, const MemoryResource &rhs) noexcept;
+
+bool operator!=(const MemoryResource &lhs, const MemoryResource &rhs) noexcept;
+
+/**
+ * Gets the resource used by allocators that were not given one. Initially this is an
+ * AlignedResource without arena.
+ *
+ * @threadsafe
+ *
+ * @return  The default resource.
+ */
+
+MemoryResource *GetDefaultMemoryResource() noexcept;
+
+/**
+ * Replaces the default resource.
+ *
+ * @threadsafe
+ *
+ * @param [in,out]  resource    The new default, nullptr restores the initial resource.
+ *
+ * @return  The previous default resource.
+ */
+
+MemoryResource *SetDefaultMemoryResource(MemoryResource *resource) noexcept;
+
+/// @}
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_RESOURCEALLOCATOR_H__
+#define __ENGINE_RESOURCEALLOCATOR_H__
+
+#include "memory/resource/memoryResource.h"
+
+#include <limits>
+#include <new>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * A standard conforming allocator that takes its memory from a MemoryResource, so standard
+ * containers can live in arenas and pools. Like std::pmr::polymorphic_allocator the resource
+ * does not propagate on assignment or swap, and copies of a container use the default resource.
+ *
+ * @code
+ * FrameArenaResource resource(arena);
+ * std::vector< U32, ResourceAllocator< U32 >> values(&resource);
+ * @endcode
+ *
+ * @tparam  T   The allocated type.
+ */
+
+template< class T >
+class ResourceAllocator
+{
+public:
+
+    typedef T value_type;
+
+    ResourceAllocator() noexcept
+        : mResource(GetDefaultMemoryResource())
+    {
+    }
+
+    ResourceAllocator(MemoryResource *resource) noexcept
+        : mResource(resource)
+    {
+    }
+
+    ResourceAllocator(const ResourceAllocator &other) noexcept = default;
+
+    template< class U >
+    ResourceAllocator(const ResourceAllocator< U > &other) noexcept
+        : mResource(other.GetResource())
+    {
+    }
+
+    ResourceAllocator &operator=(const ResourceAllocator &) = delete;
+
+    T *allocate(size_t n)
+    {
+        if (n > std::numeric_limits< size_t >::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast< T * >(mResource->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n)
+    {
+        mResource->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    ResourceAllocator select_on_container_copy_construction() const noexcept
+    {
+        return ResourceAllocator();
+    }
+
+    MemoryResource *GetResource() const noexcept
+    {
+        return mResource;
+    }
+
+private:
+
+    MemoryResource *mResource;
+};
+
+template< class T1, class T2 >
+bool operator==(const ResourceAllocator< T1 > &lhs, const ResourceAllocator< T2 > &rhs) noexcept
+{
+    return *lhs.GetResource() == *rhs.GetResource();
+}
+
+template< class T1, class T2 >
+bool operator!=(const ResourceAllocator< T1 > &lhs, const ResourceAllocator< T2 > &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/// @}
+
+#endif
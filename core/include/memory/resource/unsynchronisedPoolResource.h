@@ -0,0 +1,128 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_UNSYNCHRONISEDPOOLRESOURCE_H__
+#define __ENGINE_UNSYNCHRONISEDPOOLRESOURCE_H__
+
+#include "memory/resource/memoryResource.h"
+
+#include "common/utilClasses.h"
+#include "common/types.h"
+
+#include <vector>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * A memory resource of fixed size pools, like an ObjectPool per power of two block size.
+ * Blocks are carved from chunks taken from the upstream resource and kept in a free list
+ * per size when they are given back, so node based containers reuse their nodes without
+ * touching the heap. Allocations larger than the largest block size, or aligned beyond a
+ * cache line, go straight to the upstream resource.
+ *
+ * The chunks are only given back on Release or destruction, large allocations are given back
+ * to upstream on deallocation.
+ *
+ * @notthreadsafe
+ */
+
+class UnsynchronisedPoolResource
+    : public MemoryResource,
+      public NonCopyable< UnsynchronisedPoolResource >
+{
+public:
+
+    /**
+     * @param   largestBlock        (optional) The largest pooled block size, rounded up to a power of two.
+     * @param   chunkSize           (optional) The size of the chunks taken from upstream.
+     * @param [in,out]  upstream    (optional) The resource the chunks are taken from, nullptr for the default.
+     */
+
+    explicit UnsynchronisedPoolResource(size_t largestBlock = 512, size_t chunkSize = 64 * 1024,
+                                        MemoryResource *upstream = nullptr);
+
+    ~UnsynchronisedPoolResource();
+
+    /**
+     * Gives all chunks back to the upstream resource. Memory taken from this resource
+     * may no longer be used.
+     */
+
+    void Release();
+
+    MemoryResource *GetUpstream() const noexcept;
+
+    size_t GetLargestBlock() const noexcept;
+
+private:
+
+    // the smallest block holds the free list link
+    static const size_t MinBlockShift = 3;
+
+    // blocks are at most aligned to a cache line, larger alignments go upstream
+    static const size_t MaxBlockAlignment = 64;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    std::vector< FreeBlock * > mFreeLists;
+    std::vector< void * > mChunks;
+
+    MemoryResource *mUpstream;
+
+    U8 *mCursor;
+    U8 *mEnd;
+
+    size_t mLargestBlock;
+    size_t mChunkSize;
+
+    void *DoAllocate(size_t bytes, size_t alignment) override;
+
+    void DoDeallocate(void *ptr, size_t bytes, size_t alignment) override;
+
+    bool DoIsEqual(const MemoryResource &other) const noexcept override;
+
+    /**
+     * Gets the free list index of the block that fits an allocation.
+     *
+     * @param   bytes       The size in bytes.
+     * @param   alignment   The alignment.
+     *
+     * @return  The index.
+     */
+
+    static size_t GetBlockIndex(size_t bytes, size_t alignment) noexcept;
+
+    void *Carve(size_t blockSize);
+};
+
+/// @}
+
+#endif
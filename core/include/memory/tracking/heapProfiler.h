@@ -0,0 +1,191 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_HEAPPROFILER_H__
+#define __ENGINE_HEAPPROFILER_H__
+
+#include "common/types.h"
+
+#include "config.h"
+
+#include <atomic>
+#include <ostream>
+#include <string>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * The profiling hooks used by ZefAlignedMalloc and the pool instantiators. They compile to nothing
+ * unless PROGRAM_HEAP_PROFILING is enabled.
+ */
+
+#if PROGRAM_HEAP_PROFILING
+#   define HEAP_PROFILE_ALLOCATE(ptr, bytes, source) HeapProfiler::OnAllocate(ptr, bytes, source)
+#   define HEAP_PROFILE_FREE(ptr, source) HeapProfiler::OnFree(ptr, source)
+#else
+#   define HEAP_PROFILE_ALLOCATE(ptr, bytes, source) ((void)0)
+#   define HEAP_PROFILE_FREE(ptr, source) ((void)0)
+#endif
+
+enum class HeapSampleSource : U8
+{
+    Heap = 1,
+    Pool = 2,
+    All = 3
+};
+
+/**
+ * Live sample totals, scaled to estimate the full heap.
+ */
+
+struct HeapProfileSummary
+{
+    size_t samples;
+    F64 estimatedBytes;
+    F64 estimatedObjects;
+};
+
+/**
+ * A sampling heap profiler. Each thread counts down an exponentially distributed number of
+ * bytes, and the allocation that crosses zero is sampled together with its stack trace, so on
+ * average one sample is taken per sample interval bytes (Poisson sampling). Sampled pointers
+ * stay in a live table until freed, and reports scale every sample by the inverse of its
+ * probability of being sampled.
+ *
+ * Unsampled allocations only decrement a thread local counter, and unsampled frees check a
+ * small counting filter of the sampled addresses, so only sampled operations take the lock.
+ *
+ * Every byte is sampled once. ZefAlignedMalloc samples its allocations as heap memory, which
+ * includes the blocks of the memory pool instantiators. Operator new is not hooked, so the
+ * pool instantiators that create objects with new sample them as pool memory themselves.
+ *
+ * @threadsafe
+ */
+
+class HeapProfiler
+{
+public:
+
+    static const size_t DefaultSampleInterval;
+    static const size_t MaxFrames = 32;
+
+    /**
+     * Sets the mean amount of bytes between samples. Zero disables sampling; threads notice a
+     * change within one megabyte of allocations.
+     *
+     * @param   bytes   The sample interval.
+     */
+
+    static void SetSampleInterval(size_t bytes) noexcept;
+
+    static size_t GetSampleInterval() noexcept;
+
+    static void OnAllocate(const void *ptr, size_t bytes, HeapSampleSource source)
+    {
+        if (ptr != nullptr && (tBytesUntilSample -= static_cast< S64 >(bytes)) < 0)
+        {
+            Sample(GetKey(ptr, source), bytes, source);
+        }
+    }
+
+    static void OnFree(const void *ptr, HeapSampleSource source)
+    {
+        const size_t key = GetKey(ptr, source);
+
+        if (mLiveSamples.load(std::memory_order_relaxed) != 0 &&
+                mFilter[GetFilterIndex(key)].load(std::memory_order_relaxed) != 0)
+        {
+            Remove(key);
+        }
+    }
+
+    static HeapProfileSummary GetSummary(HeapSampleSource sources = HeapSampleSource::All);
+
+    /**
+     * Writes the live samples aggregated per stack trace, largest first, with symbolised frames
+     * where the platform supports it.
+     */
+
+    static void WriteText(std::ostream &stream, HeapSampleSource sources = HeapSampleSource::All);
+
+    /**
+     * Writes the live samples in the legacy heap profile format read by pprof. The counts are
+     * raw samples, pprof scales them with the interval in the header.
+     */
+
+    static void WritePprof(std::ostream &stream, HeapSampleSource sources = HeapSampleSource::All);
+
+    /**
+     * Writes a report to a file.
+     *
+     * @param   path    The file path.
+     * @param   pprof   Whether to write the pprof format instead of text.
+     * @param   sources (optional) The sources to include.
+     *
+     * @return  True if the file could be written.
+     */
+
+    static bool Dump(const std::string &path, bool pprof, HeapSampleSource sources = HeapSampleSource::All);
+
+    /**
+     * Forgets all samples and stacks.
+     */
+
+    static void Reset();
+
+private:
+
+    static const size_t FilterSize = 4096;
+
+    static thread_local S64 tBytesUntilSample;
+
+    static std::atomic< size_t > mLiveSamples;
+    static std::atomic< U32 > mFilter[FilterSize];
+
+    static size_t GetKey(const void *ptr, HeapSampleSource source) noexcept
+    {
+        // keeps the sources apart in the live table, allocations are at least pointer aligned so
+        // the lowest bit is free
+        return reinterpret_cast< size_t >(ptr) | (source == HeapSampleSource::Pool ? 1 : 0);
+    }
+
+    static size_t GetFilterIndex(size_t key) noexcept
+    {
+        // fold the higher bits in for large alignments
+        const size_t address = key >> 3;
+        return (address ^ (address >> 12) ^ key) & (FilterSize - 1);
+    }
+
+    static void Sample(size_t key, size_t bytes, HeapSampleSource source);
+
+    static void Remove(size_t key);
+};
+
+/// @}
+
+#endif
@@ -0,0 +1,253 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MEMORYTAG_H__
+#define __ENGINE_MEMORYTAG_H__
+
+#include "common/namespace.h"
+#include "common/types.h"
+
+#include "threading/perThread.h"
+#include "threading/threadID.h"
+
+#include "config.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * The kind of memory user a tag describes.
+ */
+
+enum class MemoryKind : U8
+{
+    Pool,
+    Allocator,
+    Namespace
+};
+
+/**
+ * A snapshot of the statistics of a memory tag, or of all tags in a namespace.
+ */
+
+struct MemoryStats
+{
+    std::string name;
+    MemoryKind kind;
+    Namespace ns;
+
+    /// The bytes currently held
+    S64 bytes;
+
+    /// The highest amount of bytes held at any collection
+    S64 peakBytes;
+
+    /// The objects currently handed out
+    S64 liveObjects;
+
+    /// The total amount of allocations
+    U64 allocations;
+
+    /// The allocations per second since the previous collection
+    F64 allocationRate;
+};
+
+/**
+ * Counts the memory used by a single pool or allocator. Every thread with a valid thread ID
+ * writes its own counters without atomic read-modify-writes, other threads share one slot.
+ * The counters are only summed when the statistics are collected, so a value may go
+ * negative on one thread when memory is freed by another. Like PerThread, the counters are
+ * only race free while no two live threads share a thread ID.
+ *
+ * Tags are owned by the MemoryTracker, use MemoryTracker::Register to create one.
+ *
+ * @threadsafe
+ */
+
+class MemoryTag
+{
+public:
+
+    MemoryTag(const std::string &name, MemoryKind kind, Namespace ns) noexcept;
+
+    MemoryTag(const MemoryTag &) = delete;
+    MemoryTag &operator=(const MemoryTag &) = delete;
+
+    /**
+     * Records an allocation.
+     *
+     * @param   bytes   The allocated size.
+     */
+
+    void OnAllocate(size_t bytes) noexcept
+    {
+        Update([bytes](Counters & counters, bool shared)
+        {
+            Add(counters.bytes, static_cast< S64 >(bytes), shared);
+            Add(counters.allocations, 1, shared);
+        });
+    }
+
+    /**
+     * Records a deallocation.
+     *
+     * @param   bytes   The freed size.
+     */
+
+    void OnFree(size_t bytes) noexcept
+    {
+        Update([bytes](Counters & counters, bool shared)
+        {
+            Add(counters.bytes, -static_cast< S64 >(bytes), shared);
+        });
+    }
+
+    /**
+     * Records objects being handed out.
+     *
+     * @param   count   (optional) The amount of objects.
+     */
+
+    void OnAcquire(size_t count = 1) noexcept
+    {
+        Update([count](Counters & counters, bool shared)
+        {
+            Add(counters.objects, static_cast< S64 >(count), shared);
+        });
+    }
+
+    /**
+     * Records objects being handed back.
+     *
+     * @param   count   (optional) The amount of objects.
+     */
+
+    void OnRelease(size_t count = 1) noexcept
+    {
+        Update([count](Counters & counters, bool shared)
+        {
+            Add(counters.objects, -static_cast< S64 >(count), shared);
+        });
+    }
+
+    /**
+     * Sets the bytes held by allocators that are cheaper to measure than to count, such as
+     * arenas. The sample is added to the counted bytes.
+     *
+     * @param   bytes   The bytes held.
+     */
+
+    void Sample(size_t bytes) noexcept;
+
+    void SetNamespace(Namespace ns) noexcept;
+
+    Namespace GetNamespace() const noexcept;
+
+    const std::string &GetName() const noexcept;
+
+    MemoryKind GetKind() const noexcept;
+
+    /**
+     * Sums the thread counters. Updates the peak and the allocation rate, so only the
+     * MemoryTracker should call this.
+     *
+     * @param   elapsed The time since the previous collection.
+     *
+     * @return  The statistics.
+     */
+
+    MemoryStats Collect(std::chrono::microseconds elapsed);
+
+private:
+
+    struct Counters
+    {
+        Counters() noexcept
+            : bytes(0),
+              objects(0),
+              allocations(0)
+        {
+        }
+
+        std::atomic< S64 > bytes;
+        std::atomic< S64 > objects;
+        std::atomic< S64 > allocations;
+    };
+
+    // all threads without a valid thread ID share the last slot
+    static const size_t SharedSlot = PerThread< Counters >::SharedSlot;
+
+    PerThread< Counters > mCounters;
+
+    std::string mName;
+
+    std::atomic< S64 > mSampledBytes;
+    std::atomic< U32 > mNamespace;
+
+    S64 mPeakBytes;
+    S64 mLastAllocations;
+
+    MemoryKind mKind;
+
+    template< typename tFunction >
+    void Update(const tFunction &update) noexcept
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        Counters &counters = mCounters.Get(threadID);
+
+        if (PerThread< Counters >::IsShared(threadID))
+        {
+            update(counters, true);
+        }
+        else
+        {
+            ThreadOwnerCheck::Guard guard(mCounters.GetOwnerCheck(threadID));
+            update(counters, false);
+        }
+    }
+
+    static void Add(std::atomic< S64 > &counter, S64 value, bool shared) noexcept
+    {
+        if (shared)
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+        else
+        {
+            // only the owning thread writes its counters
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+};
+
+/// @}
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_MEMORYTRACKER_H__
+#define __ENGINE_MEMORYTRACKER_H__
+
+#include "memory/tracking/memoryTag.h"
+
+#include "config.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// @addtogroup Memory
+/// @{
+
+/**
+ * The tracking hooks used by pools and allocators. They compile to nothing unless
+ * PROGRAM_MEMORY_TRACKING is enabled, in which case the tag may not be null.
+ */
+
+#if PROGRAM_MEMORY_TRACKING
+#   define MEMORY_TRACK_ALLOCATE(tag, bytes) (tag)->OnAllocate(bytes)
+#   define MEMORY_TRACK_FREE(tag, bytes) (tag)->OnFree(bytes)
+#   define MEMORY_TRACK_ACQUIRE(tag) (tag)->OnAcquire()
+#   define MEMORY_TRACK_RELEASE(tag) (tag)->OnRelease()
+#   define MEMORY_TRACK_ACQUIRE_BATCH(tag, count) (tag)->OnAcquire(count)
+#   define MEMORY_TRACK_RELEASE_BATCH(tag, count) (tag)->OnRelease(count)
+#   define MEMORY_TRACK_SAMPLE(tag, bytes) (tag)->Sample(bytes)
+#else
+#   define MEMORY_TRACK_ALLOCATE(tag, bytes) ((void)0)
+#   define MEMORY_TRACK_FREE(tag, bytes) ((void)0)
+#   define MEMORY_TRACK_ACQUIRE(tag) ((void)0)
+#   define MEMORY_TRACK_RELEASE(tag) ((void)0)
+#   define MEMORY_TRACK_ACQUIRE_BATCH(tag, count) ((void)0)
+#   define MEMORY_TRACK_RELEASE_BATCH(tag, count) ((void)0)
+#   define MEMORY_TRACK_SAMPLE(tag, bytes) ((void)0)
+#endif
+
+/**
+ * The registry of all memory tags. The ProfilerManager collects the statistics of every tag
+ * each frame, and aggregates them per namespace.
+ *
+ * @threadsafe
+ */
+
+class MemoryTracker
+{
+public:
+
+    /**
+     * Creates a tag, which stays valid until it is unregistered.
+     *
+     * @param   name    The name of the pool or allocator.
+     * @param   kind    The kind of memory user.
+     * @param   ns      (optional) The namespace the memory belongs to.
+     *
+     * @return  The tag.
+     */
+
+    static MemoryTag *Register(const std::string &name, MemoryKind kind, Namespace ns = 0U);
+
+    static void Unregister(MemoryTag *tag);
+
+    /**
+     * Collects the statistics of all tags.
+     *
+     * @param   elapsed             The time since the previous collection.
+     * @param [out] tags            The statistics per tag.
+     * @param [out] namespaces      The statistics summed per namespace.
+     */
+
+    static void Collect(std::chrono::microseconds elapsed, std::vector< MemoryStats > &tags,
+                        std::vector< MemoryStats > &namespaces);
+};
+
+/// @}
+
+#endif
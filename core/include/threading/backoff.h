@@ -0,0 +1,79 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_BACKOFF_H__
+#define __ENGINE_BACKOFF_H__
+
+#include "common/types.h"
+
+/**
+ * Exponential backoff for busy-wait loops. Every call to Pause() executes twice as many cpu
+ * relax instructions as the previous call, until the maximum is reached, after which the
+ * thread yields its time slice instead. This keeps spinning threads from hammering the
+ * contended cache line, and keeps hyper threaded siblings running.
+ */
+
+class Backoff
+{
+public:
+
+    explicit Backoff(U32 maxSpins = 1024) noexcept;
+
+    /**
+     * Waits for a while, the waiting time grows exponentially with every call.
+     */
+
+    void Pause() noexcept;
+
+    /**
+     * Resets the waiting time to its minimum.
+     */
+
+    void Reset() noexcept;
+
+    /**
+     * Gets the amount of times we paused since construction.
+     *
+     * @return  The pause count.
+     */
+
+    U32 GetCount() const noexcept;
+
+    /**
+     * Hints the processor that we are in a spin-wait loop.
+     */
+
+    static void CpuRelax() noexcept;
+
+private:
+
+    U32 mSpins;
+    U32 mMaxSpins;
+    U32 mCount;
+};
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_CACHEALIGNED_H__
+#define __ENGINE_CACHEALIGNED_H__
+
+#include "common/types.h"
+
+#include "config.h"
+
+#include <type_traits>
+#include <utility>
+
+/**
+ * Gives a value a cache line of its own, so writes to it do not invalidate the lines of
+ * neighbouring data. The alignment only holds for static, automatic and aligned heap storage;
+ * containers of cache aligned values need an AlignedAllocator.
+ *
+ * @tparam  tT  The value type.
+ */
+
+template< typename tT >
+struct alignas(PROGRAM_CACHE_LINE_SIZE) CacheAligned
+{
+    CacheAligned()
+        : value()
+    {
+    }
+
+    template< typename tArg, typename = std::enable_if_t< !std::is_same< std::decay_t< tArg >, CacheAligned >::value >>
+    explicit CacheAligned(tArg &&init)
+        : value(std::forward< tArg >(init))
+    {
+    }
+
+    tT &operator*() noexcept
+    {
+        return value;
+    }
+
+    const tT &operator*() const noexcept
+    {
+        return value;
+    }
+
+    tT *operator->() noexcept
+    {
+        return &value;
+    }
+
+    const tT *operator->() const noexcept
+    {
+        return &value;
+    }
+
+    tT value;
+};
+
+#endif
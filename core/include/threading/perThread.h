@@ -0,0 +1,209 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_PERTHREAD_H__
+#define __ENGINE_PERTHREAD_H__
+
+#include "threading/cacheAligned.h"
+#include "threading/threadID.h"
+#include "threading/threadOwnerCheck.h"
+
+#include "memory/allocators/malloc.h"
+
+#include "manager/scheduleManager.h"
+
+#include "common/utilClasses.h"
+
+#include "config.h"
+
+#include <new>
+
+/**
+ * One value per engine thread, each on its own cache line, indexed by the thread ID set through
+ * ScheduleManager::SetCurrentThreadID. The main thread and the workers own their slot; every
+ * thread without a valid ID, such as loaders and foreign threads, shares the last slot, so
+ * values that are written from the shared slot need to be thread safe themselves.
+ *
+ * An owned slot may be written without synchronisation only while no other live thread uses
+ * the same thread ID. Nothing enforces this, so writers should hold a ThreadOwnerCheck::Guard
+ * on GetOwnerCheck(), which asserts on it in debug builds.
+ *
+ * The slots are allocated with cache line alignment, since operator new does not honour
+ * over-aligned types before C++17.
+ *
+ * @tparam  tT  The value type.
+ */
+
+template< typename tT >
+class PerThread
+    : NonCopyable< PerThread< tT >>
+{
+public:
+
+    static const size_t SharedSlot = PROGRAM_MAX_THREADS + 1;
+    static const size_t SlotCount = SharedSlot + 1;
+
+    PerThread()
+        : mSlots(Allocate())
+    {
+        for (size_t i = 0; i < SlotCount; ++i)
+        {
+            new(mSlots + i) CacheAligned< tT >();
+        }
+    }
+
+    explicit PerThread(const tT &value)
+        : mSlots(Allocate())
+    {
+        for (size_t i = 0; i < SlotCount; ++i)
+        {
+            new(mSlots + i) CacheAligned< tT >(value);
+        }
+    }
+
+    ~PerThread()
+    {
+        for (size_t i = 0; i < SlotCount; ++i)
+        {
+            mSlots[i].~CacheAligned< tT >();
+        }
+
+        ZefAlignedFree(mSlots);
+    }
+
+    /**
+     * Gets the value of the calling thread.
+     *
+     * @return  The value.
+     */
+
+    tT &Get() noexcept
+    {
+        return Get(ScheduleManager::GetCurrentThreadID());
+    }
+
+    tT &Get(ThreadID threadID) noexcept
+    {
+        return mSlots[GetSlot(threadID)].value;
+    }
+
+    const tT &Get(ThreadID threadID) const noexcept
+    {
+        return mSlots[GetSlot(threadID)].value;
+    }
+
+    tT &operator[](size_t slot) noexcept
+    {
+        return mSlots[slot].value;
+    }
+
+    const tT &operator[](size_t slot) const noexcept
+    {
+        return mSlots[slot].value;
+    }
+
+    /**
+     * Calls the function for the value of every slot, including the shared slot.
+     *
+     * @param   function    The function.
+     */
+
+    template< typename tFunction >
+    void ForEach(const tFunction &function)
+    {
+        for (size_t i = 0; i < SlotCount; ++i)
+        {
+            function(mSlots[i].value);
+        }
+    }
+
+    template< typename tFunction >
+    void ForEach(const tFunction &function) const
+    {
+        for (size_t i = 0; i < SlotCount; ++i)
+        {
+            function(static_cast< const tT & >(mSlots[i].value));
+        }
+    }
+
+    /**
+     * Gets the check that guards an owned slot against two threads with the same thread ID.
+     *
+     * @param   threadID    The thread ID.
+     *
+     * @return  The check.
+     */
+
+    ThreadOwnerCheck &GetOwnerCheck(ThreadID threadID) noexcept
+    {
+        return mOwnerChecks[GetSlot(threadID)];
+    }
+
+    static size_t GetSlot(ThreadID threadID) noexcept
+    {
+        return threadID < SharedSlot ? threadID : SharedSlot;
+    }
+
+    /**
+     * Query if the thread writes to the shared slot.
+     *
+     * @param   threadID    The thread ID.
+     *
+     * @return  True if the slot is shared with other threads.
+     */
+
+    static bool IsShared(ThreadID threadID) noexcept
+    {
+        return threadID >= SharedSlot;
+    }
+
+private:
+
+    CacheAligned< tT > *mSlots;
+
+    ThreadOwnerCheck mOwnerChecks[SlotCount];
+
+    static CacheAligned< tT > *Allocate()
+    {
+        void *const slots = ZefAlignedMalloc(sizeof(CacheAligned< tT >) * SlotCount, alignof(CacheAligned< tT >));
+
+        if (!slots)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast< CacheAligned< tT > * >(slots);
+    }
+};
+
+template< typename tT >
+const size_t PerThread< tT >::SharedSlot;
+
+template< typename tT >
+const size_t PerThread< tT >::SlotCount;
+
+#endif
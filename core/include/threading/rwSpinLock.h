@@ -0,0 +1,118 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_RWSPINLOCK_H__
+#define __ENGINE_RWSPINLOCK_H__
+
+#include "common/types.h"
+
+#include "external/atomic.h"
+
+/**
+ * A counter based reader-writer spinlock, meant for read-mostly data. Any amount of readers
+ * can hold the lock at the same time, while a writer has exclusive access. A waiting writer
+ * marks the lock as pending, which stops new readers from entering so writers cannot be
+ * starved by a steady stream of readers.
+ *
+ * Both sides wait with an exponential backoff, and every acquisition that could not be taken
+ * immediately is counted, so hot locks can be found.
+ *
+ * The interface matches the standard Lockable and SharedLockable concepts, so the lock can be
+ * used with std::lock_guard and std::shared_lock.
+ *
+ * @threadsafe
+ */
+
+class RWSpinLock
+{
+public:
+
+    RWSpinLock() noexcept;
+
+    /// @name Exclusive Access
+    /// @{
+
+    void lock() noexcept;
+
+    bool try_lock() noexcept;
+
+    void unlock() noexcept;
+
+    /// @}
+
+    /// @name Shared Access
+    /// @{
+
+    void lock_shared() noexcept;
+
+    bool try_lock_shared() noexcept;
+
+    void unlock_shared() noexcept;
+
+    /// @}
+
+    /// @name Statistics
+    /// @{
+
+    /**
+     * Gets the amount of shared acquisitions that had to wait.
+     *
+     * @return  The read contention count.
+     */
+
+    U64 GetReadContentionCount() const noexcept;
+
+    /**
+     * Gets the amount of exclusive acquisitions that had to wait.
+     *
+     * @return  The write contention count.
+     */
+
+    U64 GetWriteContentionCount() const noexcept;
+
+    void ResetContentionCounts() noexcept;
+
+    /// @}
+
+private:
+
+    enum : U32
+    {
+        Writer = 0x01,
+        WriterPending = 0x02,
+        Reader = 0x04
+    };
+
+    boost::atomic< U32 > mState;
+
+    boost::atomic< U64 > mReadContention;
+    boost::atomic< U64 > mWriteContention;
+
+    RWSpinLock(const RWSpinLock &);
+};
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SEQLOCK_H__
+#define __ENGINE_SEQLOCK_H__
+
+#include "threading/backoff.h"
+
+#include "common/types.h"
+
+#include "external/atomic.h"
+
+#include <type_traits>
+#include <cstring>
+
+/**
+ * A sequence lock that guards a small plain old data snapshot. Readers never write to shared
+ * memory; they copy the value optimistically and retry when a writer changed it in the
+ * meantime. Writers are serialised among each other and never wait for readers. This makes
+ * the lock ideal for values that are read very often and written rarely, such as frame
+ * timings or configuration snapshots.
+ *
+ * @threadsafe
+ *
+ * @tparam  tT  The guarded type, it should be trivially copyable.
+ */
+
+template< typename tT >
+class SeqLock
+{
+public:
+
+    static_assert(std::is_trivially_copyable< tT >::value,
+                  "SeqLock:\n\tThe guarded type should be trivially copyable.");
+
+    SeqLock() noexcept
+        : mSequence(0),
+          mReadRetries(0),
+          mWriteContention(0),
+          mValue()
+    {
+    }
+
+    explicit SeqLock(const tT &value) noexcept
+        : mSequence(0),
+          mReadRetries(0),
+          mWriteContention(0),
+          mValue(value)
+    {
+    }
+
+    /**
+     * Reads a consistent snapshot of the value.
+     *
+     * @return  The value.
+     */
+
+    tT Read() const noexcept
+    {
+        tT result;
+        Backoff backoff;
+
+        for (;;)
+        {
+            const U32 sequence = mSequence.load(boost::memory_order_acquire);
+
+            // an odd sequence means a write is in progress
+            if ((sequence & 1) == 0)
+            {
+                std::memcpy(&result, &mValue, sizeof(tT));
+                boost::atomic_thread_fence(boost::memory_order_acquire);
+
+                if (mSequence.load(boost::memory_order_relaxed) == sequence)
+                {
+                    return result;
+                }
+            }
+
+            mReadRetries.fetch_add(1, boost::memory_order_relaxed);
+            backoff.Pause();
+        }
+    }
+
+    /**
+     * Replaces the value.
+     *
+     * @param   value   The new value.
+     */
+
+    void Write(const tT &value) noexcept
+    {
+        const U32 sequence = BeginWrite();
+
+        std::memcpy(&mValue, &value, sizeof(tT));
+
+        mSequence.store(sequence + 2, boost::memory_order_release);
+    }
+
+    /// @name Statistics
+    /// @{
+
+    /**
+     * Gets the amount of times a reader had to retry because of a concurrent write.
+     *
+     * @return  The read retry count.
+     */
+
+    U64 GetReadRetryCount() const noexcept
+    {
+        return mReadRetries.load(boost::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the amount of writes that had to wait for another writer.
+     *
+     * @return  The write contention count.
+     */
+
+    U64 GetWriteContentionCount() const noexcept
+    {
+        return mWriteContention.load(boost::memory_order_relaxed);
+    }
+
+    /// @}
+
+private:
+
+    boost::atomic< U32 > mSequence;
+
+    mutable boost::atomic< U64 > mReadRetries;
+    boost::atomic< U64 > mWriteContention;
+
+    tT mValue;
+
+    /**
+     * Makes the sequence odd, so readers know a write is in progress.
+     *
+     * @return  The even sequence number from before the write.
+     */
+
+    U32 BeginWrite() noexcept
+    {
+        U32 sequence = mSequence.load(boost::memory_order_relaxed);
+
+        if ((sequence & 1) == 0 &&
+            mSequence.compare_exchange_strong(sequence, sequence + 1, boost::memory_order_acquire,
+                                              boost::memory_order_relaxed))
+        {
+            boost::atomic_thread_fence(boost::memory_order_release);
+            return sequence;
+        }
+
+        mWriteContention.fetch_add(1, boost::memory_order_relaxed);
+
+        Backoff backoff;
+
+        for (;;)
+        {
+            sequence = mSequence.load(boost::memory_order_relaxed);
+
+            if ((sequence & 1) == 0 &&
+                mSequence.compare_exchange_weak(sequence, sequence + 1, boost::memory_order_acquire,
+                                                boost::memory_order_relaxed))
+            {
+                boost::atomic_thread_fence(boost::memory_order_release);
+                return sequence;
+            }
+
+            backoff.Pause();
+        }
+    }
+
+    SeqLock(const SeqLock &);
+};
+
+#endif
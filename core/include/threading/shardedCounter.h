@@ -0,0 +1,91 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SHARDEDCOUNTER_H__
+#define __ENGINE_SHARDEDCOUNTER_H__
+
+#include "threading/perThread.h"
+
+#include "common/types.h"
+
+#include <atomic>
+
+/**
+ * A counter that is cheap to change from many threads and more expensive to read. Every engine
+ * thread adds to its own cache line without a locked instruction, threads without a valid
+ * thread ID share one atomic shard. Reading sums all shards, so a read concurrent with changes
+ * sees some of them. Like PerThread, this relies on no two live threads sharing a thread ID.
+ *
+ * @threadsafe
+ */
+
+class ShardedCounter
+    : NonCopyable< ShardedCounter >
+{
+public:
+
+    void Add(S64 value) noexcept
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        std::atomic< S64 > &shard = mShards.Get(threadID);
+
+        if (PerThread< std::atomic< S64 >>::IsShared(threadID))
+        {
+            shard.fetch_add(value, std::memory_order_relaxed);
+        }
+        else
+        {
+            // only the owning thread writes its shard
+            ThreadOwnerCheck::Guard guard(mShards.GetOwnerCheck(threadID));
+            shard.store(shard.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    void Increment() noexcept
+    {
+        Add(1);
+    }
+
+    void Decrement() noexcept
+    {
+        Add(-1);
+    }
+
+    S64 Get() const noexcept;
+
+    /**
+     * Sets all shards to zero, no thread may change the counter meanwhile.
+     */
+
+    void Reset() noexcept;
+
+private:
+
+    PerThread< std::atomic< S64 >> mShards;
+};
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_SNAPSHOTPTR_H__
+#define __ENGINE_SNAPSHOTPTR_H__
+
+#include "threading/perThread.h"
+
+#include "common/utilClasses.h"
+#include "common/types.h"
+
+#include <atomic>
+#include <vector>
+
+/**
+ * Publishes an immutable snapshot to readers that never lock. A writer builds a new snapshot
+ * and publishes it, the replaced snapshot is retired and deleted once no reader can still use
+ * it.
+ *
+ * Every reader marks itself active in the counter of its own thread slot, so readers on
+ * different threads do not share a cache line. After publishing, the writer sums the counters;
+ * when all are zero, no reader can hold a retired snapshot anymore, since readers that start
+ * later see the new one. While readers are active the retired snapshots are kept until a later
+ * publish or the destruction of the pointer.
+ *
+ * Example:
+ * @code
+ *      SnapshotPtr< std::vector< U32 >> values;
+ *      values.Publish(new std::vector< U32 >(10, 42));
+ *
+ *      {
+ *          SnapshotPtr< std::vector< U32 >>::Reader reader(values);
+ *          reader->size(); // 10, even when another thread publishes meanwhile
+ *      }
+ * @endcode
+ *
+ * @note    Publish is not serialised, writers should hold a lock of their own.
+ *
+ * @threadsafe
+ *
+ * @tparam  tT  Type of the snapshot.
+ */
+
+template< typename tT >
+class SnapshotPtr
+    : NonCopyable< SnapshotPtr< tT >>
+{
+public:
+
+    /**
+     * Keeps the current snapshot alive as long as it exists. Readers should be short lived,
+     * since they hold off the deletion of retired snapshots.
+     */
+
+    class Reader
+        : NonCopyable< Reader >
+    {
+    public:
+
+        explicit Reader(const SnapshotPtr &owner) noexcept
+            : mActive(owner.mReaders.Get()),
+              mSnapshot(nullptr)
+        {
+            // the increment has to be visible before we load, which needs sequential consistency
+            mActive.fetch_add(1, std::memory_order_seq_cst);
+            mSnapshot = owner.mSnapshot.load(std::memory_order_seq_cst);
+        }
+
+        ~Reader() noexcept
+        {
+            mActive.fetch_sub(1, std::memory_order_release);
+        }
+
+        const tT *Get() const noexcept
+        {
+            return mSnapshot;
+        }
+
+        const tT *operator->() const noexcept
+        {
+            return mSnapshot;
+        }
+
+        const tT &operator*() const noexcept
+        {
+            return *mSnapshot;
+        }
+
+    private:
+
+        std::atomic< U32 > &mActive;
+        const tT *mSnapshot;
+    };
+
+    SnapshotPtr() noexcept
+        : mSnapshot(nullptr)
+    {
+    }
+
+    explicit SnapshotPtr(tT *snapshot) noexcept
+        : mSnapshot(snapshot)
+    {
+    }
+
+    /**
+     * Destructor, no reader may be active anymore.
+     */
+
+    ~SnapshotPtr() noexcept
+    {
+        delete mSnapshot.load(std::memory_order_relaxed);
+
+        for (tT *snapshot : mRetired)
+        {
+            delete snapshot;
+        }
+    }
+
+    /**
+     * Replaces the snapshot readers get, and takes ownership of the given one.
+     *
+     * @param [in]  snapshot    The new snapshot, created with new.
+     */
+
+    void Publish(tT *snapshot)
+    {
+        tT *const replaced = mSnapshot.exchange(snapshot, std::memory_order_seq_cst);
+
+        if (replaced)
+        {
+            mRetired.push_back(replaced);
+        }
+
+        Reclaim();
+    }
+
+    /**
+     * Gets the amount of replaced snapshots that still wait for readers to finish.
+     *
+     * @return  The retired count.
+     */
+
+    size_t GetRetiredCount() const noexcept
+    {
+        return mRetired.size();
+    }
+
+    /**
+     * Deletes the retired snapshots when no reader is active. Publish already tries this, so
+     * writers only need it to free snapshots that were retired while readers were active.
+     */
+
+    void Reclaim() noexcept
+    {
+        if (mRetired.empty())
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < PerThread< std::atomic< U32 >>::SlotCount; ++i)
+        {
+            if (mReaders[i].load(std::memory_order_seq_cst) != 0)
+            {
+                return;
+            }
+        }
+
+        for (tT *snapshot : mRetired)
+        {
+            delete snapshot;
+        }
+
+        mRetired.clear();
+    }
+
+private:
+
+    std::atomic< tT * > mSnapshot;
+
+    // readers of a const pointer still have to mark themselves active
+    mutable PerThread< std::atomic< U32 >> mReaders;
+
+    std::vector< tT * > mRetired;
+};
+
+#endif
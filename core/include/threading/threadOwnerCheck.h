@@ -0,0 +1,130 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#pragma once
+#ifndef __ENGINE_THREADOWNERCHECK_H__
+#define __ENGINE_THREADOWNERCHECK_H__
+
+#include "preproc/config.h"
+
+#include <assert.h>
+
+#if IS_DEBUG
+#   include <atomic>
+#   include <thread>
+#endif
+
+/**
+ * Checks that a value written without synchronisation is only used by one thread at a time.
+ *
+ * Per thread values are indexed by the thread ID of ScheduleManager, and only stay race free
+ * when no two live threads use the same ID at once. Nothing enforces that:
+ * ScheduleManager::SetCurrentThreadID is public, and every ThreadPool picks its own IDs. Debug
+ * builds therefore record the std::thread::id that is using the value, and assert when another
+ * thread enters meanwhile. The same thread may enter again, and a thread may take over the
+ * value after another one left it. Release builds check nothing.
+ *
+ * @threadsafe
+ */
+
+class ThreadOwnerCheck
+{
+public:
+
+    /**
+     * Marks the value as used by the calling thread for its lifetime.
+     */
+
+    class Guard
+    {
+    public:
+
+        explicit Guard(ThreadOwnerCheck &check) noexcept
+#if IS_DEBUG
+            : mCheck(check),
+              mEntered(check.Enter())
+#endif
+        {
+            (void)check;
+        }
+
+        ~Guard() noexcept
+        {
+#if IS_DEBUG
+
+            if (mEntered)
+            {
+                mCheck.Leave();
+            }
+
+#endif
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    private:
+
+#if IS_DEBUG
+        ThreadOwnerCheck &mCheck;
+        const bool mEntered;
+#endif
+    };
+
+    ThreadOwnerCheck() noexcept
+#if IS_DEBUG
+        : mOwner(std::thread::id())
+#endif
+    {
+    }
+
+private:
+
+#if IS_DEBUG
+
+    // the thread using the value, or the default id when none
+    std::atomic< std::thread::id > mOwner;
+
+    bool Enter() noexcept
+    {
+        const std::thread::id self = std::this_thread::get_id();
+        const std::thread::id owner = mOwner.exchange(self, std::memory_order_acquire);
+
+        assert((owner == std::thread::id() || owner == self) &&
+               "ThreadOwnerCheck: two threads use the same thread ID at once");
+
+        return owner != self;
+    }
+
+    void Leave() noexcept
+    {
+        mOwner.store(std::thread::id(), std::memory_order_release);
+    }
+
+#endif
+};
+
+#endif
@@ -46,7 +46,16 @@ class ThreadPool
 
 public:
 
-    explicit ThreadPool(const U32 capacity = 16, const U32 startThreadID = 0) noexcept;
+    /**
+     * Constructor.
+     *
+     * @param   capacity        (optional) The amount of worker threads.
+     * @param   startThreadID   (optional) The thread ID of the first worker, the others count up
+     *                          from it. The IDs index per thread storage, so they may not overlap
+     *                          with the main thread or another pool.
+     */
+
+    explicit ThreadPool(const U32 capacity = 16, const U32 startThreadID = 1) noexcept;
     ~ThreadPool() noexcept;
 
     void Init();
@@ -30,6 +30,10 @@
 
 #include "threading/threadID.h"
 
+#include "common/types.h"
+
+#include "config.h"
+
 #include <condition_variable>
 #include <atomic>
 #include <mutex>
@@ -74,8 +78,14 @@ private:
 
     JobQueue **mQueueHook;
 
+    // the main thread polls and sets the flags of all workers, so every flag is padded by a
+    // full cache line on both sides. Padding instead of alignas keeps the worker, and the
+    // managers holding one, at their natural alignment, which plain new can honour
+    U8 mPadding0[PROGRAM_CACHE_LINE_SIZE];
     std::atomic< bool > mIsRunning;
+    U8 mPadding1[PROGRAM_CACHE_LINE_SIZE];
     std::atomic< bool > mTerminate;
+    U8 mPadding2[PROGRAM_CACHE_LINE_SIZE];
 };
 
 #endif
\ No newline at end of file
@@ -50,6 +50,19 @@ namespace Hash
         return hash;
     }
 
+    U32 Fnv1a(const char *data, size_t length) noexcept
+    {
+        U32 hash = 2166136261u;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= data[i];
+            hash *= 16777619u; //-V127
+        }
+
+        return hash;
+    }
+
     size_t Combine(size_t seed, size_t val) noexcept
     {
         //rotating hash combine!
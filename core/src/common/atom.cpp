@@ -0,0 +1,237 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "common/atom.h"
+
+#include "algorithm/hash.h"
+
+#include "threading/rwSpinLock.h"
+
+#include "manager/systemManager.h"
+
+#include <assert.h>
+#include <string.h>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+class AtomStorage
+{
+public:
+
+    struct Entry
+    {
+        std::string string;
+        U32 hash;
+
+        // the next atom with the same hash
+        U32 next;
+    };
+
+    AtomStorage()
+        : collisions(0)
+    {
+        // atom zero is the invalid atom
+        entries.push_back({ std::string(), 0, 0 });
+    }
+
+    // a deque never moves its elements, so strings handed out stay valid
+    std::deque< Entry > entries;
+    std::unordered_map< U32, U32 > heads;
+    size_t collisions;
+    RWSpinLock lock;
+};
+
+namespace
+{
+    U32 FindEntry(const AtomStorage &table, const char *str, size_t length, U32 hash)
+    {
+        auto it = table.heads.find(hash);
+
+        if (it == table.heads.end())
+        {
+            return 0;
+        }
+
+        for (U32 id = it->second; id != 0; id = table.entries[id].next)
+        {
+            const std::string &string = table.entries[id].string;
+
+            if (string.size() == length && memcmp(string.data(), str, length) == 0)
+            {
+                return id;
+            }
+        }
+
+        return 0;
+    }
+}
+
+Atom::Atom(const std::string &str)
+    : mID(AtomTable::Intern(str).mID)
+{
+}
+
+U32 Atom::Intern(const char *str)
+{
+    return AtomTable::Intern(str, strlen(str), Hash::Fnv1a(str)).mID;
+}
+
+const std::string &Atom::GetString() const
+{
+    return AtomTable::GetString(*this);
+}
+
+Atom AtomTable::Intern(const std::string &str)
+{
+    return Intern(str.c_str(), str.size(), Hash::Fnv1a(str.c_str()));
+}
+
+Atom AtomTable::Find(const std::string &str)
+{
+    const U32 hash = Hash::Fnv1a(str.c_str());
+
+    AtomStorage &table = *GetStorage();
+    table.lock.lock_shared();
+
+    const U32 id = FindEntry(table, str.c_str(), str.size(), hash);
+
+    table.lock.unlock_shared();
+
+    return Atom(id);
+}
+
+Atom AtomTable::Find(const StringHash &hash)
+{
+    AtomStorage &table = *GetStorage();
+    table.lock.lock_shared();
+
+    auto it = table.heads.find(hash.GetHash());
+    const U32 id = it != table.heads.end() ? it->second : 0;
+
+    assert((id == 0 || table.entries[id].next == 0) && "AtomTable::Find(): the hash is shared by several strings");
+
+    table.lock.unlock_shared();
+
+    return Atom(id);
+}
+
+const std::string &AtomTable::GetString(Atom atom)
+{
+    AtomStorage &table = *GetStorage();
+    table.lock.lock_shared();
+
+    assert(atom.GetID() < table.entries.size());
+    const std::string &string = table.entries[atom.GetID()].string;
+
+    table.lock.unlock_shared();
+
+    return string;
+}
+
+AtomStorage *AtomTable::GetStorage()
+{
+    SystemManager *system = SystemManager::Get();
+
+    if (system != nullptr)
+    {
+        return system->GetAtomStorage();
+    }
+
+    return GetModuleStorage();
+}
+
+AtomStorage *AtomTable::GetModuleStorage()
+{
+    // never destroyed, since static objects may still use their atoms during shutdown
+    static AtomStorage *storage = new AtomStorage;
+    return storage;
+}
+
+size_t AtomTable::GetSize()
+{
+    AtomStorage &table = *GetStorage();
+    table.lock.lock_shared();
+
+    const size_t size = table.entries.size() - 1;
+
+    table.lock.unlock_shared();
+
+    return size;
+}
+
+size_t AtomTable::GetCollisionCount()
+{
+    AtomStorage &table = *GetStorage();
+    table.lock.lock_shared();
+
+    const size_t collisions = table.collisions;
+
+    table.lock.unlock_shared();
+
+    return collisions;
+}
+
+Atom AtomTable::Intern(const char *str, size_t length, U32 hash)
+{
+    AtomStorage &table = *GetStorage();
+
+    table.lock.lock_shared();
+    U32 id = FindEntry(table, str, length, hash);
+    table.lock.unlock_shared();
+
+    if (id != 0)
+    {
+        return Atom(id);
+    }
+
+    std::lock_guard< RWSpinLock > lock(table.lock);
+
+    // another thread may have interned the string meanwhile
+    id = FindEntry(table, str, length, hash);
+
+    if (id != 0)
+    {
+        return Atom(id);
+    }
+
+    id = static_cast< U32 >(table.entries.size());
+
+    auto result = table.heads.emplace(hash, id);
+    U32 next = 0;
+
+    if (!result.second)
+    {
+        // keep the first string the head, so hash lookups stay stable
+        next = table.entries[result.first->second].next;
+        table.entries[result.first->second].next = id;
+        ++table.collisions;
+    }
+
+    table.entries.push_back({ std::string(str, length), hash, next });
+
+    return Atom(id);
+}
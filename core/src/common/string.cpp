@@ -121,34 +121,7 @@ bool String::IsWhiteSpace(const std::string &str)
 std::vector< std::string > String::Split(const std::string &str, char sep, bool trim /*= false */) noexcept
 {
     std::vector< std::string > output;
-
-    std::string::size_type pos, prevPos = 0;
-
-    //loop over all delimiter positions
-    while ((pos = str.find(sep, prevPos + 1)) != std::string::npos)
-    {
-        std::string token = str.substr(prevPos, pos - prevPos);
-
-        if (trim)
-        {
-            token = Trim(token);
-        }
-
-        output.push_back(token);
-
-        prevPos = pos + 1;
-    }
-
-    //wont catch the last bit
-    std::string token = str.substr(prevPos, str.size());
-
-    if (trim)
-    {
-        token = Trim(token);
-    }
-
-    output.push_back(token);
-
+    Split(str, sep, output, trim);
     return output;
 }
 
@@ -0,0 +1,89 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "common/typeID.h"
+
+#include "manager/systemManager.h"
+
+TypeRegistry::TypeRegistry()
+{
+}
+
+TypeID TypeRegistry::Register(const std::type_index &type)
+{
+    std::lock_guard< std::mutex > lock(mMutex);
+
+    auto it = mIDs.find(type);
+
+    if (it != mIDs.end())
+    {
+        return TypeID(it->second);
+    }
+
+    mTypes.push_back(type);
+
+    const U32 id = static_cast< U32 >(mTypes.size());
+    mIDs.emplace(type, id);
+
+    return TypeID(id);
+}
+
+const char *TypeRegistry::GetName(TypeID id)
+{
+    std::lock_guard< std::mutex > lock(mMutex);
+
+    if (!id.IsValid() || id.GetID() > mTypes.size())
+    {
+        return "";
+    }
+
+    return mTypes[id.GetID() - 1].name();
+}
+
+size_t TypeRegistry::GetSize()
+{
+    std::lock_guard< std::mutex > lock(mMutex);
+
+    return mTypes.size();
+}
+
+TypeRegistry *TypeRegistry::Get()
+{
+    SystemManager *system = SystemManager::Get();
+
+    if (system != nullptr)
+    {
+        return system->GetTypeRegistry();
+    }
+
+    return GetModuleRegistry();
+}
+
+TypeRegistry *TypeRegistry::GetModuleRegistry()
+{
+    static TypeRegistry *registry = new TypeRegistry;
+    return registry;
+}
@@ -38,6 +38,23 @@ U32 Util::BitExponent(const U64 in) noexcept
     return static_cast<U32>(Mathf::Log2(in));
 }
 
+void Util::FaultIn(void *memory, size_t size) noexcept
+{
+    // the smallest page size we run on, touching more often is harmless
+    const size_t pageSize = 4096;
+    volatile U8 *const bytes = static_cast< volatile U8 * >(memory);
+
+    for (size_t i = 0; i < size; i += pageSize)
+    {
+        bytes[i] = bytes[i];
+    }
+
+    if (size > 0)
+    {
+        bytes[size - 1] = bytes[size - 1];
+    }
+}
+
 std::tm Util::Now() noexcept
 {
 #include "warnings/push.h"
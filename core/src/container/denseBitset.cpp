@@ -26,6 +26,122 @@
 
 #include "container/denseBitset.h"
 
+#include "preproc/hw.h"
+
+#include <algorithm>
+#include <assert.h>
+
+#if HW_HAS_SIMD_X86_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace
+{
+    struct And
+    {
+        static U64 Apply(U64 a, U64 b) noexcept
+        {
+            return a & b;
+        }
+
+#if HW_HAS_SIMD_X86_SSE2
+        static __m128i Apply(__m128i a, __m128i b) noexcept
+        {
+            return _mm_and_si128(a, b);
+        }
+#endif
+    };
+
+    struct Or
+    {
+        static U64 Apply(U64 a, U64 b) noexcept
+        {
+            return a | b;
+        }
+
+#if HW_HAS_SIMD_X86_SSE2
+        static __m128i Apply(__m128i a, __m128i b) noexcept
+        {
+            return _mm_or_si128(a, b);
+        }
+#endif
+    };
+
+    struct Xor
+    {
+        static U64 Apply(U64 a, U64 b) noexcept
+        {
+            return a ^ b;
+        }
+
+#if HW_HAS_SIMD_X86_SSE2
+        static __m128i Apply(__m128i a, __m128i b) noexcept
+        {
+            return _mm_xor_si128(a, b);
+        }
+#endif
+    };
+
+    struct AndNot
+    {
+        static U64 Apply(U64 a, U64 b) noexcept
+        {
+            return a & ~b;
+        }
+
+#if HW_HAS_SIMD_X86_SSE2
+        static __m128i Apply(__m128i a, __m128i b) noexcept
+        {
+            // the intrinsic negates its first operand
+            return _mm_andnot_si128(b, a);
+        }
+#endif
+    };
+
+    template< typename tOperation >
+    void Combine(std::vector< U64 > &bits, const std::vector< U64 > &other) noexcept
+    {
+        const size_t count = std::min(bits.size(), other.size());
+        U64 *const target = bits.data();
+        const U64 *const source = other.data();
+
+        size_t i = 0;
+
+#if HW_HAS_SIMD_X86_SSE2
+
+        // four words per iteration, so two loads can be in flight per operand
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i *const a = reinterpret_cast< __m128i * >(target + i);
+            const __m128i *const b = reinterpret_cast< const __m128i * >(source + i);
+
+            const __m128i low = tOperation::Apply(_mm_loadu_si128(a), _mm_loadu_si128(b));
+            const __m128i high = tOperation::Apply(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1));
+
+            _mm_storeu_si128(a, low);
+            _mm_storeu_si128(a + 1, high);
+        }
+
+#endif
+
+        for (; i < count; ++i)
+        {
+            target[i] = tOperation::Apply(target[i], source[i]);
+        }
+    }
+
+    const size_t WordsPerBlock = 8;
+
+    size_t SelectInWord(U64 word, size_t n) noexcept
+    {
+        for (; n > 0; --n)
+        {
+            word &= word - 1;
+        }
+
+        return DenseBitset::CountTrailingZeros(word);
+    }
+}
 
 const DenseBitset::BitReference &DenseBitset::BitReference::operator=(bool val) const noexcept
 {
@@ -59,6 +175,7 @@ DenseBitset::BitReference::BitReference(U64 &integer, U64 mask) noexcept
 }
 
 DenseBitset::DenseBitset(size_t size /*= 0 */) noexcept
+    : mSize(0)
 {
     Resize(size);
 }
@@ -70,7 +187,11 @@ void DenseBitset::Reset() noexcept
 
 void DenseBitset::Resize(size_t size) noexcept
 {
-    mBits.resize((size >> 6) + 1);
+    mSize = size;
+    mBits.resize((size + 63) >> 6);
+
+    // the bits cut off by shrinking should not come back when growing again
+    ClearTail();
 }
 
 bool DenseBitset::operator[](size_t bit) const noexcept
@@ -81,4 +202,237 @@ bool DenseBitset::operator[](size_t bit) const noexcept
 DenseBitset::BitReference DenseBitset::operator[](size_t bit) noexcept
 {
     return BitReference(mBits[bit >> 6], static_cast< U64 >(1) << (bit & 63));
-}
\ No newline at end of file
+}
+
+DenseBitset &DenseBitset::operator&=(const DenseBitset &other) noexcept
+{
+    assert(mSize == other.mSize);
+    Combine< And >(mBits, other.mBits);
+    return *this;
+}
+
+DenseBitset &DenseBitset::operator|=(const DenseBitset &other) noexcept
+{
+    assert(mSize == other.mSize);
+    Combine< Or >(mBits, other.mBits);
+    return *this;
+}
+
+DenseBitset &DenseBitset::operator^=(const DenseBitset &other) noexcept
+{
+    assert(mSize == other.mSize);
+    Combine< Xor >(mBits, other.mBits);
+    return *this;
+}
+
+DenseBitset &DenseBitset::AndNot(const DenseBitset &other) noexcept
+{
+    assert(mSize == other.mSize);
+    Combine< ::AndNot >(mBits, other.mBits);
+    return *this;
+}
+
+void DenseBitset::SetRange(size_t begin, size_t end) noexcept
+{
+    end = std::min(end, mSize);
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const size_t first = begin >> 6;
+    const size_t last = (end - 1) >> 6;
+    const U64 firstMask = ~static_cast< U64 >(0) << (begin & 63);
+    const U64 lastMask = ~static_cast< U64 >(0) >> (63 - ((end - 1) & 63));
+
+    if (first == last)
+    {
+        mBits[first] |= firstMask & lastMask;
+        return;
+    }
+
+    mBits[first] |= firstMask;
+    std::fill(mBits.begin() + first + 1, mBits.begin() + last, ~static_cast< U64 >(0));
+    mBits[last] |= lastMask;
+}
+
+void DenseBitset::ClearRange(size_t begin, size_t end) noexcept
+{
+    end = std::min(end, mSize);
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const size_t first = begin >> 6;
+    const size_t last = (end - 1) >> 6;
+    const U64 firstMask = ~static_cast< U64 >(0) << (begin & 63);
+    const U64 lastMask = ~static_cast< U64 >(0) >> (63 - ((end - 1) & 63));
+
+    if (first == last)
+    {
+        mBits[first] &= ~(firstMask & lastMask);
+        return;
+    }
+
+    mBits[first] &= ~firstMask;
+    std::fill(mBits.begin() + first + 1, mBits.begin() + last, static_cast< U64 >(0));
+    mBits[last] &= ~lastMask;
+}
+
+size_t DenseBitset::Count() const noexcept
+{
+    const U64 *const bits = mBits.data();
+    const size_t count = mBits.size();
+
+    // independent sums, so the popcounts do not wait on each other
+    size_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        sum0 += Popcount(bits[i]);
+        sum1 += Popcount(bits[i + 1]);
+        sum2 += Popcount(bits[i + 2]);
+        sum3 += Popcount(bits[i + 3]);
+    }
+
+    for (; i < count; ++i)
+    {
+        sum0 += Popcount(bits[i]);
+    }
+
+    return sum0 + sum1 + sum2 + sum3;
+}
+
+bool DenseBitset::Any() const noexcept
+{
+    for (const U64 word : mBits)
+    {
+        if (word != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t DenseBitset::FindFirst() const noexcept
+{
+    for (size_t i = 0, end = mBits.size(); i < end; ++i)
+    {
+        if (mBits[i] != 0)
+        {
+            return (i << 6) + CountTrailingZeros(mBits[i]);
+        }
+    }
+
+    return mSize;
+}
+
+size_t DenseBitset::FindNext(size_t bit) const noexcept
+{
+    const size_t start = bit + 1;
+
+    if (start >= mSize)
+    {
+        return mSize;
+    }
+
+    size_t i = start >> 6;
+    U64 word = mBits[i] & (~static_cast< U64 >(0) << (start & 63));
+
+    for (;;)
+    {
+        if (word != 0)
+        {
+            return (i << 6) + CountTrailingZeros(word);
+        }
+
+        if (++i == mBits.size())
+        {
+            return mSize;
+        }
+
+        word = mBits[i];
+    }
+}
+
+void DenseBitset::BuildRankIndex()
+{
+    const size_t blocks = (mBits.size() + WordsPerBlock - 1) / WordsPerBlock;
+    mRanks.resize(blocks + 1);
+
+    U64 rank = 0;
+
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        mRanks[block] = rank;
+
+        const size_t end = std::min(mBits.size(), (block + 1) * WordsPerBlock);
+
+        for (size_t i = block * WordsPerBlock; i < end; ++i)
+        {
+            rank += Popcount(mBits[i]);
+        }
+    }
+
+    mRanks[blocks] = rank;
+}
+
+size_t DenseBitset::Rank(size_t bit) const noexcept
+{
+    assert(bit <= mSize && !mRanks.empty());
+
+    const size_t word = bit >> 6;
+    const size_t block = word / WordsPerBlock;
+
+    size_t rank = static_cast< size_t >(mRanks[block]);
+
+    for (size_t i = block * WordsPerBlock; i < word; ++i)
+    {
+        rank += Popcount(mBits[i]);
+    }
+
+    if ((bit & 63) != 0)
+    {
+        rank += Popcount(mBits[word] & ((static_cast< U64 >(1) << (bit & 63)) - 1));
+    }
+
+    return rank;
+}
+
+size_t DenseBitset::Select(size_t n) const noexcept
+{
+    if (mRanks.empty() || n >= mRanks.back())
+    {
+        return mSize;
+    }
+
+    // the last block that starts with at most n set bits before it
+    const size_t block = static_cast< size_t >(std::upper_bound(mRanks.begin(), mRanks.end(), static_cast< U64 >(n)) - mRanks.begin()) - 1;
+    size_t remaining = n - static_cast< size_t >(mRanks[block]);
+
+    for (size_t i = block * WordsPerBlock;; ++i)
+    {
+        const size_t count = Popcount(mBits[i]);
+
+        if (remaining < count)
+        {
+            return (i << 6) + SelectInWord(mBits[i], remaining);
+        }
+
+        remaining -= count;
+    }
+}
+
+void DenseBitset::ClearTail() noexcept
+{
+    if ((mSize & 63) != 0)
+    {
+        mBits.back() &= (static_cast< U64 >(1) << (mSize & 63)) - 1;
+    }
+}
@@ -26,6 +26,8 @@
 
 #include "manager/controllerManager.h"
 
+#include "container/smallVector.h"
+
 void ControllerManager::OnInit()
 {
     for (size_t i = 0; i < mControllerCache.size(); ++i)
@@ -75,6 +77,11 @@ void ControllerManager::OnRelease()
 }
 
 void ControllerManager::AddExt(std::type_index typeID, AbstractManager *mngr, Namespace ns /*= 0U */)
+{
+    AddExt(TypeRegistry::Get()->Register(typeID), mngr, ns);
+}
+
+void ControllerManager::AddExt(TypeID typeID, AbstractManager *mngr, Namespace ns /*= 0U */)
 {
     if (!mControllers.Has(typeID))
     {
@@ -98,7 +105,8 @@ void ControllerManager::OnPostRelease()
 
 void ControllerManager::OnRelease(Namespace ns)
 {
-    std::vector< std::type_index > removed = mControllers.GetNames(ns);
+    SmallVector< TypeID, 16 > removed;
+    mControllers.GetNames(ns, removed);
 
     // cache values
     for (auto cont : std::vector< AbstractManager * >(mControllerCache))
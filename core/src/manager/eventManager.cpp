@@ -27,7 +27,6 @@
 #include "manager/eventManager.h"
 
 EventManager::EventManager()
-    : mClassIDCounter(0)
 {
 }
 
@@ -35,7 +34,7 @@ void EventManager::OnRelease()
 {
     for (auto &observers : mOberservers)
     {
-        for (auto it = observers.second.begin(), end = observers.second.end(); it != end; ++it)
+        for (auto it = observers.begin(), end = observers.end(); it != end; ++it)
         {
             delete *it;
         }
@@ -26,6 +26,16 @@
 
 #include "manager/factoryManager.h"
 
+void FactoryManager::OnPreInit()
+{
+    mFactories.BeginBatch();
+}
+
+void FactoryManager::OnPostInit()
+{
+    mFactories.EndBatch();
+}
+
 void FactoryManager::OnRelease()
 {
     mFactories.Clear();
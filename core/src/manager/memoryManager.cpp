@@ -28,20 +28,52 @@
 #include "common/util.h"
 
 MemoryManager::ThreadAllocators::ThreadAllocators()
-    : blockAlloc(SIZE_OF_MB(1))
+    : frameArena(SIZE_OF_MB(1)),
+      multiFrameArena(PROGRAM_FRAME_BUFFERS, SIZE_OF_MB(1))
 {
 
 }
 
 void MemoryManager::ThreadAllocators::Clear()
 {
-    blockAlloc.Clear();
+    frameArena.Reset();
+    multiFrameArena.NextFrame();
+}
+
+MemoryManager::MemoryManager()
+{
+#if PROGRAM_MEMORY_TRACKING
+    mFrameArenaTag = MemoryTracker::Register("FrameArena", MemoryKind::Allocator);
+    mMultiFrameArenaTag = MemoryTracker::Register("MultiFrameArena", MemoryKind::Allocator);
+#endif
+}
+
+MemoryManager::~MemoryManager()
+{
+#if PROGRAM_MEMORY_TRACKING
+    MemoryTracker::Unregister(mFrameArenaTag);
+    MemoryTracker::Unregister(mMultiFrameArenaTag);
+#endif
 }
 
 //Clear all temp memory for a new frame
 void MemoryManager::OnUpdate()
 {
-    for (ThreadID i = 0; i < PROGRAM_MAX_THREADS; ++i)
+#if PROGRAM_MEMORY_TRACKING
+    size_t frameBytes = 0;
+    size_t multiFrameBytes = 0;
+
+    for (const ThreadAllocators &allocators : mTempThreadAllocators)
+    {
+        frameBytes += allocators.frameArena.GetUsed();
+        multiFrameBytes += allocators.multiFrameArena.GetUsed();
+    }
+
+    MEMORY_TRACK_SAMPLE(mFrameArenaTag, frameBytes);
+    MEMORY_TRACK_SAMPLE(mMultiFrameArenaTag, multiFrameBytes);
+#endif
+
+    for (ThreadID i = 0; i <= PROGRAM_MAX_THREADS; ++i)
     {
         mTempThreadAllocators[i].Clear();
     }
@@ -25,6 +25,29 @@
  */
 
 #include "manager/poolManager.h"
+#include "manager/eventManager.h"
+
+#include "events/memoryEvents.h"
+
+PoolManager::PoolManager()
+    : mTrimRequested(false)
+{
+}
+
+void PoolManager::OnPreInit()
+{
+    mPools.BeginBatch();
+}
+
+void PoolManager::OnInit()
+{
+    Observe(&PoolManager::OnMemoryPressure);
+}
+
+void PoolManager::OnPostInit()
+{
+    mPools.EndBatch();
+}
 
 void PoolManager::OnRelease()
 {
@@ -36,6 +59,37 @@ void PoolManager::OnRelease(Namespace ns)
     ClearAll(ns);
 }
 
+void PoolManager::OnUpdate()
+{
+    mPools.ForEach([](AbstractPool *pool)
+    {
+        pool->Adapt();
+    });
+
+    // the workers are joined between updates, so their magazines can be drained here
+    if (mTrimRequested.exchange(false))
+    {
+        Trim();
+    }
+}
+
+size_t PoolManager::Trim()
+{
+    size_t trimmed = 0;
+
+    mPools.ForEach([&trimmed](AbstractPool *pool)
+    {
+        trimmed += pool->Trim();
+    });
+
+    return trimmed;
+}
+
+void PoolManager::OnMemoryPressure(const MemoryPressureEvent &)
+{
+    mTrimRequested.store(true);
+}
+
 void PoolManager::ClearAll(const Namespace ns)
 {
     mPools.Clear(ns);
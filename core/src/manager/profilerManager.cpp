@@ -28,6 +28,9 @@
 #include "manager/eventManager.h"
 
 #include "events/profileEvents.h"
+#include "events/memoryEvents.h"
+
+#include "memory/tracking/memoryTracker.h"
 
 #include "api/console.h"
 
@@ -48,10 +51,20 @@ void ProfilerManager::OnUpdate()
     GetManagers()->event->Post(ProfileUpdateEvent(time,
                                                   std::chrono::duration_cast< std::chrono::microseconds >(mLastUpdate - time)));
 
+#if PROGRAM_MEMORY_TRACKING
+
+    std::vector< MemoryStats > tags;
+    std::vector< MemoryStats > namespaces;
+    MemoryTracker::Collect(std::chrono::duration_cast< std::chrono::microseconds >(time - mLastUpdate), tags, namespaces);
+
+    GetManagers()->event->Post(MemoryStatsEvent(time, tags, namespaces));
+
+#endif
+
     mLastUpdate = time;
 }
 
-void ProfilerManager::Start(const std::string &name)
+void ProfilerManager::Start(Atom name)
 {
     std::chrono::time_point< std::chrono::high_resolution_clock > time = std::chrono::high_resolution_clock::now();
     {
@@ -65,14 +78,14 @@ void ProfilerManager::Start(const std::string &name)
         }
         else
         {
-            Console::Warningf(LOG("Profile request '%s' already started."), name);
+            Console::Warningf(LOG("Profile request '%s' already started."), name.GetString());
         }
     }
 
-    GetManagers()->event->Post(ProfileStartEvent(name, time));
+    GetManagers()->event->Post(ProfileStartEvent(name.GetString(), time));
 }
 
-void ProfilerManager::Waypoint(const std::string &name, const std::string &comment)
+void ProfilerManager::Waypoint(Atom name, const std::string &comment)
 {
     std::chrono::microseconds duration;
     std::chrono::time_point< std::chrono::high_resolution_clock > time = std::chrono::high_resolution_clock::now();
@@ -85,16 +98,16 @@ void ProfilerManager::Waypoint(const std::string &name, const std::string &comme
         {
             duration = std::chrono::duration_cast<std::chrono::microseconds>(time - it->second);
 
-            GetManagers()->event->Post(ProfileWaypointEvent(name, comment, time, duration));
+            GetManagers()->event->Post(ProfileWaypointEvent(name.GetString(), comment, time, duration));
         }
         else
         {
-            Console::Warningf(LOG("Trying to waypoint an unknown profile request '%s'."), name);
+            Console::Warningf(LOG("Trying to waypoint an unknown profile request '%s'."), name.GetString());
         }
     }
 }
 
-void ProfilerManager::End(const std::string &name)
+void ProfilerManager::End(Atom name)
 {
     std::chrono::microseconds duration;
     std::chrono::time_point< std::chrono::high_resolution_clock > time = std::chrono::high_resolution_clock::now();
@@ -109,11 +122,11 @@ void ProfilerManager::End(const std::string &name)
             duration = std::chrono::duration_cast< std::chrono::microseconds >(time - it->second);
             mTimings.erase(it);
 
-            GetManagers()->event->Post(ProfileEndEvent(name, time, duration));
+            GetManagers()->event->Post(ProfileEndEvent(name.GetString(), time, duration));
         }
         else
         {
-            Console::Warningf(LOG("Trying to end unknown profile request '%s'."), name);
+            Console::Warningf(LOG("Trying to end unknown profile request '%s'."), name.GetString());
         }
     }
 }
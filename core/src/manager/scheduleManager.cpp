@@ -185,6 +185,9 @@ void ScheduleManager::RunLoaderJobs()
             {
                 mLoaderWorker.RunJobs(Thread::FailedLoaderID);
                 mLoaderIsRunning = false;
+
+                // the jobs ran on the main thread, which should get its own slot back
+                SetCurrentThreadID(Thread::MainThreadID);
             }
         }
 
@@ -40,15 +40,22 @@
 #include "manager/logManager.h"
 
 #include "common/directory.h"
+#include "common/typeID.h"
+#include "common/atom.h"
 #include "common/path.h"
 
 #include "api/profiler.h"
 
-
+namespace
+{
+    SystemManager *gSystemManager = nullptr;
+}
 
 SystemManager::SystemManager(S32 argc, const char **argv)
     : mArgc(argc),
-      mArgv(argv)
+      mArgv(argv),
+      mTypeRegistry(TypeRegistry::GetModuleRegistry()),
+      mAtomStorage(AtomTable::GetModuleStorage())
 {
     const std::string tempDir = Path::GetProgramTempDirectory();
 
@@ -74,6 +81,11 @@ SystemManager::SystemManager(S32 argc, const char **argv)
 
 SystemManager::~SystemManager()
 {
+    // the registries fall back to the module's own until the next manager is set
+    if (gSystemManager == this)
+    {
+        gSystemManager = nullptr;
+    }
 }
 
 void SystemManager::Initialise()
@@ -167,15 +179,23 @@ void SystemManager::RegisterManagers()
 
 SystemManager *SystemManager::Get(SystemManager *systemManager /* = nullptr */)
 {
-    static SystemManager *mSystemManager = nullptr;
-
     if (systemManager)
     {
-        mSystemManager = systemManager;
-        mSystemManager->mManagerHolder.system = systemManager;
+        gSystemManager = systemManager;
+        gSystemManager->mManagerHolder.system = systemManager;
     }
 
-    return mSystemManager;
+    return gSystemManager;
+}
+
+TypeRegistry *SystemManager::GetTypeRegistry() const
+{
+    return mTypeRegistry;
+}
+
+AtomStorage *SystemManager::GetAtomStorage() const
+{
+    return mAtomStorage;
 }
 
 const S32 &SystemManager::GetArgc() const
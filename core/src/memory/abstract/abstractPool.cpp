@@ -29,3 +29,12 @@
 AbstractPool::~AbstractPool()
 {
 }
+
+size_t AbstractPool::Trim()
+{
+    return 0;
+}
+
+void AbstractPool::Adapt()
+{
+}
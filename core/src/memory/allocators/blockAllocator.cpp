@@ -26,12 +26,13 @@
 #include "memory/allocators/blockAllocator.h"
 
 
-BlockAllocator::BlockAllocator(size_t blockSize)
-    : mBlocks(1, StackAllocator(blockSize)),
-      mBlockSize(blockSize),
-      mBlockPosition(0)
+BlockAllocator::BlockAllocator(size_t blockSize, HugePageArena *arena)
+    : mBlockSize(blockSize),
+      mBlockPosition(0),
+      mArena(arena)
 {
-
+    // construct in place, a copy would allocate the block twice
+    mBlocks.emplace_back(blockSize, arena);
 }
 
 void BlockAllocator::BlockAdvance(size_t bytes)
@@ -39,9 +40,11 @@ void BlockAllocator::BlockAdvance(size_t bytes)
     //determine if we can accomodate this item in the current block
     if (!mBlocks[mBlockPosition].FitsInStack(bytes))
     {
-        //advance the block
-        mBlockPosition++;
-        mBlocks.push_back(StackAllocator(mBlockSize));
+        //advance the block, reusing the ones kept by Clear
+        if (++mBlockPosition == mBlocks.size())
+        {
+            mBlocks.emplace_back(mBlockSize, mArena);
+        }
     }
 }
 
@@ -0,0 +1,147 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/frameArena.h"
+#include "memory/allocators/malloc.h"
+
+FrameArena::FrameArena(size_t chunkSize, HugePageArena *arena)
+    : mDestructors(nullptr),
+      mCursor(nullptr),
+      mEnd(nullptr),
+      mChunkIndex(0),
+      mUsedBefore(0),
+      mChunkSize(chunkSize),
+      mArena(arena)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    Reset();
+
+    for (const Chunk &chunk : mChunks)
+    {
+        if (chunk.owned)
+        {
+            ZefAlignedFree(chunk.begin);
+        }
+    }
+}
+
+void FrameArena::Reset()
+{
+    for (Destructor *destructor = mDestructors; destructor; destructor = destructor->next)
+    {
+        destructor->destroy(destructor->object);
+    }
+
+    mDestructors = nullptr;
+    mChunkIndex = 0;
+    mUsedBefore = 0;
+
+    if (!mChunks.empty())
+    {
+        mCursor = mChunks.front().begin;
+        mEnd = mChunks.front().end;
+    }
+}
+
+size_t FrameArena::GetUsed() const
+{
+    return mChunks.empty() ? 0 : mUsedBefore + static_cast< size_t >(mCursor - mChunks[mChunkIndex].begin);
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    size_t capacity = 0;
+
+    for (const Chunk &chunk : mChunks)
+    {
+        capacity += static_cast< size_t >(chunk.end - chunk.begin);
+    }
+
+    return capacity;
+}
+
+size_t FrameArena::GetChunkSize() const
+{
+    return mChunkSize;
+}
+
+void *FrameArena::AllocateSlow(size_t bytes, size_t alignment)
+{
+    // move on to the next chunk that fits, chunks we skip stay unused until the reset
+    while (!mChunks.empty() && mChunkIndex + 1 < mChunks.size())
+    {
+        mUsedBefore += static_cast< size_t >(mCursor - mChunks[mChunkIndex].begin);
+
+        const Chunk &chunk = mChunks[++mChunkIndex];
+        mCursor = chunk.begin;
+        mEnd = chunk.end;
+
+        U8 *const ptr = Fit(mCursor, mEnd, bytes, alignment);
+
+        if (ptr)
+        {
+            mCursor = ptr + bytes;
+            return ptr;
+        }
+    }
+
+    const size_t size = bytes + alignment > mChunkSize ? bytes + alignment : mChunkSize;
+
+    Chunk chunk;
+    chunk.begin = mArena ? static_cast< U8 * >(mArena->Allocate(size, 64)) : nullptr;
+    chunk.owned = chunk.begin == nullptr;
+
+    if (chunk.owned)
+    {
+        chunk.begin = static_cast< U8 * >(ZefAlignedMalloc(size, 64));
+
+        if (!chunk.begin)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    chunk.end = chunk.begin + size;
+
+    if (!mChunks.empty())
+    {
+        mUsedBefore += static_cast< size_t >(mCursor - mChunks[mChunkIndex].begin);
+        mChunkIndex = mChunks.size();
+    }
+
+    mChunks.push_back(chunk);
+
+    // the chunk holds the allocation with any padding
+    U8 *const ptr = Fit(chunk.begin, chunk.end, bytes, alignment);
+
+    mCursor = ptr + bytes;
+    mEnd = chunk.end;
+
+    return ptr;
+}
@@ -0,0 +1,200 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/hugePageArena.h"
+
+#include "preproc/os.h"
+
+#if OS_IS_WINDOWS
+#   include <windows.h>
+#else
+#   include <sys/mman.h>
+#endif
+
+#include <stdint.h>
+#include <mutex>
+
+namespace
+{
+    const size_t gHugePageSize = 2 * 1024 * 1024;
+
+    uintptr_t AlignUp(uintptr_t address, size_t alignment)
+    {
+        return (address + alignment - 1) & ~static_cast< uintptr_t >(alignment - 1);
+    }
+}
+
+HugePageArena::HugePageArena(size_t capacity, PageMode mode)
+    : mMapping(nullptr),
+      mMappingSize(0),
+      mBegin(nullptr),
+      mCursor(nullptr),
+      mEnd(nullptr),
+      mPageMode(PageMode::Normal)
+{
+    Map(AlignUp(capacity, gHugePageSize), mode);
+}
+
+HugePageArena::~HugePageArena()
+{
+    if (!mMapping)
+    {
+        return;
+    }
+
+#if OS_IS_WINDOWS
+    VirtualFree(mMapping, 0, MEM_RELEASE);
+#else
+    munmap(mMapping, mMappingSize);
+#endif
+}
+
+void *HugePageArena::Allocate(size_t bytes, size_t alignment)
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    char *const ptr = reinterpret_cast< char * >(AlignUp(reinterpret_cast< uintptr_t >(mCursor), alignment));
+
+    if (!mBegin || ptr > mEnd || static_cast< size_t >(mEnd - ptr) < bytes)
+    {
+        return nullptr;
+    }
+
+    mCursor = ptr + bytes;
+
+    return ptr;
+}
+
+void HugePageArena::Reset()
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    mCursor = mBegin;
+}
+
+bool HugePageArena::Owns(const void *ptr) const
+{
+    return ptr >= mBegin && ptr < mEnd;
+}
+
+HugePageArena::PageMode HugePageArena::GetPageMode() const
+{
+    return mPageMode;
+}
+
+size_t HugePageArena::GetCapacity() const
+{
+    return static_cast< size_t >(mEnd - mBegin);
+}
+
+size_t HugePageArena::GetUsed() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return static_cast< size_t >(mCursor - mBegin);
+}
+
+size_t HugePageArena::GetHugePageSize()
+{
+    return gHugePageSize;
+}
+
+void HugePageArena::Map(size_t capacity, PageMode mode)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+
+#if OS_IS_WINDOWS
+
+    if (mode == PageMode::Explicit)
+    {
+        // needs the lock pages in memory privilege
+        mMapping = VirtualAlloc(nullptr, capacity, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        mPageMode = PageMode::Explicit;
+    }
+
+    if (!mMapping)
+    {
+        mMapping = VirtualAlloc(nullptr, capacity, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        mPageMode = PageMode::Normal;
+    }
+
+    mMappingSize = capacity;
+    mBegin = static_cast< char * >(mMapping);
+
+#else
+
+#   ifdef MAP_HUGETLB
+
+    if (mode == PageMode::Explicit)
+    {
+        // reserves the huge pages up front, so we fail here instead of on a later fault
+        void *const mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                                   -1, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            mMapping = mapping;
+            mMappingSize = capacity;
+            mBegin = static_cast< char * >(mapping);
+            mPageMode = PageMode::Explicit;
+        }
+    }
+
+#   endif
+
+    if (!mMapping)
+    {
+        // over reserve so the arena starts at a huge page boundary
+        const size_t mappingSize = capacity + gHugePageSize;
+        void *const mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if (mapping == MAP_FAILED)
+        {
+            return;
+        }
+
+        mMapping = mapping;
+        mMappingSize = mappingSize;
+        mBegin = reinterpret_cast< char * >(AlignUp(reinterpret_cast< uintptr_t >(mapping), gHugePageSize));
+        mPageMode = PageMode::Normal;
+
+#   ifdef MADV_HUGEPAGE
+
+        if (mode != PageMode::Normal && madvise(mBegin, capacity, MADV_HUGEPAGE) == 0)
+        {
+            mPageMode = PageMode::Transparent;
+        }
+
+#   endif
+    }
+
+#endif
+
+    mCursor = mBegin;
+    mEnd = mBegin + capacity;
+}
@@ -25,10 +25,18 @@
  */
 
 #include "memory/allocators/malloc.h"
+#include "memory/allocators/slabAllocator.h"
+#include "memory/tracking/heapProfiler.h"
+
+#include "config.h"
 
 #include <stdlib.h>
 #include <emmintrin.h>
 
+#if PROGRAM_OVERRIDE_NEW
+#   include <new>
+#endif
+
 void *_InternalAlignedMalloc(size_t bytes, size_t alignment)
 {
     /*
@@ -68,12 +76,77 @@ void _InternalAlignedFree(void *ptr)
 
 void *ZefAlignedMalloc(size_t bytes, size_t alignment)
 {
-    // TODO add lib specific allocs
-    return _InternalAlignedMalloc(bytes, alignment);
+    void *const ptr = SlabAllocator::Allocate(bytes, alignment);
+
+    HEAP_PROFILE_ALLOCATE(ptr, bytes, HeapSampleSource::Heap);
+
+    return ptr;
 }
 
 void ZefAlignedFree(void *ptr)
 {
-    // TODO add lib specific frees
-    return _InternalAlignedFree(ptr);
-}
\ No newline at end of file
+    HEAP_PROFILE_FREE(ptr, HeapSampleSource::Heap);
+
+    SlabAllocator::Free(ptr);
+}
+
+#if PROGRAM_OVERRIDE_NEW
+
+void *operator new(size_t bytes)
+{
+    void *const ptr = SlabAllocator::Allocate(bytes, 16);
+
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void *operator new[](size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept
+{
+    return SlabAllocator::Allocate(bytes, 16);
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept
+{
+    return SlabAllocator::Allocate(bytes, 16);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    SlabAllocator::Free(ptr);
+}
+
+#endif
\ No newline at end of file
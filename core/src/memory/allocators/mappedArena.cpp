@@ -0,0 +1,393 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/mappedArena.h"
+
+#if OS_IS_WINDOWS
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <stdint.h>
+#include <mutex>
+
+struct MappedArena::Header
+{
+    U64 magic;
+    U32 formatVersion;
+    U32 layoutVersion;
+    U32 pointerSize;
+    U32 byteOrder;
+    U64 size;
+    U64 used;
+    U64 root;
+    U32 committed;
+    U32 reserved;
+};
+
+const U32 MappedArena::FormatVersion = 1;
+
+namespace
+{
+    const U64 gMagic = 0x414e455241464552ull;
+    const U32 gByteOrder = 0x01020304u;
+    const U64 gNoRoot = ~0ull;
+
+    // keeps the data page aligned, so the alignment of allocations holds on every mapping
+    const size_t gDataOffset = 4096;
+
+    uintptr_t AlignUp(uintptr_t address, size_t alignment)
+    {
+        return (address + alignment - 1) & ~static_cast< uintptr_t >(alignment - 1);
+    }
+}
+
+MappedArena::MappedArena()
+    : mHeader(nullptr),
+      mBegin(nullptr),
+      mMappingSize(0),
+#if OS_IS_WINDOWS
+      mFile(INVALID_HANDLE_VALUE),
+      mFileMapping(nullptr)
+#else
+      mFile(-1)
+#endif
+{
+}
+
+MappedArena::~MappedArena()
+{
+    Close();
+}
+
+MappedArena::OpenResult MappedArena::Open(const std::string &path, size_t capacity, U32 layoutVersion)
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    CloseFile();
+
+    size_t fileSize = 0;
+
+#if OS_IS_WINDOWS
+
+    mFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    LARGE_INTEGER size;
+
+    if (mFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(mFile, &size))
+    {
+        CloseFile();
+        return OpenResult::Failed;
+    }
+
+    fileSize = static_cast< size_t >(size.QuadPart);
+
+#else
+
+    mFile = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+    struct stat status;
+
+    if (mFile == -1 || fstat(mFile, &status) != 0)
+    {
+        CloseFile();
+        return OpenResult::Failed;
+    }
+
+    fileSize = static_cast< size_t >(status.st_size);
+
+#endif
+
+    if (fileSize >= gDataOffset && Map(fileSize))
+    {
+        const Header &header = *mHeader;
+        const U64 dataSize = fileSize - gDataOffset;
+
+        if (header.magic == gMagic &&
+                header.formatVersion == FormatVersion &&
+                header.layoutVersion == layoutVersion &&
+                header.pointerSize == sizeof(void *) &&
+                header.byteOrder == gByteOrder &&
+                header.size == fileSize &&
+                header.used <= dataSize &&
+                (header.root == gNoRoot || header.root < header.used) &&
+                header.committed)
+        {
+            return OpenResult::Opened;
+        }
+
+        Unmap();
+    }
+
+    // empty the file first, so no stale data survives in the new one
+    const size_t size = gDataOffset + static_cast< size_t >(AlignUp(capacity, gDataOffset));
+
+    if (!Resize(0) || !Resize(size) || !Map(size))
+    {
+        CloseFile();
+        return OpenResult::Failed;
+    }
+
+    Initialise(size, layoutVersion);
+
+    return fileSize == 0 ? OpenResult::Created : OpenResult::Rebuilt;
+}
+
+void MappedArena::Close()
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    CloseFile();
+}
+
+void *MappedArena::Allocate(size_t bytes, size_t alignment)
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    if (!mHeader)
+    {
+        return nullptr;
+    }
+
+    char *const end = mBegin + (mMappingSize - gDataOffset);
+    char *const ptr = reinterpret_cast< char * >(AlignUp(reinterpret_cast< uintptr_t >(mBegin + mHeader->used), alignment));
+
+    if (ptr > end || static_cast< size_t >(end - ptr) < bytes)
+    {
+        return nullptr;
+    }
+
+    mHeader->used = static_cast< U64 >(ptr + bytes - mBegin);
+    mHeader->committed = 0;
+
+    return ptr;
+}
+
+void MappedArena::SetRoot(void *root)
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    if (!mHeader)
+    {
+        return;
+    }
+
+    mHeader->root = root ? static_cast< U64 >(static_cast< char * >(root) - mBegin) : gNoRoot;
+    mHeader->committed = 0;
+}
+
+bool MappedArena::Commit()
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    if (!mHeader)
+    {
+        return false;
+    }
+
+    // the data has to be on disk before the header claims it is valid
+    if (!Flush(mHeader, mMappingSize))
+    {
+        return false;
+    }
+
+    mHeader->committed = 1;
+
+    return Flush(mHeader, sizeof(Header));
+}
+
+bool MappedArena::IsOpen() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return mHeader != nullptr;
+}
+
+bool MappedArena::IsCommitted() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return mHeader && mHeader->committed;
+}
+
+bool MappedArena::Owns(const void *ptr) const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return mHeader && ptr >= mBegin && ptr < mBegin + (mMappingSize - gDataOffset);
+}
+
+size_t MappedArena::GetCapacity() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return mHeader ? mMappingSize - gDataOffset : 0;
+}
+
+size_t MappedArena::GetUsed() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+    return mHeader ? static_cast< size_t >(mHeader->used) : 0;
+}
+
+void *MappedArena::GetRootPointer() const
+{
+    std::lock_guard< SpinLock > lock(mLock);
+
+    if (!mHeader || mHeader->root == gNoRoot)
+    {
+        return nullptr;
+    }
+
+    return mBegin + mHeader->root;
+}
+
+bool MappedArena::Map(size_t size)
+{
+    void *mapping = nullptr;
+
+#if OS_IS_WINDOWS
+
+    const U64 mappingSize = static_cast< U64 >(size);
+    mFileMapping = CreateFileMappingA(mFile, nullptr, PAGE_READWRITE, static_cast< DWORD >(mappingSize >> 32),
+                                      static_cast< DWORD >(mappingSize), nullptr);
+
+    if (!mFileMapping)
+    {
+        return false;
+    }
+
+    mapping = MapViewOfFile(mFileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+    if (!mapping)
+    {
+        CloseHandle(mFileMapping);
+        mFileMapping = nullptr;
+        return false;
+    }
+
+#else
+
+    mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+#endif
+
+    mHeader = static_cast< Header * >(mapping);
+    mBegin = static_cast< char * >(mapping) + gDataOffset;
+    mMappingSize = size;
+
+    return true;
+}
+
+void MappedArena::Unmap()
+{
+    if (!mHeader)
+    {
+        return;
+    }
+
+#if OS_IS_WINDOWS
+
+    UnmapViewOfFile(mHeader);
+    CloseHandle(mFileMapping);
+    mFileMapping = nullptr;
+
+#else
+
+    munmap(mHeader, mMappingSize);
+
+#endif
+
+    mHeader = nullptr;
+    mBegin = nullptr;
+    mMappingSize = 0;
+}
+
+void MappedArena::CloseFile()
+{
+    Unmap();
+
+#if OS_IS_WINDOWS
+
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+
+#else
+
+    if (mFile != -1)
+    {
+        close(mFile);
+        mFile = -1;
+    }
+
+#endif
+}
+
+bool MappedArena::Resize(size_t size)
+{
+#if OS_IS_WINDOWS
+
+    LARGE_INTEGER distance;
+    distance.QuadPart = static_cast< LONGLONG >(size);
+
+    return SetFilePointerEx(mFile, distance, nullptr, FILE_BEGIN) && SetEndOfFile(mFile);
+
+#else
+
+    return ftruncate(mFile, static_cast< off_t >(size)) == 0;
+
+#endif
+}
+
+void MappedArena::Initialise(size_t size, U32 layoutVersion)
+{
+    mHeader->magic = gMagic;
+    mHeader->formatVersion = FormatVersion;
+    mHeader->layoutVersion = layoutVersion;
+    mHeader->pointerSize = sizeof(void *);
+    mHeader->byteOrder = gByteOrder;
+    mHeader->size = size;
+    mHeader->used = 0;
+    mHeader->root = gNoRoot;
+    mHeader->committed = 0;
+    mHeader->reserved = 0;
+}
+
+bool MappedArena::Flush(void *address, size_t size)
+{
+#if OS_IS_WINDOWS
+    return FlushViewOfFile(address, size) && FlushFileBuffers(mFile);
+#else
+    return msync(address, size, MS_SYNC) == 0;
+#endif
+}
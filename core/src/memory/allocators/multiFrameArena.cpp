@@ -0,0 +1,79 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/multiFrameArena.h"
+
+MultiFrameArena::MultiFrameArena(U32 frames, size_t chunkSize, HugePageArena *arena)
+    : mCurrent(nullptr),
+      mIndex(0)
+{
+    const U32 count = frames > 0 ? frames : 1;
+
+    for (U32 i = 0; i < count; ++i)
+    {
+        mArenas.emplace_back(new FrameArena(chunkSize, arena));
+    }
+
+    mCurrent = mArenas.front().get();
+}
+
+void MultiFrameArena::NextFrame()
+{
+    mIndex = mIndex + 1 == mArenas.size() ? 0 : mIndex + 1;
+
+    mCurrent = mArenas[mIndex].get();
+    mCurrent->Reset();
+}
+
+void MultiFrameArena::Reset()
+{
+    for (std::unique_ptr< FrameArena > &arena : mArenas)
+    {
+        arena->Reset();
+    }
+}
+
+FrameArena &MultiFrameArena::GetCurrent()
+{
+    return *mCurrent;
+}
+
+U32 MultiFrameArena::GetFrameCount() const
+{
+    return static_cast< U32 >(mArenas.size());
+}
+
+size_t MultiFrameArena::GetUsed() const
+{
+    size_t used = 0;
+
+    for (const std::unique_ptr< FrameArena > &arena : mArenas)
+    {
+        used += arena->GetUsed();
+    }
+
+    return used;
+}
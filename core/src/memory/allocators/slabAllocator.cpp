@@ -0,0 +1,514 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/slabAllocator.h"
+
+#include "threading/spinlock.h"
+
+#include "preproc/compiler.h"
+#include "preproc/os.h"
+
+#include "common/types.h"
+
+#if OS_IS_WINDOWS
+#   include <windows.h>
+#   include <intrin.h>
+#else
+#   include <sys/mman.h>
+#endif
+
+#include <stdint.h>
+#include <mutex>
+
+namespace
+{
+    const U32 gSlabMagic = 0x51AB51ABu;
+    const U32 gLargeMagic = 0x1A26E1A2u;
+
+    // every slab reserves this much for its header
+    const size_t gSlabHeaderSize = 64;
+
+    const size_t gMinAlignment = 16;
+
+    // the amount of bytes a thread caches per size class
+    const size_t gCacheBytes = 64 * 1024;
+    const size_t gMaxCacheCount = 256;
+
+    struct FreeObject
+    {
+        FreeObject *next;
+    };
+
+    /**
+     * Lies at the start of every slab, or in front of a directly mapped allocation.
+     */
+
+    struct SpanHeader
+    {
+        U32 magic;
+        U32 sizeClass;
+        size_t usableSize;
+        void *mapping;
+        size_t mappingSize;
+    };
+
+    struct CentralList
+    {
+        SpinLock lock;
+        FreeObject *freeList;
+        U8 *fresh;
+        U8 *freshEnd;
+    };
+
+    struct ThreadCache
+    {
+        ~ThreadCache();
+
+        FreeObject *lists[SlabAllocator::ClassCount];
+        size_t counts[SlabAllocator::ClassCount];
+    };
+
+    // zero initialised, so usable before static initialisation reaches this file
+    CentralList gCentral[SlabAllocator::ClassCount];
+
+    SpinLock gChunkLock;
+    U8 *gChunkCursor;
+    U8 *gChunkEnd;
+
+    thread_local ThreadCache tCache;
+    thread_local bool tCacheDestroyed;
+
+    size_t Log2Floor(size_t value)
+    {
+#ifdef COMP_IS_MSVC
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    uintptr_t AlignUp(uintptr_t address, size_t alignment)
+    {
+        return (address + alignment - 1) & ~static_cast< uintptr_t >(alignment - 1);
+    }
+
+    void *MapMemory(size_t bytes)
+    {
+#if OS_IS_WINDOWS
+        return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+        void *const ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+    }
+
+    void UnmapMemory(void *ptr, size_t bytes)
+    {
+#if OS_IS_WINDOWS
+        (void)bytes;
+        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+        munmap(ptr, bytes);
+#endif
+    }
+
+    /**
+     * The offset of the first object in a slab. Keeps every object aligned to the largest
+     * power of two that divides the object size, up to the maximum small alignment.
+     */
+
+    size_t GetDataOffset(size_t sizeClass)
+    {
+        const size_t size = SlabAllocator::GetClassSize(sizeClass);
+        const size_t lowBit = size & (~size + 1);
+        const size_t alignment = lowBit < SlabAllocator::MaxSmallAlignment ? lowBit : SlabAllocator::MaxSmallAlignment;
+
+        return alignment > gSlabHeaderSize ? alignment : gSlabHeaderSize;
+    }
+
+    size_t GetCacheLimit(size_t sizeClass)
+    {
+        const size_t count = gCacheBytes / SlabAllocator::GetClassSize(sizeClass);
+        return count < 2 ? 2 : (count > gMaxCacheCount ? gMaxCacheCount : count);
+    }
+
+    SpanHeader *GetHeader(const void *ptr)
+    {
+        const uintptr_t address = reinterpret_cast< uintptr_t >(ptr);
+        const uintptr_t base = address & ~static_cast< uintptr_t >(SlabAllocator::SlabSize - 1);
+
+        // objects never start at a slab boundary, only directly mapped allocations do
+        if (address == base)
+        {
+            return reinterpret_cast< SpanHeader * >(address) - 1;
+        }
+
+        return reinterpret_cast< SpanHeader * >(base);
+    }
+
+    /**
+     * Takes a new slab from the current chunk and makes it the fresh slab of the size class.
+     * Should be called with the central list locked.
+     */
+
+    bool AddSlab(size_t sizeClass, CentralList &central)
+    {
+        U8 *slab;
+
+        {
+            std::lock_guard< SpinLock > lock(gChunkLock);
+
+            if (gChunkCursor == gChunkEnd)
+            {
+                U8 *const chunk = static_cast< U8 * >(MapMemory(SlabAllocator::ChunkSize + SlabAllocator::SlabSize));
+
+                if (!chunk)
+                {
+                    return false;
+                }
+
+                gChunkCursor = reinterpret_cast< U8 * >(AlignUp(reinterpret_cast< uintptr_t >(chunk), SlabAllocator::SlabSize));
+                gChunkEnd = gChunkCursor + SlabAllocator::ChunkSize;
+            }
+
+            slab = gChunkCursor;
+            gChunkCursor += SlabAllocator::SlabSize;
+        }
+
+        SpanHeader *const header = reinterpret_cast< SpanHeader * >(slab);
+        header->magic = gSlabMagic;
+        header->sizeClass = static_cast< U32 >(sizeClass);
+        header->usableSize = SlabAllocator::GetClassSize(sizeClass);
+        header->mapping = nullptr;
+        header->mappingSize = 0;
+
+        const size_t offset = GetDataOffset(sizeClass);
+        const size_t count = (SlabAllocator::SlabSize - offset) / header->usableSize;
+
+        central.fresh = slab + offset;
+        central.freshEnd = central.fresh + count * header->usableSize;
+
+        return true;
+    }
+
+    /**
+     * Takes up to count objects from the central list of the size class.
+     *
+     * @return  The amount of objects taken.
+     */
+
+    size_t TakeCentral(size_t sizeClass, size_t count, FreeObject *&list)
+    {
+        CentralList &central = gCentral[sizeClass];
+        const size_t size = SlabAllocator::GetClassSize(sizeClass);
+
+        std::lock_guard< SpinLock > lock(central.lock);
+
+        size_t taken = 0;
+
+        for (; taken < count && central.freeList; ++taken)
+        {
+            FreeObject *const object = central.freeList;
+            central.freeList = object->next;
+
+            object->next = list;
+            list = object;
+        }
+
+        for (; taken < count; ++taken)
+        {
+            if (central.fresh == central.freshEnd && !AddSlab(sizeClass, central))
+            {
+                break;
+            }
+
+            FreeObject *const object = reinterpret_cast< FreeObject * >(central.fresh);
+            central.fresh += size;
+
+            object->next = list;
+            list = object;
+        }
+
+        return taken;
+    }
+
+    /**
+     * Gives a linked list of objects back to the central list of the size class.
+     */
+
+    void GiveCentral(size_t sizeClass, FreeObject *first, FreeObject *last)
+    {
+        CentralList &central = gCentral[sizeClass];
+
+        std::lock_guard< SpinLock > lock(central.lock);
+
+        last->next = central.freeList;
+        central.freeList = first;
+    }
+
+    /**
+     * Gives count objects from the front of the thread cache back to the central list.
+     */
+
+    void FlushCache(ThreadCache &cache, size_t sizeClass, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        FreeObject *const first = cache.lists[sizeClass];
+        FreeObject *last = first;
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            last = last->next;
+        }
+
+        cache.lists[sizeClass] = last->next;
+        cache.counts[sizeClass] -= count;
+
+        GiveCentral(sizeClass, first, last);
+    }
+
+    ThreadCache::~ThreadCache()
+    {
+        SlabAllocator::FlushThreadCache();
+        tCacheDestroyed = true;
+    }
+
+    void *AllocateSmall(size_t sizeClass)
+    {
+        if (tCacheDestroyed)
+        {
+            FreeObject *object = nullptr;
+            TakeCentral(sizeClass, 1, object);
+            return object;
+        }
+
+        ThreadCache &cache = tCache;
+        FreeObject *object = cache.lists[sizeClass];
+
+        if (!object)
+        {
+            cache.counts[sizeClass] = TakeCentral(sizeClass, GetCacheLimit(sizeClass) / 2, cache.lists[sizeClass]);
+            object = cache.lists[sizeClass];
+
+            if (!object)
+            {
+                return nullptr;
+            }
+        }
+
+        cache.lists[sizeClass] = object->next;
+        --cache.counts[sizeClass];
+
+        return object;
+    }
+
+    void FreeSmall(void *ptr, size_t sizeClass)
+    {
+        FreeObject *const object = static_cast< FreeObject * >(ptr);
+
+        if (tCacheDestroyed)
+        {
+            GiveCentral(sizeClass, object, object);
+            return;
+        }
+
+        ThreadCache &cache = tCache;
+
+        object->next = cache.lists[sizeClass];
+        cache.lists[sizeClass] = object;
+
+        const size_t limit = GetCacheLimit(sizeClass);
+
+        if (++cache.counts[sizeClass] > limit)
+        {
+            FlushCache(cache, sizeClass, limit / 2);
+        }
+    }
+
+    void *AllocateLarge(size_t bytes, size_t alignment)
+    {
+        const size_t headerSize = sizeof(SpanHeader);
+        uintptr_t address;
+        SpanHeader *header;
+        void *mapping;
+        size_t mappingSize;
+
+        if (alignment < SlabAllocator::SlabSize)
+        {
+            // the header lies at the slab boundary in front of the memory
+            mappingSize = bytes + alignment + headerSize + SlabAllocator::SlabSize;
+            mapping = MapMemory(mappingSize);
+
+            if (!mapping)
+            {
+                return nullptr;
+            }
+
+            const uintptr_t base = AlignUp(reinterpret_cast< uintptr_t >(mapping), SlabAllocator::SlabSize);
+            address = AlignUp(base + headerSize, alignment);
+            header = reinterpret_cast< SpanHeader * >(base);
+        }
+        else
+        {
+            // the memory lies at a slab boundary, with the header directly in front of it
+            mappingSize = bytes + 2 * alignment;
+            mapping = MapMemory(mappingSize);
+
+            if (!mapping)
+            {
+                return nullptr;
+            }
+
+            address = AlignUp(reinterpret_cast< uintptr_t >(mapping) + headerSize, alignment);
+            header = reinterpret_cast< SpanHeader * >(address) - 1;
+        }
+
+        header->magic = gLargeMagic;
+        header->sizeClass = SlabAllocator::ClassCount;
+        header->usableSize = bytes;
+        header->mapping = mapping;
+        header->mappingSize = mappingSize;
+
+        return reinterpret_cast< void * >(address);
+    }
+}
+
+const size_t SlabAllocator::ClassCount;
+const size_t SlabAllocator::MaxSmallSize;
+const size_t SlabAllocator::MaxSmallAlignment;
+const size_t SlabAllocator::SlabSize;
+const size_t SlabAllocator::ChunkSize;
+
+void *SlabAllocator::Allocate(size_t bytes, size_t alignment)
+{
+    if (alignment < gMinAlignment)
+    {
+        alignment = gMinAlignment;
+    }
+
+    const size_t sizeClass = GetSizeClass(bytes, alignment);
+
+    if (sizeClass < ClassCount)
+    {
+        return AllocateSmall(sizeClass);
+    }
+
+    return AllocateLarge(bytes, alignment);
+}
+
+void SlabAllocator::Free(void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    SpanHeader *const header = GetHeader(ptr);
+
+    if (header->magic == gSlabMagic)
+    {
+        FreeSmall(ptr, header->sizeClass);
+    }
+    else
+    {
+        UnmapMemory(header->mapping, header->mappingSize);
+    }
+}
+
+size_t SlabAllocator::GetUsableSize(const void *ptr)
+{
+    return GetHeader(ptr)->usableSize;
+}
+
+size_t SlabAllocator::GetSizeClass(size_t bytes, size_t alignment)
+{
+    if (bytes > MaxSmallSize || alignment > MaxSmallAlignment)
+    {
+        return ClassCount;
+    }
+
+    size_t size = bytes == 0 ? 1 : bytes;
+
+    if (alignment > gMinAlignment)
+    {
+        size = AlignUp(size, alignment);
+    }
+
+    size_t sizeClass;
+
+    if (size <= 128)
+    {
+        // steps of 16 bytes
+        sizeClass = (size + 15) / 16 - 1;
+    }
+    else
+    {
+        // four steps per power of two
+        const size_t exponent = Log2Floor(size - 1);
+        sizeClass = 8 + (exponent - 7) * 4 + ((size - 1 - (size_t(1) << exponent)) >> (exponent - 2));
+    }
+
+    while (sizeClass < ClassCount && (GetClassSize(sizeClass) & (alignment - 1)) != 0)
+    {
+        ++sizeClass;
+    }
+
+    return sizeClass;
+}
+
+size_t SlabAllocator::GetClassSize(size_t sizeClass)
+{
+    if (sizeClass < 8)
+    {
+        return (sizeClass + 1) * 16;
+    }
+
+    const size_t step = sizeClass - 8;
+    const size_t exponent = 7 + step / 4;
+
+    return (size_t(1) << exponent) + (step % 4 + 1) * (size_t(1) << (exponent - 2));
+}
+
+void SlabAllocator::FlushThreadCache()
+{
+    if (tCacheDestroyed)
+    {
+        return;
+    }
+
+    ThreadCache &cache = tCache;
+
+    for (size_t sizeClass = 0; sizeClass < ClassCount; ++sizeClass)
+    {
+        FlushCache(cache, sizeClass, cache.counts[sizeClass]);
+    }
+}
@@ -26,14 +26,16 @@
 
 #include "memory/allocators/stackAllocator.h"
 
+#include <utility>
+
 StackAllocator::StackAllocator()
     : mStack(10, '@'),
       mCursor(0)
 {
 }
 
-StackAllocator::StackAllocator(size_t size)
-    : mStack(size + 1, '@'),
+StackAllocator::StackAllocator(size_t size, HugePageArena *arena)
+    : mStack(size + 1, '@', AlignedAllocator< U8, 16 >(arena)),
       mCursor(0)
 {
 }
@@ -53,7 +55,22 @@ StackAllocator::StackLocation StackAllocator::InternalAlloc(size_t allocSize)
 {
     if (!FitsInStack(allocSize))
     {
-        mStack.resize(static_cast< size_t >(mStack.size() * 1.6f) + allocSize, '~');
+        const size_t size = static_cast< size_t >(mStack.size() * 1.6f) + allocSize;
+
+        if (mStack.get_allocator().GetArena())
+        {
+            // the arena cannot take the old stack back, so grow on the heap from here on
+            std::vector< U8, AlignedAllocator< U8, 16 > > grown;
+            grown.reserve(size);
+            grown.assign(mStack.begin(), mStack.end());
+            grown.resize(size, '~');
+
+            mStack = std::move(grown);
+        }
+        else
+        {
+            mStack.resize(size, '~');
+        }
     }
 
     StackLocation ptr = ((mStack.data() + mCursor) - mStack.data());
@@ -0,0 +1,75 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/alignedResource.h"
+
+#include "memory/allocators/hugePageArena.h"
+#include "memory/allocators/malloc.h"
+
+#include <new>
+
+AlignedResource::AlignedResource(HugePageArena *arena /*= nullptr*/) noexcept
+    : mArena(arena)
+{
+}
+
+HugePageArena *AlignedResource::GetArena() const noexcept
+{
+    return mArena;
+}
+
+void *AlignedResource::DoAllocate(size_t bytes, size_t alignment)
+{
+    void *address = mArena ? mArena->Allocate(bytes, alignment) : nullptr;
+
+    if (address == nullptr)
+    {
+        address = ZefAlignedMalloc(bytes, alignment);
+    }
+
+    if (address == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return address;
+}
+
+void AlignedResource::DoDeallocate(void *ptr, size_t, size_t)
+{
+    // arena memory is given back with the arena
+    if (!mArena || !mArena->Owns(ptr))
+    {
+        ZefAlignedFree(ptr);
+    }
+}
+
+bool AlignedResource::DoIsEqual(const MemoryResource &other) const noexcept
+{
+    const AlignedResource *aligned = dynamic_cast< const AlignedResource * >(&other);
+
+    return aligned && aligned->mArena == mArena;
+}
@@ -0,0 +1,55 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/frameArenaResource.h"
+
+#include "memory/allocators/frameArena.h"
+
+FrameArenaResource::FrameArenaResource(FrameArena &arena) noexcept
+    : mArena(arena)
+{
+}
+
+FrameArena &FrameArenaResource::GetArena() const noexcept
+{
+    return mArena;
+}
+
+void *FrameArenaResource::DoAllocate(size_t bytes, size_t alignment)
+{
+    return mArena.Allocate(bytes, alignment);
+}
+
+void FrameArenaResource::DoDeallocate(void *, size_t, size_t)
+{
+}
+
+bool FrameArenaResource::DoIsEqual(const MemoryResource &other) const noexcept
+{
+    const FrameArenaResource *resource = dynamic_cast< const FrameArenaResource * >(&other);
+
+    return resource && &resource->mArena == &mArena;
+}
@@ -0,0 +1,71 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/memoryResource.h"
+#include "memory/resource/alignedResource.h"
+
+#include <atomic>
+
+namespace
+{
+    // null means the initial resource, so the default is usable during static initialisation
+    std::atomic< MemoryResource * > gDefaultResource(nullptr);
+
+    MemoryResource *GetInitialResource() noexcept
+    {
+        static AlignedResource resource;
+        return &resource;
+    }
+}
+
+MemoryResource::~MemoryResource()
+{
+
+}
+
+bool operator==(const MemoryResource &lhs, const MemoryResource &rhs) noexcept
+{
+    return lhs.IsEqual(rhs);
+}
+
+bool operator!=(const MemoryResource &lhs, const MemoryResource &rhs) noexcept
+{
+    return !lhs.IsEqual(rhs);
+}
+
+MemoryResource *GetDefaultMemoryResource() noexcept
+{
+    MemoryResource *const resource = gDefaultResource.load(std::memory_order_acquire);
+
+    return resource ? resource : GetInitialResource();
+}
+
+MemoryResource *SetDefaultMemoryResource(MemoryResource *resource) noexcept
+{
+    MemoryResource *const previous = gDefaultResource.exchange(resource, std::memory_order_acq_rel);
+
+    return previous ? previous : GetInitialResource();
+}
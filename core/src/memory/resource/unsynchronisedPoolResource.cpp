@@ -0,0 +1,154 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/unsynchronisedPoolResource.h"
+
+#include <algorithm>
+#include <new>
+
+const size_t UnsynchronisedPoolResource::MinBlockShift;
+const size_t UnsynchronisedPoolResource::MaxBlockAlignment;
+
+UnsynchronisedPoolResource::UnsynchronisedPoolResource(size_t largestBlock /*= 512*/,
+                                                       size_t chunkSize /*= 64 * 1024*/,
+                                                       MemoryResource *upstream /*= nullptr*/)
+    : mUpstream(upstream ? upstream : GetDefaultMemoryResource()),
+      mCursor(nullptr),
+      mEnd(nullptr),
+      mLargestBlock(size_t(1) << MinBlockShift),
+      mChunkSize(chunkSize)
+{
+    while (mLargestBlock < largestBlock)
+    {
+        mLargestBlock <<= 1;
+    }
+
+    mChunkSize = std::max(mChunkSize, mLargestBlock);
+    mFreeLists.resize(GetBlockIndex(mLargestBlock, 1) + 1, nullptr);
+}
+
+UnsynchronisedPoolResource::~UnsynchronisedPoolResource()
+{
+    Release();
+}
+
+void UnsynchronisedPoolResource::Release()
+{
+    for (void *chunk : mChunks)
+    {
+        mUpstream->Deallocate(chunk, mChunkSize, MaxBlockAlignment);
+    }
+
+    mChunks.clear();
+    std::fill(mFreeLists.begin(), mFreeLists.end(), nullptr);
+
+    mCursor = nullptr;
+    mEnd = nullptr;
+}
+
+MemoryResource *UnsynchronisedPoolResource::GetUpstream() const noexcept
+{
+    return mUpstream;
+}
+
+size_t UnsynchronisedPoolResource::GetLargestBlock() const noexcept
+{
+    return mLargestBlock;
+}
+
+void *UnsynchronisedPoolResource::DoAllocate(size_t bytes, size_t alignment)
+{
+    if (bytes > mLargestBlock || alignment > MaxBlockAlignment)
+    {
+        return mUpstream->Allocate(bytes, alignment);
+    }
+
+    const size_t index = GetBlockIndex(bytes, alignment);
+    FreeBlock *const block = mFreeLists[index];
+
+    if (block)
+    {
+        mFreeLists[index] = block->next;
+        return block;
+    }
+
+    return Carve(size_t(1) << (index + MinBlockShift));
+}
+
+void UnsynchronisedPoolResource::DoDeallocate(void *ptr, size_t bytes, size_t alignment)
+{
+    if (bytes > mLargestBlock || alignment > MaxBlockAlignment)
+    {
+        mUpstream->Deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    const size_t index = GetBlockIndex(bytes, alignment);
+    FreeBlock *const block = static_cast< FreeBlock * >(ptr);
+
+    block->next = mFreeLists[index];
+    mFreeLists[index] = block;
+}
+
+bool UnsynchronisedPoolResource::DoIsEqual(const MemoryResource &) const noexcept
+{
+    // blocks can only be given back to the pool they came from
+    return false;
+}
+
+size_t UnsynchronisedPoolResource::GetBlockIndex(size_t bytes, size_t alignment) noexcept
+{
+    const size_t needed = std::max(bytes, alignment);
+    size_t index = 0;
+
+    while ((size_t(1) << (index + MinBlockShift)) < needed)
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+void *UnsynchronisedPoolResource::Carve(size_t blockSize)
+{
+    // aligning every block to its size, up to a cache line, keeps reused blocks aligned for
+    // every request that maps to the same size
+    const size_t alignment = std::min(blockSize, MaxBlockAlignment);
+    U8 *ptr = reinterpret_cast< U8 * >((reinterpret_cast< size_t >(mCursor) + alignment - 1) & ~(alignment - 1));
+
+    if (mCursor == nullptr || ptr + blockSize > mEnd)
+    {
+        U8 *const chunk = static_cast< U8 * >(mUpstream->Allocate(mChunkSize, MaxBlockAlignment));
+        mChunks.push_back(chunk);
+
+        ptr = chunk;
+        mEnd = chunk + mChunkSize;
+    }
+
+    mCursor = ptr + blockSize;
+
+    return ptr;
+}
@@ -0,0 +1,485 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/heapProfiler.h"
+
+#include "preproc/os.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if OS_IS_WINDOWS
+#   include <windows.h>
+#elif OS_IS_LINUX || OS_IS_MACOS
+#   include <execinfo.h>
+#   include <stdlib.h>
+#endif
+
+const size_t HeapProfiler::DefaultSampleInterval = 512 * 1024;
+const size_t HeapProfiler::MaxFrames;
+const size_t HeapProfiler::FilterSize;
+
+thread_local S64 HeapProfiler::tBytesUntilSample = 0;
+
+std::atomic< size_t > HeapProfiler::mLiveSamples(0);
+std::atomic< U32 > HeapProfiler::mFilter[HeapProfiler::FilterSize];
+
+namespace
+{
+    // how many bytes a thread allocates before it notices sampling was enabled again
+    const S64 gDisabledRecheckBytes = 1024 * 1024;
+
+    struct Stack
+    {
+        std::vector< void * > frames;
+        size_t allocSamples;
+        size_t allocBytes;
+        U8 sources;
+    };
+
+    struct LiveSample
+    {
+        size_t bytes;
+        F64 scale;
+        U32 stack;
+        HeapSampleSource source;
+    };
+
+    struct Profile
+    {
+        std::unordered_map< size_t, LiveSample > live;
+        std::unordered_multimap< U64, U32 > stackIndices;
+        std::vector< Stack > stacks;
+        std::mutex mutex;
+    };
+
+    struct ReportRow
+    {
+        std::vector< void * > frames;
+        size_t samples;
+        size_t bytes;
+        size_t allocSamples;
+        size_t allocBytes;
+        F64 estimatedBytes;
+        F64 estimatedObjects;
+    };
+
+    std::atomic< size_t > gSampleInterval(HeapProfiler::DefaultSampleInterval);
+
+    thread_local U64 tRandom = 0;
+    thread_local bool tArmed = false;
+    thread_local bool tSampling = false;
+
+    Profile &GetProfile()
+    {
+        // never destroyed, since static objects may free sampled memory during shutdown
+        static Profile *profile = new Profile;
+        return *profile;
+    }
+
+    U64 NextRandom() noexcept
+    {
+        if (tRandom == 0)
+        {
+            tRandom = (reinterpret_cast< U64 >(&tRandom) ^ 0x9E3779B97F4A7C15ull) | 1;
+        }
+
+        // xorshift64*
+        tRandom ^= tRandom >> 12;
+        tRandom ^= tRandom << 25;
+        tRandom ^= tRandom >> 27;
+        return tRandom * 0x2545F4914F6CDD1Dull;
+    }
+
+    S64 DrawSampleDistance(size_t interval) noexcept
+    {
+        // uniform in (0, 1], so the logarithm stays finite
+        const F64 uniform = static_cast< F64 >((NextRandom() >> 11) + 1) * (1.0 / 9007199254740992.0);
+        return static_cast< S64 >(-std::log(uniform) * static_cast< F64 >(interval)) + 1;
+    }
+
+    size_t CaptureStack(void **frames, size_t maxFrames, size_t skip) noexcept
+    {
+#if OS_IS_WINDOWS
+        return CaptureStackBackTrace(static_cast< DWORD >(skip), static_cast< DWORD >(maxFrames), frames, nullptr);
+#elif OS_IS_LINUX || OS_IS_MACOS
+        void *buffer[HeapProfiler::MaxFrames + 4];
+        const size_t count = static_cast< size_t >(backtrace(buffer, static_cast< int >(std::min(maxFrames + skip,
+                                                                                               HeapProfiler::MaxFrames + 4))));
+
+        if (count <= skip)
+        {
+            return 0;
+        }
+
+        std::copy(buffer + skip, buffer + count, frames);
+        return count - skip;
+#else
+        (void)frames;
+        (void)maxFrames;
+        (void)skip;
+        return 0;
+#endif
+    }
+
+    U64 HashFrames(void *const *frames, size_t count) noexcept
+    {
+        U64 hash = 14695981039346656037ull;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            hash = (hash ^ reinterpret_cast< U64 >(frames[i])) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    U32 FindStack(Profile &profile, void *const *frames, size_t count)
+    {
+        const U64 hash = HashFrames(frames, count);
+        auto range = profile.stackIndices.equal_range(hash);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const std::vector< void * > &existing = profile.stacks[it->second].frames;
+
+            if (existing.size() == count && std::equal(existing.begin(), existing.end(), frames))
+            {
+                return it->second;
+            }
+        }
+
+        const U32 index = static_cast< U32 >(profile.stacks.size());
+        profile.stacks.push_back({ std::vector< void * >(frames, frames + count), 0, 0, 0 });
+        profile.stackIndices.emplace(hash, index);
+
+        return index;
+    }
+
+    bool HasSource(HeapSampleSource sources, HeapSampleSource source) noexcept
+    {
+        return (static_cast< U8 >(sources) & static_cast< U8 >(source)) != 0;
+    }
+
+    // freed stacks have no live samples, but still count towards the allocation totals
+    std::vector< ReportRow > CollectRows(HeapSampleSource sources, bool includeFreed)
+    {
+        Profile &profile = GetProfile();
+        std::unordered_map< U32, ReportRow > rows;
+
+        {
+            std::lock_guard< std::mutex > lock(profile.mutex);
+
+            if (includeFreed)
+            {
+                for (U32 i = 0; i < profile.stacks.size(); ++i)
+                {
+                    const Stack &stack = profile.stacks[i];
+
+                    if ((stack.sources & static_cast< U8 >(sources)) != 0)
+                    {
+                        rows.emplace(i, ReportRow{ stack.frames, 0, 0, stack.allocSamples, stack.allocBytes, 0, 0 });
+                    }
+                }
+            }
+
+            for (const auto &entry : profile.live)
+            {
+                const LiveSample &sample = entry.second;
+
+                if (!HasSource(sources, sample.source))
+                {
+                    continue;
+                }
+
+                auto it = rows.find(sample.stack);
+
+                if (it == rows.end())
+                {
+                    const Stack &stack = profile.stacks[sample.stack];
+                    it = rows.emplace(sample.stack, ReportRow{ stack.frames, 0, 0, stack.allocSamples, stack.allocBytes, 0, 0 }).first;
+                }
+
+                ReportRow &row = it->second;
+                ++row.samples;
+                row.bytes += sample.bytes;
+                row.estimatedBytes += sample.scale * static_cast< F64 >(sample.bytes);
+                row.estimatedObjects += sample.scale;
+            }
+        }
+
+        std::vector< ReportRow > sorted;
+        sorted.reserve(rows.size());
+
+        for (auto &row : rows)
+        {
+            sorted.push_back(std::move(row.second));
+        }
+
+        std::sort(sorted.begin(), sorted.end(), [](const ReportRow &a, const ReportRow &b)
+        {
+            return a.estimatedBytes > b.estimatedBytes;
+        });
+
+        return sorted;
+    }
+}
+
+void HeapProfiler::SetSampleInterval(size_t bytes) noexcept
+{
+    gSampleInterval.store(bytes, std::memory_order_relaxed);
+}
+
+size_t HeapProfiler::GetSampleInterval() noexcept
+{
+    return gSampleInterval.load(std::memory_order_relaxed);
+}
+
+HeapProfileSummary HeapProfiler::GetSummary(HeapSampleSource sources /*= HeapSampleSource::All*/)
+{
+    HeapProfileSummary summary = {};
+
+    for (const ReportRow &row : CollectRows(sources, false))
+    {
+        summary.samples += row.samples;
+        summary.estimatedBytes += row.estimatedBytes;
+        summary.estimatedObjects += row.estimatedObjects;
+    }
+
+    return summary;
+}
+
+void HeapProfiler::WriteText(std::ostream &stream, HeapSampleSource sources /*= HeapSampleSource::All*/)
+{
+    const std::vector< ReportRow > rows = CollectRows(sources, false);
+
+    HeapProfileSummary summary = {};
+
+    for (const ReportRow &row : rows)
+    {
+        summary.samples += row.samples;
+        summary.estimatedBytes += row.estimatedBytes;
+        summary.estimatedObjects += row.estimatedObjects;
+    }
+
+    stream << "Heap profile: " << summary.samples << " live samples, ~" << static_cast< U64 >(summary.estimatedBytes)
+           << " bytes in ~" << static_cast< U64 >(summary.estimatedObjects) << " objects, interval "
+           << GetSampleInterval() << " bytes\n";
+
+    for (const ReportRow &row : rows)
+    {
+        stream << "\n~" << static_cast< U64 >(row.estimatedBytes) << " bytes in ~"
+               << static_cast< U64 >(row.estimatedObjects) << " objects (" << row.samples << " samples)\n";
+
+#if (OS_IS_LINUX || OS_IS_MACOS) && !OS_IS_ANDROID
+        char **symbols = backtrace_symbols(row.frames.data(), static_cast< int >(row.frames.size()));
+#endif
+
+        for (size_t i = 0; i < row.frames.size(); ++i)
+        {
+            stream << "    #" << i << " " << row.frames[i];
+
+#if (OS_IS_LINUX || OS_IS_MACOS) && !OS_IS_ANDROID
+
+            if (symbols)
+            {
+                stream << " " << symbols[i];
+            }
+
+#endif
+            stream << "\n";
+        }
+
+#if (OS_IS_LINUX || OS_IS_MACOS) && !OS_IS_ANDROID
+        free(symbols);
+#endif
+    }
+}
+
+void HeapProfiler::WritePprof(std::ostream &stream, HeapSampleSource sources /*= HeapSampleSource::All*/)
+{
+    const std::vector< ReportRow > rows = CollectRows(sources, true);
+
+    size_t samples = 0;
+    size_t bytes = 0;
+    size_t allocSamples = 0;
+    size_t allocBytes = 0;
+
+    for (const ReportRow &row : rows)
+    {
+        samples += row.samples;
+        bytes += row.bytes;
+        allocSamples += row.allocSamples;
+        allocBytes += row.allocBytes;
+    }
+
+    stream << "heap profile: " << samples << ": " << bytes << " [" << allocSamples << ": " << allocBytes
+           << "] @ heap_v2/" << GetSampleInterval() << "\n";
+
+    for (const ReportRow &row : rows)
+    {
+        stream << row.samples << ": " << row.bytes << " [" << row.allocSamples << ": " << row.allocBytes << "] @";
+
+        for (void *frame : row.frames)
+        {
+            stream << " " << frame;
+        }
+
+        stream << "\n";
+    }
+
+#if OS_IS_LINUX
+    // lets pprof map the addresses back to the binaries
+    std::ifstream maps("/proc/self/maps");
+
+    if (maps)
+    {
+        stream << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+    }
+
+#endif
+}
+
+bool HeapProfiler::Dump(const std::string &path, bool pprof, HeapSampleSource sources /*= HeapSampleSource::All*/)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::trunc);
+
+    if (!stream)
+    {
+        return false;
+    }
+
+    if (pprof)
+    {
+        WritePprof(stream, sources);
+    }
+    else
+    {
+        WriteText(stream, sources);
+    }
+
+    return static_cast< bool >(stream);
+}
+
+void HeapProfiler::Reset()
+{
+    Profile &profile = GetProfile();
+    std::lock_guard< std::mutex > lock(profile.mutex);
+
+    profile.live.clear();
+    profile.stackIndices.clear();
+    profile.stacks.clear();
+
+    for (std::atomic< U32 > &counter : mFilter)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    mLiveSamples.store(0, std::memory_order_relaxed);
+}
+
+void HeapProfiler::Sample(size_t key, size_t bytes, HeapSampleSource source)
+{
+    const size_t interval = gSampleInterval.load(std::memory_order_relaxed);
+
+    if (interval == 0)
+    {
+        tArmed = false;
+        tBytesUntilSample = gDisabledRecheckBytes;
+        return;
+    }
+
+    if (!tArmed)
+    {
+        // a fresh thread or a re-enabled profiler, draw a distance instead of sampling the first allocation
+        tArmed = true;
+        tBytesUntilSample += DrawSampleDistance(interval);
+
+        if (tBytesUntilSample >= 0)
+        {
+            return;
+        }
+    }
+
+    tBytesUntilSample = DrawSampleDistance(interval);
+
+    if (tSampling)
+    {
+        return;
+    }
+
+    tSampling = true;
+
+    void *frames[MaxFrames];
+    const size_t count = CaptureStack(frames, MaxFrames, 1);
+    const F64 scale = 1.0 / (1.0 - std::exp(-static_cast< F64 >(bytes) / static_cast< F64 >(interval)));
+
+    Profile &profile = GetProfile();
+
+    {
+        std::lock_guard< std::mutex > lock(profile.mutex);
+
+        const U32 stack = FindStack(profile, frames, count);
+        profile.stacks[stack].allocSamples += 1;
+        profile.stacks[stack].allocBytes += bytes;
+        profile.stacks[stack].sources |= static_cast< U8 >(source);
+
+        auto result = profile.live.emplace(key, LiveSample{ bytes, scale, stack, source });
+
+        if (result.second)
+        {
+            mFilter[GetFilterIndex(key)].fetch_add(1, std::memory_order_relaxed);
+            mLiveSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            // the pointer was freed through a path that is not hooked, replace the stale sample
+            result.first->second = LiveSample{ bytes, scale, stack, source };
+        }
+    }
+
+    tSampling = false;
+}
+
+void HeapProfiler::Remove(size_t key)
+{
+    Profile &profile = GetProfile();
+    std::lock_guard< std::mutex > lock(profile.mutex);
+
+    auto it = profile.live.find(key);
+
+    if (it != profile.live.end())
+    {
+        profile.live.erase(it);
+
+        mFilter[GetFilterIndex(key)].fetch_sub(1, std::memory_order_relaxed);
+        mLiveSamples.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
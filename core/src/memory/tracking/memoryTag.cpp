@@ -0,0 +1,98 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/memoryTag.h"
+
+#include "manager/scheduleManager.h"
+
+#include <algorithm>
+
+const size_t MemoryTag::SharedSlot;
+
+MemoryTag::MemoryTag(const std::string &name, MemoryKind kind, Namespace ns) noexcept
+    : mName(name),
+      mSampledBytes(0),
+      mNamespace(ns.GetNamespace()),
+      mPeakBytes(0),
+      mLastAllocations(0),
+      mKind(kind)
+{
+}
+
+void MemoryTag::Sample(size_t bytes) noexcept
+{
+    mSampledBytes.store(static_cast< S64 >(bytes), std::memory_order_relaxed);
+}
+
+void MemoryTag::SetNamespace(Namespace ns) noexcept
+{
+    mNamespace.store(ns.GetNamespace(), std::memory_order_relaxed);
+}
+
+Namespace MemoryTag::GetNamespace() const noexcept
+{
+    return mNamespace.load(std::memory_order_relaxed);
+}
+
+const std::string &MemoryTag::GetName() const noexcept
+{
+    return mName;
+}
+
+MemoryKind MemoryTag::GetKind() const noexcept
+{
+    return mKind;
+}
+
+MemoryStats MemoryTag::Collect(std::chrono::microseconds elapsed)
+{
+    MemoryStats stats;
+    stats.name = mName;
+    stats.kind = mKind;
+    stats.ns = GetNamespace();
+    stats.bytes = mSampledBytes.load(std::memory_order_relaxed);
+    stats.liveObjects = 0;
+
+    S64 allocations = 0;
+
+    mCounters.ForEach([&stats, &allocations](const Counters &counters)
+    {
+        stats.bytes += counters.bytes.load(std::memory_order_relaxed);
+        stats.liveObjects += counters.objects.load(std::memory_order_relaxed);
+        allocations += counters.allocations.load(std::memory_order_relaxed);
+    });
+
+    mPeakBytes = std::max(mPeakBytes, stats.bytes);
+    stats.peakBytes = mPeakBytes;
+    stats.allocations = static_cast< U64 >(allocations);
+    stats.allocationRate = elapsed.count() > 0 ?
+                           static_cast< F64 >(allocations - mLastAllocations) * 1e6 / elapsed.count() :
+                           0.0;
+
+    mLastAllocations = allocations;
+
+    return stats;
+}
@@ -0,0 +1,120 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/memoryTracker.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    struct Registry
+    {
+        std::vector< std::unique_ptr< MemoryTag >> tags;
+        std::unordered_map< U32, S64 > namespacePeaks;
+        std::mutex mutex;
+    };
+
+    Registry &GetRegistry()
+    {
+        // never destroyed, since static pools may unregister their tags during shutdown
+        static Registry *registry = new Registry;
+        return *registry;
+    }
+}
+
+MemoryTag *MemoryTracker::Register(const std::string &name, MemoryKind kind, Namespace ns /*= 0U*/)
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+
+    registry.tags.emplace_back(new MemoryTag(name, kind, ns));
+
+    return registry.tags.back().get();
+}
+
+void MemoryTracker::Unregister(MemoryTag *tag)
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+
+    auto it = std::find_if(registry.tags.begin(), registry.tags.end(), [tag](const std::unique_ptr< MemoryTag > &owned)
+    {
+        return owned.get() == tag;
+    });
+
+    if (it != registry.tags.end())
+    {
+        std::swap(*it, registry.tags.back());
+        registry.tags.pop_back();
+    }
+}
+
+void MemoryTracker::Collect(std::chrono::microseconds elapsed, std::vector< MemoryStats > &tags,
+                            std::vector< MemoryStats > &namespaces)
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+
+    tags.clear();
+    namespaces.clear();
+
+    std::unordered_map< U32, size_t > namespaceIndices;
+
+    for (const std::unique_ptr< MemoryTag > &tag : registry.tags)
+    {
+        tags.push_back(tag->Collect(elapsed));
+
+        const MemoryStats &stats = tags.back();
+        const U32 ns = stats.ns.GetNamespace();
+        auto it = namespaceIndices.find(ns);
+
+        if (it == namespaceIndices.end())
+        {
+            it = namespaceIndices.emplace(ns, namespaces.size()).first;
+
+            MemoryStats total = {};
+            total.kind = MemoryKind::Namespace;
+            total.ns = stats.ns;
+            namespaces.push_back(total);
+        }
+
+        MemoryStats &total = namespaces[it->second];
+        total.bytes += stats.bytes;
+        total.liveObjects += stats.liveObjects;
+        total.allocations += stats.allocations;
+        total.allocationRate += stats.allocationRate;
+    }
+
+    for (MemoryStats &total : namespaces)
+    {
+        S64 &peak = registry.namespacePeaks[total.ns.GetNamespace()];
+        peak = std::max(peak, total.bytes);
+        total.peakBytes = peak;
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/backoff.h"
+
+#include "preproc/arch.h"
+
+#if ARCH_IS_X86
+#   include <emmintrin.h>
+#endif
+
+#include <thread>
+
+Backoff::Backoff(U32 maxSpins /*= 1024*/) noexcept
+    : mSpins(1),
+      mMaxSpins(maxSpins),
+      mCount(0)
+{
+}
+
+void Backoff::Pause() noexcept
+{
+    ++mCount;
+
+    if (mSpins <= mMaxSpins)
+    {
+        for (U32 i = 0; i < mSpins; ++i)
+        {
+            CpuRelax();
+        }
+
+        mSpins <<= 1;
+    }
+    else
+    {
+        std::this_thread::yield();
+    }
+}
+
+void Backoff::Reset() noexcept
+{
+    mSpins = 1;
+}
+
+U32 Backoff::GetCount() const noexcept
+{
+    return mCount;
+}
+
+void Backoff::CpuRelax() noexcept
+{
+#if ARCH_IS_X86
+    _mm_pause();
+#endif
+}
@@ -0,0 +1,137 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/rwSpinLock.h"
+#include "threading/backoff.h"
+
+RWSpinLock::RWSpinLock() noexcept
+    : mState(0),
+      mReadContention(0),
+      mWriteContention(0)
+{
+}
+
+void RWSpinLock::lock() noexcept
+{
+    if (try_lock())
+    {
+        return;
+    }
+
+    mWriteContention.fetch_add(1, boost::memory_order_relaxed);
+
+    Backoff backoff;
+
+    for (;;)
+    {
+        U32 state = mState.load(boost::memory_order_relaxed);
+
+        if ((state & ~WriterPending) == 0)
+        {
+            // acquiring clears the pending flag, other waiting writers will set it again
+            if (mState.compare_exchange_weak(state, Writer, boost::memory_order_acquire, boost::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+        else if ((state & WriterPending) == 0)
+        {
+            mState.fetch_or(WriterPending, boost::memory_order_relaxed);
+        }
+
+        backoff.Pause();
+    }
+}
+
+bool RWSpinLock::try_lock() noexcept
+{
+    U32 state = mState.load(boost::memory_order_relaxed);
+
+    return (state & ~WriterPending) == 0 &&
+           mState.compare_exchange_strong(state, Writer, boost::memory_order_acquire, boost::memory_order_relaxed);
+}
+
+void RWSpinLock::unlock() noexcept
+{
+    mState.fetch_and(~static_cast< U32 >(Writer), boost::memory_order_release);
+}
+
+void RWSpinLock::lock_shared() noexcept
+{
+    if (try_lock_shared())
+    {
+        return;
+    }
+
+    mReadContention.fetch_add(1, boost::memory_order_relaxed);
+
+    Backoff backoff;
+
+    for (;;)
+    {
+        // only touch the line for writing when we have a chance to succeed
+        if ((mState.load(boost::memory_order_relaxed) & (Writer | WriterPending)) == 0 && try_lock_shared())
+        {
+            return;
+        }
+
+        backoff.Pause();
+    }
+}
+
+bool RWSpinLock::try_lock_shared() noexcept
+{
+    const U32 state = mState.fetch_add(Reader, boost::memory_order_acquire);
+
+    if ((state & (Writer | WriterPending)) != 0)
+    {
+        mState.fetch_sub(Reader, boost::memory_order_release);
+        return false;
+    }
+
+    return true;
+}
+
+void RWSpinLock::unlock_shared() noexcept
+{
+    mState.fetch_sub(Reader, boost::memory_order_release);
+}
+
+U64 RWSpinLock::GetReadContentionCount() const noexcept
+{
+    return mReadContention.load(boost::memory_order_relaxed);
+}
+
+U64 RWSpinLock::GetWriteContentionCount() const noexcept
+{
+    return mWriteContention.load(boost::memory_order_relaxed);
+}
+
+void RWSpinLock::ResetContentionCounts() noexcept
+{
+    mReadContention.store(0, boost::memory_order_relaxed);
+    mWriteContention.store(0, boost::memory_order_relaxed);
+}
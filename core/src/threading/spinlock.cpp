@@ -25,6 +25,7 @@
  */
 
 #include "threading/spinlock.h"
+#include "threading/backoff.h"
 
 SpinLock::SpinLock() noexcept
 {
@@ -32,8 +33,16 @@ SpinLock::SpinLock() noexcept
 
 void SpinLock::lock() noexcept
 {
+    if (!mLockValue.test_and_set(boost::memory_order_acquire))
+    {
+        return;
+    }
+
+    Backoff backoff;
+
     while (mLockValue.test_and_set(boost::memory_order_acquire))
     {
+        backoff.Pause();
     }
 }
 
@@ -29,7 +29,7 @@
 #include "threading/worker.h"
 
 
-ThreadPool::ThreadPool(const U32 capacity /*= 16*/, const U32 startThreadID /*= 0 */) noexcept
+ThreadPool::ThreadPool(const U32 capacity /*= 16*/, const U32 startThreadID /*= 1 */) noexcept
     : mQueueHook(nullptr),
       mLastQueueSize(0),
       mStartThreadID(startThreadID)
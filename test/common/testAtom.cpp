@@ -0,0 +1,177 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "common/atom.h"
+
+#include "manager/systemManager.h"
+
+#include "engineTest.h"
+
+#include <string.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    U32 GetAtomID(Atom atom)
+    {
+        return atom.GetID();
+    }
+
+    TEST(Atom, Sanity)
+    {
+        Atom atom;
+
+        EXPECT_FALSE(atom.IsValid());
+        EXPECT_EQ("", atom.GetString());
+    }
+
+    TEST(Atom, Intern)
+    {
+        Atom a = AtomTable::Intern(std::string("AtomIntern"));
+        Atom b = AtomTable::Intern("AtomIntern");
+        Atom c("AtomIntern");
+
+        EXPECT_TRUE(a.IsValid());
+        EXPECT_EQ(a, b);
+        EXPECT_EQ(a, c);
+        EXPECT_EQ("AtomIntern", a.GetString());
+    }
+
+    TEST(Atom, InternPointer)
+    {
+        const char *str = "AtomInternPointer";
+
+        EXPECT_EQ(Atom("AtomInternPointer"), AtomTable::Intern(str));
+    }
+
+    TEST(Atom, ConvertPointer)
+    {
+        const char *str = "AtomConvertPointer";
+
+        // a function taking an atom accepts a pointer, like it accepts a literal
+        EXPECT_EQ(Atom("AtomConvertPointer").GetID(), GetAtomID(str));
+        EXPECT_EQ(GetAtomID("AtomConvertPointer"), GetAtomID(str));
+    }
+
+    TEST(Atom, PartialBuffer)
+    {
+        char buffer[32] = {};
+        strcpy(buffer, "AtomPartialBuffer");
+
+        Atom atom(buffer);
+
+        EXPECT_EQ(Atom("AtomPartialBuffer"), atom);
+        EXPECT_EQ(Atom("AtomPartialBuffer"), AtomTable::Intern(buffer));
+        EXPECT_EQ(strlen("AtomPartialBuffer"), atom.GetString().size());
+    }
+
+    TEST(Atom, HostStorage)
+    {
+        EXPECT_EQ(SystemManager::Get()->GetAtomStorage(), AtomTable::GetStorage());
+        EXPECT_EQ(AtomTable::GetModuleStorage(), AtomTable::GetStorage());
+    }
+
+    TEST(Atom, Distinct)
+    {
+        Atom a("AtomDistinct1");
+        Atom b("AtomDistinct2");
+
+        EXPECT_NE(a, b);
+        EXPECT_NE(std::hash< Atom >()(a), std::hash< Atom >()(b));
+    }
+
+    TEST(Atom, Find)
+    {
+        EXPECT_FALSE(AtomTable::Find(std::string("AtomFindNever")).IsValid());
+
+        const size_t size = AtomTable::GetSize();
+        Atom atom("AtomFind");
+
+        EXPECT_EQ(size + 1, AtomTable::GetSize());
+        EXPECT_EQ(atom, AtomTable::Find(std::string("AtomFind")));
+        EXPECT_EQ(atom, AtomTable::Find(StringHash("AtomFind")));
+        EXPECT_FALSE(AtomTable::Find(StringHash("AtomFindNever")).IsValid());
+    }
+
+    TEST(Atom, Collision)
+    {
+        // both strings have FNV-1a hash 0x07bdd991
+        const size_t collisions = AtomTable::GetCollisionCount();
+
+        Atom a("atom162789");
+        Atom b("atom379192");
+
+        EXPECT_EQ(StringHash("atom162789").GetHash(), StringHash("atom379192").GetHash());
+        EXPECT_NE(a, b);
+        EXPECT_EQ("atom162789", a.GetString());
+        EXPECT_EQ("atom379192", b.GetString());
+        EXPECT_EQ(b, Atom("atom379192"));
+        EXPECT_EQ(collisions + 1, AtomTable::GetCollisionCount());
+    }
+
+    TEST(Atom, Map)
+    {
+        std::unordered_map< Atom, U32 > map;
+        map[Atom("AtomMap1")] = 1;
+        map[Atom("AtomMap2")] = 2;
+
+        EXPECT_EQ(1u, map[Atom(std::string("AtomMap1"))]);
+        EXPECT_EQ(2u, map[Atom("AtomMap2")]);
+    }
+
+    TEST(Atom, Threads)
+    {
+        std::vector< Atom > atoms(8);
+        std::vector< std::thread > threads;
+
+        for (size_t i = 0; i < atoms.size(); ++i)
+        {
+            threads.emplace_back([&atoms, i]()
+            {
+                for (U32 j = 0; j < 100; ++j)
+                {
+                    AtomTable::Intern("AtomThreads" + std::to_string(j));
+                }
+
+                atoms[i] = AtomTable::Intern("AtomThreads");
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const Atom &atom : atoms)
+        {
+            EXPECT_EQ(atoms[0], atom);
+        }
+
+        EXPECT_TRUE(AtomTable::Find(std::string("AtomThreads99")).IsValid());
+    }
+}
@@ -24,6 +24,8 @@
  * @endcond
  */
 
+#include "container/smallVector.h"
+
 #include "common/string.h"
 
 #include "engineTest.h"
@@ -256,6 +258,16 @@ namespace
         //! [Split Trimmed]
     }
 
+    TEST(String, Split, Container)
+    {
+        SmallVector< std::string, 4 > parts;
+        String::Split("< ; >", ';', parts, true);
+        EXPECT_TRUE(parts.IsInline());
+        EXPECT_EQ(2u, parts.size());
+        EXPECT_EQ("<", parts[0]);
+        EXPECT_EQ(">", parts[1]);
+    }
+
     TEST(String, Split, Whitespace)
     {
         {
@@ -0,0 +1,148 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "common/typeID.h"
+
+#include "manager/systemManager.h"
+
+#include "engineTest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TypeA
+    {
+    };
+
+    struct TypeB
+    {
+    };
+
+    template< U32 tN >
+    struct Numbered
+    {
+    };
+
+    struct PluginOnly
+    {
+    };
+
+    struct Shared
+    {
+    };
+
+    TEST(TypeID, Sanity)
+    {
+        TypeID id;
+
+        EXPECT_FALSE(id.IsValid());
+        EXPECT_STREQ("", TypeRegistry::Get()->GetName(id));
+    }
+
+    TEST(TypeID, Get)
+    {
+        const TypeID a = TypeID::Get< TypeA >();
+
+        EXPECT_TRUE(a.IsValid());
+        EXPECT_EQ(a, TypeID::Get< TypeA >());
+        EXPECT_NE(a, TypeID::Get< TypeB >());
+        EXPECT_LE(a.GetID(), TypeRegistry::Get()->GetSize());
+    }
+
+    TEST(TypeID, Register)
+    {
+        // a module without the cached static finds the same identifier
+        EXPECT_EQ(TypeID::Get< TypeB >(), TypeRegistry::Get()->Register(typeid(TypeB)));
+        EXPECT_EQ(TypeRegistry::Get()->Register(typeid(double)), TypeID::Get< double >());
+    }
+
+    TEST(TypeID, Name)
+    {
+        EXPECT_EQ(std::string(typeid(TypeA).name()), TypeRegistry::Get()->GetName(TypeID::Get< TypeA >()));
+    }
+
+    TEST(TypeID, Dense)
+    {
+        const size_t size = TypeRegistry::Get()->GetSize();
+
+        const TypeID first = TypeID::Get< Numbered< 1 >>();
+        const TypeID second = TypeID::Get< Numbered< 2 >>();
+
+        EXPECT_EQ(size + 1, first.GetID());
+        EXPECT_EQ(size + 2, second.GetID());
+        EXPECT_LT(first, second);
+    }
+
+    TEST(TypeID, Threads)
+    {
+        std::vector< std::thread > threads;
+        std::vector< TypeID > ids(8);
+
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            threads.emplace_back([&ids, i]()
+            {
+                ids[i] = TypeRegistry::Get()->Register(typeid(Numbered< 100 >));
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const TypeID &id : ids)
+        {
+            EXPECT_EQ(TypeID::Get< Numbered< 100 >>(), id);
+        }
+    }
+
+    TEST(TypeID, HostRegistry)
+    {
+        EXPECT_EQ(SystemManager::Get()->GetTypeRegistry(), TypeRegistry::Get());
+        EXPECT_EQ(TypeRegistry::GetModuleRegistry(), TypeRegistry::Get());
+    }
+
+    TEST(TypeID, ModuleRegistry)
+    {
+        const TypeID id = TypeID::Get< Shared >();
+
+        // a plugin has its own registry, which numbers its types from one
+        TypeRegistry plugin;
+        EXPECT_EQ(1u, plugin.Register(typeid(PluginOnly)).GetID());
+        EXPECT_NE(id, plugin.Register(typeid(Shared)));
+
+        // but it resolves types through the registry of the host
+        TypeRegistry *host = SystemManager::Get()->GetTypeRegistry();
+        EXPECT_NE(&plugin, host);
+        EXPECT_EQ(id, host->Register(typeid(Shared)));
+        EXPECT_STREQ(plugin.GetName(plugin.Register(typeid(Shared))), host->GetName(id));
+        EXPECT_EQ(id, TypeID::Get< Shared >());
+    }
+}
@@ -26,6 +26,8 @@
 
 #include "engineTest.h"
 
+#include <vector>
+
 namespace
 {
 
@@ -369,6 +371,24 @@ namespace
         //! [NearestPower2]
     }
 
+    TEST(Util, FaultIn)
+    {
+        std::vector< U8 > memory(3 * 4096 + 17);
+
+        for (size_t i = 0; i < memory.size(); ++i)
+        {
+            memory[i] = static_cast< U8 >(i);
+        }
+
+        Util::FaultIn(memory.data(), memory.size());
+        Util::FaultIn(memory.data(), 0);
+
+        for (size_t i = 0; i < memory.size(); ++i)
+        {
+            EXPECT_EQ(static_cast< U8 >(i), memory[i]);
+        }
+    }
+
     //! [IsChildParent Example]
     class Base
     {
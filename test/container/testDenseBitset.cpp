@@ -29,6 +29,10 @@
 
 #include "engineTest.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 namespace
 {
     TEST(DenseBitset, SanityCheck)
@@ -89,4 +93,185 @@ namespace
         EXPECT_FALSE(f);
     }
 
-}
\ No newline at end of file
+    std::vector< bool > RandomBits(DenseBitset &set, size_t size, U32 seed, U32 percentage)
+    {
+        std::mt19937 gen(seed);
+        std::vector< bool > reference(size);
+
+        set.Resize(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            reference[i] = gen() % 100 < percentage;
+            set[i] = reference[i];
+        }
+
+        return reference;
+    }
+
+    TEST(DenseBitset, GetSize)
+    {
+        DenseBitset m(100);
+        EXPECT_EQ(100u, m.GetSize());
+
+        m.Resize(10);
+        EXPECT_EQ(10u, m.GetSize());
+    }
+
+    TEST(DenseBitset, ResizeClearsTail)
+    {
+        DenseBitset m(100);
+        m.SetRange(0, 100);
+        m.Resize(10);
+        m.Resize(100);
+
+        EXPECT_EQ(10u, m.Count());
+        EXPECT_FALSE(m[10]);
+    }
+
+    TEST(DenseBitset, Bulk)
+    {
+        // not a multiple of the four words combined at once
+        const size_t size = 1100;
+        DenseBitset a, b;
+        const std::vector< bool > ra = RandomBits(a, size, 1, 50);
+        const std::vector< bool > rb = RandomBits(b, size, 2, 50);
+
+        DenseBitset andSet(a), orSet(a), xorSet(a), andNotSet(a);
+        andSet &= b;
+        orSet |= b;
+        xorSet ^= b;
+        andNotSet.AndNot(b);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(ra[i] && rb[i], andSet[i]);
+            EXPECT_EQ(ra[i] || rb[i], orSet[i]);
+            EXPECT_EQ(ra[i] != rb[i], xorSet[i]);
+            EXPECT_EQ(ra[i] && !rb[i], andNotSet[i]);
+        }
+    }
+
+    TEST(DenseBitset, Count)
+    {
+        DenseBitset m;
+        const std::vector< bool > reference = RandomBits(m, 1001, 3, 30);
+
+        EXPECT_EQ(static_cast< size_t >(std::count(reference.begin(), reference.end(), true)), m.Count());
+        EXPECT_TRUE(m.Any());
+
+        m.Reset();
+        EXPECT_EQ(0u, m.Count());
+        EXPECT_FALSE(m.Any());
+    }
+
+    TEST(DenseBitset, Range)
+    {
+        DenseBitset m(300);
+        m.SetRange(10, 20);
+        EXPECT_EQ(10u, m.Count());
+        EXPECT_FALSE(m[9]);
+        EXPECT_TRUE(m[10]);
+        EXPECT_TRUE(m[19]);
+        EXPECT_FALSE(m[20]);
+
+        m.SetRange(60, 250);
+        EXPECT_EQ(200u, m.Count());
+
+        m.ClearRange(64, 128);
+        EXPECT_EQ(136u, m.Count());
+        EXPECT_TRUE(m[63]);
+        EXPECT_FALSE(m[64]);
+        EXPECT_FALSE(m[127]);
+        EXPECT_TRUE(m[128]);
+
+        m.ClearRange(15, 15);
+        m.SetRange(290, 1000);
+        EXPECT_EQ(146u, m.Count());
+
+        m.ClearRange(0, 300);
+        EXPECT_FALSE(m.Any());
+    }
+
+    TEST(DenseBitset, FindNext)
+    {
+        DenseBitset m;
+        const std::vector< bool > reference = RandomBits(m, 1000, 4, 5);
+
+        std::vector< size_t > found;
+
+        for (size_t bit = m.FindFirst(); bit != m.GetSize(); bit = m.FindNext(bit))
+        {
+            found.push_back(bit);
+        }
+
+        std::vector< size_t > expected;
+
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            if (reference[i])
+            {
+                expected.push_back(i);
+            }
+        }
+
+        EXPECT_EQ(expected, found);
+
+        std::vector< size_t > visited;
+        m.ForEachSet([&visited](size_t bit)
+        {
+            visited.push_back(bit);
+        });
+
+        EXPECT_EQ(expected, visited);
+    }
+
+    TEST(DenseBitset, FindEmpty)
+    {
+        DenseBitset m(100);
+        EXPECT_EQ(100u, m.FindFirst());
+
+        m[99] = true;
+        EXPECT_EQ(99u, m.FindFirst());
+        EXPECT_EQ(100u, m.FindNext(99));
+    }
+
+    TEST(DenseBitset, RankSelect)
+    {
+        DenseBitset m;
+        const std::vector< bool > reference = RandomBits(m, 5000, 5, 20);
+        m.BuildRankIndex();
+
+        size_t rank = 0;
+
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            ASSERT_EQ(rank, m.Rank(i));
+
+            if (reference[i])
+            {
+                ASSERT_EQ(i, m.Select(rank));
+                ++rank;
+            }
+        }
+
+        EXPECT_EQ(rank, m.Rank(m.GetSize()));
+        EXPECT_EQ(m.GetSize(), m.Select(rank));
+    }
+
+    TEST(DenseBitset, RankSelectSparse)
+    {
+        DenseBitset m(10000);
+        m[0] = true;
+        m[5000] = true;
+        m[9999] = true;
+        m.BuildRankIndex();
+
+        EXPECT_EQ(0u, m.Select(0));
+        EXPECT_EQ(5000u, m.Select(1));
+        EXPECT_EQ(9999u, m.Select(2));
+        EXPECT_EQ(10000u, m.Select(3));
+        EXPECT_EQ(2u, m.Rank(9999));
+        EXPECT_EQ(3u, m.Rank(10000));
+    }
+}
@@ -28,6 +28,10 @@
 
 #include "engineTest.h"
 
+#include <unordered_map>
+#include <random>
+#include <vector>
+
 namespace
 {
     TEST(FastPtrHashMap, SanityCheck)
@@ -176,4 +180,149 @@ namespace
         delete ptr2;
     }
 
-}
\ No newline at end of file
+    TEST(FastPtrHashMap, Erase)
+    {
+        U8 *ptr = new U8;
+        U8 *ptr2 = new U8;
+        FastPtrHashMap< U8, U8 > m;
+        m.Insert(ptr, 5);
+        m.Insert(ptr2, 50);
+
+        EXPECT_TRUE(m.Erase(ptr));
+        EXPECT_FALSE(m.Erase(ptr));
+        EXPECT_FALSE(m.Has(ptr));
+        EXPECT_EQ(1u, m.Size());
+
+        U8 *val = nullptr;
+        EXPECT_TRUE(m.Find(ptr2, val));
+        EXPECT_EQ(50, *val);
+
+        EXPECT_EQ(1u, m.Data().size());
+        EXPECT_EQ(ptr2, m.Data()[0].ptr);
+
+        delete ptr;
+        delete ptr2;
+    }
+
+    TEST(FastPtrHashMap, EraseReinsert)
+    {
+        U8 *ptr = new U8;
+        FastPtrHashMap< U8, U8 > m;
+        m.Insert(ptr, 5);
+        m.Erase(ptr);
+        m.Insert(ptr, 50);
+
+        U8 *val = nullptr;
+        EXPECT_TRUE(m.Find(ptr, val));
+        EXPECT_EQ(50, *val);
+
+        delete ptr;
+    }
+
+    TEST(FastPtrHashMap, EraseChurn)
+    {
+        std::vector< U32 > storage(4096);
+        std::unordered_map< U32 *, U32 > reference;
+        FastPtrHashMap< U32, U32 > m(16);
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution< size_t > dist(0, storage.size() - 1);
+
+        for (U32 i = 0; i < 50000; ++i)
+        {
+            U32 *ptr = &storage[dist(gen)];
+
+            if (gen() % 3 == 0)
+            {
+                EXPECT_EQ(reference.erase(ptr) == 1, m.Erase(ptr));
+            }
+            else if (reference.emplace(ptr, i).second)
+            {
+                m.Insert(ptr, i);
+            }
+        }
+
+        ASSERT_EQ(reference.size(), m.Size());
+        ASSERT_EQ(reference.size(), m.Data().size());
+
+        for (size_t i = 0; i < storage.size(); ++i)
+        {
+            U32 *val = nullptr;
+            auto it = reference.find(&storage[i]);
+
+            ASSERT_EQ(it != reference.end(), m.Find(&storage[i], val));
+
+            if (it != reference.end())
+            {
+                EXPECT_EQ(it->second, *val);
+            }
+        }
+
+        for (auto &node : m.Data())
+        {
+            EXPECT_EQ(reference[node.ptr], node.element);
+        }
+    }
+
+    TEST(FastPtrHashMap, FindMany)
+    {
+        std::vector< U32 > storage(100);
+        FastPtrHashMap< U32, U32 > m;
+
+        for (U32 i = 0; i < storage.size(); i += 2)
+        {
+            m.Insert(&storage[i], i);
+        }
+
+        std::vector< U32 * > ptrs;
+        std::vector< U32 * > values(storage.size());
+
+        for (U32 &value : storage)
+        {
+            ptrs.push_back(&value);
+        }
+
+        EXPECT_EQ(50u, m.FindMany(ptrs.data(), ptrs.size(), values.data()));
+
+        for (U32 i = 0; i < storage.size(); ++i)
+        {
+            if (i % 2 == 0)
+            {
+                ASSERT_NE(nullptr, values[i]);
+                EXPECT_EQ(i, *values[i]);
+            }
+            else
+            {
+                EXPECT_EQ(nullptr, values[i]);
+            }
+        }
+    }
+
+    TEST(FastPtrHashMap, ShrinkToFit)
+    {
+        std::vector< U32 > storage(1000);
+        FastPtrHashMap< U32, U32 > m;
+
+        for (U32 i = 0; i < storage.size(); ++i)
+        {
+            m.Insert(&storage[i], i);
+        }
+
+        for (U32 i = 10; i < storage.size(); ++i)
+        {
+            m.Erase(&storage[i]);
+        }
+
+        m.ShrinkToFit();
+        EXPECT_EQ(16u, m.GetCapacity());
+
+        for (U32 i = 0; i < storage.size(); ++i)
+        {
+            U32 *val = nullptr;
+            EXPECT_EQ(i < 10, m.Find(&storage[i], val));
+        }
+
+        m.Insert(&storage[500], 500);
+        EXPECT_TRUE(m.Has(&storage[500]));
+    }
+}
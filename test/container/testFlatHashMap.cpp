@@ -0,0 +1,341 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/flatHashMap.h"
+
+#include "engineTest.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <random>
+
+namespace
+{
+    struct TransparentStringHash
+    {
+        typedef void is_transparent;
+
+        size_t operator()(const std::string &str) const
+        {
+            return std::hash< std::string >()(str);
+        }
+
+        size_t operator()(const char *str) const
+        {
+            return std::hash< std::string >()(str);
+        }
+    };
+
+    struct TransparentStringEqual
+    {
+        typedef void is_transparent;
+
+        bool operator()(const std::string &a, const std::string &b) const
+        {
+            return a == b;
+        }
+
+        bool operator()(const std::string &a, const char *b) const
+        {
+            return a == b;
+        }
+    };
+
+    // puts every key in the same group, so probing and deleted markers get exercised
+    struct CollidingHash
+    {
+        size_t operator()(U32) const
+        {
+            return 0;
+        }
+    };
+
+    TEST(FlatHashMap, SanityCheck)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(0u, map.size());
+        EXPECT_EQ(0u, map.capacity());
+        EXPECT_EQ(map.end(), map.find(1));
+        EXPECT_EQ(map.begin(), map.end());
+        EXPECT_EQ(0u, map.erase(1));
+    }
+
+    TEST(FlatHashMap, Insert)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        auto result = map.insert(std::make_pair(1u, 2u));
+        EXPECT_TRUE(result.second);
+        EXPECT_EQ(1u, result.first->first);
+        EXPECT_EQ(2u, result.first->second);
+
+        result = map.insert(std::make_pair(1u, 3u));
+        EXPECT_FALSE(result.second);
+        EXPECT_EQ(2u, result.first->second);
+
+        EXPECT_EQ(1u, map.size());
+    }
+
+    TEST(FlatHashMap, Grow)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        for (U32 i = 0; i < 10000; ++i)
+        {
+            map[i] = i * 2;
+        }
+
+        EXPECT_EQ(10000u, map.size());
+        EXPECT_LE(map.load_factor(), 0.875f);
+
+        for (U32 i = 0; i < 10000; ++i)
+        {
+            ASSERT_EQ(1u, map.count(i));
+            EXPECT_EQ(i * 2, map.at(i));
+        }
+
+        EXPECT_EQ(map.end(), map.find(10000));
+        EXPECT_ANY_THROW(map.at(10000));
+    }
+
+    TEST(FlatHashMap, Erase)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            map[i] = i;
+        }
+
+        for (U32 i = 0; i < 1000; i += 2)
+        {
+            EXPECT_EQ(1u, map.erase(i));
+        }
+
+        EXPECT_EQ(500u, map.size());
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            EXPECT_EQ(i % 2, map.count(i));
+        }
+    }
+
+    TEST(FlatHashMap, EraseIterator)
+    {
+        FlatHashMap< U32, U32 > map = { { 1, 1 }, { 2, 2 }, { 3, 3 } };
+
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (it->first != 2)
+            {
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        EXPECT_EQ(1u, map.size());
+        EXPECT_EQ(2u, map.begin()->second);
+    }
+
+    TEST(FlatHashMap, Collisions)
+    {
+        FlatHashMap< U32, U32, CollidingHash > map;
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            map[i] = i;
+        }
+
+        for (U32 i = 0; i < 100; i += 3)
+        {
+            map.erase(i);
+        }
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(i % 3 != 0 ? 1u : 0u, map.count(i));
+        }
+
+        // refills the deleted slots
+        for (U32 i = 0; i < 100; i += 3)
+        {
+            EXPECT_TRUE(map.emplace(i, i + 1).second);
+        }
+
+        EXPECT_EQ(100u, map.size());
+        EXPECT_EQ(4u, map.at(3));
+    }
+
+    TEST(FlatHashMap, Churn)
+    {
+        FlatHashMap< U32, U32 > map;
+        std::unordered_map< U32, U32 > reference;
+        std::mt19937 generator(7);
+
+        for (U32 i = 0; i < 100000; ++i)
+        {
+            const U32 key = generator() % 512;
+
+            if (generator() % 2)
+            {
+                map[key] = i;
+                reference[key] = i;
+            }
+            else
+            {
+                EXPECT_EQ(reference.erase(key), map.erase(key));
+            }
+        }
+
+        ASSERT_EQ(reference.size(), map.size());
+
+        for (const auto &pair : reference)
+        {
+            EXPECT_EQ(pair.second, map.at(pair.first));
+        }
+
+        // erasing and inserting in a small key range should not grow without bounds
+        EXPECT_LE(map.capacity(), 2048u);
+    }
+
+    TEST(FlatHashMap, Iterate)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            map[i] = i;
+        }
+
+        U32 sum = 0;
+        size_t count = 0;
+
+        for (const auto &pair : map)
+        {
+            EXPECT_EQ(pair.first, pair.second);
+            sum += pair.second;
+            ++count;
+        }
+
+        EXPECT_EQ(100u, count);
+        EXPECT_EQ(4950u, sum);
+    }
+
+    TEST(FlatHashMap, StringKeys)
+    {
+        FlatHashMap< std::string, std::string > map;
+        map.emplace("key", "value");
+        map["other"] = "thing";
+
+        EXPECT_EQ("value", map.at("key"));
+        EXPECT_EQ("thing", map.at("other"));
+        EXPECT_EQ(1u, map.erase("key"));
+        EXPECT_EQ(0u, map.count("key"));
+    }
+
+    TEST(FlatHashMap, HeterogeneousLookup)
+    {
+        FlatHashMap< std::string, U32, TransparentStringHash, TransparentStringEqual > map;
+        map["key"] = 1;
+
+        const char *key = "key";
+        EXPECT_EQ(1u, map.find(key)->second);
+        EXPECT_EQ(1u, map.count(key));
+        EXPECT_EQ(1u, map.erase(key));
+        EXPECT_TRUE(map.empty());
+    }
+
+    TEST(FlatHashMap, MoveOnlyValues)
+    {
+        FlatHashMap< U32, std::unique_ptr< U32 > > map;
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            map.try_emplace(i, new U32(i));
+        }
+
+        FlatHashMap< U32, std::unique_ptr< U32 > > moved(std::move(map));
+
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(100u, moved.size());
+        EXPECT_EQ(50u, *moved.at(50));
+    }
+
+    TEST(FlatHashMap, Copy)
+    {
+        FlatHashMap< std::string, U32 > map = { { "a", 1 }, { "b", 2 } };
+        FlatHashMap< std::string, U32 > copy;
+        copy = map;
+
+        EXPECT_EQ(2u, copy.size());
+        EXPECT_EQ(2u, copy.at("b"));
+    }
+
+    TEST(FlatHashMap, InsertOrAssign)
+    {
+        FlatHashMap< U32, U32 > map;
+
+        EXPECT_TRUE(map.insert_or_assign(1, 2u).second);
+        EXPECT_FALSE(map.insert_or_assign(1, 3u).second);
+        EXPECT_EQ(3u, map.at(1));
+    }
+
+    TEST(FlatHashMap, ReserveAndShrink)
+    {
+        FlatHashMap< U32, U32 > map;
+        map.reserve(1000);
+
+        const size_t capacity = map.capacity();
+        EXPECT_LE(1000u, capacity * 7 / 8);
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            map[i] = i;
+        }
+
+        EXPECT_EQ(capacity, map.capacity());
+
+        for (U32 i = 10; i < 1000; ++i)
+        {
+            map.erase(i);
+        }
+
+        map.shrink_to_fit();
+        EXPECT_EQ(16u, map.capacity());
+        EXPECT_EQ(10u, map.size());
+        EXPECT_EQ(9u, map.at(9));
+
+        map.clear();
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.end(), map.find(9));
+    }
+}
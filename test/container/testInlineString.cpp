@@ -0,0 +1,172 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/inlineString.h"
+
+#include "engineTest.h"
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+namespace
+{
+    TEST(InlineString, SanityCheck)
+    {
+        InlineString< 8 > str;
+        EXPECT_TRUE(str.empty());
+        EXPECT_TRUE(str.IsInline());
+        EXPECT_STREQ("", str.c_str());
+    }
+
+    TEST(InlineString, Construct)
+    {
+        InlineString< 8 > str("hello");
+
+        EXPECT_TRUE(str.IsInline());
+        EXPECT_EQ(5u, str.size());
+        EXPECT_EQ("hello", str);
+        EXPECT_EQ(std::string("hello"), str.str());
+    }
+
+    TEST(InlineString, ConstructHeap)
+    {
+        InlineString< 4 > str(std::string("hello world"));
+
+        EXPECT_FALSE(str.IsInline());
+        EXPECT_EQ("hello world", str);
+        EXPECT_STREQ("hello world", str.c_str());
+    }
+
+    TEST(InlineString, Append)
+    {
+        InlineString< 4 > str("ab");
+        str += 'c';
+        str += "de";
+        str += std::string("f");
+
+        EXPECT_FALSE(str.IsInline());
+        EXPECT_EQ("abcdef", str);
+    }
+
+    TEST(InlineString, AppendSelf)
+    {
+        InlineString< 4 > str("abc");
+        str.append(str);
+
+        EXPECT_EQ("abcabc", str);
+    }
+
+    TEST(InlineString, CopyAndMove)
+    {
+        InlineString< 4 > small("ab");
+        InlineString< 4 > large("abcdefgh");
+
+        InlineString< 4 > smallCopy(small);
+        InlineString< 4 > largeCopy(large);
+        EXPECT_EQ(small, smallCopy);
+        EXPECT_EQ(large, largeCopy);
+
+        const char *data = large.c_str();
+        InlineString< 4 > moved(std::move(large));
+
+        EXPECT_EQ(data, moved.c_str());
+        EXPECT_TRUE(large.empty());
+        EXPECT_TRUE(large.IsInline());
+
+        moved = std::move(small);
+        EXPECT_EQ("ab", moved);
+    }
+
+    TEST(InlineString, Find)
+    {
+        InlineString< 16 > str("key=value");
+
+        EXPECT_EQ(3u, str.find('='));
+        EXPECT_EQ(4u, str.find("val"));
+        EXPECT_EQ(InlineString< 16 >::npos, str.find('x'));
+        EXPECT_EQ(InlineString< 16 >::npos, str.find("value", 5));
+        EXPECT_EQ("value", str.substr(str.find('=') + 1));
+    }
+
+    TEST(InlineString, Resize)
+    {
+        InlineString< 4 > str;
+        str.resize(6, 'x');
+
+        EXPECT_EQ("xxxxxx", str);
+
+        str.resize(2);
+        EXPECT_EQ("xx", str);
+        EXPECT_STREQ("xx", str.c_str());
+    }
+
+    TEST(InlineString, Compare)
+    {
+        EXPECT_TRUE(InlineString< 4 >("ab") < InlineString< 4 >("abc"));
+        EXPECT_TRUE(InlineString< 4 >("abc") < InlineString< 4 >("abd"));
+        EXPECT_FALSE(InlineString< 4 >("abc") < InlineString< 4 >("abc"));
+        EXPECT_NE(InlineString< 4 >("abc"), "abd");
+    }
+
+    TEST(InlineString, Hash)
+    {
+        std::unordered_set< InlineString< 8 > > set;
+        set.insert("a");
+        set.insert("b");
+        set.insert("a");
+
+        EXPECT_EQ(2u, set.size());
+        EXPECT_EQ(1u, set.count("b"));
+    }
+
+    TEST(InlineString, HashEmbeddedNull)
+    {
+        const InlineString< 8 > a("a\0b", 3);
+        const InlineString< 8 > b("a\0c", 3);
+
+        EXPECT_NE(a, b);
+        EXPECT_NE(std::hash< InlineString< 8 > >()(a), std::hash< InlineString< 8 > >()(b));
+    }
+
+    TEST(InlineString, ZeroCapacity)
+    {
+        InlineString< 0 > str;
+        str.push_back('a');
+        str.push_back('b');
+
+        EXPECT_EQ(2u, str.size());
+        EXPECT_STREQ("ab", str.c_str());
+    }
+
+    TEST(InlineString, Stream)
+    {
+        std::stringstream ss;
+        ss << InlineString< 8 >("abc");
+
+        EXPECT_EQ("abc", ss.str());
+    }
+}
@@ -25,9 +25,15 @@
  */
 
 #include "container/namespaceNamedStorage.h"
+#include "container/smallVector.h"
+
+#include "common/typeID.h"
 
 #include "engineTest.h"
 
+#include <atomic>
+#include <thread>
+
 namespace
 {
 
@@ -730,4 +736,95 @@ namespace
         EXPECT_TRUE(std::is_permutation(names.begin(), names.end(), result.begin()));
     }
 
-}
\ No newline at end of file
+
+    TEST(NamespaceNamedStorage, GetNamesContainer)
+    {
+        NamespaceNamedStorage< U32, U32 > storage;
+
+        EXPECT_TRUE(storage.Add(new U32(1), 0, Namespace(0, 0)));
+        EXPECT_TRUE(storage.Add(new U32(2), 1, Namespace(0, 1)));
+        EXPECT_TRUE(storage.Add(new U32(3), 2, Namespace(1, 0)));
+
+        SmallVector< U32, 4 > names;
+        storage.GetNames(0, names);
+
+        EXPECT_TRUE(names.IsInline());
+        EXPECT_EQ(2u, names.size());
+        EXPECT_TRUE(std::is_permutation(names.begin(), names.end(), std::vector< U32 >({ 0, 1 }).begin()));
+
+        storage.GetNames(Namespace(0, 1), names);
+        EXPECT_EQ(3u, names.size());
+        EXPECT_EQ(1u, names.back());
+    }
+
+    TEST(NamespaceNamedStorage, GetWhileChanging)
+    {
+        NamespaceNamedStorage< U32, U32 > storage;
+        storage.Add(new U32(42), 0, Namespace(1, 1));
+
+        std::atomic< bool > stop(false);
+
+        std::thread reader([&storage, &stop]()
+        {
+            while (!stop.load())
+            {
+                const U32 *value = storage.Get(0);
+                ASSERT_NE(nullptr, value);
+                ASSERT_EQ(42u, *value);
+
+                storage.Has(1);
+            }
+        });
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            storage.Add(new U32(i), 1, 1u);
+            storage.Remove(1);
+        }
+
+        stop = true;
+        reader.join();
+
+        EXPECT_FALSE(storage.Has(1));
+        EXPECT_EQ(42u, *storage.Get(0));
+    }
+
+    TEST(NamespaceNamedStorage, TypeIDNames)
+    {
+        NamespaceNamedStorage< TypeID, U32 > storage;
+
+        EXPECT_TRUE(storage.Add(new U32(1), TypeID::Get< U8 >()));
+        EXPECT_TRUE(storage.Add(new U32(2), TypeID::Get< U16 >(), Namespace(1, 1)));
+        EXPECT_FALSE(storage.Add(new U32(3), TypeID::Get< U8 >(), 1u));
+
+        EXPECT_EQ(1u, *storage.Get(TypeID::Get< U8 >()));
+        EXPECT_EQ(2u, *storage.Get(TypeID::Get< U16 >()));
+        EXPECT_EQ(nullptr, storage.Get(TypeID::Get< U32 >()));
+        EXPECT_EQ(nullptr, storage.Get(TypeID()));
+
+        storage.Remove(TypeID::Get< U8 >());
+
+        EXPECT_FALSE(storage.Has(TypeID::Get< U8 >()));
+        EXPECT_TRUE(storage.Has(TypeID::Get< U16 >()));
+    }
+
+    TEST(NamespaceNamedStorage, Batch)
+    {
+        NamespaceNamedStorage< U32, U32 > storage;
+        storage.Add(new U32(1), 0);
+
+        {
+            NamespaceNamedStorage< U32, U32 >::Batch batch(storage);
+
+            // readers see the changes before the batch publishes them
+            EXPECT_TRUE(storage.Add(new U32(2), 1, 1u));
+            EXPECT_EQ(2u, *storage.Get(1));
+
+            storage.Remove(0);
+            EXPECT_FALSE(storage.Has(0));
+        }
+
+        EXPECT_EQ(2u, *storage.Get(1));
+        EXPECT_FALSE(storage.Has(0));
+    }
+}
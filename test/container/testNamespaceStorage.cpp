@@ -26,8 +26,13 @@
 
 #include "container/namespaceStorage.h"
 
+#include "common/typeID.h"
+
 #include "engineTest.h"
 
+#include <atomic>
+#include <thread>
+
 namespace
 {
 
@@ -733,4 +738,103 @@ namespace
 
         EXPECT_FALSE(storage.HasNamespace(0u));
     }
-}
\ No newline at end of file
+
+    TEST(NamespaceStorage, ForEach)
+    {
+        NamespaceStorage< U32, U32 > storage;
+
+        storage.Add(new U32(1), 0);
+        storage.Add(new U32(2), 1, 1u);
+        storage.Add(new U32(4), 2, Namespace(1, 1));
+
+        U32 sum = 0;
+        storage.ForEach([&sum](U32 *value)
+        {
+            sum += *value;
+        });
+
+        EXPECT_EQ(7u, sum);
+    }
+
+    TEST(NamespaceStorage, GetWhileChanging)
+    {
+        NamespaceStorage< U32, U32 > storage;
+        storage.Add(new U32(42), 0, Namespace(1, 1));
+
+        std::atomic< bool > stop(false);
+
+        std::thread reader([&storage, &stop]()
+        {
+            while (!stop.load())
+            {
+                const U32 *value = storage.Get(0, Namespace(1, 1));
+                ASSERT_NE(nullptr, value);
+                ASSERT_EQ(42u, *value);
+
+                storage.Has(1, 1u);
+            }
+        });
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            storage.Add(new U32(i), 1, 1u);
+            storage.Remove(1, 1u);
+        }
+
+        stop = true;
+        reader.join();
+
+        EXPECT_FALSE(storage.Has(1, 1u));
+        EXPECT_EQ(42u, *storage.Get(0, Namespace(1, 1)));
+    }
+
+    TEST(NamespaceStorage, TypeIDNames)
+    {
+        NamespaceStorage< TypeID, U32 > storage;
+
+        EXPECT_TRUE(storage.Add(new U32(1), TypeID::Get< U8 >()));
+        EXPECT_TRUE(storage.Add(new U32(2), TypeID::Get< U8 >(), 1u));
+        EXPECT_TRUE(storage.Add(new U32(3), TypeID::Get< U8 >(), Namespace(1, 1)));
+        EXPECT_FALSE(storage.Add(new U32(4), TypeID::Get< U8 >()));
+
+        EXPECT_EQ(1u, *storage.Get(TypeID::Get< U8 >()));
+        EXPECT_EQ(2u, *storage.Get(TypeID::Get< U8 >(), 1u));
+        EXPECT_EQ(3u, *storage.Get(TypeID::Get< U8 >(), Namespace(1, 1)));
+        EXPECT_EQ(nullptr, storage.Get(TypeID::Get< U16 >()));
+        EXPECT_EQ(nullptr, storage.Get(TypeID()));
+
+        storage.Clear(1u);
+
+        EXPECT_TRUE(storage.Has(TypeID::Get< U8 >()));
+        EXPECT_FALSE(storage.Has(TypeID::Get< U8 >(), 1u));
+        EXPECT_FALSE(storage.Has(TypeID::Get< U8 >(), Namespace(1, 1)));
+    }
+
+    TEST(NamespaceStorage, Batch)
+    {
+        NamespaceStorage< U32, U32 > storage;
+        storage.Add(new U32(1), 0);
+
+        {
+            NamespaceStorage< U32, U32 >::Batch batch(storage);
+
+            // readers see the changes before the batch publishes them
+            EXPECT_TRUE(storage.Add(new U32(2), 1, 1u));
+            EXPECT_EQ(2u, *storage.Get(1, 1u));
+
+            {
+                NamespaceStorage< U32, U32 >::Batch nested(storage);
+
+                EXPECT_TRUE(storage.Add(new U32(3), 2, Namespace(1, 1)));
+                storage.Remove(0);
+            }
+
+            EXPECT_EQ(3u, *storage.Get(2, Namespace(1, 1)));
+            EXPECT_FALSE(storage.Has(0));
+        }
+
+        EXPECT_EQ(2u, *storage.Get(1, 1u));
+        EXPECT_EQ(3u, *storage.Get(2, Namespace(1, 1)));
+        EXPECT_FALSE(storage.Has(0));
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/persistentHashMap.h"
+
+#include "common/file.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    const size_t gArenaSize = 4 * 1024 * 1024;
+
+    typedef PersistentHashMap< U32, U64 > Map;
+
+    TEST(PersistentHashMap, SanityCheck)
+    {
+        Map map;
+
+        EXPECT_TRUE(map.IsEmpty());
+        EXPECT_EQ(0u, map.GetBucketCount());
+        EXPECT_FALSE(map.Has(0));
+        EXPECT_EQ(nullptr, map.Find(0));
+    }
+
+    TEST(PersistentHashMap, Insert)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, gArenaSize, 1);
+
+        Map *map = arena.New< Map >();
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            EXPECT_TRUE(map->Insert(arena, i * 7, i));
+        }
+
+        EXPECT_EQ(1000u, map->Size());
+        EXPECT_GE(map->GetBucketCount() * 3, map->Size() * 4);
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            ASSERT_TRUE(map->Has(i * 7));
+            EXPECT_EQ(i, *map->Find(i * 7));
+        }
+
+        EXPECT_FALSE(map->Has(1));
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(PersistentHashMap, Replace)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, gArenaSize, 1);
+
+        Map *map = arena.New< Map >();
+        map->Insert(arena, 1, 2);
+        map->Insert(arena, 1, 3);
+
+        EXPECT_EQ(1u, map->Size());
+        EXPECT_EQ(3u, *map->Find(1));
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(PersistentHashMap, ForEach)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, gArenaSize, 1);
+
+        Map *map = arena.New< Map >();
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            map->Insert(arena, i, i);
+        }
+
+        U64 sum = 0;
+        map->ForEach([&sum](U32 key, U64 value)
+        {
+            EXPECT_EQ(key, value);
+            sum += value;
+        });
+
+        EXPECT_EQ(45u, sum);
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(PersistentHashMap, Reopen)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, gArenaSize, 1);
+
+            Map *map = arena.New< Map >();
+            map->Reserve(arena, 5000);
+
+            for (U32 i = 0; i < 5000; ++i)
+            {
+                map->Insert(arena, i, static_cast< U64 >(i) * i);
+            }
+
+            arena.SetRoot(map);
+            arena.Commit();
+        }
+
+        MappedArena arena;
+        ASSERT_EQ(MappedArena::OpenResult::Opened, arena.Open(path, gArenaSize, 1));
+
+        const Map *map = arena.GetRoot< Map >();
+        ASSERT_EQ(5000u, map->Size());
+
+        for (U32 i = 0; i < 5000; ++i)
+        {
+            ASSERT_TRUE(map->Has(i));
+            EXPECT_EQ(static_cast< U64 >(i) * i, *map->Find(i));
+        }
+
+        arena.Close();
+        File::Delete(path);
+    }
+}
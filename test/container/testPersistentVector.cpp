@@ -0,0 +1,125 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/persistentVector.h"
+
+#include "common/file.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    const size_t gArenaSize = 1024 * 1024;
+
+    TEST(PersistentVector, SanityCheck)
+    {
+        PersistentVector< U32 > vec;
+
+        EXPECT_TRUE(vec.IsEmpty());
+        EXPECT_EQ(0u, vec.Size());
+        EXPECT_EQ(vec.begin(), vec.end());
+    }
+
+    TEST(PersistentVector, PushBack)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, gArenaSize, 1);
+
+        PersistentVector< U32 > *vec = arena.New< PersistentVector< U32 > >();
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            EXPECT_TRUE(vec->PushBack(arena, i));
+        }
+
+        EXPECT_EQ(100u, vec->Size());
+        EXPECT_LE(100u, vec->Capacity());
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(i, (*vec)[i]);
+        }
+
+        vec->PopBack();
+        EXPECT_EQ(98u, vec->end()[-1]);
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(PersistentVector, Exhausted)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, 4096, 1);
+
+        PersistentVector< U64 > *vec = arena.New< PersistentVector< U64 > >();
+
+        EXPECT_FALSE(vec->Reserve(arena, 1024));
+        EXPECT_TRUE(vec->IsEmpty());
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(PersistentVector, Reopen)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, gArenaSize, 1);
+
+            PersistentVector< U32 > *vec = arena.New< PersistentVector< U32 > >();
+
+            for (U32 i = 0; i < 1000; ++i)
+            {
+                vec->PushBack(arena, i * 2);
+            }
+
+            arena.SetRoot(vec);
+            arena.Commit();
+        }
+
+        MappedArena arena;
+        ASSERT_EQ(MappedArena::OpenResult::Opened, arena.Open(path, gArenaSize, 1));
+
+        const PersistentVector< U32 > *vec = arena.GetRoot< PersistentVector< U32 > >();
+        ASSERT_EQ(1000u, vec->Size());
+
+        U32 i = 0;
+
+        for (U32 value : *vec)
+        {
+            EXPECT_EQ(i * 2, value);
+            ++i;
+        }
+
+        arena.Close();
+        File::Delete(path);
+    }
+}
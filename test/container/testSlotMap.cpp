@@ -0,0 +1,229 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/slotMap.h"
+
+#include "engineTest.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    struct Throwing
+    {
+        explicit Throwing(bool fail)
+        {
+            if (fail)
+            {
+                throw std::runtime_error("Throwing");
+            }
+        }
+    };
+
+    TEST(SlotMap, SanityCheck)
+    {
+        SlotMap< U32 > map;
+        EXPECT_EQ(0u, map.Size());
+        EXPECT_TRUE(map.IsEmpty());
+        EXPECT_FALSE(map.Has(SlotMap< U32 >::Handle()));
+    }
+
+    TEST(SlotMap, Insert)
+    {
+        SlotMap< U32 > map;
+        auto a = map.Insert(2);
+        auto b = map.Insert(4);
+
+        EXPECT_TRUE(a.IsValid());
+        EXPECT_NE(a, b);
+        EXPECT_EQ(2u, map.Size());
+        EXPECT_EQ(2u, *map.Find(a));
+        EXPECT_EQ(4u, *map.CFind(b));
+    }
+
+    TEST(SlotMap, Emplace)
+    {
+        SlotMap< std::string > map;
+        auto handle = map.Emplace(3, 'a');
+
+        EXPECT_EQ("aaa", *map.Find(handle));
+    }
+
+    TEST(SlotMap, Erase)
+    {
+        SlotMap< U32 > map;
+        auto a = map.Insert(2);
+        auto b = map.Insert(4);
+        auto c = map.Insert(6);
+
+        EXPECT_TRUE(map.Erase(a));
+        EXPECT_FALSE(map.Erase(a));
+        EXPECT_FALSE(map.Has(a));
+        EXPECT_EQ(nullptr, map.Find(a));
+
+        EXPECT_EQ(2u, map.Size());
+        EXPECT_EQ(4u, *map.Find(b));
+        EXPECT_EQ(6u, *map.Find(c));
+    }
+
+    TEST(SlotMap, StaleHandle)
+    {
+        SlotMap< U32 > map;
+        auto a = map.Insert(2);
+        map.Erase(a);
+
+        auto b = map.Insert(4);
+
+        EXPECT_EQ(a.GetIndex(), b.GetIndex());
+        EXPECT_NE(a.GetGeneration(), b.GetGeneration());
+        EXPECT_FALSE(map.Has(a));
+        EXPECT_EQ(4u, *map.Find(b));
+    }
+
+    TEST(SlotMap, DenseIteration)
+    {
+        SlotMap< U32 > map;
+        std::vector< SlotMap< U32 >::Handle > handles;
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            handles.push_back(map.Insert(i));
+        }
+
+        for (U32 i = 0; i < 10; i += 2)
+        {
+            map.Erase(handles[i]);
+        }
+
+        EXPECT_THAT(map.GetValues(), ::testing::UnorderedElementsAre(1u, 3u, 5u, 7u, 9u));
+
+        for (size_t i = 0; i < map.Size(); ++i)
+        {
+            EXPECT_EQ(&map.GetValues()[i], map.Find(map.GetHandle(i)));
+        }
+
+        U32 sum = 0;
+
+        for (U32 value : map)
+        {
+            sum += value;
+        }
+
+        EXPECT_EQ(25u, sum);
+    }
+
+    TEST(SlotMap, Clear)
+    {
+        SlotMap< U32 > map;
+        auto a = map.Insert(2);
+        auto b = map.Insert(4);
+
+        map.Clear();
+
+        EXPECT_TRUE(map.IsEmpty());
+        EXPECT_FALSE(map.Has(a));
+        EXPECT_FALSE(map.Has(b));
+
+        map.Insert(6);
+        map.Insert(8);
+        EXPECT_EQ(2u, map.GetSlotCount());
+    }
+
+    TEST(SlotMap, RetireSlot)
+    {
+        SlotMap< U32 > map;
+        auto handle = map.Insert(0);
+
+        for (U32 i = 1; i < SlotMap< U32 >::Handle::MaxGeneration; ++i)
+        {
+            map.Erase(handle);
+            handle = map.Insert(i);
+            EXPECT_EQ(0u, handle.GetIndex());
+        }
+
+        map.Erase(handle);
+        handle = map.Insert(0);
+
+        EXPECT_EQ(1u, handle.GetIndex());
+        EXPECT_EQ(2u, map.GetSlotCount());
+    }
+
+    TEST(SlotMap, Handle64)
+    {
+        SlotMap< U32, U64 > map;
+        auto a = map.Insert(2);
+        map.Erase(a);
+        auto b = map.Insert(4);
+
+        EXPECT_EQ(8u, sizeof(b));
+        EXPECT_FALSE(map.Has(a));
+        EXPECT_EQ(4u, *map.Find(b));
+        typedef SlotMap< U32, U64 >::Handle Handle;
+        EXPECT_EQ(b, Handle::FromValue(b.GetValue()));
+    }
+
+    TEST(SlotMap, EmplaceThrows)
+    {
+        SlotMap< Throwing > map;
+        auto a = map.Emplace(false);
+        map.Erase(a);
+
+        EXPECT_THROW(map.Emplace(true), std::runtime_error);
+        EXPECT_EQ(0u, map.Size());
+
+        // the freed slot was not lost
+        auto b = map.Emplace(false);
+
+        EXPECT_EQ(a.GetIndex(), b.GetIndex());
+        EXPECT_EQ(1u, map.GetSlotCount());
+
+        EXPECT_THROW(map.Emplace(true), std::runtime_error);
+        EXPECT_EQ(1u, map.Size());
+        EXPECT_EQ(1u, map.GetSlotCount());
+    }
+
+    TEST(SlotMap, IndexOverflow)
+    {
+        typedef SlotMap< U8 >::Handle Handle;
+
+        SlotMap< U8 > map;
+        Handle last;
+
+        for (U32 i = 0; i <= Handle::IndexMask; ++i)
+        {
+            last = map.Insert(0);
+        }
+
+        EXPECT_EQ(Handle::IndexMask, last.GetIndex());
+        EXPECT_THROW(map.Insert(0), std::length_error);
+        EXPECT_EQ(static_cast< size_t >(Handle::IndexMask) + 1, map.Size());
+
+        // freed slots can still be reused
+        map.Erase(last);
+        EXPECT_EQ(Handle::IndexMask, map.Insert(0).GetIndex());
+    }
+}
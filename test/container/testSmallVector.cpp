@@ -0,0 +1,266 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/smallVector.h"
+
+#include "engineTest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct SelfMoveCheck
+    {
+        SelfMoveCheck() = default;
+        SelfMoveCheck(SelfMoveCheck &&) = default;
+
+        SelfMoveCheck &operator=(SelfMoveCheck &&other)
+        {
+            EXPECT_NE(this, &other);
+            return *this;
+        }
+    };
+
+    TEST(SmallVector, SanityCheck)
+    {
+        SmallVector< U32, 4 > vec;
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(0u, vec.size());
+        EXPECT_EQ(4u, vec.capacity());
+        EXPECT_TRUE(vec.IsInline());
+    }
+
+    TEST(SmallVector, PushBackInline)
+    {
+        SmallVector< U32, 4 > vec;
+
+        for (U32 i = 0; i < 4; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_TRUE(vec.IsInline());
+        EXPECT_EQ(4u, vec.size());
+        EXPECT_EQ(0u, vec.front());
+        EXPECT_EQ(3u, vec.back());
+    }
+
+    TEST(SmallVector, PushBackGrow)
+    {
+        SmallVector< U32, 4 > vec;
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_FALSE(vec.IsInline());
+        EXPECT_EQ(100u, vec.size());
+        EXPECT_LE(100u, vec.capacity());
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(i, vec[i]);
+        }
+    }
+
+    TEST(SmallVector, PushBackSelf)
+    {
+        SmallVector< std::string, 2 > vec = { "a", "b" };
+        vec.push_back(vec[0]);
+
+        EXPECT_EQ("a", vec[2]);
+    }
+
+    TEST(SmallVector, EmplaceBack)
+    {
+        SmallVector< std::string, 2 > vec;
+        vec.emplace_back(3, 'a');
+
+        EXPECT_EQ("aaa", vec[0]);
+    }
+
+    TEST(SmallVector, MoveOnly)
+    {
+        SmallVector< std::unique_ptr< U32 >, 2 > vec;
+
+        for (U32 i = 0; i < 5; ++i)
+        {
+            vec.emplace_back(new U32(i));
+        }
+
+        SmallVector< std::unique_ptr< U32 >, 2 > moved(std::move(vec));
+
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(5u, moved.size());
+        EXPECT_EQ(4u, *moved.back());
+    }
+
+    TEST(SmallVector, CopyInline)
+    {
+        SmallVector< std::string, 4 > vec = { "a", "b" };
+        SmallVector< std::string, 4 > copy(vec);
+
+        EXPECT_TRUE(copy.IsInline());
+        EXPECT_EQ(vec, copy);
+    }
+
+    TEST(SmallVector, CopyHeap)
+    {
+        SmallVector< std::string, 1 > vec = { "a", "b", "c" };
+        SmallVector< std::string, 1 > copy;
+        copy = vec;
+
+        EXPECT_FALSE(copy.IsInline());
+        EXPECT_EQ(vec, copy);
+    }
+
+    TEST(SmallVector, MoveInline)
+    {
+        SmallVector< std::string, 4 > vec = { "a", "b" };
+        SmallVector< std::string, 4 > moved;
+        moved = std::move(vec);
+
+        EXPECT_TRUE(vec.empty());
+        EXPECT_TRUE(moved.IsInline());
+        EXPECT_EQ(2u, moved.size());
+        EXPECT_EQ("b", moved[1]);
+    }
+
+    TEST(SmallVector, MoveHeap)
+    {
+        SmallVector< std::string, 1 > vec = { "a", "b", "c" };
+        const std::string *data = vec.data();
+
+        SmallVector< std::string, 1 > moved(std::move(vec));
+
+        EXPECT_TRUE(vec.IsInline());
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(data, moved.data());
+    }
+
+    TEST(SmallVector, RangeConstruct)
+    {
+        const std::vector< U32 > values = { 1, 2, 3 };
+        SmallVector< U32, 2 > vec(values.begin(), values.end());
+
+        EXPECT_EQ(3u, vec.size());
+        EXPECT_TRUE(std::equal(values.begin(), values.end(), vec.begin()));
+    }
+
+    TEST(SmallVector, CountConstruct)
+    {
+        SmallVector< U32, 2 > vec(3, 7u);
+
+        EXPECT_EQ(3u, vec.size());
+        EXPECT_EQ(7u, vec[2]);
+    }
+
+    TEST(SmallVector, Resize)
+    {
+        SmallVector< U32, 2 > vec;
+        vec.resize(5);
+
+        EXPECT_EQ(5u, vec.size());
+        EXPECT_EQ(0u, vec[4]);
+
+        vec.resize(1);
+        EXPECT_EQ(1u, vec.size());
+    }
+
+    TEST(SmallVector, Erase)
+    {
+        SmallVector< std::string, 4 > vec = { "a", "b", "c", "d" };
+
+        auto it = vec.erase(vec.begin() + 1);
+        EXPECT_EQ("c", *it);
+
+        it = vec.erase(vec.begin(), vec.begin() + 2);
+        EXPECT_EQ("d", *it);
+        EXPECT_EQ(1u, vec.size());
+    }
+
+    TEST(SmallVector, EraseEmpty)
+    {
+        SmallVector< SelfMoveCheck, 4 > vec(3);
+
+        auto it = vec.erase(vec.begin() + 1, vec.begin() + 1);
+
+        EXPECT_EQ(vec.begin() + 1, it);
+        EXPECT_EQ(3u, vec.size());
+    }
+
+    TEST(SmallVector, Insert)
+    {
+        SmallVector< U32, 2 > vec = { 1, 4 };
+        vec.insert(vec.begin() + 1, 2);
+
+        const std::vector< U32 > more = { 3 };
+        vec.insert(vec.begin() + 2, more.begin(), more.end());
+
+        const SmallVector< U32, 2 > expected = { 1, 2, 3, 4 };
+        EXPECT_EQ(expected, vec);
+    }
+
+    TEST(SmallVector, PopBack)
+    {
+        SmallVector< U32, 2 > vec = { 1, 2 };
+        vec.pop_back();
+
+        EXPECT_EQ(1u, vec.size());
+        EXPECT_EQ(1u, vec.back());
+    }
+
+    TEST(SmallVector, ShrinkToFit)
+    {
+        SmallVector< U32, 4 > vec = { 1, 2, 3, 4, 5 };
+        vec.pop_back();
+        vec.shrink_to_fit();
+
+        EXPECT_TRUE(vec.IsInline());
+        EXPECT_EQ(4u, vec.back());
+    }
+
+    TEST(SmallVector, Swap)
+    {
+        SmallVector< U32, 2 > a = { 1 };
+        SmallVector< U32, 2 > b = { 1, 2, 3 };
+        a.swap(b);
+
+        EXPECT_EQ(3u, a.size());
+        EXPECT_EQ(1u, b.size());
+    }
+
+    TEST(SmallVector, At)
+    {
+        SmallVector< U32, 2 > vec = { 1 };
+
+        EXPECT_EQ(1u, vec.at(0));
+        EXPECT_ANY_THROW(vec.at(1));
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "container/stableVector.h"
+
+#include "engineTest.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef StableVector< U32, 4 > SmallChunks;
+
+    TEST(StableVector, SanityCheck)
+    {
+        SmallChunks vec;
+
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(0u, vec.size());
+        EXPECT_EQ(0u, vec.capacity());
+        EXPECT_EQ(vec.begin(), vec.end());
+    }
+
+    TEST(StableVector, PushBack)
+    {
+        SmallChunks vec;
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_EQ(10u, vec.size());
+        EXPECT_EQ(3u, vec.GetChunkCount());
+        EXPECT_EQ(12u, vec.capacity());
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            EXPECT_EQ(i, vec[i]);
+        }
+
+        EXPECT_EQ(0u, vec.front());
+        EXPECT_EQ(9u, vec.back());
+    }
+
+    TEST(StableVector, PointersStayValid)
+    {
+        SmallChunks vec;
+        vec.push_back(1);
+
+        const U32 *first = &vec[0];
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_EQ(first, &vec[0]);
+        EXPECT_EQ(1u, *first);
+    }
+
+    TEST(StableVector, EmplaceBack)
+    {
+        StableVector< std::string, 2 > vec;
+        std::string &value = vec.emplace_back(3, 'a');
+
+        EXPECT_EQ("aaa", value);
+        EXPECT_EQ(&value, &vec[0]);
+    }
+
+    TEST(StableVector, MoveOnly)
+    {
+        StableVector< std::unique_ptr< U32 >, 2 > vec;
+
+        for (U32 i = 0; i < 5; ++i)
+        {
+            vec.emplace_back(new U32(i));
+        }
+
+        StableVector< std::unique_ptr< U32 >, 2 > moved(std::move(vec));
+
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(5u, moved.size());
+        EXPECT_EQ(4u, *moved.back());
+    }
+
+    TEST(StableVector, Copy)
+    {
+        StableVector< std::string, 2 > vec = { "a", "b", "c" };
+        StableVector< std::string, 2 > copy;
+        copy = vec;
+
+        EXPECT_EQ(3u, copy.size());
+        EXPECT_TRUE(std::equal(vec.begin(), vec.end(), copy.begin()));
+        EXPECT_NE(&vec[0], &copy[0]);
+    }
+
+    TEST(StableVector, Iterate)
+    {
+        SmallChunks vec;
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_EQ(10, vec.end() - vec.begin());
+        EXPECT_EQ(45u, std::accumulate(vec.begin(), vec.end(), 0u));
+        EXPECT_EQ(5u, vec.begin()[5]);
+        EXPECT_EQ(9u, *(vec.end() - 1));
+
+        const SmallChunks &constVec = vec;
+        SmallChunks::const_iterator it = vec.begin();
+        EXPECT_EQ(constVec.begin(), it);
+    }
+
+    TEST(StableVector, IteratorsStayValid)
+    {
+        SmallChunks vec;
+        vec.push_back(1);
+        vec.push_back(2);
+
+        const SmallChunks::iterator first = vec.begin();
+        const SmallChunks::const_iterator second = first + 1;
+
+        // grows the chunk table well past its first allocation
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        EXPECT_EQ(1u, *first);
+        EXPECT_EQ(2u, *second);
+        EXPECT_EQ(999u, first[1001]);
+        EXPECT_EQ(1002, vec.end() - first);
+    }
+
+    TEST(StableVector, ForEachChunk)
+    {
+        SmallChunks vec;
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        std::vector< size_t > counts;
+        U32 sum = 0;
+
+        vec.ForEachChunk([&](const U32 * values, size_t count)
+        {
+            counts.push_back(count);
+            sum += std::accumulate(values, values + count, 0u);
+        });
+
+        EXPECT_EQ(std::vector< size_t >({ 4, 4, 2 }), counts);
+        EXPECT_EQ(45u, sum);
+    }
+
+    TEST(StableVector, ClearKeepsChunks)
+    {
+        SmallChunks vec;
+        vec.resize(10);
+        vec.clear();
+
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(12u, vec.capacity());
+
+        vec.shrink_to_fit();
+        EXPECT_EQ(0u, vec.capacity());
+    }
+
+    TEST(StableVector, Resize)
+    {
+        SmallChunks vec;
+        vec.resize(6);
+
+        EXPECT_EQ(6u, vec.size());
+        EXPECT_EQ(0u, vec[5]);
+
+        vec.resize(2);
+        EXPECT_EQ(2u, vec.size());
+
+        vec.shrink_to_fit();
+        EXPECT_EQ(4u, vec.capacity());
+    }
+
+    TEST(StableVector, Reserve)
+    {
+        SmallChunks vec;
+        vec.reserve(9);
+
+        EXPECT_EQ(12u, vec.capacity());
+        EXPECT_TRUE(vec.empty());
+    }
+
+    TEST(StableVector, At)
+    {
+        SmallChunks vec = { 1 };
+
+        EXPECT_EQ(1u, vec.at(0));
+        EXPECT_ANY_THROW(vec.at(1));
+    }
+
+    TEST(StableVector, Alignment)
+    {
+        struct alignas(64) Aligned
+        {
+            U8 value;
+        };
+
+        StableVector< Aligned, 4 > vec;
+        vec.resize(9);
+
+        for (const Aligned &value : vec)
+        {
+            EXPECT_EQ(0u, reinterpret_cast< size_t >(&value) % 64);
+        }
+    }
+}
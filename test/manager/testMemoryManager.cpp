@@ -0,0 +1,104 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "manager/memoryManager.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    struct Item
+    {
+        U32 a;
+        U64 b;
+    };
+
+    TEST(MemoryManager, TempNew)
+    {
+        MemoryManager manager;
+
+        Item *item = manager.TempNew< Item >(0, Item{ 1, 2 });
+
+        EXPECT_EQ(1u, item->a);
+        EXPECT_EQ(2u, item->b);
+        EXPECT_GT(manager.GetFrameArena(0).GetUsed(), 0u);
+    }
+
+    TEST(MemoryManager, TempMove)
+    {
+        MemoryManager manager;
+
+        MemoryManager::TempLocation loc = manager.TempMove< Item >(1, Item{ 3, 4 });
+        Item *item = manager.ExtractTemp< Item >(1, loc);
+
+        EXPECT_EQ(3u, item->a);
+        EXPECT_EQ(4u, item->b);
+    }
+
+    TEST(MemoryManager, TempAlloc)
+    {
+        MemoryManager manager;
+
+        MemoryManager::TempLocation loc = manager.TempAlloc< U64 >(2);
+        *manager.ExtractTemp< U64 >(2, loc) = 42;
+
+        EXPECT_EQ(42u, *manager.ExtractTemp< U64 >(2, loc));
+    }
+
+    TEST(MemoryManager, LastWorker)
+    {
+        MemoryManager manager;
+
+        EXPECT_NE(nullptr, manager.TempNew< U32 >(PROGRAM_MAX_THREADS, 1u));
+    }
+
+    TEST(MemoryManager, OnUpdate)
+    {
+        MemoryManager manager;
+
+        manager.TempNew< U64 >(0, 1u);
+        manager.OnUpdate();
+
+        EXPECT_EQ(0u, manager.GetFrameArena(0).GetUsed());
+    }
+
+    TEST(MemoryManager, MultiFrameNew)
+    {
+        MemoryManager manager;
+
+        U64 *value = manager.MultiFrameNew< U64 >(0, 42u);
+
+        for (U32 i = 1; i < PROGRAM_FRAME_BUFFERS; ++i)
+        {
+            manager.OnUpdate();
+            manager.MultiFrameNew< U64 >(0, 0u);
+
+            EXPECT_EQ(42u, *value);
+        }
+
+        EXPECT_EQ(static_cast< U32 >(PROGRAM_FRAME_BUFFERS), manager.GetMultiFrameArena(0).GetFrameCount());
+    }
+}
@@ -26,6 +26,7 @@
 
 #include "manager/poolManager.h"
 
+#include "events/memoryEvents.h"
 
 #include "engineTest.h"
 
@@ -67,6 +68,20 @@ namespace
         EXPECT_TRUE(m.HasPools(0));
     }
 
+    TEST(PoolManager, AddMagazines)
+    {
+        PoolManager m;
+        auto pool = m.Add< PoolTest >(0U, 100, 16);
+
+        EXPECT_EQ(16u, static_cast< ObjectPool< PoolTest > * >(pool)->GetMagazineSize());
+
+        PoolTest *test = pool->Get();
+        EXPECT_TRUE(test->init);
+
+        pool->Dispose(test);
+        EXPECT_TRUE(test->released);
+    }
+
     TEST(PoolManager, AddFromFactory)
     {
         PoolManager m;
@@ -196,4 +211,60 @@ namespace
         EXPECT_TRUE(m.HasPools(0));
         EXPECT_FALSE(m.HasPools(1));
     }
+
+    TEST(PoolManager, Trim)
+    {
+        PoolManager m;
+        auto pool = m.Add< PoolTest >();
+        auto pool2 = m.Add< PoolTest >(1);
+
+        pool->Dispose(pool->Get());
+        pool2->Dispose(pool2->Get());
+
+        EXPECT_EQ(2u, m.Trim());
+        EXPECT_EQ(0u, m.Trim());
+    }
+
+    TEST(PoolManager, MemoryPressure)
+    {
+        PoolManager m;
+        auto pool = static_cast< ObjectPool< PoolTest > * >(m.Add< PoolTest >());
+
+        pool->Dispose(pool->Get());
+
+        m.OnUpdate();
+        EXPECT_EQ(1u, pool->GetIdleCount());
+
+        // the trim waits for the next update
+        m.OnMemoryPressure(MemoryPressureEvent());
+        EXPECT_EQ(1u, pool->GetIdleCount());
+
+        m.OnUpdate();
+        EXPECT_EQ(0u, pool->GetIdleCount());
+    }
+
+    TEST(PoolManager, OnUpdate)
+    {
+        PoolManager m;
+        auto pool = static_cast< ObjectPool< PoolTest > * >(m.Add< PoolTest >());
+        pool->SetAdaptiveCapacity(0, 500, 1);
+
+        pool->Dispose(pool->Get());
+
+        m.OnUpdate();
+        EXPECT_EQ(1u, pool->GetIdleCount());
+
+        m.OnUpdate();
+        EXPECT_EQ(0u, pool->GetIdleCount());
+    }
+
+    TEST(PoolManager, Reserve)
+    {
+        PoolManager m;
+        m.Add< PoolTest >(1);
+
+        EXPECT_EQ(10u, m.Reserve< PoolTest >(10, 1));
+        EXPECT_EQ(0u, m.Reserve< PoolTest >(10));
+        EXPECT_EQ(10u, static_cast< ObjectPool< PoolTest > * >(m.Get< PoolTest >(1))->GetIdleCount());
+    }
 }
@@ -90,4 +90,21 @@ namespace
         delete inst;
     }
 
-}
\ No newline at end of file
+    TEST(AbstractObjectPool, Reserve)
+    {
+        AbstractObjectPool< U32 > *inst = new ImplObjectPool;
+        EXPECT_EQ(0u, inst->Reserve(10));
+        delete inst;
+    }
+
+    TEST(AbstractObjectPool, Batch)
+    {
+        AbstractObjectPool< U32 > *inst = new ImplObjectPool;
+
+        U32 *objects[4];
+        inst->GetBatch(4, objects);
+        inst->DisposeBatch(objects, 4);
+
+        delete inst;
+    }
+}
@@ -0,0 +1,238 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/frameArena.h"
+
+#include "engineTest.h"
+
+#include <new>
+#include <string>
+
+namespace
+{
+    struct alignas(64) Aligned
+    {
+        U8 data[3];
+    };
+
+    class Tracked
+    {
+    public:
+
+        explicit Tracked(std::vector< U32 > &log, U32 id)
+            : mLog(log),
+              mID(id)
+        {
+        }
+
+        ~Tracked()
+        {
+            mLog.push_back(mID);
+        }
+
+    private:
+
+        std::vector< U32 > &mLog;
+        U32 mID;
+    };
+
+    bool IsAligned(const void *ptr, size_t alignment)
+    {
+        return (reinterpret_cast< size_t >(ptr) & (alignment - 1)) == 0;
+    }
+
+    TEST(FrameArena, SanityCheck)
+    {
+        FrameArena arena;
+
+        EXPECT_EQ(0u, arena.GetUsed());
+        EXPECT_EQ(0u, arena.GetCapacity());
+    }
+
+    TEST(FrameArena, New)
+    {
+        FrameArena arena;
+
+        U8 *byte = arena.New< U8 >(static_cast< U8 >(3));
+        U64 *value = arena.New< U64 >(42u);
+
+        EXPECT_EQ(3u, *byte);
+        EXPECT_EQ(42u, *value);
+        EXPECT_TRUE(IsAligned(value, alignof(U64)));
+    }
+
+    TEST(FrameArena, Alignment)
+    {
+        FrameArena arena;
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            arena.New< U8 >();
+            EXPECT_TRUE(IsAligned(arena.New< Aligned >(), 64));
+            EXPECT_TRUE(IsAligned(arena.Allocate(5, 256), 256));
+        }
+    }
+
+    TEST(FrameArena, EmptyAllocation)
+    {
+        FrameArena arena;
+
+        // the first allocation may be empty, it still gets a chunk
+        EXPECT_NE(nullptr, arena.Allocate(0, 1));
+        EXPECT_EQ(arena.GetChunkSize(), arena.GetCapacity());
+        EXPECT_NE(nullptr, arena.Allocate(0, 16));
+    }
+
+    TEST(FrameArena, FillChunk)
+    {
+        FrameArena arena(256);
+
+        U8 *first = static_cast< U8 * >(arena.Allocate(200, 1));
+
+        // exactly the rest of the chunk
+        EXPECT_EQ(first + 200, arena.Allocate(56, 1));
+        EXPECT_EQ(256u, arena.GetCapacity());
+
+        arena.Allocate(1, 1);
+        EXPECT_EQ(512u, arena.GetCapacity());
+    }
+
+    TEST(FrameArena, NoMove)
+    {
+        FrameArena arena(64);
+
+        U64 *first = arena.New< U64 >(1u);
+
+        for (U64 i = 0; i < 1000; ++i)
+        {
+            arena.New< U64 >(i);
+        }
+
+        EXPECT_EQ(1u, *first);
+        EXPECT_GT(arena.GetCapacity(), 64u);
+    }
+
+    TEST(FrameArena, LargeAllocation)
+    {
+        FrameArena arena(64);
+
+        U8 *data = arena.AllocateArray< U8 >(1000);
+        std::fill(data, data + 1000, 1);
+
+        EXPECT_GE(arena.GetCapacity(), 1000u);
+        EXPECT_GE(arena.GetUsed(), 1000u);
+    }
+
+    TEST(FrameArena, FailedAllocation)
+    {
+        FrameArena arena(64);
+
+        U64 *value = arena.New< U64 >(1u);
+        const size_t used = arena.GetUsed();
+        const size_t capacity = arena.GetCapacity();
+
+        // no chunk this size can be mapped, the arena stays as it was
+        EXPECT_THROW(arena.Allocate(size_t(1) << 60, 1), std::bad_alloc);
+
+        EXPECT_EQ(used, arena.GetUsed());
+        EXPECT_EQ(capacity, arena.GetCapacity());
+        EXPECT_EQ(1u, *value);
+
+        U64 *next = arena.New< U64 >(2u);
+        EXPECT_EQ(1, next - value);
+    }
+
+    TEST(FrameArena, Destructors)
+    {
+        std::vector< U32 > log;
+
+        {
+            FrameArena arena;
+
+            arena.New< Tracked >(log, 1u);
+            arena.New< Tracked >(log, 2u);
+            arena.NewUntracked< Tracked >(log, 3u);
+
+            arena.Reset();
+
+            ASSERT_EQ(2u, log.size());
+            EXPECT_EQ(2u, log[0]);
+            EXPECT_EQ(1u, log[1]);
+
+            arena.New< Tracked >(log, 4u);
+        }
+
+        ASSERT_EQ(3u, log.size());
+        EXPECT_EQ(4u, log[2]);
+    }
+
+    TEST(FrameArena, NonTrivial)
+    {
+        FrameArena arena;
+
+        std::string *text = arena.New< std::string >(100, 'x');
+
+        EXPECT_EQ(100u, text->size());
+    }
+
+    TEST(FrameArena, Reset)
+    {
+        FrameArena arena(128);
+
+        U64 *first = arena.New< U64 >(1u);
+
+        for (U64 i = 0; i < 100; ++i)
+        {
+            arena.New< U64 >(i);
+        }
+
+        const size_t capacity = arena.GetCapacity();
+
+        arena.Reset();
+
+        EXPECT_EQ(0u, arena.GetUsed());
+        EXPECT_EQ(capacity, arena.GetCapacity());
+        EXPECT_EQ(first, arena.New< U64 >(2u));
+
+        // the chunks are reused
+        for (U64 i = 0; i < 100; ++i)
+        {
+            arena.New< U64 >(i);
+        }
+
+        EXPECT_EQ(capacity, arena.GetCapacity());
+    }
+
+    TEST(FrameArena, HugePageArena)
+    {
+        HugePageArena pages(HugePageArena::GetHugePageSize());
+        FrameArena arena(1024, &pages);
+
+        U64 *value = arena.New< U64 >(42u);
+
+        EXPECT_TRUE(pages.Owns(value));
+    }
+}
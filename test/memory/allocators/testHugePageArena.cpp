@@ -0,0 +1,189 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/instantiator/memoryPoolInstantiator.h"
+#include "memory/allocators/alignedAllocator.h"
+#include "memory/allocators/blockAllocator.h"
+#include "memory/allocators/hugePageArena.h"
+
+#include "engineTest.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const size_t gArenaSize = 8 * 1024 * 1024;
+
+    TEST(HugePageArena, SanityCheck)
+    {
+        HugePageArena arena(gArenaSize);
+
+        EXPECT_EQ(gArenaSize, arena.GetCapacity());
+        EXPECT_EQ(0u, arena.GetUsed());
+    }
+
+    TEST(HugePageArena, RoundsToHugePages)
+    {
+        HugePageArena arena(1);
+
+        EXPECT_EQ(HugePageArena::GetHugePageSize(), arena.GetCapacity());
+    }
+
+    TEST(HugePageArena, Allocate)
+    {
+        HugePageArena arena(gArenaSize);
+
+        void *first = arena.Allocate(100, 16);
+        void *second = arena.Allocate(100, 4096);
+
+        ASSERT_NE(nullptr, first);
+        ASSERT_NE(nullptr, second);
+
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(first) % 16);
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(second) % 4096);
+        EXPECT_TRUE(arena.Owns(first));
+        EXPECT_TRUE(arena.Owns(second));
+
+        std::memset(first, 0, 100);
+        std::memset(second, 0, 100);
+    }
+
+    TEST(HugePageArena, Exhausted)
+    {
+        HugePageArena arena(HugePageArena::GetHugePageSize());
+
+        EXPECT_NE(nullptr, arena.Allocate(HugePageArena::GetHugePageSize(), 16));
+        EXPECT_EQ(nullptr, arena.Allocate(1, 16));
+    }
+
+    TEST(HugePageArena, Reset)
+    {
+        HugePageArena arena(gArenaSize);
+
+        void *first = arena.Allocate(1000, 16);
+        arena.Reset();
+
+        EXPECT_EQ(0u, arena.GetUsed());
+        EXPECT_EQ(first, arena.Allocate(1000, 16));
+    }
+
+    TEST(HugePageArena, PageModes)
+    {
+        HugePageArena normal(gArenaSize, HugePageArena::PageMode::Normal);
+        HugePageArena transparent(gArenaSize, HugePageArena::PageMode::Transparent);
+        HugePageArena explicitPages(gArenaSize, HugePageArena::PageMode::Explicit);
+
+        EXPECT_EQ(HugePageArena::PageMode::Normal, normal.GetPageMode());
+        EXPECT_NE(HugePageArena::PageMode::Explicit, transparent.GetPageMode());
+
+        // falls back when the system has no huge pages reserved
+        void *memory = explicitPages.Allocate(gArenaSize, 16);
+
+        ASSERT_NE(nullptr, memory);
+        std::memset(memory, 0, gArenaSize);
+    }
+
+    TEST(HugePageArena, OwnsForeign)
+    {
+        HugePageArena arena(gArenaSize);
+        U32 value;
+
+        EXPECT_FALSE(arena.Owns(&value));
+    }
+
+    TEST(HugePageArena, MemoryPoolInstantiator)
+    {
+        HugePageArena arena(gArenaSize);
+        MemoryPoolInstantiator< U64 > inst(100, 10, &arena);
+
+        U64 *object = inst.Create();
+
+        EXPECT_TRUE(arena.Owns(object));
+        EXPECT_EQ(&arena, inst.GetArena());
+
+        inst.Destroy(object);
+    }
+
+    TEST(HugePageArena, MemoryPoolInstantiatorOverflow)
+    {
+        HugePageArena arena(HugePageArena::GetHugePageSize());
+        // blocks of 1MB, so the third block no longer fits in the arena
+        MemoryPoolInstantiator< U64 > inst(128 * 1024, 3, &arena);
+
+        std::vector< U64 * > objects;
+
+        for (U32 i = 0; i < 3 * 128 * 1024; ++i)
+        {
+            objects.push_back(inst.Create());
+        }
+
+        EXPECT_TRUE(arena.Owns(objects.front()));
+        EXPECT_FALSE(arena.Owns(objects.back()));
+
+        for (U64 *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+
+    TEST(HugePageArena, AlignedAllocator)
+    {
+        HugePageArena arena(gArenaSize);
+        const AlignedAllocator< U32, 64 > allocator(&arena);
+        std::vector< U32, AlignedAllocator< U32, 64 > > values(allocator);
+
+        values.resize(1000, 42);
+
+        EXPECT_TRUE(arena.Owns(values.data()));
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(values.data()) % 64);
+        EXPECT_EQ(42u, values.back());
+    }
+
+    TEST(HugePageArena, AlignedAllocatorEquality)
+    {
+        HugePageArena arena(gArenaSize);
+
+        EXPECT_TRUE((AlignedAllocator< U32, 64 >(&arena) == AlignedAllocator< U8, 64 >(&arena)));
+        EXPECT_FALSE((AlignedAllocator< U32, 64 >(&arena) == AlignedAllocator< U32, 64 >()));
+    }
+
+    TEST(HugePageArena, BlockAllocator)
+    {
+        HugePageArena arena(gArenaSize);
+        BlockAllocator allocator(1024, &arena);
+
+        BlockAllocator::BlockLocation first = allocator.Move< U64 >(42);
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            allocator.Move< U64 >(i);
+        }
+
+        EXPECT_TRUE(arena.Owns(allocator.Extract< U64 >(first)));
+        EXPECT_EQ(42u, *allocator.Extract< U64 >(first));
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/mappedArena.h"
+#include "memory/allocators/offsetPtr.h"
+
+#include "common/file.h"
+
+#include "engineTest.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    const size_t gArenaSize = 1024 * 1024;
+    const U32 gLayoutVersion = 3;
+
+    struct Node
+    {
+        U32 value;
+        OffsetPtr< Node > next;
+    };
+
+    TEST(OffsetPtr, SanityCheck)
+    {
+        OffsetPtr< U32 > ptr;
+
+        EXPECT_FALSE(ptr);
+        EXPECT_EQ(nullptr, ptr.Get());
+    }
+
+    TEST(OffsetPtr, Copy)
+    {
+        U32 value = 4;
+        OffsetPtr< U32 > ptr(&value);
+        OffsetPtr< U32 > copy(ptr);
+
+        EXPECT_TRUE(copy);
+        EXPECT_EQ(&value, copy.Get());
+        EXPECT_EQ(ptr, copy);
+        EXPECT_EQ(4u, *copy);
+    }
+
+    TEST(OffsetPtr, Relocate)
+    {
+        char first[sizeof(Node) * 2];
+        char second[sizeof(Node) * 2];
+
+        Node *nodes = new(first) Node[2];
+        nodes[0].value = 1;
+        nodes[1].value = 2;
+        nodes[0].next = &nodes[1];
+
+        // moves both the pointer and its target, as a remapped file would
+        std::memcpy(second, first, sizeof(first));
+        const Node *moved = reinterpret_cast< const Node * >(second);
+
+        EXPECT_EQ(&moved[1], moved[0].next.Get());
+        EXPECT_EQ(2u, moved[0].next->value);
+    }
+
+    TEST(MappedArena, Create)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Created, arena.Open(path, gArenaSize, gLayoutVersion));
+        EXPECT_TRUE(arena.IsOpen());
+        EXPECT_FALSE(arena.IsCommitted());
+        EXPECT_EQ(gArenaSize, arena.GetCapacity());
+        EXPECT_EQ(0u, arena.GetUsed());
+        EXPECT_EQ(nullptr, arena.GetRoot< Node >());
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, Allocate)
+    {
+        const std::string path = File::TempGet();
+        MappedArena arena;
+        arena.Open(path, gArenaSize, gLayoutVersion);
+
+        void *first = arena.Allocate(100, 16);
+        void *second = arena.Allocate(100, 64);
+
+        EXPECT_TRUE(arena.Owns(first));
+        EXPECT_TRUE(arena.Owns(second));
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(second) % 64);
+        EXPECT_EQ(nullptr, arena.Allocate(gArenaSize, 16));
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, Reopen)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, gArenaSize, gLayoutVersion);
+
+            Node *second = arena.New< Node >();
+            second->value = 2;
+
+            Node *first = arena.New< Node >();
+            first->value = 1;
+            first->next = second;
+
+            arena.SetRoot(first);
+            EXPECT_TRUE(arena.Commit());
+            EXPECT_TRUE(arena.IsCommitted());
+        }
+
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Opened, arena.Open(path, gArenaSize, gLayoutVersion));
+        EXPECT_TRUE(arena.IsCommitted());
+
+        const Node *root = arena.GetRoot< Node >();
+        ASSERT_NE(nullptr, root);
+        EXPECT_EQ(1u, root->value);
+        EXPECT_EQ(2u, root->next->value);
+        EXPECT_TRUE(arena.Owns(root->next.Get()));
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, RebuildOnVersionMismatch)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, gArenaSize, gLayoutVersion);
+            arena.SetRoot(arena.New< Node >());
+            arena.Commit();
+        }
+
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Rebuilt, arena.Open(path, gArenaSize, gLayoutVersion + 1));
+        EXPECT_EQ(nullptr, arena.GetRoot< Node >());
+        EXPECT_EQ(0u, arena.GetUsed());
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, RebuildWhenNotCommitted)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            MappedArena arena;
+            arena.Open(path, gArenaSize, gLayoutVersion);
+            arena.SetRoot(arena.New< Node >());
+            arena.Commit();
+
+            // changes after the commit invalidate it
+            arena.New< Node >();
+            EXPECT_FALSE(arena.IsCommitted());
+        }
+
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Rebuilt, arena.Open(path, gArenaSize, gLayoutVersion));
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, RebuildOnGarbage)
+    {
+        const std::string path = File::TempGet();
+
+        {
+            std::ofstream stream(path, std::ios::binary);
+            stream << std::string(8192, 'x');
+        }
+
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Rebuilt, arena.Open(path, gArenaSize, gLayoutVersion));
+        EXPECT_EQ(gArenaSize, arena.GetCapacity());
+
+        arena.Close();
+        File::Delete(path);
+    }
+
+    TEST(MappedArena, OpenFails)
+    {
+        MappedArena arena;
+
+        EXPECT_EQ(MappedArena::OpenResult::Failed, arena.Open(File::TempGet() + "/missing/file", gArenaSize, gLayoutVersion));
+        EXPECT_FALSE(arena.IsOpen());
+        EXPECT_EQ(nullptr, arena.Allocate(16, 16));
+    }
+}
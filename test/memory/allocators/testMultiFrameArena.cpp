@@ -0,0 +1,117 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/multiFrameArena.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    class Tracked
+    {
+    public:
+
+        explicit Tracked(U32 &destroyed)
+            : mDestroyed(destroyed)
+        {
+        }
+
+        ~Tracked()
+        {
+            ++mDestroyed;
+        }
+
+    private:
+
+        U32 &mDestroyed;
+    };
+
+    TEST(MultiFrameArena, SanityCheck)
+    {
+        MultiFrameArena arena;
+
+        EXPECT_EQ(2u, arena.GetFrameCount());
+        EXPECT_EQ(0u, arena.GetUsed());
+    }
+
+    TEST(MultiFrameArena, AtLeastOneFrame)
+    {
+        MultiFrameArena arena(0);
+
+        EXPECT_EQ(1u, arena.GetFrameCount());
+    }
+
+    TEST(MultiFrameArena, SurvivesFrames)
+    {
+        MultiFrameArena arena(3);
+        U32 destroyed = 0;
+
+        arena.New< Tracked >(destroyed);
+
+        arena.NextFrame();
+        EXPECT_EQ(0u, destroyed);
+
+        arena.NextFrame();
+        EXPECT_EQ(0u, destroyed);
+
+        arena.NextFrame();
+        EXPECT_EQ(1u, destroyed);
+    }
+
+    TEST(MultiFrameArena, DoubleBuffered)
+    {
+        MultiFrameArena arena(2);
+
+        U64 *previous = arena.New< U64 >(1u);
+        arena.NextFrame();
+
+        U64 *current = arena.New< U64 >(2u);
+
+        EXPECT_EQ(1u, *previous);
+        EXPECT_NE(previous, current);
+
+        arena.NextFrame();
+
+        // the memory of two frames ago is recycled
+        EXPECT_EQ(previous, arena.New< U64 >(3u));
+        EXPECT_EQ(2u, *current);
+    }
+
+    TEST(MultiFrameArena, Reset)
+    {
+        MultiFrameArena arena(2);
+        U32 destroyed = 0;
+
+        arena.New< Tracked >(destroyed);
+        arena.NextFrame();
+        arena.New< Tracked >(destroyed);
+
+        arena.Reset();
+
+        EXPECT_EQ(2u, destroyed);
+        EXPECT_EQ(0u, arena.GetUsed());
+    }
+}
@@ -0,0 +1,181 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/allocators/slabAllocator.h"
+#include "memory/allocators/malloc.h"
+
+#include "engineTest.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <set>
+
+namespace
+{
+    bool IsAligned(const void *ptr, size_t alignment)
+    {
+        return (reinterpret_cast< size_t >(ptr) & (alignment - 1)) == 0;
+    }
+
+    TEST(SlabAllocator, ClassSizes)
+    {
+        EXPECT_EQ(16u, SlabAllocator::GetClassSize(0));
+        EXPECT_EQ(128u, SlabAllocator::GetClassSize(7));
+        EXPECT_EQ(160u, SlabAllocator::GetClassSize(8));
+        EXPECT_EQ(256u, SlabAllocator::GetClassSize(11));
+        EXPECT_EQ(SlabAllocator::MaxSmallSize, SlabAllocator::GetClassSize(SlabAllocator::ClassCount - 1));
+
+        for (size_t sizeClass = 1; sizeClass < SlabAllocator::ClassCount; ++sizeClass)
+        {
+            EXPECT_LT(SlabAllocator::GetClassSize(sizeClass - 1), SlabAllocator::GetClassSize(sizeClass));
+        }
+    }
+
+    TEST(SlabAllocator, SizeClass)
+    {
+        for (size_t bytes = 0; bytes <= SlabAllocator::MaxSmallSize; bytes += 7)
+        {
+            const size_t sizeClass = SlabAllocator::GetSizeClass(bytes, 16);
+
+            ASSERT_LT(sizeClass, SlabAllocator::ClassCount);
+            EXPECT_GE(SlabAllocator::GetClassSize(sizeClass), bytes);
+
+            if (sizeClass > 0)
+            {
+                EXPECT_LT(SlabAllocator::GetClassSize(sizeClass - 1), bytes);
+            }
+        }
+
+        EXPECT_EQ(SlabAllocator::ClassCount, SlabAllocator::GetSizeClass(SlabAllocator::MaxSmallSize + 1, 16));
+        EXPECT_EQ(SlabAllocator::ClassCount, SlabAllocator::GetSizeClass(16, SlabAllocator::MaxSmallAlignment * 2));
+    }
+
+    TEST(SlabAllocator, Alignment)
+    {
+        for (size_t alignment = 1; alignment <= 1024 * 1024; alignment <<= 1)
+        {
+            for (size_t bytes : { 1, 24, 100, 1000, 5000, 40000 })
+            {
+                void *ptr = SlabAllocator::Allocate(bytes, alignment);
+
+                ASSERT_NE(nullptr, ptr);
+                EXPECT_TRUE(IsAligned(ptr, alignment));
+                EXPECT_GE(SlabAllocator::GetUsableSize(ptr), bytes);
+
+                std::memset(ptr, 0xAB, bytes);
+                SlabAllocator::Free(ptr);
+            }
+        }
+    }
+
+    TEST(SlabAllocator, Unique)
+    {
+        std::vector< void * > ptrs;
+        std::set< void * > unique;
+
+        for (U32 i = 0; i < 10000; ++i)
+        {
+            void *ptr = SlabAllocator::Allocate(48, 16);
+            std::memset(ptr, 0, 48);
+
+            ptrs.push_back(ptr);
+            unique.insert(ptr);
+        }
+
+        EXPECT_EQ(ptrs.size(), unique.size());
+
+        for (void *ptr : ptrs)
+        {
+            SlabAllocator::Free(ptr);
+        }
+    }
+
+    TEST(SlabAllocator, Reuse)
+    {
+        void *first = SlabAllocator::Allocate(64, 16);
+        SlabAllocator::Free(first);
+
+        void *second = SlabAllocator::Allocate(64, 16);
+        EXPECT_EQ(first, second);
+
+        SlabAllocator::Free(second);
+    }
+
+    TEST(SlabAllocator, FreeNull)
+    {
+        SlabAllocator::Free(nullptr);
+    }
+
+    TEST(SlabAllocator, CrossThreadFree)
+    {
+        std::vector< void * > ptrs;
+
+        std::thread producer([&ptrs]()
+        {
+            for (U32 i = 0; i < 5000; ++i)
+            {
+                ptrs.push_back(SlabAllocator::Allocate(16 + (i % 64) * 16, 16));
+            }
+        });
+        producer.join();
+
+        std::thread consumer([&ptrs]()
+        {
+            for (void *ptr : ptrs)
+            {
+                SlabAllocator::Free(ptr);
+            }
+        });
+        consumer.join();
+
+        // the objects are reusable after the consumer exited
+        void *ptr = SlabAllocator::Allocate(32, 16);
+        EXPECT_NE(nullptr, ptr);
+        SlabAllocator::Free(ptr);
+    }
+
+    TEST(SlabAllocator, FlushThreadCache)
+    {
+        void *ptr = SlabAllocator::Allocate(128, 16);
+        SlabAllocator::Free(ptr);
+        SlabAllocator::FlushThreadCache();
+
+        void *again = SlabAllocator::Allocate(128, 16);
+        EXPECT_NE(nullptr, again);
+        SlabAllocator::Free(again);
+    }
+
+    TEST(SlabAllocator, ZefAlignedMalloc)
+    {
+        void *ptr = ZefAlignedMalloc(100, 64);
+
+        EXPECT_TRUE(IsAligned(ptr, 64));
+        EXPECT_GE(SlabAllocator::GetUsableSize(ptr), 100u);
+
+        ZefAlignedFree(ptr);
+    }
+}
@@ -25,6 +25,7 @@
  */
 
 #include "memory/allocators/stackAllocator.h"
+#include "memory/allocators/hugePageArena.h"
 
 #include "engineTest.h"
 
@@ -125,4 +126,22 @@ namespace
         EXPECT_EQ(80, *s.Extract<U8>(fl2));
     }
 
+    TEST(StackAllocator, ArenaGrowth)
+    {
+        HugePageArena arena(HugePageArena::GetHugePageSize());
+        StackAllocator s(4, &arena);
+
+        const size_t used = arena.GetUsed();
+        const U8 f = 8;
+        StackAllocator::StackLocation l = s.Move(f);
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            s.Alloc< U64 >();
+        }
+
+        EXPECT_EQ(used, arena.GetUsed());
+        EXPECT_EQ(8, *s.Extract<U8>(l));
+    }
+
 }
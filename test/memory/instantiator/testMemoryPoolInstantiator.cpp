@@ -29,6 +29,9 @@
 
 #include "engineTest.h"
 
+#include <stdexcept>
+#include <vector>
+
 namespace
 {
     class Base
@@ -55,6 +58,74 @@ namespace
         }
     };
 
+    class Counted
+    {
+    public:
+
+        Counted()
+        {
+            ++constructed;
+        }
+
+        ~Counted()
+        {
+            ++destructed;
+        }
+
+        static U32 constructed;
+        static U32 destructed;
+    };
+
+    U32 Counted::constructed = 0;
+    U32 Counted::destructed = 0;
+
+    class Point
+    {
+    public:
+
+        Point(U32 x, U32 y)
+            : x(x),
+              y(y)
+        {
+        }
+
+        U32 x;
+        U32 y;
+    };
+
+    Point *CreateOrigin(void *memory)
+    {
+        return new(memory) Point(0u, 0u);
+    }
+
+    class Throwing
+    {
+    public:
+
+        explicit Throwing(bool fail)
+        {
+            if (fail)
+            {
+                throw std::runtime_error("Throwing");
+            }
+        }
+    };
+
+    struct Large
+    {
+        U8 data[3000];
+    };
+
+    struct alignas(64) Aligned
+    {
+        U32 value;
+    };
+
+    Throwing *CreateThrowing(void *memory)
+    {
+        return new(memory) Throwing(false);
+    }
+
     typedef MemoryPoolInstantiator< Child, Base > MemoryPoolInstantiatorImpl;
 
     TEST(MemoryPoolInstantiator, SanityCheck)
@@ -149,4 +220,185 @@ namespace
         MemoryPoolInstantiatorImpl instantiator;
         delete instantiator.Copy();
     }
-}
\ No newline at end of file
+
+    TEST(MemoryPoolInstantiator, ReuseSlot)
+    {
+        MemoryPoolInstantiatorImpl inst(4, 1);
+
+        Base *child = inst.Create();
+        inst.Destroy(child);
+
+        Base *child2 = inst.Create();
+
+        EXPECT_EQ(child, child2);
+        EXPECT_TRUE(child2->IsDerived());
+
+        inst.Destroy(child2);
+    }
+
+    TEST(MemoryPoolInstantiator, ConstructDestruct)
+    {
+        Counted::constructed = 0;
+        Counted::destructed = 0;
+
+        {
+            MemoryPoolInstantiator< Counted > inst(10, 1);
+
+            EXPECT_EQ(0u, Counted::constructed);
+
+            Counted *first = inst.Create();
+            Counted *second = inst.Create();
+
+            EXPECT_EQ(2u, Counted::constructed);
+
+            inst.Destroy(first);
+            inst.Destroy(second);
+
+            EXPECT_EQ(2u, Counted::destructed);
+        }
+
+        EXPECT_EQ(2u, Counted::destructed);
+    }
+
+    TEST(MemoryPoolInstantiator, OverflowDestroy)
+    {
+        Counted::constructed = 0;
+        Counted::destructed = 0;
+
+        MemoryPoolInstantiator< Counted > inst(1, 0);
+
+        Counted *pooled = inst.Create();
+        Counted *heap = inst.Create();
+
+        inst.Destroy(heap);
+        inst.Destroy(pooled);
+
+        EXPECT_EQ(2u, Counted::constructed);
+        EXPECT_EQ(2u, Counted::destructed);
+    }
+
+    TEST(MemoryPoolInstantiator, CreateArguments)
+    {
+        MemoryPoolInstantiator< Point > inst(2, 1, nullptr, &CreateOrigin);
+
+        Point *first = inst.Create(1u, 2u);
+        Point *second = inst.Create(3u, 4u);
+
+        EXPECT_EQ(1u, first->x);
+        EXPECT_EQ(2u, first->y);
+        EXPECT_EQ(3u, second->x);
+        EXPECT_EQ(4u, second->y);
+        EXPECT_EQ(1, second - first);
+
+        inst.Destroy(first);
+        inst.Destroy(second);
+    }
+
+    TEST(MemoryPoolInstantiator, CreateArgumentsOverflow)
+    {
+        MemoryPoolInstantiator< Point > inst(1, 0, nullptr, &CreateOrigin);
+
+        Point *pooled = inst.Create(1u, 2u);
+        Point *heap = inst.Create(3u, 4u);
+
+        EXPECT_EQ(3u, heap->x);
+        EXPECT_EQ(4u, heap->y);
+
+        inst.Destroy(heap);
+        inst.Destroy(pooled);
+    }
+
+    TEST(MemoryPoolInstantiator, CreateFactory)
+    {
+        MemoryPoolInstantiator< Point > inst(2, 1, nullptr, &CreateOrigin);
+
+        Point *point = inst.Create();
+
+        EXPECT_EQ(0u, point->x);
+        EXPECT_EQ(0u, point->y);
+
+        // the copy keeps the factory
+        MemoryPoolInstantiator< Point > *copy = static_cast< MemoryPoolInstantiator< Point > * >(inst.Copy());
+        Point *copied = copy->Create();
+
+        EXPECT_EQ(0u, copied->x);
+
+        copy->Destroy(copied);
+        delete copy;
+
+        inst.Destroy(point);
+    }
+
+    TEST(MemoryPoolInstantiator, CreateThrows)
+    {
+        MemoryPoolInstantiator< Throwing > inst(1, 0, nullptr, &CreateThrowing);
+
+        Throwing *first = inst.Create(false);
+        inst.Destroy(first);
+
+        EXPECT_THROW(inst.Create(true), std::runtime_error);
+
+        // the slot went back to the pool
+        Throwing *pooled = inst.Create(false);
+        EXPECT_EQ(first, pooled);
+
+        // and a failed heap construction frees its memory
+        EXPECT_THROW(inst.Create(true), std::runtime_error);
+
+        inst.Destroy(pooled);
+    }
+
+    TEST(MemoryPoolInstantiator, SlabSpanningBlock)
+    {
+        // the block spans two slabs and ends inside the last one
+        MemoryPoolInstantiator< Large > inst(30, 0);
+        std::vector< Large * > objects;
+
+        for (U32 i = 0; i < 30; ++i)
+        {
+            objects.push_back(inst.Create());
+        }
+
+        Large *heap = inst.Create();
+        inst.Destroy(heap);
+
+        for (U32 i = 1; i < 30; ++i)
+        {
+            EXPECT_EQ(1, objects[i] - objects[i - 1]);
+        }
+
+        for (Large *object : objects)
+        {
+            inst.Destroy(object);
+        }
+
+        // every slot went back to the pool
+        for (U32 i = 0; i < 30; ++i)
+        {
+            EXPECT_EQ(objects[29 - i], inst.Create());
+        }
+
+        for (Large *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+
+    TEST(MemoryPoolInstantiator, AlignedOverflow)
+    {
+        // two blocks of two slots, everything after that comes from the heap
+        MemoryPoolInstantiator< Aligned > inst(2, 1);
+        std::vector< Aligned * > objects;
+
+        for (U32 i = 0; i < 8; ++i)
+        {
+            objects.push_back(inst.Create());
+            EXPECT_EQ(0u, reinterpret_cast< size_t >(objects.back()) % alignof(Aligned));
+        }
+
+        for (Aligned *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+}
@@ -176,4 +176,30 @@ namespace
         PoolableInstantiatorImpl instantiator;
         delete instantiator.Copy();
     }
-}
\ No newline at end of file
+
+    TEST(PoolableInstantiator, Batch)
+    {
+        PoolableInstantiatorImpl inst;
+
+        Base *children[4];
+
+        for (Base *&child : children)
+        {
+            child = inst.Create();
+        }
+
+        inst.InitialiseBatch(children, 4);
+
+        for (Base *child : children)
+        {
+            EXPECT_EQ(84u, *child->GetValue());
+        }
+
+        inst.ReleaseBatch(children, 4);
+
+        for (Base *child : children)
+        {
+            inst.Destroy(child);
+        }
+    }
+}
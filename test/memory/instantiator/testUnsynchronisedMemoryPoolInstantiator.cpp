@@ -29,6 +29,9 @@
 
 #include "engineTest.h"
 
+#include <stdexcept>
+#include <vector>
+
 namespace
 {
     class Base
@@ -55,6 +58,53 @@ namespace
         }
     };
 
+    class Point
+    {
+    public:
+
+        Point(U32 x, U32 y)
+            : x(x),
+              y(y)
+        {
+        }
+
+        U32 x;
+        U32 y;
+    };
+
+    Point *CreateOrigin(void *memory)
+    {
+        return new(memory) Point(0u, 0u);
+    }
+
+    class Throwing
+    {
+    public:
+
+        explicit Throwing(bool fail)
+        {
+            if (fail)
+            {
+                throw std::runtime_error("Throwing");
+            }
+        }
+    };
+
+    struct Large
+    {
+        U8 data[3000];
+    };
+
+    struct alignas(64) Aligned
+    {
+        U32 value;
+    };
+
+    Throwing *CreateThrowing(void *memory)
+    {
+        return new(memory) Throwing(false);
+    }
+
     typedef UnsychronisedMemoryPoolInstantiator< Child, Base > UnsychronisedMemoryPoolInstantiatorImpl;
 
     TEST(UnsychronisedMemoryPoolInstantiator, SanityCheck)
@@ -150,4 +200,128 @@ namespace
         delete instantiator.Copy();
     }
 
-}
\ No newline at end of file
+    TEST(UnsychronisedMemoryPoolInstantiator, CreateArguments)
+    {
+        UnsychronisedMemoryPoolInstantiator< Point > inst(2, 1, nullptr, &CreateOrigin);
+
+        Point *first = inst.Create(1u, 2u);
+        Point *second = inst.Create(3u, 4u);
+
+        EXPECT_EQ(1u, first->x);
+        EXPECT_EQ(2u, first->y);
+        EXPECT_EQ(3u, second->x);
+        EXPECT_EQ(4u, second->y);
+        EXPECT_EQ(1, second - first);
+
+        inst.Destroy(first);
+        inst.Destroy(second);
+    }
+
+    TEST(UnsychronisedMemoryPoolInstantiator, CreateArgumentsOverflow)
+    {
+        UnsychronisedMemoryPoolInstantiator< Point > inst(1, 0, nullptr, &CreateOrigin);
+
+        Point *pooled = inst.Create(1u, 2u);
+        Point *heap = inst.Create(3u, 4u);
+
+        EXPECT_EQ(3u, heap->x);
+        EXPECT_EQ(4u, heap->y);
+
+        inst.Destroy(heap);
+        inst.Destroy(pooled);
+    }
+
+    TEST(UnsychronisedMemoryPoolInstantiator, CreateFactory)
+    {
+        UnsychronisedMemoryPoolInstantiator< Point > inst(2, 1, nullptr, &CreateOrigin);
+
+        Point *point = inst.Create();
+
+        EXPECT_EQ(0u, point->x);
+        EXPECT_EQ(0u, point->y);
+
+        // the copy keeps the factory
+        UnsychronisedMemoryPoolInstantiator< Point > *copy = static_cast< UnsychronisedMemoryPoolInstantiator< Point > * >(inst.Copy());
+        Point *copied = copy->Create();
+
+        EXPECT_EQ(0u, copied->x);
+
+        copy->Destroy(copied);
+        delete copy;
+
+        inst.Destroy(point);
+    }
+
+    TEST(UnsychronisedMemoryPoolInstantiator, CreateThrows)
+    {
+        UnsychronisedMemoryPoolInstantiator< Throwing > inst(1, 0, nullptr, &CreateThrowing);
+
+        Throwing *first = inst.Create(false);
+        inst.Destroy(first);
+
+        EXPECT_THROW(inst.Create(true), std::runtime_error);
+
+        // the slot went back to the pool
+        Throwing *pooled = inst.Create(false);
+        EXPECT_EQ(first, pooled);
+
+        // and a failed heap construction frees its memory
+        EXPECT_THROW(inst.Create(true), std::runtime_error);
+
+        inst.Destroy(pooled);
+    }
+
+    TEST(UnsychronisedMemoryPoolInstantiator, SlabSpanningBlock)
+    {
+        // the block spans two slabs and ends inside the last one
+        UnsychronisedMemoryPoolInstantiator< Large > inst(30, 0);
+        std::vector< Large * > objects;
+
+        for (U32 i = 0; i < 30; ++i)
+        {
+            objects.push_back(inst.Create());
+        }
+
+        Large *heap = inst.Create();
+        inst.Destroy(heap);
+
+        for (U32 i = 1; i < 30; ++i)
+        {
+            EXPECT_EQ(1, objects[i] - objects[i - 1]);
+        }
+
+        for (Large *object : objects)
+        {
+            inst.Destroy(object);
+        }
+
+        // every slot went back to the pool
+        for (U32 i = 0; i < 30; ++i)
+        {
+            EXPECT_EQ(objects[29 - i], inst.Create());
+        }
+
+        for (Large *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+
+    TEST(UnsychronisedMemoryPoolInstantiator, AlignedOverflow)
+    {
+        // two blocks of two slots, everything after that comes from the heap
+        UnsychronisedMemoryPoolInstantiator< Aligned > inst(2, 1);
+        std::vector< Aligned * > objects;
+
+        for (U32 i = 0; i < 8; ++i)
+        {
+            objects.push_back(inst.Create());
+            EXPECT_EQ(0u, reinterpret_cast< size_t >(objects.back()) % alignof(Aligned));
+        }
+
+        for (Aligned *object : objects)
+        {
+            inst.Destroy(object);
+        }
+    }
+}
@@ -28,6 +28,8 @@
 
 #include "engineTest.h"
 
+#include <thread>
+
 namespace
 {
     class Base
@@ -301,4 +303,414 @@ namespace
 
         delete pool.FastGet();
     }
+
+    TEST(ObjectPool, MagazineSize)
+    {
+        ObjectPoolImpl pool(10, 4);
+        ObjectPoolImpl noMagazines;
+
+        EXPECT_EQ(4u, pool.GetMagazineSize());
+        EXPECT_EQ(0u, noMagazines.GetMagazineSize());
+    }
+
+    TEST(ObjectPool, MagazineGet)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        ScheduleManager::SetCurrentThreadID(1);
+
+        {
+            ObjectPoolImpl pool(10, 2);
+
+            Base *first = pool.Get();
+            EXPECT_EQ(42u, first->GetValue());
+
+            pool.Dispose(first);
+
+            EXPECT_EQ(0u, first->GetValue());
+
+            Base *second = pool.Get();
+            Base *third = pool.Get();
+
+            EXPECT_EQ(first, second);
+            EXPECT_NE(first, third);
+
+            EXPECT_EQ(3u, pool.GetBorrowedCount());
+            EXPECT_EQ(1u, pool.GetReturnedCount());
+
+            pool.Dispose(third);
+            pool.Dispose(second);
+
+            EXPECT_EQ(3u, pool.GetReturnedCount());
+        }
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(ObjectPool, MagazineFlush)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        ScheduleManager::SetCurrentThreadID(1);
+
+        {
+            ImplPoolableInstantiator *inst = new ImplPoolableInstantiator;
+            ObjectPool< U32 > pool(inst, 0, 1);
+
+            U32 *first = pool.Get();
+            U32 *second = pool.Get();
+
+            pool.Dispose(first);
+            EXPECT_FALSE(inst->destroyed);
+
+            // the magazine overflows into the full shared pool
+            pool.Dispose(second);
+            EXPECT_TRUE(inst->destroyed);
+
+            EXPECT_EQ(2u, pool.GetBorrowedCount());
+            EXPECT_EQ(2u, pool.GetReturnedCount());
+        }
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(ObjectPool, MagazineShared)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        ScheduleManager::SetCurrentThreadID(1);
+
+        {
+            ObjectPoolImpl pool(10, 1);
+
+            Base *first = pool.Get();
+            Base *second = pool.Get();
+
+            pool.Dispose(first);
+            pool.Dispose(second);
+
+            // threads without a magazine take the flushed object from the shared pool
+            Base *fromShared = nullptr;
+            std::thread thread([&]()
+            {
+                ScheduleManager::SetCurrentThreadID(Thread::InvalidID);
+                fromShared = pool.Get();
+                pool.Dispose(fromShared);
+            });
+            thread.join();
+
+            EXPECT_TRUE(fromShared == first || fromShared == second);
+            EXPECT_EQ(3u, pool.GetBorrowedCount());
+            EXPECT_EQ(3u, pool.GetReturnedCount());
+        }
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(ObjectPool, MagazineThreads)
+    {
+        ObjectPoolImpl pool(100, 8);
+
+        std::vector< std::thread > threads;
+
+        for (ThreadID i = 1; i <= 4; ++i)
+        {
+            threads.emplace_back([&pool, i]()
+            {
+                ScheduleManager::SetCurrentThreadID(i);
+
+                std::vector< Base * > objects;
+
+                for (U32 j = 0; j < 1000; ++j)
+                {
+                    objects.push_back(pool.Get());
+
+                    if (objects.size() == 20)
+                    {
+                        for (Base *object : objects)
+                        {
+                            pool.Dispose(object);
+                        }
+
+                        objects.clear();
+                    }
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(4000u, pool.GetBorrowedCount());
+        EXPECT_EQ(4000u, pool.GetReturnedCount());
+    }
+
+    void Cycle(ObjectPoolImpl &pool, size_t count)
+    {
+        std::vector< Base * > objects;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects.push_back(pool.Get());
+        }
+
+        for (Base *object : objects)
+        {
+            pool.Dispose(object);
+        }
+    }
+
+    TEST(ObjectPool, Trim)
+    {
+        ObjectPoolImpl pool(100);
+        Cycle(pool, 10);
+
+        EXPECT_EQ(10u, pool.GetIdleCount());
+        EXPECT_EQ(10u, pool.Trim());
+        EXPECT_EQ(0u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, TrimTo)
+    {
+        ObjectPoolImpl pool(100);
+        Cycle(pool, 10);
+
+        EXPECT_EQ(6u, pool.TrimTo(4));
+        EXPECT_EQ(4u, pool.GetIdleCount());
+        EXPECT_EQ(0u, pool.TrimTo(8));
+    }
+
+    TEST(ObjectPool, TrimMagazines)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        ScheduleManager::SetCurrentThreadID(1);
+
+        {
+            ObjectPoolImpl pool(100, 4);
+            Cycle(pool, 3);
+
+            // the objects sit in the magazine, the shared pool is empty
+            EXPECT_EQ(0u, pool.GetIdleCount());
+            EXPECT_EQ(2u, pool.TrimTo(1));
+            EXPECT_EQ(1u, pool.GetIdleCount());
+        }
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(ObjectPool, TrimMinCapacity)
+    {
+        ObjectPoolImpl pool(100);
+        pool.SetAdaptiveCapacity(5, 100);
+        Cycle(pool, 10);
+
+        EXPECT_EQ(5u, pool.Trim());
+        EXPECT_EQ(5u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, AdaptDisabled)
+    {
+        ObjectPoolImpl pool(100);
+        Cycle(pool, 10);
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            pool.Adapt();
+        }
+
+        EXPECT_EQ(10u, pool.GetIdleCount());
+        EXPECT_EQ(100u, pool.GetCapacity());
+    }
+
+    TEST(ObjectPool, AdaptShrink)
+    {
+        ObjectPoolImpl pool(100);
+        pool.SetAdaptiveCapacity(0, 100, 2);
+        Cycle(pool, 20);
+
+        // the first window saw an empty pool
+        pool.Adapt();
+        pool.Adapt();
+        EXPECT_EQ(20u, pool.GetIdleCount());
+
+        // the idle objects were never used, so half of them go
+        pool.Adapt();
+        EXPECT_EQ(20u, pool.GetIdleCount());
+        pool.Adapt();
+        EXPECT_EQ(10u, pool.GetIdleCount());
+        EXPECT_EQ(90u, pool.GetCapacity());
+
+        // the remaining objects are in use, so they stay
+        Cycle(pool, 10);
+        pool.Adapt();
+        pool.Adapt();
+        EXPECT_EQ(10u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, AdaptGrow)
+    {
+        ObjectPoolImpl pool(10);
+        pool.SetAdaptiveCapacity(0, 100, 1);
+
+        // ten objects are created and destroyed again
+        Cycle(pool, 20);
+        EXPECT_EQ(10u, pool.GetIdleCount());
+
+        pool.Adapt();
+        EXPECT_EQ(20u, pool.GetCapacity());
+
+        Cycle(pool, 20);
+        EXPECT_EQ(20u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, AdaptMaxCapacity)
+    {
+        ObjectPoolImpl pool(10);
+        pool.SetAdaptiveCapacity(0, 15, 1);
+
+        Cycle(pool, 40);
+        pool.Adapt();
+
+        EXPECT_EQ(15u, pool.GetCapacity());
+    }
+
+    TEST(ObjectPool, Reserve)
+    {
+        ObjectPoolImpl pool(10);
+
+        EXPECT_EQ(20u, pool.Reserve(20));
+        EXPECT_EQ(20u, pool.GetIdleCount());
+        EXPECT_EQ(20u, pool.GetCapacity());
+
+        // reserving takes the idle objects into account
+        EXPECT_EQ(0u, pool.Reserve(10));
+        EXPECT_EQ(5u, pool.Reserve(25, true));
+
+        Base *object = pool.Get();
+        EXPECT_TRUE(object->IsDerived());
+        pool.Dispose(object);
+
+        EXPECT_EQ(25u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, ReserveMagazines)
+    {
+        ObjectPoolImpl pool(100, 8);
+        pool.Reserve(16);
+
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+
+        ScheduleManager::SetCurrentThreadID(1);
+        pool.Dispose(pool.Get());
+        ScheduleManager::SetCurrentThreadID(threadID);
+
+        // the magazine took a batch from the reserved objects
+        EXPECT_EQ(8u, pool.GetIdleCount());
+    }
+
+    class Counted
+    {
+    public:
+
+        void OnInit()
+        {
+            ++inits;
+        }
+
+        void OnRelease()
+        {
+            ++releases;
+        }
+
+        U32 inits = 0;
+        U32 releases = 0;
+    };
+
+    TEST(ObjectPool, GetBatch)
+    {
+        ObjectPool< Counted > pool(100);
+
+        Counted *objects[10];
+        pool.GetBatch(10, objects);
+
+        for (Counted *object : objects)
+        {
+            EXPECT_EQ(1u, object->inits);
+        }
+
+        EXPECT_EQ(10u, pool.GetBorrowedCount());
+
+        pool.DisposeBatch(objects, 10);
+
+        for (Counted *object : objects)
+        {
+            EXPECT_EQ(1u, object->releases);
+        }
+
+        EXPECT_EQ(10u, pool.GetReturnedCount());
+        EXPECT_EQ(10u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, GetBatchReuse)
+    {
+        ObjectPool< Counted > pool(100);
+        pool.Reserve(6);
+
+        Counted *objects[10];
+        pool.FastGetBatch(10, objects);
+
+        EXPECT_EQ(0u, pool.GetIdleCount());
+
+        pool.FastDisposeBatch(objects, 10);
+        pool.FastGetBatch(10, objects);
+
+        // every object comes out of the pool once
+        for (U32 i = 0; i < 10; ++i)
+        {
+            for (U32 j = i + 1; j < 10; ++j)
+            {
+                EXPECT_NE(objects[i], objects[j]);
+            }
+
+            EXPECT_EQ(0u, objects[i]->inits);
+        }
+
+        pool.FastDisposeBatch(objects, 10);
+        EXPECT_EQ(10u, pool.GetIdleCount());
+    }
+
+    TEST(ObjectPool, DisposeBatchOverflow)
+    {
+        ObjectPool< Counted > pool(4);
+
+        Counted *objects[10];
+        pool.GetBatch(10, objects);
+        pool.DisposeBatch(objects, 10);
+
+        EXPECT_EQ(4u, pool.GetIdleCount());
+        EXPECT_EQ(10u, pool.GetReturnedCount());
+    }
+
+    TEST(ObjectPool, BatchMagazine)
+    {
+        ObjectPool< Counted > pool(100, 8);
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+
+        ScheduleManager::SetCurrentThreadID(1);
+
+        Counted *objects[20];
+        pool.GetBatch(20, objects);
+        pool.DisposeBatch(objects, 20);
+
+        // the magazine keeps up to its size, the rest goes back to the shared pool
+        EXPECT_EQ(12u, pool.GetIdleCount());
+
+        pool.GetBatch(20, objects);
+        EXPECT_EQ(0u, pool.GetIdleCount());
+        pool.DisposeBatch(objects, 20);
+
+        EXPECT_EQ(40u, pool.GetBorrowedCount());
+        EXPECT_EQ(40u, pool.GetReturnedCount());
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
 }
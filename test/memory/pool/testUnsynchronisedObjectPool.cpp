@@ -297,4 +297,111 @@ namespace
         EXPECT_EQ(2u, pool.GetReturnedCount());
     }
 
-}
\ No newline at end of file
+    TEST(UnsynchronisedObjectPool, Trim)
+    {
+        UnsynchronisedObjectPoolImpl pool;
+
+        Base *first = pool.Get();
+        Base *second = pool.Get();
+        pool.Dispose(first);
+        pool.Dispose(second);
+
+        EXPECT_EQ(2u, pool.GetIdleCount());
+        EXPECT_EQ(1u, pool.TrimTo(1));
+        EXPECT_EQ(1u, pool.Trim());
+        EXPECT_EQ(0u, pool.GetIdleCount());
+    }
+
+    TEST(UnsynchronisedObjectPool, Reserve)
+    {
+        UnsynchronisedObjectPoolImpl pool(10);
+
+        EXPECT_EQ(20u, pool.Reserve(20, true));
+        EXPECT_EQ(20u, pool.GetIdleCount());
+        EXPECT_EQ(20u, pool.GetCapacity());
+        EXPECT_EQ(0u, pool.Reserve(5));
+    }
+
+    class Counted
+    {
+    public:
+
+        void OnInit()
+        {
+            ++inits;
+        }
+
+        void OnRelease()
+        {
+            ++releases;
+        }
+
+        U32 inits = 0;
+        U32 releases = 0;
+    };
+
+    TEST(UnsynchronisedObjectPool, GetBatch)
+    {
+        UnsynchronisedObjectPool< Counted > pool(100);
+
+        Counted *objects[10];
+        pool.GetBatch(10, objects);
+
+        for (Counted *object : objects)
+        {
+            EXPECT_EQ(1u, object->inits);
+        }
+
+        EXPECT_EQ(10u, pool.GetBorrowedCount());
+
+        pool.DisposeBatch(objects, 10);
+
+        for (Counted *object : objects)
+        {
+            EXPECT_EQ(1u, object->releases);
+        }
+
+        EXPECT_EQ(10u, pool.GetReturnedCount());
+        EXPECT_EQ(10u, pool.GetIdleCount());
+    }
+
+    TEST(UnsynchronisedObjectPool, GetBatchReuse)
+    {
+        UnsynchronisedObjectPool< Counted > pool(100);
+        pool.Reserve(6);
+
+        Counted *objects[10];
+        pool.FastGetBatch(10, objects);
+
+        EXPECT_EQ(0u, pool.GetIdleCount());
+
+        pool.FastDisposeBatch(objects, 10);
+        pool.FastGetBatch(10, objects);
+
+        // every object comes out of the pool once
+        for (U32 i = 0; i < 10; ++i)
+        {
+            for (U32 j = i + 1; j < 10; ++j)
+            {
+                EXPECT_NE(objects[i], objects[j]);
+            }
+
+            EXPECT_EQ(0u, objects[i]->inits);
+        }
+
+        pool.FastDisposeBatch(objects, 10);
+        EXPECT_EQ(10u, pool.GetIdleCount());
+    }
+
+    TEST(UnsynchronisedObjectPool, DisposeBatchOverflow)
+    {
+        UnsynchronisedObjectPool< Counted > pool(4);
+
+        Counted *objects[10];
+        pool.GetBatch(10, objects);
+        pool.DisposeBatch(objects, 10);
+
+        EXPECT_EQ(4u, pool.GetIdleCount());
+        EXPECT_EQ(10u, pool.GetReturnedCount());
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/alignedResource.h"
+#include "memory/resource/frameArenaResource.h"
+#include "memory/resource/memoryResource.h"
+
+#include "memory/allocators/frameArena.h"
+#include "memory/allocators/hugePageArena.h"
+
+#include "common/util.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    TEST(MemoryResource, Default)
+    {
+        MemoryResource *resource = GetDefaultMemoryResource();
+        ASSERT_NE(nullptr, resource);
+
+        EXPECT_TRUE(*resource == AlignedResource());
+    }
+
+    TEST(MemoryResource, SetDefault)
+    {
+        FrameArena arena;
+        FrameArenaResource resource(arena);
+
+        MemoryResource *initial = SetDefaultMemoryResource(&resource);
+        EXPECT_EQ(&resource, GetDefaultMemoryResource());
+
+        EXPECT_EQ(&resource, SetDefaultMemoryResource(nullptr));
+        EXPECT_EQ(initial, GetDefaultMemoryResource());
+    }
+
+    TEST(AlignedResource, Allocate)
+    {
+        AlignedResource resource;
+
+        for (size_t alignment = 8; alignment <= 4096; alignment *= 2)
+        {
+            void *ptr = resource.Allocate(100, alignment);
+            EXPECT_EQ(0u, reinterpret_cast< size_t >(ptr) % alignment);
+
+            resource.Deallocate(ptr, 100, alignment);
+        }
+    }
+
+    TEST(AlignedResource, Arena)
+    {
+        HugePageArena arena(SIZE_OF_MB(2), HugePageArena::PageMode::Normal);
+        AlignedResource resource(&arena);
+
+        void *ptr = resource.Allocate(128, 64);
+        EXPECT_TRUE(arena.Owns(ptr));
+        resource.Deallocate(ptr, 128, 64);
+
+        // falls back to the heap when the arena is full
+        void *large = resource.Allocate(SIZE_OF_MB(4), 64);
+        EXPECT_FALSE(arena.Owns(large));
+        resource.Deallocate(large, SIZE_OF_MB(4), 64);
+    }
+
+    TEST(AlignedResource, IsEqual)
+    {
+        HugePageArena arena(SIZE_OF_MB(2), HugePageArena::PageMode::Normal);
+
+        EXPECT_TRUE(AlignedResource() == AlignedResource());
+        EXPECT_TRUE(AlignedResource(&arena) == AlignedResource(&arena));
+        EXPECT_FALSE(AlignedResource(&arena) == AlignedResource());
+    }
+
+    TEST(FrameArenaResource, Allocate)
+    {
+        FrameArena arena;
+        FrameArenaResource resource(arena);
+
+        EXPECT_EQ(&arena, &resource.GetArena());
+
+        void *ptr = resource.Allocate(24, 16);
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(ptr) % 16);
+        EXPECT_GE(arena.GetUsed(), 24u);
+
+        resource.Deallocate(ptr, 24, 16);
+        EXPECT_GE(arena.GetUsed(), 24u);
+
+        arena.Reset();
+        EXPECT_EQ(0u, arena.GetUsed());
+    }
+
+    TEST(FrameArenaResource, IsEqual)
+    {
+        FrameArena arena;
+        FrameArena other;
+
+        EXPECT_TRUE(FrameArenaResource(arena) == FrameArenaResource(arena));
+        EXPECT_FALSE(FrameArenaResource(arena) == FrameArenaResource(other));
+        EXPECT_FALSE(FrameArenaResource(arena) == AlignedResource());
+    }
+}
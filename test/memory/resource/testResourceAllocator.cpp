@@ -0,0 +1,124 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/resourceAllocator.h"
+#include "memory/resource/frameArenaResource.h"
+#include "memory/resource/unsynchronisedPoolResource.h"
+
+#include "memory/allocators/frameArena.h"
+
+#include "engineTest.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    TEST(ResourceAllocator, Default)
+    {
+        ResourceAllocator< U32 > allocator;
+
+        EXPECT_EQ(GetDefaultMemoryResource(), allocator.GetResource());
+    }
+
+    TEST(ResourceAllocator, Rebind)
+    {
+        UnsynchronisedPoolResource resource;
+        ResourceAllocator< U32 > allocator(&resource);
+        ResourceAllocator< U64 > rebound(allocator);
+
+        EXPECT_EQ(&resource, rebound.GetResource());
+        EXPECT_TRUE(allocator == rebound);
+        EXPECT_FALSE(allocator != rebound);
+    }
+
+    TEST(ResourceAllocator, CopyUsesDefault)
+    {
+        UnsynchronisedPoolResource resource;
+        std::vector< U32, ResourceAllocator< U32 >> values({ 1, 2, 3 }, &resource);
+        std::vector< U32, ResourceAllocator< U32 >> copy(values);
+
+        EXPECT_EQ(&resource, values.get_allocator().GetResource());
+        EXPECT_EQ(GetDefaultMemoryResource(), copy.get_allocator().GetResource());
+        EXPECT_EQ(values, copy);
+    }
+
+    TEST(ResourceAllocator, Vector)
+    {
+        FrameArena arena;
+        FrameArenaResource resource(arena);
+
+        std::vector< U64, ResourceAllocator< U64 >> values(&resource);
+
+        for (U64 i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+
+        EXPECT_EQ(999u, values.back());
+        EXPECT_GE(arena.GetUsed(), 1000 * sizeof(U64));
+    }
+
+    TEST(ResourceAllocator, Map)
+    {
+        UnsynchronisedPoolResource resource;
+        typedef ResourceAllocator< std::pair< const U32, U32 >> Allocator;
+
+        std::map< U32, U32, std::less< U32 >, Allocator > values(&resource);
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            values[i] = i * 2;
+        }
+
+        EXPECT_EQ(1000u, values.size());
+        EXPECT_EQ(20u, values[10]);
+
+        values.clear();
+        values[1] = 1;
+        EXPECT_EQ(1u, values.size());
+    }
+
+    TEST(ResourceAllocator, UnorderedMap)
+    {
+        UnsynchronisedPoolResource resource;
+        typedef ResourceAllocator< std::pair< const std::string, U32 >> Allocator;
+
+        std::unordered_map< std::string, U32, std::hash< std::string >, std::equal_to< std::string >, Allocator >
+        values(16, std::hash< std::string >(), std::equal_to< std::string >(), &resource);
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            values[std::to_string(i)] = i;
+        }
+
+        EXPECT_EQ(1000u, values.size());
+        EXPECT_EQ(500u, values["500"]);
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/resource/unsynchronisedPoolResource.h"
+#include "memory/resource/alignedResource.h"
+
+#include "engineTest.h"
+
+#include <set>
+
+namespace
+{
+    class CountingResource
+        : public MemoryResource
+    {
+    public:
+
+        size_t allocations = 0;
+        size_t deallocations = 0;
+
+    private:
+
+        AlignedResource mResource;
+
+        void *DoAllocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return mResource.Allocate(bytes, alignment);
+        }
+
+        void DoDeallocate(void *ptr, size_t bytes, size_t alignment) override
+        {
+            ++deallocations;
+            mResource.Deallocate(ptr, bytes, alignment);
+        }
+
+        bool DoIsEqual(const MemoryResource &) const noexcept override
+        {
+            return false;
+        }
+    };
+
+    TEST(UnsynchronisedPoolResource, Sanity)
+    {
+        CountingResource upstream;
+        UnsynchronisedPoolResource resource(500, 4096, &upstream);
+
+        EXPECT_EQ(512u, resource.GetLargestBlock());
+        EXPECT_EQ(&upstream, resource.GetUpstream());
+        EXPECT_EQ(0u, upstream.allocations);
+    }
+
+    TEST(UnsynchronisedPoolResource, Reuse)
+    {
+        CountingResource upstream;
+        UnsynchronisedPoolResource resource(512, 4096, &upstream);
+
+        void *a = resource.Allocate(24, 8);
+        resource.Deallocate(a, 24, 8);
+
+        // the same size class hands out the freed block
+        void *b = resource.Allocate(32, 8);
+        EXPECT_EQ(a, b);
+        EXPECT_EQ(1u, upstream.allocations);
+
+        resource.Deallocate(b, 32, 8);
+    }
+
+    TEST(UnsynchronisedPoolResource, Alignment)
+    {
+        UnsynchronisedPoolResource resource;
+
+        for (size_t alignment = 8; alignment <= 64; alignment *= 2)
+        {
+            for (size_t bytes = 1; bytes <= 512; bytes += 7)
+            {
+                void *ptr = resource.Allocate(bytes, alignment);
+                EXPECT_EQ(0u, reinterpret_cast< size_t >(ptr) % alignment);
+            }
+        }
+    }
+
+    TEST(UnsynchronisedPoolResource, Distinct)
+    {
+        UnsynchronisedPoolResource resource(512, 1024);
+        std::set< void * > blocks;
+
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            EXPECT_TRUE(blocks.insert(resource.Allocate(16 + i % 100, 8)).second);
+        }
+    }
+
+    TEST(UnsynchronisedPoolResource, Large)
+    {
+        CountingResource upstream;
+        UnsynchronisedPoolResource resource(512, 4096, &upstream);
+
+        void *ptr = resource.Allocate(1024, 8);
+        EXPECT_EQ(1u, upstream.allocations);
+
+        resource.Deallocate(ptr, 1024, 8);
+        EXPECT_EQ(1u, upstream.deallocations);
+
+        ptr = resource.Allocate(64, 128);
+        resource.Deallocate(ptr, 64, 128);
+        EXPECT_EQ(2u, upstream.deallocations);
+    }
+
+    TEST(UnsynchronisedPoolResource, Release)
+    {
+        CountingResource upstream;
+        {
+            UnsynchronisedPoolResource resource(512, 4096, &upstream);
+
+            for (U32 i = 0; i < 100; ++i)
+            {
+                resource.Allocate(256, 8);
+            }
+
+            EXPECT_LT(1u, upstream.allocations);
+
+            resource.Release();
+            EXPECT_EQ(upstream.allocations, upstream.deallocations);
+
+            resource.Allocate(256, 8);
+        }
+
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    }
+
+    TEST(UnsynchronisedPoolResource, IsEqual)
+    {
+        UnsynchronisedPoolResource resource;
+        UnsynchronisedPoolResource other;
+
+        EXPECT_TRUE(resource == resource);
+        EXPECT_FALSE(resource == other);
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/heapProfiler.h"
+
+#include "engineTest.h"
+
+#include <sstream>
+
+namespace
+{
+    const void *FakeAddress(size_t i)
+    {
+        // the profiler never dereferences the sampled pointers
+        return reinterpret_cast< const void * >(0x100000 + i * 64);
+    }
+
+    // sets the interval and makes sure this thread noticed, also when a previous test disabled sampling
+    void Enable(size_t interval)
+    {
+        HeapProfiler::SetSampleInterval(interval);
+        HeapProfiler::OnAllocate(FakeAddress(0), 4 * 1024 * 1024, HeapSampleSource::Heap);
+        HeapProfiler::OnFree(FakeAddress(0), HeapSampleSource::Heap);
+        HeapProfiler::Reset();
+    }
+
+    void Restore()
+    {
+        HeapProfiler::SetSampleInterval(HeapProfiler::DefaultSampleInterval);
+        HeapProfiler::Reset();
+    }
+
+    TEST(HeapProfiler, SampleAndFree)
+    {
+        Enable(1);
+
+        HeapProfiler::OnAllocate(FakeAddress(1), 4096, HeapSampleSource::Heap);
+
+        HeapProfileSummary summary = HeapProfiler::GetSummary();
+        EXPECT_EQ(1u, summary.samples);
+        EXPECT_NEAR(4096.0, summary.estimatedBytes, 1.0);
+        EXPECT_NEAR(1.0, summary.estimatedObjects, 0.001);
+
+        HeapProfiler::OnFree(FakeAddress(1), HeapSampleSource::Heap);
+        EXPECT_EQ(0u, HeapProfiler::GetSummary().samples);
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, Disabled)
+    {
+        Enable(0);
+
+        for (size_t i = 1; i < 100; ++i)
+        {
+            HeapProfiler::OnAllocate(FakeAddress(i), 4096, HeapSampleSource::Heap);
+        }
+
+        EXPECT_EQ(0u, HeapProfiler::GetSummary().samples);
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, Sources)
+    {
+        Enable(1);
+
+        HeapProfiler::OnAllocate(FakeAddress(1), 4096, HeapSampleSource::Heap);
+        HeapProfiler::OnAllocate(FakeAddress(1), 64, HeapSampleSource::Pool);
+
+        EXPECT_EQ(2u, HeapProfiler::GetSummary().samples);
+        EXPECT_EQ(1u, HeapProfiler::GetSummary(HeapSampleSource::Pool).samples);
+
+        HeapProfiler::OnFree(FakeAddress(1), HeapSampleSource::Pool);
+
+        EXPECT_EQ(0u, HeapProfiler::GetSummary(HeapSampleSource::Pool).samples);
+        EXPECT_EQ(1u, HeapProfiler::GetSummary(HeapSampleSource::Heap).samples);
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, UnsampledFree)
+    {
+        Enable(1);
+
+        HeapProfiler::OnAllocate(FakeAddress(1), 4096, HeapSampleSource::Heap);
+        HeapProfiler::OnFree(FakeAddress(2), HeapSampleSource::Heap);
+
+        EXPECT_EQ(1u, HeapProfiler::GetSummary().samples);
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, Estimate)
+    {
+        Enable(1024);
+
+        const size_t count = 100000;
+
+        for (size_t i = 1; i <= count; ++i)
+        {
+            HeapProfiler::OnAllocate(FakeAddress(i), 64, HeapSampleSource::Heap);
+        }
+
+        // about 6250 samples, so the estimate is well within ten percent
+        HeapProfileSummary summary = HeapProfiler::GetSummary();
+        EXPECT_NEAR(64.0 * count, summary.estimatedBytes, 6.4 * count);
+        EXPECT_NEAR(static_cast< F64 >(count), summary.estimatedObjects, 0.1 * count);
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, WriteText)
+    {
+        Enable(1);
+
+        HeapProfiler::OnAllocate(FakeAddress(1), 4096, HeapSampleSource::Heap);
+
+        std::stringstream stream;
+        HeapProfiler::WriteText(stream);
+
+        EXPECT_NE(std::string::npos, stream.str().find("Heap profile: 1 live samples, ~4096 bytes in ~1 objects"));
+
+        Restore();
+    }
+
+    TEST(HeapProfiler, WritePprof)
+    {
+        Enable(1);
+
+        HeapProfiler::OnAllocate(FakeAddress(1), 4096, HeapSampleSource::Heap);
+        HeapProfiler::OnAllocate(FakeAddress(2), 4096, HeapSampleSource::Heap);
+        HeapProfiler::OnFree(FakeAddress(2), HeapSampleSource::Heap);
+
+        std::stringstream stream;
+        HeapProfiler::WritePprof(stream);
+
+        EXPECT_EQ(0u, stream.str().find("heap profile: 1: 4096 [2: 8192] @ heap_v2/1\n"));
+
+        Restore();
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/memoryTag.h"
+
+#include "manager/scheduleManager.h"
+
+#include "engineTest.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    TEST(MemoryTag, Sanity)
+    {
+        MemoryTag tag("Test", MemoryKind::Pool, 3U);
+
+        EXPECT_EQ("Test", tag.GetName());
+        EXPECT_EQ(MemoryKind::Pool, tag.GetKind());
+        EXPECT_EQ(Namespace(3U), tag.GetNamespace());
+
+        const MemoryStats stats = tag.Collect(std::chrono::microseconds(1000));
+        EXPECT_EQ(0, stats.bytes);
+        EXPECT_EQ(0, stats.peakBytes);
+        EXPECT_EQ(0, stats.liveObjects);
+        EXPECT_EQ(0u, stats.allocations);
+    }
+
+    TEST(MemoryTag, AllocateFree)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        tag.OnAllocate(100);
+        tag.OnAllocate(50);
+        tag.OnFree(100);
+
+        const MemoryStats stats = tag.Collect(std::chrono::microseconds(1000));
+        EXPECT_EQ(50, stats.bytes);
+        EXPECT_EQ(2u, stats.allocations);
+    }
+
+    TEST(MemoryTag, AcquireRelease)
+    {
+        MemoryTag tag("Test", MemoryKind::Pool, 0U);
+
+        tag.OnAcquire();
+        tag.OnAcquire();
+        tag.OnRelease();
+
+        EXPECT_EQ(1, tag.Collect(std::chrono::microseconds(1000)).liveObjects);
+    }
+
+    TEST(MemoryTag, Peak)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        tag.OnAllocate(100);
+        EXPECT_EQ(100, tag.Collect(std::chrono::microseconds(1000)).peakBytes);
+
+        tag.OnFree(100);
+        const MemoryStats stats = tag.Collect(std::chrono::microseconds(1000));
+        EXPECT_EQ(0, stats.bytes);
+        EXPECT_EQ(100, stats.peakBytes);
+    }
+
+    TEST(MemoryTag, AllocationRate)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        tag.OnAllocate(1);
+        tag.OnAllocate(1);
+        EXPECT_DOUBLE_EQ(2000.0, tag.Collect(std::chrono::microseconds(1000)).allocationRate);
+
+        tag.OnAllocate(1);
+        EXPECT_DOUBLE_EQ(500.0, tag.Collect(std::chrono::microseconds(2000)).allocationRate);
+        EXPECT_DOUBLE_EQ(0.0, tag.Collect(std::chrono::microseconds(1000)).allocationRate);
+    }
+
+    TEST(MemoryTag, Sample)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        tag.OnAllocate(10);
+        tag.Sample(1000);
+        EXPECT_EQ(1010, tag.Collect(std::chrono::microseconds(1000)).bytes);
+
+        tag.Sample(0);
+        EXPECT_EQ(10, tag.Collect(std::chrono::microseconds(1000)).bytes);
+    }
+
+    TEST(MemoryTag, SetNamespace)
+    {
+        MemoryTag tag("Test", MemoryKind::Pool, 0U);
+        tag.SetNamespace(5U);
+
+        EXPECT_EQ(Namespace(5U), tag.GetNamespace());
+        EXPECT_EQ(Namespace(5U), tag.Collect(std::chrono::microseconds(1000)).ns);
+    }
+
+    TEST(MemoryTag, CrossThreadFree)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        std::thread allocator([&tag]()
+        {
+            ScheduleManager::SetCurrentThreadID(1);
+            tag.OnAllocate(64);
+        });
+        allocator.join();
+
+        std::thread freer([&tag]()
+        {
+            ScheduleManager::SetCurrentThreadID(2);
+            tag.OnFree(64);
+        });
+        freer.join();
+
+        EXPECT_EQ(0, tag.Collect(std::chrono::microseconds(1000)).bytes);
+    }
+
+    TEST(MemoryTag, Threaded)
+    {
+        MemoryTag tag("Test", MemoryKind::Allocator, 0U);
+
+        std::vector< std::thread > threads;
+
+        // the even threads own a slot, the odd threads share one
+        for (ThreadID i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([&tag, i]()
+            {
+                ScheduleManager::SetCurrentThreadID(i % 2 == 0 ? static_cast< ThreadID >(i / 2 + 1) : Thread::InvalidID);
+
+                for (U32 j = 0; j < 10000; ++j)
+                {
+                    tag.OnAllocate(2);
+                    tag.OnFree(1);
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        const MemoryStats stats = tag.Collect(std::chrono::microseconds(1000));
+        EXPECT_EQ(80000, stats.bytes);
+        EXPECT_EQ(80000u, stats.allocations);
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "memory/tracking/memoryTracker.h"
+#include "memory/pool/objectPool.h"
+
+#include "manager/poolManager.h"
+
+#include "engineTest.h"
+
+#include <algorithm>
+
+namespace
+{
+    const MemoryStats *FindStats(const std::vector< MemoryStats > &stats, Namespace ns)
+    {
+        auto it = std::find_if(stats.begin(), stats.end(), [ns](const MemoryStats &s)
+        {
+            return s.ns == ns;
+        });
+
+        return it != stats.end() ? &*it : nullptr;
+    }
+
+    TEST(MemoryTracker, Register)
+    {
+        MemoryTag *tag = MemoryTracker::Register("TrackerRegister", MemoryKind::Allocator, 0xBEEF0001);
+        tag->OnAllocate(42);
+
+        std::vector< MemoryStats > tags, namespaces;
+        MemoryTracker::Collect(std::chrono::microseconds(1000), tags, namespaces);
+
+        const MemoryStats *stats = FindStats(tags, 0xBEEF0001);
+        ASSERT_NE(nullptr, stats);
+        EXPECT_EQ("TrackerRegister", stats->name);
+        EXPECT_EQ(42, stats->bytes);
+
+        MemoryTracker::Unregister(tag);
+        MemoryTracker::Collect(std::chrono::microseconds(1000), tags, namespaces);
+
+        EXPECT_EQ(nullptr, FindStats(tags, 0xBEEF0001));
+    }
+
+    TEST(MemoryTracker, Namespaces)
+    {
+        MemoryTag *pool = MemoryTracker::Register("TrackerPool", MemoryKind::Pool, 0xBEEF0002);
+        MemoryTag *allocator = MemoryTracker::Register("TrackerAllocator", MemoryKind::Allocator, 0xBEEF0002);
+
+        pool->OnAllocate(100);
+        pool->OnAcquire();
+        allocator->OnAllocate(50);
+
+        std::vector< MemoryStats > tags, namespaces;
+        MemoryTracker::Collect(std::chrono::microseconds(1000), tags, namespaces);
+
+        const MemoryStats *total = FindStats(namespaces, 0xBEEF0002);
+        ASSERT_NE(nullptr, total);
+        EXPECT_EQ(MemoryKind::Namespace, total->kind);
+        EXPECT_EQ(150, total->bytes);
+        EXPECT_EQ(150, total->peakBytes);
+        EXPECT_EQ(1, total->liveObjects);
+        EXPECT_EQ(2u, total->allocations);
+
+        pool->OnFree(100);
+        MemoryTracker::Collect(std::chrono::microseconds(1000), tags, namespaces);
+
+        total = FindStats(namespaces, 0xBEEF0002);
+        ASSERT_NE(nullptr, total);
+        EXPECT_EQ(50, total->bytes);
+        EXPECT_EQ(150, total->peakBytes);
+
+        MemoryTracker::Unregister(pool);
+        MemoryTracker::Unregister(allocator);
+    }
+
+#if PROGRAM_MEMORY_TRACKING
+
+    class TrackedObject
+    {
+    public:
+
+        void OnInit()
+        {
+        }
+
+        void OnRelease()
+        {
+        }
+
+        U64 data[4];
+    };
+
+    TEST(MemoryTracker, ObjectPool)
+    {
+        PoolManager m;
+        AbstractObjectPool< TrackedObject > *pool = m.Add< TrackedObject >(0xBEEF0003);
+
+        TrackedObject *a = pool->Get();
+        TrackedObject *b = pool->Get();
+        pool->Dispose(a);
+
+        std::vector< MemoryStats > tags, namespaces;
+        MemoryTracker::Collect(std::chrono::microseconds(1000), tags, namespaces);
+
+        const MemoryStats *stats = FindStats(tags, 0xBEEF0003);
+        ASSERT_NE(nullptr, stats);
+        EXPECT_EQ(MemoryKind::Pool, stats->kind);
+        EXPECT_EQ(static_cast< S64 >(2 * sizeof(TrackedObject)), stats->bytes);
+        EXPECT_EQ(1, stats->liveObjects);
+        EXPECT_EQ(2u, stats->allocations);
+
+        pool->Dispose(b);
+    }
+
+#endif
+}
@@ -0,0 +1,62 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/backoff.h"
+
+#include "engineTest.h"
+
+namespace
+{
+    TEST(Backoff, Sanity)
+    {
+        Backoff backoff;
+        EXPECT_EQ(0u, backoff.GetCount());
+    }
+
+    TEST(Backoff, Pause)
+    {
+        Backoff backoff(4);
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            backoff.Pause();
+        }
+
+        EXPECT_EQ(10u, backoff.GetCount());
+    }
+
+    TEST(Backoff, Reset)
+    {
+        Backoff backoff(1);
+
+        backoff.Pause();
+        backoff.Pause();
+        backoff.Reset();
+        backoff.Pause();
+
+        EXPECT_EQ(3u, backoff.GetCount());
+    }
+}
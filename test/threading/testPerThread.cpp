@@ -0,0 +1,143 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/perThread.h"
+
+#include "engineTest.h"
+
+#include <thread>
+
+namespace
+{
+    TEST(CacheAligned, Layout)
+    {
+        EXPECT_EQ(static_cast< size_t >(PROGRAM_CACHE_LINE_SIZE), alignof(CacheAligned< U8 >));
+        EXPECT_EQ(static_cast< size_t >(PROGRAM_CACHE_LINE_SIZE), sizeof(CacheAligned< U8 >));
+
+        CacheAligned< U32 > value(42u);
+        EXPECT_EQ(42u, *value);
+    }
+
+    TEST(PerThread, Sanity)
+    {
+        PerThread< U32 > values(7);
+
+        U32 sum = 0;
+        values.ForEach([&sum](U32 value)
+        {
+            sum += value;
+        });
+
+        EXPECT_EQ(7u * PerThread< U32 >::SlotCount, sum);
+    }
+
+    TEST(PerThread, Alignment)
+    {
+        PerThread< U32 > values;
+
+        for (size_t i = 0; i < PerThread< U32 >::SlotCount; ++i)
+        {
+            EXPECT_EQ(0u, reinterpret_cast< size_t >(&values[i]) % PROGRAM_CACHE_LINE_SIZE);
+        }
+    }
+
+    TEST(PerThread, Get)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        PerThread< U32 > values;
+
+        ScheduleManager::SetCurrentThreadID(1);
+        values.Get() = 1;
+
+        ScheduleManager::SetCurrentThreadID(2);
+        values.Get() = 2;
+
+        EXPECT_EQ(1u, values.Get(1));
+        EXPECT_EQ(2u, values.Get(2));
+        EXPECT_EQ(0u, values.Get(0));
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(PerThread, SharedSlot)
+    {
+        PerThread< U32 > values;
+
+        values.Get(Thread::InvalidID) = 3;
+
+        EXPECT_EQ(3u, values.Get(Thread::LoaderID));
+        EXPECT_EQ(3u, values[PerThread< U32 >::SharedSlot]);
+
+        EXPECT_TRUE(PerThread< U32 >::IsShared(Thread::InvalidID));
+        EXPECT_TRUE(PerThread< U32 >::IsShared(Thread::LoaderID));
+        EXPECT_FALSE(PerThread< U32 >::IsShared(Thread::MainThreadID));
+        EXPECT_FALSE(PerThread< U32 >::IsShared(PROGRAM_MAX_THREADS));
+    }
+
+    TEST(PerThread, OwnerCheckNested)
+    {
+        PerThread< U32 > values;
+        ThreadOwnerCheck &check = values.GetOwnerCheck(1);
+
+        {
+            ThreadOwnerCheck::Guard outer(check);
+            ThreadOwnerCheck::Guard inner(check);
+            values.Get(1) = 1;
+        }
+
+        ThreadOwnerCheck::Guard again(check);
+        EXPECT_EQ(1u, values.Get(1));
+    }
+
+    TEST(PerThread, OwnerCheckHandover)
+    {
+        PerThread< U32 > values;
+        ThreadOwnerCheck &check = values.GetOwnerCheck(1);
+
+        {
+            ThreadOwnerCheck::Guard guard(check);
+            values.Get(1) = 1;
+        }
+
+        // another thread may reuse the slot once this one left it
+        std::thread([&values, &check]()
+        {
+            ThreadOwnerCheck::Guard guard(check);
+            ++values.Get(1);
+        }).join();
+
+        ThreadOwnerCheck::Guard guard(check);
+        EXPECT_EQ(2u, values.Get(1));
+    }
+
+    TEST(PerThread, OwnerCheckSlots)
+    {
+        PerThread< U32 > values;
+
+        EXPECT_EQ(&values.GetOwnerCheck(Thread::InvalidID), &values.GetOwnerCheck(Thread::LoaderID));
+        EXPECT_NE(&values.GetOwnerCheck(1), &values.GetOwnerCheck(2));
+    }
+}
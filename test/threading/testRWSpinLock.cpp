@@ -0,0 +1,175 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/rwSpinLock.h"
+
+#include "engineTest.h"
+
+#include <shared_mutex>
+#include <thread>
+#include <mutex>
+
+namespace
+{
+    TEST(RWSpinLock, Sanity)
+    {
+        RWSpinLock l;
+        l.lock();
+        l.unlock();
+    }
+
+    TEST(RWSpinLock, SharedSanity)
+    {
+        RWSpinLock l;
+        l.lock_shared();
+        l.unlock_shared();
+    }
+
+    TEST(RWSpinLock, MultipleReaders)
+    {
+        RWSpinLock l;
+
+        EXPECT_TRUE(l.try_lock_shared());
+        EXPECT_TRUE(l.try_lock_shared());
+
+        l.unlock_shared();
+        l.unlock_shared();
+    }
+
+    TEST(RWSpinLock, ReaderBlocksWriter)
+    {
+        RWSpinLock l;
+
+        l.lock_shared();
+        EXPECT_FALSE(l.try_lock());
+        l.unlock_shared();
+
+        EXPECT_TRUE(l.try_lock());
+        l.unlock();
+    }
+
+    TEST(RWSpinLock, WriterBlocksReader)
+    {
+        RWSpinLock l;
+
+        l.lock();
+        EXPECT_FALSE(l.try_lock_shared());
+        EXPECT_FALSE(l.try_lock());
+        l.unlock();
+
+        EXPECT_TRUE(l.try_lock_shared());
+        l.unlock_shared();
+    }
+
+    TEST(RWSpinLock, StdLocks)
+    {
+        RWSpinLock l;
+
+        {
+            std::shared_lock< RWSpinLock > lock(l);
+        }
+
+        {
+            std::lock_guard< RWSpinLock > lock(l);
+        }
+
+        EXPECT_TRUE(l.try_lock());
+        l.unlock();
+    }
+
+    TEST(RWSpinLock, Contention)
+    {
+        RWSpinLock l;
+
+        EXPECT_EQ(0u, l.GetReadContentionCount());
+        EXPECT_EQ(0u, l.GetWriteContentionCount());
+
+        l.lock();
+
+        std::thread reader([&l]()
+        {
+            l.lock_shared();
+            l.unlock_shared();
+        });
+
+        while (l.GetReadContentionCount() == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        l.unlock();
+        reader.join();
+
+        EXPECT_EQ(1u, l.GetReadContentionCount());
+
+        l.ResetContentionCounts();
+        EXPECT_EQ(0u, l.GetReadContentionCount());
+    }
+
+    TEST(RWSpinLock, Threaded)
+    {
+        RWSpinLock l;
+        U32 a = 0;
+        U32 b = 0;
+        bool consistent = true;
+
+        std::vector< std::thread > threads;
+
+        for (U32 t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (U32 i = 0; i < 10000; ++i)
+                {
+                    if (i % 20 == t)
+                    {
+                        std::lock_guard< RWSpinLock > lock(l);
+                        ++a;
+                        ++b;
+                    }
+                    else
+                    {
+                        std::shared_lock< RWSpinLock > lock(l);
+
+                        if (a != b)
+                        {
+                            consistent = false;
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_TRUE(consistent);
+        EXPECT_EQ(2000u, a);
+        EXPECT_EQ(a, b);
+    }
+}
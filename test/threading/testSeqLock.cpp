@@ -0,0 +1,101 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/seqLock.h"
+
+#include "engineTest.h"
+
+#include <thread>
+
+namespace
+{
+    struct Snapshot
+    {
+        U64 first;
+        U64 second;
+        U64 third;
+    };
+
+    TEST(SeqLock, Sanity)
+    {
+        SeqLock< U32 > l;
+        EXPECT_EQ(0u, l.Read());
+    }
+
+    TEST(SeqLock, Initial)
+    {
+        SeqLock< U32 > l(42u);
+        EXPECT_EQ(42u, l.Read());
+    }
+
+    TEST(SeqLock, Write)
+    {
+        SeqLock< Snapshot > l;
+
+        l.Write({ 1, 2, 3 });
+
+        const Snapshot snapshot = l.Read();
+        EXPECT_EQ(1u, snapshot.first);
+        EXPECT_EQ(2u, snapshot.second);
+        EXPECT_EQ(3u, snapshot.third);
+
+        EXPECT_EQ(0u, l.GetReadRetryCount());
+        EXPECT_EQ(0u, l.GetWriteContentionCount());
+    }
+
+    TEST(SeqLock, Threaded)
+    {
+        SeqLock< Snapshot > l;
+        bool consistent = true;
+
+        std::thread writer([&l]()
+        {
+            for (U64 i = 1; i <= 10000; ++i)
+            {
+                l.Write({ i, i * 2, i * 3 });
+            }
+        });
+
+        std::thread reader([&l, &consistent]()
+        {
+            for (U32 i = 0; i < 10000; ++i)
+            {
+                const Snapshot snapshot = l.Read();
+
+                if (snapshot.second != snapshot.first * 2 || snapshot.third != snapshot.first * 3)
+                {
+                    consistent = false;
+                }
+            }
+        });
+
+        writer.join();
+        reader.join();
+
+        EXPECT_TRUE(consistent);
+        EXPECT_EQ(10000u, l.Read().first);
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/shardedCounter.h"
+
+#include "engineTest.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    TEST(ShardedCounter, Sanity)
+    {
+        ShardedCounter counter;
+        EXPECT_EQ(0, counter.Get());
+    }
+
+    TEST(ShardedCounter, Add)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        ShardedCounter counter;
+
+        ScheduleManager::SetCurrentThreadID(1);
+        counter.Add(5);
+        counter.Increment();
+
+        ScheduleManager::SetCurrentThreadID(Thread::InvalidID);
+        counter.Decrement();
+
+        EXPECT_EQ(5, counter.Get());
+
+        counter.Reset();
+        EXPECT_EQ(0, counter.Get());
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+
+    TEST(ShardedCounter, Threads)
+    {
+        ShardedCounter counter;
+        std::vector< std::thread > threads;
+
+        // half the threads own a shard, the others share one
+        for (U32 i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([&counter, i]()
+            {
+                ScheduleManager::SetCurrentThreadID(i % 2 == 0 ? static_cast< ThreadID >(i / 2 + 1) : Thread::InvalidID);
+
+                for (U32 j = 0; j < 10000; ++j)
+                {
+                    counter.Increment();
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(80000, counter.Get());
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @cond ___LICENSE___
+ *
+ * Copyright (c) 2016-2018 Zefiros Software.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @endcond
+ */
+
+#include "threading/snapshotPtr.h"
+
+#include "engineTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Counted
+    {
+        explicit Counted(U32 value, U32 *destroyed = nullptr)
+            : value(value),
+              destroyed(destroyed)
+        {
+        }
+
+        ~Counted()
+        {
+            if (destroyed)
+            {
+                ++*destroyed;
+            }
+        }
+
+        U32 value;
+        U32 *destroyed;
+    };
+
+    TEST(SnapshotPtr, Sanity)
+    {
+        SnapshotPtr< Counted > ptr;
+        SnapshotPtr< Counted >::Reader reader(ptr);
+
+        EXPECT_EQ(nullptr, reader.Get());
+    }
+
+    TEST(SnapshotPtr, Publish)
+    {
+        SnapshotPtr< Counted > ptr(new Counted(1));
+        ptr.Publish(new Counted(2));
+
+        SnapshotPtr< Counted >::Reader reader(ptr);
+        EXPECT_EQ(2u, reader->value);
+        EXPECT_EQ(0u, ptr.GetRetiredCount());
+    }
+
+    TEST(SnapshotPtr, ReaderKeepsSnapshot)
+    {
+        U32 destroyed = 0;
+        SnapshotPtr< Counted > ptr(new Counted(1, &destroyed));
+
+        {
+            SnapshotPtr< Counted >::Reader reader(ptr);
+            ptr.Publish(new Counted(2, &destroyed));
+
+            EXPECT_EQ(1u, reader->value);
+            EXPECT_EQ(0u, destroyed);
+            EXPECT_EQ(1u, ptr.GetRetiredCount());
+
+            SnapshotPtr< Counted >::Reader later(ptr);
+            EXPECT_EQ(2u, later->value);
+        }
+
+        ptr.Publish(new Counted(3, &destroyed));
+
+        EXPECT_EQ(2u, destroyed);
+        EXPECT_EQ(0u, ptr.GetRetiredCount());
+    }
+
+    TEST(SnapshotPtr, Reclaim)
+    {
+        U32 destroyed = 0;
+        SnapshotPtr< Counted > ptr(new Counted(1, &destroyed));
+
+        {
+            SnapshotPtr< Counted >::Reader reader(ptr);
+            ptr.Publish(new Counted(2, &destroyed));
+
+            ptr.Reclaim();
+            EXPECT_EQ(1u, ptr.GetRetiredCount());
+        }
+
+        ptr.Reclaim();
+
+        EXPECT_EQ(1u, destroyed);
+        EXPECT_EQ(0u, ptr.GetRetiredCount());
+    }
+
+    TEST(SnapshotPtr, Destruct)
+    {
+        U32 destroyed = 0;
+
+        {
+            SnapshotPtr< Counted > ptr(new Counted(1, &destroyed));
+            SnapshotPtr< Counted >::Reader reader(ptr);
+            ptr.Publish(new Counted(2, &destroyed));
+        }
+
+        EXPECT_EQ(2u, destroyed);
+    }
+
+    TEST(SnapshotPtr, Threads)
+    {
+        const ThreadID threadID = ScheduleManager::GetCurrentThreadID();
+        SnapshotPtr< std::vector< U32 >> ptr(new std::vector< U32 >(1, 0));
+        std::vector< std::thread > readers;
+        std::atomic< bool > stop(false);
+
+        // every snapshot holds its version in all values, so a freed one shows up as a mismatch
+        for (U32 i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&ptr, &stop, i]()
+            {
+                ScheduleManager::SetCurrentThreadID(i % 2 == 0 ? static_cast< ThreadID >(i + 1) : Thread::InvalidID);
+
+                while (!stop.load())
+                {
+                    SnapshotPtr< std::vector< U32 >>::Reader reader(ptr);
+
+                    for (U32 value : *reader)
+                    {
+                        ASSERT_EQ(reader->front(), value);
+                    }
+                }
+            });
+        }
+
+        ScheduleManager::SetCurrentThreadID(Thread::MainThreadID);
+
+        for (U32 i = 1; i < 2000; ++i)
+        {
+            ptr.Publish(new std::vector< U32 >(64, i));
+        }
+
+        stop = true;
+
+        for (std::thread &thread : readers)
+        {
+            thread.join();
+        }
+
+        ptr.Publish(new std::vector< U32 >(1, 0));
+        EXPECT_EQ(0u, ptr.GetRetiredCount());
+
+        ScheduleManager::SetCurrentThreadID(threadID);
+    }
+}
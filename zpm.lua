@@ -65,9 +65,28 @@ workspace "CoreLib"
                     
         includedirs {
             "plugin/test4/include/"
-        }	
-        
-    
+        }
+
+    project "core-bench"
+        kind "ConsoleApp"
+        useCore()
+
+        zpm.uses {
+            "Zefiros-Software/GoogleBenchmark",
+        }
+
+        links "core"
+
+        includedirs {
+            "core/include/",
+            "bench/"
+        }
+
+        files {
+            "bench/**.h",
+            "bench/**.cpp"
+        }
+
     group "Plugins/"
         project "core-plugin-test"    
             targetname "Test"